@@ -42,44 +42,72 @@ namespace Galactic {
 			managedSingleton<Logger>::destroyInstance();
 		}
 
-		void print(UTF16 format, ...) {
-			//Fetch the args
-			va_list args;
-			_crt_va_start(args, format);
-			String result = String::ToStr(format, args);
-			_crt_va_end(args);		
+		//Send a message to the Logger, or to stderr while the console is not initialized (so early errors are not lost)
+		static Logger *fetchLogger(const StringBuilder &message) {
+			Logger *logger = managedSingleton<Logger>::instance();
+			if (logger == NULL) {
+				fprintf(stderr, "%s\n", message.c_str());
+			}
+			return logger;
+		}
+
+		void printArgs(UTF16 format, const FormatArg *args, U32 count) {
+			StringBuilder message;
+			Format::formatArgs(message, format, args, count);
 			//Fork off to Logger
-			managedSingleton<Logger>::instance()->print(result.c_str());
+			Logger *logger = fetchLogger(message);
+			if (logger) {
+				logger->print(message.build());
+			}
 		}
 
-		void warn(UTF16 format, ...) {
-			//Fetch the args
-			va_list args;
-			_crt_va_start(args, format);
-			String result = String::ToStr(format, args);
-			_crt_va_end(args);		
+		void warnArgs(UTF16 format, const FormatArg *args, U32 count) {
+			StringBuilder message;
+			Format::formatArgs(message, format, args, count);
 			//Fork off to Logger
-			managedSingleton<Logger>::instance()->warn(result.c_str());
+			Logger *logger = fetchLogger(message);
+			if (logger) {
+				logger->warn(message.build());
+			}
 		}
 
-		void error(UTF16 format, ...) {
-			//Fetch the args
-			va_list args;
-			_crt_va_start(args, format);
-			String result = String::ToStr(format, args);
-			_crt_va_end(args);		
+		void errorArgs(UTF16 format, const FormatArg *args, U32 count) {
+			StringBuilder message;
+			Format::formatArgs(message, format, args, count);
 			//Fork off to Logger
-			managedSingleton<Logger>::instance()->error(result.c_str());
+			Logger *logger = fetchLogger(message);
+			if (logger) {
+				logger->error(message.build());
+			}
 		}
 
-		void cerr(UTF16 format, ...) {
-			//Fetch the args
-			va_list args;
-			_crt_va_start(args, format);
-			String result = String::ToStr(format, args);
-			_crt_va_end(args);		
+		void cerrArgs(UTF16 format, const FormatArg *args, U32 count) {
+			StringBuilder message;
+			Format::formatArgs(message, format, args, count);
 			//Fork off to Logger
-			managedSingleton<Logger>::instance()->cerr(result.c_str());
+			Logger *logger = fetchLogger(message);
+			if (logger) {
+				logger->cerr(message.build());
+			}
+		}
+
+		void dumpMemoryStats() {
+			PlatformMemory::updateStats();
+			MemoryStatistics stats = PlatformMemory::fetchStats();
+			//Byte counts are printed in KB
+			print("Memory Statistics:");
+			print(" Physical: {} KB used, {} KB peak, {} KB available of {} KB", stats.physicalUsed >> 10, stats.physicalPeak >> 10,
+				stats.physicalAvail >> 10, stats.physicalMem >> 10);
+			print(" Virtual: {} KB used, {} KB available", stats.virtualUsed >> 10, stats.virtualAvail >> 10);
+			#if GALACTIC_MEMORY_TRACKING == 1
+				print(" Tracked: {} KB live, {} KB peak", stats.trackedUsed >> 10, stats.trackedPeak >> 10);
+				for (U32 i = 0; i < MemoryTracker::Tag_Count; i++) {
+					print("  {}: {} KB live, {} KB peak, {} allocations", MemoryTracker::fetchTagName(i), MemoryTracker::fetchLiveBytes(i) >> 10,
+						MemoryTracker::fetchPeakBytes(i) >> 10, MemoryTracker::fetchAllocCount(i));
+				}
+			#else
+				print(" Tracked: Disabled (see GALACTIC_MEMORY_TRACKING)");
+			#endif
 		}
 
 	};
@@ -42,15 +42,39 @@ namespace Galactic {
 		//destroy(): disable the console system. This function is called at engine shutdown and is used for final operations and memory cleanup.
 		void destroy();
 
-		/* Logger Functions: These are forked off to the mSingleton instance of Console::Logger */
+		/* Logger Functions: These format the message (see Core::Format) and fork it off to the mSingleton instance of Console::Logger */
+		//printArgs
+		void printArgs(UTF16 format, const ::Galactic::Core::FormatArg *args, U32 count);
+		//warnArgs
+		void warnArgs(UTF16 format, const ::Galactic::Core::FormatArg *args, U32 count);
+		//errorArgs
+		void errorArgs(UTF16 format, const ::Galactic::Core::FormatArg *args, U32 count);
+		//cerrArgs
+		void cerrArgs(UTF16 format, const ::Galactic::Core::FormatArg *args, U32 count);
 		//print
-		void print(UTF16 format, ...);
+		template <typename... Args> void print(UTF16 format, const Args &... args) {
+			const ::Galactic::Core::FormatArg list[] = { ::Galactic::Core::FormatArg(args)..., ::Galactic::Core::FormatArg() };
+			printArgs(format, list, sizeof...(Args));
+		}
 		//warn
-		void warn(UTF16 format, ...);
+		template <typename... Args> void warn(UTF16 format, const Args &... args) {
+			const ::Galactic::Core::FormatArg list[] = { ::Galactic::Core::FormatArg(args)..., ::Galactic::Core::FormatArg() };
+			warnArgs(format, list, sizeof...(Args));
+		}
 		//error
-		void error(UTF16 format, ...);
+		template <typename... Args> void error(UTF16 format, const Args &... args) {
+			const ::Galactic::Core::FormatArg list[] = { ::Galactic::Core::FormatArg(args)..., ::Galactic::Core::FormatArg() };
+			errorArgs(format, list, sizeof...(Args));
+		}
 		//cerr
-		void cerr(UTF16 format, ...);
+		template <typename... Args> void cerr(UTF16 format, const Args &... args) {
+			const ::Galactic::Core::FormatArg list[] = { ::Galactic::Core::FormatArg(args)..., ::Galactic::Core::FormatArg() };
+			cerrArgs(format, list, sizeof...(Args));
+		}
+
+		/* Diagnostic Functions */
+		//dumpMemoryStats(): prints the process memory usage along with the live and peak bytes of every MemoryTracker tag.
+		void dumpMemoryStats();
 
 	};
 
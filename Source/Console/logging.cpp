@@ -37,19 +37,19 @@ namespace Galactic {
 		
 		}
 
-		void Logger::print(UTF16 s) {
+		void Logger::print(const ::Galactic::Core::String &s) {
 			addMessage(Normal, s);
 		}
 
-		void Logger::warn(UTF16 s) {
+		void Logger::warn(const ::Galactic::Core::String &s) {
 			addMessage(Warning, s);
 		}
 
-		void Logger::error(UTF16 s) {
+		void Logger::error(const ::Galactic::Core::String &s) {
 			addMessage(Error, s);
 		}
 
-		void Logger::cerr(UTF16 s) {
+		void Logger::cerr(const ::Galactic::Core::String &s) {
 			addMessage(Critical, s);
 		}
 
@@ -57,7 +57,7 @@ namespace Galactic {
 			//Stub.. Insert Code Later.
 		}
 
-		void Logger::addMessage(S32 l, UTF16 message) {
+		void Logger::addMessage(S32 l, const ::Galactic::Core::String &message) {
 			LogEntry entry(message, l);
 
 			consoleMB.pushToBack(entry);
@@ -38,14 +38,11 @@ namespace Galactic {
 		*/
 		class LogEntry {
 			public:
-				UTF16 message;
+				::Galactic::Core::String message;
 				S32 level;
 
-				LogEntry() : message(NULL), level(0) { }
-				LogEntry(UTF16 m, S32 l) {
-					message = m;
-					level = l;
-				}
+				LogEntry() : level(0) { }
+				LogEntry(const ::Galactic::Core::String &m, S32 l) : message(m), level(l) { }
 		};
 
 		/*
@@ -60,13 +57,13 @@ namespace Galactic {
 				~Logger();
 
 				//Standard print(), uses Normal logging level
-				void print(UTF16 s);
+				void print(const ::Galactic::Core::String &s);
 				//Standard warn(), uses Warning logging level
-				void warn(UTF16 s);
+				void warn(const ::Galactic::Core::String &s);
 				//Standard error(), uses Error logging level
-				void error(UTF16 s);
+				void error(const ::Galactic::Core::String &s);
 				//Standard cerr(), uses Critial logging level
-				void cerr(UTF16 s);
+				void cerr(const ::Galactic::Core::String &s);
 				//dumpToFile(): places all console output in a file.
 				void dumpToFile(::Galactic::Core::String path);
 		
@@ -76,7 +73,7 @@ namespace Galactic {
 
 				/* Private Class Functions */
 				//Generic Add Method (Add a message to the buffer)
-				void addMessage(S32 l, UTF16 message);
+				void addMessage(S32 l, const ::Galactic::Core::String &message);
 
 				/* Private Class Members */
 				//Defines a level the message is stored in
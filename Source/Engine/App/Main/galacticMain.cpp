@@ -24,6 +24,7 @@
 **/
 
 #include "galacticMain.h"
+#include "../../../EngineCore/Tests/engineTests.h"
 
 namespace Galactic {
 
@@ -72,14 +73,19 @@ namespace Galactic {
 
 			//UNIX Build Init
 			bool GalacticMain::init(S32 argc, UTF8 argv[]) {
-				String arguments;
+				//Size the builder up front, so the arguments are copied exactly once.
+				U32 totalLength = 0;
 				for(S32 i = 0; i < argc; i++) {
-					arguments += argv[i];
+					totalLength += (U32)strlen(argv[i]) + 1;
+				}
+				StringBuilder arguments(totalLength);
+				for(S32 i = 0; i < argc; i++) {
+					arguments.append(argv[i]);
 					if(i != argc-1) {
-						arguments += "\t";
+						arguments.append('\t');
 					}
 				}
-				return initialize(arguments);
+				return initialize(arguments.build());
 			}
 
 			//Windows Build Init
@@ -110,6 +116,13 @@ namespace Galactic {
 				managedSingleton<Galactic::Engine::Game::Genre>::createInstance();
 				//Load the Console and the Scripting Engine
 				Galactic::Console::init();
+				#if GALACTIC_BUILD_TESTS == 1
+					//-runTests: Run the engine's self tests (after the console, which reports them) and exit without entering the main loop.
+					if (ProcessCommandLine::fetchInstance().hasParam("runTests")) {
+						gWantExit = true;
+						return Tests::runAll();
+					}
+				#endif
 				//Once the core is active, we can load in the Game's modules as needed.
 				
 				//Check for an internal project
@@ -136,6 +149,19 @@ namespace Galactic {
 			bool GalacticMain::mainLoop() {
 				while (!gWantExit) {
 					//Do the main loop stuff in here...
+
+					//End of the frame, release all of the per-frame temporaries in one step.
+					FrameArena::endFrame();
+					#if GALACTIC_MEMORY_TRACKING == 1
+						MemoryTracker::sample();
+					#endif
+					gFrameCount++;
+					#if GALACTIC_ALLOCATER_SCAVENGE_FRAMES > 0
+						//Hand cached memory (including that of idle threads) back every so often.
+						if ((gFrameCount % GALACTIC_ALLOCATER_SCAVENGE_FRAMES) == 0) {
+							Memory::releaseIdleMemory();
+						}
+					#endif
 				}
 				return false;
 			}
@@ -92,7 +92,7 @@
 
 					//Perform interlock exchange on a pointer
 					SFIN any exchange(any *dst, any exc) {
-						return __sync_lock_test_and_set(any, exc);
+						return __sync_lock_test_and_set(dst, exc);
 					}
 
 					//Perform interlock compare exchange on a pointer
@@ -0,0 +1,244 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Containers/allocaterPolicy.h
+* Defines the allocater policies used by the engine's containers
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_ALLOCATERPOLICY
+#define GALACTIC_INTERNAL_ALLOCATERPOLICY
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		Allocater Policies: Containers such as DynArray take an allocater policy as a template parameter, and store one instance of it. A policy must provide
+		 the three methods below, policies may hold state (see FrameArenaPolicy, StackAllocaterPolicy) which allows arena, pool and stack allocaters to be
+		 used per container instance. Containers default to GlobalAllocaterPolicy.
+		*/
+
+		/*
+		GlobalAllocaterPolicy: Routes container memory through the global engine Allocater (Memory::gmalloc), this is the default policy for containers.
+		 The memory is accounted to MemoryTracker::Tag_Containers unless the thread is inside of another MemoryTagScope.
+		*/
+		class GlobalAllocaterPolicy {
+			public:
+				/* Public Class Methods */
+				//Allocate a block of memory
+				FINLINE any allocate(SIZE_T bytes) {
+					return Memory::gmallocTagged(bytes, MemoryTracker::resolveTag(MemoryTracker::Tag_Containers));
+				}
+				//Resize a block of memory, the contents are preserved
+				FINLINE any reallocate(any ptr, SIZE_T oldBytes, SIZE_T newBytes) {
+					return Memory::grealloc(ptr, newBytes);
+				}
+				//Release a block of memory
+				FINLINE void deallocate(any ptr, SIZE_T bytes) {
+					Memory::gfree(ptr);
+				}
+		};
+
+		/*
+		InstanceAllocaterPolicy: Routes container memory to a specific Allocater instance (IE: a private StandardAllocater heap for one subsystem).
+		 The allocater must outlive every container using it.
+		*/
+		class InstanceAllocaterPolicy {
+			public:
+				/* Constructor */
+				//Default Constructor, uses the global allocater
+				InstanceAllocaterPolicy() : allocater(NULL) { }
+				//Creation Constructor
+				InstanceAllocaterPolicy(Allocater *trgAllocater) : allocater(trgAllocater) { }
+
+				/* Public Class Methods */
+				//Allocate a block of memory
+				FINLINE any allocate(SIZE_T bytes) {
+					return allocater ? allocater->gmalloc(bytes) : Memory::gmalloc(bytes);
+				}
+				//Resize a block of memory, the contents are preserved
+				FINLINE any reallocate(any ptr, SIZE_T oldBytes, SIZE_T newBytes) {
+					return allocater ? allocater->grealloc(ptr, newBytes) : Memory::grealloc(ptr, newBytes);
+				}
+				//Release a block of memory
+				FINLINE void deallocate(any ptr, SIZE_T bytes) {
+					if (allocater) {
+						allocater->gfree(ptr);
+					}
+					else {
+						Memory::gfree(ptr);
+					}
+				}
+
+			private:
+				/* Private Class Members */
+				//The allocater instance, NULL for the global allocater
+				Allocater *allocater;
+		};
+
+		/*
+		StackBuffer: A fixed size linear buffer (usually placed on the stack) for StackAllocaterPolicy. Allocations are made by moving a bump pointer,
+		 only the most recent allocation can be resized in place or released, everything else is reclaimed when the buffer goes out of scope.
+		*/
+		class StackBuffer {
+			public:
+				/* Constructor */
+				//Creation Constructor
+				StackBuffer(any memory, SIZE_T bytes) : start((UTX8)memory), end((UTX8)memory + bytes), top((UTX8)memory), last(NULL) { }
+
+				/* Public Class Methods */
+				//Allocate a block from the buffer, returns NULL if the buffer is full
+				any alloc(SIZE_T bytes) {
+					UTX8 block = (UTX8)(((IntPointer)top + 15) & ~(IntPointer)15);
+					if (block + bytes > end || block < top) {
+						return NULL;
+					}
+					top = block + bytes;
+					last = block;
+					return block;
+				}
+				//Resize the most recent allocation in place, returns false if the block cannot be resized
+				bool resize(any ptr, SIZE_T bytes) {
+					if (ptr != last || (UTX8)ptr + bytes > end) {
+						return false;
+					}
+					top = (UTX8)ptr + bytes;
+					return true;
+				}
+				//Release the most recent allocation, other blocks are ignored
+				void release(any ptr) {
+					if (ptr == last) {
+						top = last;
+						last = NULL;
+					}
+				}
+				//Test if a block belongs to this buffer
+				bool owns(cAny ptr) const {
+					return (UTX8)ptr >= start && (UTX8)ptr < end;
+				}
+
+			private:
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				StackBuffer(const StackBuffer &);
+				//Assignment Operator
+				StackBuffer &operator=(const StackBuffer &);
+
+				/* Private Class Members */
+				//The start of the buffer
+				UTX8 start;
+				//The end of the buffer
+				UTX8 end;
+				//The next free byte
+				UTX8 top;
+				//The most recent allocation
+				UTX8 last;
+		};
+
+		/*
+		FixedStackBuffer: A StackBuffer with it's own inline storage, IE: FixedStackBuffer<1024> scratch; DynArray<S32, StackAllocaterPolicy> arr(0, scratch);
+		*/
+		template <U32 bytes> class FixedStackBuffer : public StackBuffer {
+			public:
+				/* Constructor */
+				//Default Constructor
+				FixedStackBuffer() : StackBuffer(storage, bytes) { }
+
+			private:
+				/* Private Class Members */
+				//The inline storage
+				U64 storage[(bytes + sizeof(U64) - 1) / sizeof(U64)];
+		};
+
+		/*
+		StackAllocaterPolicy: Allocates container memory from a StackBuffer, falling back to the global allocater once the buffer is full. The buffer must
+		 outlive every container using it.
+		*/
+		class StackAllocaterPolicy {
+			public:
+				/* Constructor */
+				//Creation Constructor
+				StackAllocaterPolicy(StackBuffer &trgBuffer) : buffer(&trgBuffer) { }
+
+				/* Public Class Methods */
+				//Allocate a block of memory
+				any allocate(SIZE_T bytes) {
+					any ptr = buffer->alloc(bytes);
+					return ptr ? ptr : Memory::gmalloc(bytes);
+				}
+				//Resize a block of memory, the contents are preserved
+				any reallocate(any ptr, SIZE_T oldBytes, SIZE_T newBytes) {
+					if (!buffer->owns(ptr)) {
+						return Memory::grealloc(ptr, newBytes);
+					}
+					if (buffer->resize(ptr, newBytes)) {
+						return ptr;
+					}
+					any newPtr = allocate(newBytes);
+					if (newPtr) {
+						Memory::gmemcpy(newPtr, ptr, oldBytes < newBytes ? oldBytes : newBytes);
+					}
+					return newPtr;
+				}
+				//Release a block of memory
+				void deallocate(any ptr, SIZE_T bytes) {
+					if (ptr == NULL) {
+						return;
+					}
+					if (buffer->owns(ptr)) {
+						buffer->release(ptr);
+					}
+					else {
+						Memory::gfree(ptr);
+					}
+				}
+
+			private:
+				/* Private Class Members */
+				//The buffer used for allocations
+				StackBuffer *buffer;
+		};
+
+		/*
+		SystemAllocaterPolicy: Routes container memory directly to the C runtime heap.
+		*/
+		class SystemAllocaterPolicy {
+			public:
+				/* Public Class Methods */
+				//Allocate a block of memory
+				FINLINE any allocate(SIZE_T bytes) {
+					return ::malloc(bytes);
+				}
+				//Resize a block of memory, the contents are preserved
+				FINLINE any reallocate(any ptr, SIZE_T oldBytes, SIZE_T newBytes) {
+					return ::realloc(ptr, newBytes);
+				}
+				//Release a block of memory
+				FINLINE void deallocate(any ptr, SIZE_T bytes) {
+					::free(ptr);
+				}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_ALLOCATERPOLICY
\ No newline at end of file
@@ -35,17 +35,18 @@ namespace Galactic {
 		/*
 		DynArray is a template array class, you can create a definition of a dynamically adjusting array of objects by means of
 		 DynArray<class> x; Numerous arrayObj operations are provided in the class definition below, however the application of the DynArray
-		 class behaves quite similarly to that of std::vector, thus granting std::vector capabilities without needing the STL.
+		 class behaves quite similarly to that of std::vector, thus granting std::vector capabilities without needing the STL. The second template parameter
+		 is the allocater policy used for the array memory (see allocaterPolicy.h), it defaults to GlobalAllocaterPolicy (declared in engineCore.h).
 		*/
-		template <class T> class DynArray {	
+		template <class T, class A> class DynArray {	
 			typedef T& ref;
 			typedef const T* X;
 			typedef T* Y;
 			typedef const T& Z;
 
 			public:
-				//Dynamic Array Constructor: initial size definition 
-				DynArray(Z32 initialSize = 0);
+				//Dynamic Array Constructor: initial size definition, with an optional allocater policy instance
+				DynArray(Z32 initialSize = 0, const A &alloc = A());
 				//Dynamic Array Constructor: Clone existing array definition
 				DynArray(const DynArray & c);
 				//Dynamic Array Destructor.
@@ -135,6 +136,8 @@ namespace Galactic {
 				void clear();
 				//Clears all empty (deallocated) instances from the arrayObj
 				void compact();
+				//Exchanges the elements (and allocaters) of two arrays without copying the elements
+				void swap(DynArray &other);
 				//Fills the entire arrayObj (allocated space) with instances of const T& Value
 				void fill(Z value);
 				//Removes all instances of const T& found from the arrayObj.
@@ -160,6 +163,8 @@ namespace Galactic {
 				U32 arrayObjSize;
 				//The pointer instance to each element within the arrayObj
 				Y arrayObj;
+				//The allocater policy used for the arrayObj memory
+				A allocater;
 
 				/* Standard Array Functions (Protected) */
 				//resize the memory space of the arrayObj for allocation
@@ -212,7 +217,7 @@ namespace Galactic {
 
 		/**
 		**/
-		template <class T> DynArray<T>::DynArray(Z32 initialSize) {
+		template <class T, class A> DynArray<T, A>::DynArray(Z32 initialSize, const A &alloc) : allocater(alloc) {
 			arrayObj = NULL;
 			elementCount = 0;
 			arrayObjSize = 0;
@@ -222,45 +227,44 @@ namespace Galactic {
 			}
 		}
 
-		template <class T> DynArray<T>::DynArray(const DynArray & c) {
+		template <class T, class A> DynArray<T, A>::DynArray(const DynArray & c) : allocater(c.allocater) {
 			//Copy one DynArray into another.
 			arrayObj = NULL;
 			resize(c.elementCount);
 			constr(0, p.elementCount, p.arrayObj);
 		}
 
-		template <class T> DynArray<T>::~DynArray() {
+		template <class T, class A> DynArray<T, A>::~DynArray() {
 			clear();
-			//Compiler is bitching with C2146 if you use SendToHeaven() Here.
-			free(arrayObj);
+			allocater.deallocate(arrayObj, arrayObjSize * sizeof(T));
 			arrayObj = NULL;
 		}
 
-		template <class T> T* DynArray<T>::begin() {
+		template <class T, class A> T* DynArray<T, A>::begin() {
 			return arrayObj;
 		}
 
-		template <class T> const T* DynArray<T>::begin() const {
+		template <class T, class A> const T* DynArray<T, A>::begin() const {
 			return arrayObj;
 		}
 
-		template <class T> T* DynArray<T>::end() {
+		template <class T, class A> T* DynArray<T, A>::end() {
 			return arrayObj + elementCount;
 		}
 
-		template <class T> const T* DynArray<T>::end() const {
+		template <class T, class A> const T* DynArray<T, A>::end() const {
 			return arrayObj + elementCount;
 		}
 
-		template <class T> S32 DynArray<T>::size() const {
+		template <class T, class A> S32 DynArray<T, A>::size() const {
 			return (S32)elementCount;
 		}
 
-		template <class T> bool DynArray<T>::isEmpty() const {
+		template <class T, class A> bool DynArray<T, A>::isEmpty() const {
 			return (elementCount == 0);
 		}
 
-		template <class T> bool DynArray<T>::contains(const T& e) const {
+		template <class T, class A> bool DynArray<T, A>::contains(const T& e) const {
 			const T* iterator = begin();
 			while(iterator != end()) {
 				if(*iterator == e) {
@@ -271,55 +275,55 @@ namespace Galactic {
 			return false;
 		}
 
-		template <class T> void DynArray<T>::insert(T* position, const T& newItem) {
+		template <class T, class A> void DynArray<T, A>::insert(T* position, const T& newItem) {
 			U32 indexPosition = (U32)(position - arrayObj);
 			insert(indexPosition);
 			arrayObj[index] = newItem;
 		}
 
-		template <class T> void DynArray<T>::erase(T* position) {
+		template <class T, class A> void DynArray<T, A>::erase(T* position) {
 			erase(U32(position - arrayObj));
 		}
 
-		template <class T> T& DynArray<T>::front() {
+		template <class T, class A> T& DynArray<T, A>::front() {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return *begin();
 		}
 
-		template <class T> const T& DynArray<T>::front() const {
+		template <class T, class A> const T& DynArray<T, A>::front() const {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return *begin();
 		}
 
-		template <class T> T& DynArray<T>::back() {
+		template <class T, class A> T& DynArray<T, A>::back() {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return *(end() - 1);
 		}
 
-		template <class T> const T& DynArray<T>::back() const {
+		template <class T, class A> const T& DynArray<T, A>::back() const {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return *(end() - 1);
 		}
 
-		template <class T> void DynArray<T>::pushToFront(const T& e) {
+		template <class T, class A> void DynArray<T, A>::pushToFront(const T& e) {
 			insert(0);
 			arrayObj[0] = e;
 		}
 
-		template <class T> void DynArray<T>::pushToBack(const T& e) {
+		template <class T, class A> void DynArray<T, A>::pushToBack(const T& e) {
 			inc();
 			arrayObj[elementCount - 1] = e;
 		}
 
-		template <class T> void DynArray<T>::popFront() {
+		template <class T, class A> void DynArray<T, A>::popFront() {
 			if(elementCount == 0) {
 				//No element to pop.
 				return;
@@ -327,7 +331,7 @@ namespace Galactic {
 			erase(U32(0));
 		}
 
-		template <class T> void DynArray<T>::popBack() {
+		template <class T, class A> void DynArray<T, A>::popBack() {
 			if(elementCount == 0) {
 				//No element to pop.
 				return;
@@ -335,7 +339,7 @@ namespace Galactic {
 			dec(); //dec() handles deletion of the back element.
 		}
 
-		template <class T> S32 DynArray<T>::findNext(const T& e, U32 startPos) const {
+		template <class T, class A> S32 DynArray<T, A>::findNext(const T& e, U32 startPos) const {
 			if(start >= elementCount) {
 				return -1;
 			}
@@ -347,21 +351,21 @@ namespace Galactic {
 			return -1;
 		}
 
-		template <class T> T& DynArray<T>::operator[](U32 index) {
+		template <class T, class A> T& DynArray<T, A>::operator[](U32 index) {
 			if(index < 0 || index >= elementCount) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[index];
 		}
 
-		template <class T> const T& DynArray<T>::operator[](U32 index) const {
+		template <class T, class A> const T& DynArray<T, A>::operator[](U32 index) const {
 			if(index < 0 || index >= elementCount) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[index];
 		}
 
-		template <class T> void DynArray<T>::reserve(U32 size) {
+		template <class T, class A> void DynArray<T, A>::reserve(U32 size) {
 			if(size <= arrayObjSize) {
 				//cannot de-allocate space using reserve
 				return;
@@ -373,15 +377,15 @@ namespace Galactic {
 			}
 		}
 
-		template <class T> U32 DynArray<T>::capacity() const {
+		template <class T, class A> U32 DynArray<T, A>::capacity() const {
 			return arrayObjSize;
 		}
 
-		template <class T> U32 DynArray<T>::memSize() const {
+		template <class T, class A> U32 DynArray<T, A>::memSize() const {
 			return capacity() * sizeof(T);
 		}
 
-		template <class T> U32 DynArray<T>::setSize(U32 s) {
+		template <class T, class A> U32 DynArray<T, A>::setSize(U32 s) {
 			Z32 oldSize = elementCount;
 			if(s > elementCount) {
 				//growing.
@@ -399,11 +403,11 @@ namespace Galactic {
 			return elementCount;
 		}
 
-		template <class T> T* DynArray<T>::addr() const {
+		template <class T, class A> T* DynArray<T, A>::addr() const {
 			return arrayObj;
 		}
 
-		template <class T> void DynArray<T>::inc() {
+		template <class T, class A> void DynArray<T, A>::inc() {
 			if(elementCount == arrayObjSize) {
 				resize(elementCount + 1);
 			}
@@ -414,7 +418,7 @@ namespace Galactic {
 			createRef(&arrayObj[elementCount - 1]);
 		}
 
-		template <class T> void DynArray<T>::dec() {
+		template <class T, class A> void DynArray<T, A>::dec() {
 			if(elementCount == 0) {
 				//No elements to delete.
 				return;
@@ -424,7 +428,7 @@ namespace Galactic {
 			killRef(&arrayObj[elementCount]);
 		}
 
-		template <class T> void DynArray<T>::inc(U32 amount) {
+		template <class T, class A> void DynArray<T, A>::inc(U32 amount) {
 			U32 currentCount = elementCount;
 			if((elementCount += amount) >= arrayObjSize) {
 				resize(elementCount);	
@@ -432,7 +436,7 @@ namespace Galactic {
 			constr(currentCount, elementCount);
 		}
 
-		template <class T> void DynArray<T>::dec(U32 amount) {
+		template <class T, class A> void DynArray<T, A>::dec(U32 amount) {
 			if(elementCount == 0) {
 				//Cannot decrement with 0 elements
 				return;
@@ -450,7 +454,7 @@ namespace Galactic {
 			elementCount = countNow;
 		}
 
-		template <class T> void DynArray<T>::insert(U32 pos) {
+		template <class T, class A> void DynArray<T, A>::insert(U32 pos) {
 			if(pos < 0 || pos >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::insert(%i): Cannot insert an element outside of the array bounds [0 - %i].", pos, elementCount);
@@ -469,12 +473,17 @@ namespace Galactic {
 			createRef(&arrayObj[pos]);
 		}
 
-		template <class T> void DynArray<T>::insert(U32 pos, const T& e) {
+		template <class T, class A> void DynArray<T, A>::insert(U32 pos, const T& e) {
+			U32 count = elementCount;
 			insert(pos);
+			if(elementCount == count) {
+				//The position was out of bounds (insert() reported it), nothing was added
+				return;
+			}
 			arrayObj[pos] = e;
 		}
 
-		template <class T> void DynArray<T>::erase(U32 pos) {
+		template <class T, class A> void DynArray<T, A>::erase(U32 pos) {
 			if(pos < 0 || pos >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::erase(%i): Cannot erase an element outside of the array bounds [0 - %i].", pos, elementCount);
@@ -490,7 +499,7 @@ namespace Galactic {
 			elementCount--;
 		}
 
-		template <class T> void DynArray<T>::erase(U32 start, U32 amount) {
+		template <class T, class A> void DynArray<T, A>::erase(U32 start, U32 amount) {
 			if(start < 0 || start >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::erase(%i, %i): Cannot erase elements outside of the array bounds [0 - %i].", start, amount, elementCount);
@@ -514,22 +523,37 @@ namespace Galactic {
 			elementCount -= amount;
 		}
 
-		template <class T> void DynArray<T>::clear() {
+		template <class T, class A> void DynArray<T, A>::clear() {
 			remove(0, elementCount);
 			elementCount = 0;
 		}
 
-		template <class T> void DynArray<T>::compact() {
+		template <class T, class A> void DynArray<T, A>::compact() {
 			resize(elementCount);
 		}
 
-		template <class T> void DynArray<T>::fill(const T& value) {
+		template <class T, class A> void DynArray<T, A>::swap(DynArray<T, A> &other) {
+			U32 count = elementCount;
+			U32 objSize = arrayObjSize;
+			T* obj = arrayObj;
+			A alloc = allocater;
+			elementCount = other.elementCount;
+			arrayObjSize = other.arrayObjSize;
+			arrayObj = other.arrayObj;
+			allocater = other.allocater;
+			other.elementCount = count;
+			other.arrayObjSize = objSize;
+			other.arrayObj = obj;
+			other.allocater = alloc;
+		}
+
+		template <class T, class A> void DynArray<T, A>::fill(const T& value) {
 			for(U32 i = 0; i < size() i++) {
 				arrayObj[i] = value;
 			}
 		}
 
-		template <class T> U32 DynArray<T>::eraseSpecific(const T& value) {
+		template <class T, class A> U32 DynArray<T, A>::eraseSpecific(const T& value) {
 			U32 count = 0;
 			T* iterator = begin();
 			while(iterator != end()) {
@@ -542,7 +566,7 @@ namespace Galactic {
 			return count;
 		}
 
-		template <class T> void DynArray<T>::set(any addr, U32 size) {
+		template <class T, class A> void DynArray<T, A>::set(any addr, U32 size) {
 			if(!addr) {
 				size = 0;
 			}
@@ -552,35 +576,35 @@ namespace Galactic {
 			}
 		}
 
-		template <class T> T& DynArray<T>::first() {
+		template <class T, class A> T& DynArray<T, A>::first() {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[0];
 		}
 
-		template <class T> const T& DynArray<T>::first() const {
+		template <class T, class A> const T& DynArray<T, A>::first() const {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[0];
 		}
 
-		template <class T> T& DynArray<T>::last() {
+		template <class T, class A> T& DynArray<T, A>::last() {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[elementCount - 1];
 		}
 
-		template <class T> const T& DynArray<T>::last() const {
+		template <class T, class A> const T& DynArray<T, A>::last() const {
 			if(elementCount == 0) {
 				//ToDo: Throw an assert error here
 			}
 			return arrayObj[elementCount - 1];
 		} 
 		 
-		template <class T> bool DynArray<T>::resize(U32 count) {
+		template <class T, class A> bool DynArray<T, A>::resize(U32 count) {
 			any *arrayObjPtr = (any *) &arrayObj;
 
 			X32 VectorBlockSize = GALACTIC_DYNARRAY_RESIZE_BLOCK_SIZE;
@@ -590,23 +614,22 @@ namespace Galactic {
 					arrayObjBlocks++;
 				}
 				S32 arrayObjMemSize = arrayObjBlocks * VectorBlockSize * sizeof(T);
-				*arrayObjPtr = *arrayObjPtr ? realloc(*arrayObjPtr, arrayObjMemSize) : malloc(arrayObjMemSize);
+				*arrayObjPtr = *arrayObjPtr ? allocater.reallocate(*arrayObjPtr, arrayObjSize * sizeof(T), arrayObjMemSize) : allocater.allocate(arrayObjMemSize);
 				elementCount = count;
 				arrayObjSize = arrayObjBlocks * VectorBlockSize;
 				return true;
 			}
 
 			if(*arrayObjPtr) {
-				//Compiler is bitching with C2146 if you use SendToHeaven() Here.
-				free(*arrayObjPtr);
-				arrayObjPtr = NULL;
+				allocater.deallocate(*arrayObjPtr, arrayObjSize * sizeof(T));
+				*arrayObjPtr = NULL;
 			}
 			arrayObjSize = 0;
 			elementCount = 0;
 			return true;
 		}
 
-		template <class T> void DynArray<T>::remove(U32 start, U32 end) {
+		template <class T, class A> void DynArray<T, A>::remove(U32 start, U32 end) {
 			if(start < 0 || end < 0 || start >= elementCount || end >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::remove(%i, %i): Cannot remove elements outside of the array bounds [0 - %i].", start, end, elementCount);
@@ -618,7 +641,7 @@ namespace Galactic {
 			}
 		}
 
-		template <class T> void DynArray<T>::constr(U32 start, U32 end) {
+		template <class T, class A> void DynArray<T, A>::constr(U32 start, U32 end) {
 			if(start < 0 || end < 0 || start >= elementCount || end >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::constr(%i, %i): Cannot construct elements outside of the array bounds [0 - %i].", start, end, elementCount);
@@ -631,7 +654,7 @@ namespace Galactic {
 			}
 		}
 
-		template <class T> void DynArray<T>::constr(U32 start, U32 end, const T* element) {
+		template <class T, class A> void DynArray<T, A>::constr(U32 start, U32 end, const T* element) {
 			if(start < 0 || end < 0 || start >= elementCount || end >= elementCount) {
 				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 					GC_Error("DynArray::constr(%i, %i, x): Cannot construct elements outside of the array bounds [0 - %i].", start, end, elementCount);
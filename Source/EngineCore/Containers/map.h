@@ -147,30 +147,62 @@ namespace Galactic {
 			//Setting Operator (Key Type).
 			MapNode &operator=(Key &src) {
 				first = src;
-				return this;
+				return *this;
 			}
 			//Setting Operator (Map Type).
 			MapNode &operator=(T &src) {
 				second = src;
-				return this;
+				return *this;
 			}
 		};
 
+		/*
+		MapIterator walks the nodes of a Map. The Map stores pointers to it's nodes, so the iterator steps over the pointer array and dereferences
+		 to the node it points at (IE: it->first).
+		*/
+		template <class Node> class MapIterator {
+			public:
+				//Position Constructor
+				MapIterator(Node * const *position = NULL) : pos(position) { }
+				//Conversion Constructor (iterator to const_iterator)
+				template <class Other> MapIterator(const MapIterator<Other> &c) : pos(c.fetchPosition()) { }
+
+				//Fetch the position in the Map's node array
+				Node * const *fetchPosition() const { return pos; }
+
+				//Operators
+				Node &operator*() const { return **pos; }
+				Node *operator->() const { return *pos; }
+				MapIterator &operator++() { pos++; return *this; }
+				MapIterator operator++(S32) { MapIterator old(*this); pos++; return old; }
+				MapIterator &operator--() { pos--; return *this; }
+				MapIterator operator--(S32) { MapIterator old(*this); pos--; return old; }
+				bool operator==(const MapIterator &c) const { return pos == c.pos; }
+				bool operator!=(const MapIterator &c) const { return pos != c.pos; }
+
+			private:
+				//The position in the node array
+				Node * const *pos;
+		};
+
 		/*
 		Map is a class that is based off of the functioning used by the STL's map class. The map is a double associated array where each value
-		 in the array has an associated key to go with the value
+		 in the array has an associated key to go with the value. The third template parameter is the allocater policy used for the nodes and the
+		 node array (see allocaterPolicy.h).
 		*/
-		template <class Key, class T> class Map {
+		template <class Key, class T, class A = GlobalAllocaterPolicy> class Map {
 			public:
 				//This typedef is a shortcut to using Pair<Key, T> in the numerous functions here, instead, use _pRef.
 				typedef Pair<Key, T> _pRef;
 				typedef Key _keyType;
 				typedef T _mapType;
-				typedef MapNode<Key, T>* iterator;
-				typedef const MapNode<Key, T>* const_iterator;
+				typedef MapIterator<MapNode<Key, T> > iterator;
+				typedef MapIterator<const MapNode<Key, T> > const_iterator;
 
-				//Standard Constructor
-				Map();
+				//Standard Constructor, with an optional allocater policy instance
+				Map(const A &alloc = A());
+				//Copy Constructor
+				Map(const Map &c);
 				//Standard Destructor
 				~Map();
 
@@ -190,7 +222,7 @@ namespace Galactic {
 				//Returns the maximum space of the Map in it's current state
 				U32 maxSize();
 
-				//Returns the first MapNode based on a key, see find()
+				//Returns the first MapNode based on a key (see find()), a node with a default value is added for keys not in the Map
 				MapNode<Key, T> &at(const _keyType &src);
 
 				//Access operator
@@ -202,7 +234,7 @@ namespace Galactic {
 
 				//Insert a pair to the Map
 				void insert(_pRef &src);
-				//Insert a pair at a specified location
+				//Insert a pair in front of a specified location, end() (or an iterator of another Map) adds it to the end
 				void insert(iterator pos, _pRef &src);
 				//Erase a single element
 				void erase(iterator pos);
@@ -210,114 +242,139 @@ namespace Galactic {
 				void erase(const _keyType &ref);
 				//Empty the map
 				void clear();
-				//Find the first MapNode based on a key at a given position
+				//Find the first MapNode based on a key at a given position, returns end() if there is none
 				iterator find(const _keyType &ref, U32 startPosition = 0);
 				//Returns the number of MapNodes that are using a specifiec key
 				U32 count(const _keyType &ref);
 
 			protected:
+				//Allocate and construct a new MapNode
+				MapNode<Key, T> *createNode(_pRef &src);
+				//Destruct and release a MapNode
+				void destroyNode(MapNode<Key, T> *node);
+				//Fetch the index of an iterator in the container, -1 if it is not a node of this Map
+				S32 indexOf(const_iterator pos) const;
+
+				//The allocater policy used for the MapNodes
+				A allocater;
 				//The Dynamic Array containing the MapNodes for this object
-				DynArray<MapNode<Key, T> *> container;
+				DynArray<MapNode<Key, T> *, A> container;
 		};
 
 		/* Map Functions */
 		//
-		template <class Key, class T> Map<Key, T>::Map() {
-			container = NULL;
+		template <class Key, class T, class A> Map<Key, T, A>::Map(const A &alloc) : allocater(alloc), container(0, alloc) {
+
 		}
 
-		template <class Key, class T> Map<Key, T>::~Map() {
+		template <class Key, class T, class A> Map<Key, T, A>::Map(const Map<Key, T, A> &c) : allocater(c.allocater), container(0, c.allocater) {
+			*this = c;
+		}
 
+		template <class Key, class T, class A> Map<Key, T, A>::~Map() {
+			clear();
 		}
 
-		template <class Key, class T> MapNode<Key, T> *Map<Key, T>::begin() {
-			//Note: We need this type-cast otherwise the compiler thinks this is DynArray::Y (iterator) instead of Map::iterator
-			return (MapNode<Key, T> *)container.begin();
+		template <class Key, class T, class A> typename Map<Key, T, A>::iterator Map<Key, T, A>::begin() {
+			return iterator(container.begin());
 		}
 
-		template <class Key, class T> MapNode<Key, T> *Map<Key, T>::end() {
-			//Note: We need this type-cast otherwise the compiler thinks this is DynArray::Y (iterator) instead of Map::iterator
-			return (MapNode<Key, T> *)container.end();
+		template <class Key, class T, class A> typename Map<Key, T, A>::iterator Map<Key, T, A>::end() {
+			return iterator(container.end());
 		}
 
-		template <class Key, class T> const MapNode<Key, T> *Map<Key, T>::begin() const {
-			//Note: We need this type-cast otherwise the compiler thinks this is DynArray::Y (iterator) instead of Map::iterator
-			return (const MapNode<Key, T> *)container.begin();
+		template <class Key, class T, class A> typename Map<Key, T, A>::const_iterator Map<Key, T, A>::begin() const {
+			return const_iterator(container.begin());
 		}
 
-		template <class Key, class T> const MapNode<Key, T> *Map<Key, T>::end() const {
-			//Note: We need this type-cast otherwise the compiler thinks this is DynArray::Y (iterator) instead of Map::iterator
-			return (const MapNode<Key, T> *)container.end();
+		template <class Key, class T, class A> typename Map<Key, T, A>::const_iterator Map<Key, T, A>::end() const {
+			return const_iterator(container.end());
 		}
 
-		template <class Key, class T> bool Map<Key, T>::empty() {
+		template <class Key, class T, class A> bool Map<Key, T, A>::empty() {
 			return container.isEmpty();
 		}
 
-		template <class Key, class T> U32 Map<Key, T>::size() {
+		template <class Key, class T, class A> U32 Map<Key, T, A>::size() {
 			return container.size();
 		}
 
-		template <class Key, class T> U32 Map<Key, T>::maxSize() {
+		template <class Key, class T, class A> U32 Map<Key, T, A>::maxSize() {
 			return container.capacity();
 		}
 
-		template <class Key, class T> MapNode<Key, T> &Map<Key, T>::at(const Key &src) {
-			for(iterator it = begin(); it != end(); it++) {
-				if(it->first == src) {
-					return it;
+		template <class Key, class T, class A> MapNode<Key, T> &Map<Key, T, A>::at(const Key &src) {
+			for(U32 i = 0; i < size(); i++) {
+				if(container[i]->first == src) {
+					return *container[i];
 				}
 			}
-			return NULL;
+			_pRef added(src, T());
+			container.pushToBack(createNode(added));
+			return *container[container.size() - 1];
 		}
 
-		template <class Key, class T> MapNode<Key, T> &Map<Key, T>::operator[](U32 index) {
-			return container[index];
+		template <class Key, class T, class A> MapNode<Key, T> &Map<Key, T, A>::operator[](U32 index) {
+			return *container[index];
 		}
 
-		template <class Key, class T> Map<Key, T> &Map<Key, T>::operator=(const Map<Key, T> &c) {
-			container = c.container;
-
-			return this;
+		template <class Key, class T, class A> Map<Key, T, A> &Map<Key, T, A>::operator=(const Map<Key, T, A> &c) {
+			if (this != &c) {
+				clear();
+				for (U32 i = 0; i < (U32)c.container.size(); i++) {
+					_pRef src(c.container[i]->first, c.container[i]->second);
+					container.pushToBack(createNode(src));
+				}
+			}
+			return *this;
 		}
 
-		template <class Key, class T> void Map<Key, T>::insert(Pair<Key, T> &src) {
-			MapNode<Key, T> newNode(src);
-			container.pushToBack(&newNode);
+		template <class Key, class T, class A> void Map<Key, T, A>::insert(Pair<Key, T> &src) {
+			container.pushToBack(createNode(src));
 		}
 
-		template <class Key, class T> void Map<Key, T>::insert(MapNode<Key, T>* pos, Pair<Key, T> &src) {
-			MapNode newNode(src);
-			container.insert(pos, src);
+		template <class Key, class T, class A> void Map<Key, T, A>::insert(iterator pos, Pair<Key, T> &src) {
+			S32 index = indexOf(pos);
+			if(index < 0) {
+				//No position to insert before, add the node to the end
+				container.pushToBack(createNode(src));
+				return;
+			}
+			container.insert((U32)index, createNode(src));
 		}
 
-		template <class Key, class T> void Map<Key, T>::erase(MapNode<Key, T>* pos) {
-			container.erase(pos);
+		template <class Key, class T, class A> void Map<Key, T, A>::erase(iterator pos) {
+			S32 index = indexOf(pos);
+			if (index >= 0) {
+				destroyNode(container[index]);
+				container.erase((U32)index);
+			}
 		}
 
-		template <class Key, class T> void Map<Key, T>::erase(const Key &src) {
-			while(find(src) != NULL) {
-				container.erase(find(src));
+		template <class Key, class T, class A> void Map<Key, T, A>::erase(const Key &src) {
+			iterator node;
+			while((node = find(src)) != end()) {
+				erase(node);
 			}
 		}
 
-		template <class Key, class T> void Map<Key, T>::clear() {
+		template <class Key, class T, class A> void Map<Key, T, A>::clear() {
+			for (U32 i = 0; i < (U32)container.size(); i++) {
+				destroyNode(container[i]);
+			}
 			container.clear();
 		}
 
-		template <class Key, class T> MapNode<Key, T> *Map<Key, T>::find(const Key &ref, U32 startPosition) {
-			if(startPosition >= size()) {
-				return NULL;
-			}
+		template <class Key, class T, class A> typename Map<Key, T, A>::iterator Map<Key, T, A>::find(const Key &ref, U32 startPosition) {
 			for(U32 i = startPosition; i < size(); i++) {
 				if(container[i]->first == ref) {
-					return container[i];
+					return iterator(container.begin() + i);
 				}
 			}
-			return NULL;
+			return end();
 		}
 
-		template <class Key, class T> U32 Map<Key, T>::count(const Key &ref) {
+		template <class Key, class T, class A> U32 Map<Key, T, A>::count(const Key &ref) {
 			U32 elements = 0;
 			for(iterator it = begin(); it != end(); it++) {
 				if(it->first == ref) {
@@ -327,6 +384,27 @@ namespace Galactic {
 			return elements;
 		}
 
+		template <class Key, class T, class A> MapNode<Key, T> *Map<Key, T, A>::createNode(Pair<Key, T> &src) {
+			any mem = allocater.allocate(sizeof(MapNode<Key, T>));
+			return new (mem) MapNode<Key, T>(src);
+		}
+
+		template <class Key, class T, class A> void Map<Key, T, A>::destroyNode(MapNode<Key, T> *node) {
+			if (node != NULL) {
+				node->~MapNode<Key, T>();
+				allocater.deallocate(node, sizeof(MapNode<Key, T>));
+			}
+		}
+
+		template <class Key, class T, class A> S32 Map<Key, T, A>::indexOf(const_iterator pos) const {
+			const MapNode<Key, T> * const *position = pos.fetchPosition();
+			const_iterator first = begin();
+			if (position < first.fetchPosition() || position >= end().fetchPosition()) {
+				return -1;
+			}
+			return (S32)(position - first.fetchPosition());
+		}
+
 	};
 
 };
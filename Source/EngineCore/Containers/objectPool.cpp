@@ -0,0 +1,352 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Containers/objectPool.cpp
+* Implements the untyped portion of the ObjectPool<T> template
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		ObjectPoolChunk: The header placed at the start of every chunk allocated by an ObjectPool, the object slots follow it.
+		*/
+		struct ObjectPoolChunk {
+			//The next chunk of the pool
+			ObjectPoolChunk *next;
+			//The amount of slots in this chunk
+			U32 slotCount;
+			//The memory block returned by allocChunk() (the header is aligned within it)
+			any block;
+			//The size of the memory block
+			SIZE_T blockSize;
+		};
+
+		/*
+		ObjectPoolFront: A per-thread cache of free objects for one ThreadFront pool.
+		*/
+		struct ObjectPoolFront {
+			//The identifier of the pool this front belongs to, 0 if the front is unused
+			U32 poolID;
+			//The cached free objects
+			any head;
+			//The amount of cached objects
+			U32 count;
+		};
+
+		//The amount of ThreadFront pools a single thread may keep a front for, further pools fall back to the locked path.
+		#define GALACTIC_OBJECTPOOL_MAX_FRONTS 8
+
+		//The fronts of the calling thread. Note: objects left in a front when it's thread exits are not returned to the pool.
+		static THREADLOCAL ObjectPoolFront _poolFronts[GALACTIC_OBJECTPOOL_MAX_FRONTS];
+		//Counter used to hand out unique pool identifiers (never reused, so a stale front can never match a new pool)
+		static volatile S32 _nextPoolID = 0;
+
+		//Fetch the next object of a free list chain
+		FINLINE any &nextOf(any object) {
+			return *((any *)object);
+		}
+
+		//Round a value up to a multiple of the alignment
+		FINLINE SIZE_T alignUp(SIZE_T value, SIZE_T alignment) {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		/*
+		ObjectPoolBase Class Definitions
+		*/
+		ObjectPoolBase::ObjectPoolBase(SIZE_T objectSize, SIZE_T objectAlignment, U32 objectsPerChunk, U32 flags) : 
+			poolFlags(flags), chunks(NULL), freeList(NULL), freeCount(0), capacity(0) {
+			if (poolFlags & ThreadFront) {
+				poolFlags |= ThreadSafe;
+			}
+			poolID = (U32)PlatformAtomics::increment(&_nextPoolID);
+			chunkObjects = objectsPerChunk > 0 ? objectsPerChunk : 1;
+			//The object must be able to hold the free list link, and it's owner pointer sits directly in front of it.
+			slotAlignment = objectAlignment > sizeof(any) ? objectAlignment : sizeof(any);
+			objectOffset = alignUp(sizeof(ObjectPoolBase *), slotAlignment);
+			slotSize = alignUp(objectOffset + (objectSize > sizeof(any) ? objectSize : sizeof(any)), slotAlignment);
+		}
+
+		ObjectPoolBase::~ObjectPoolBase() {
+			//Forget the calling thread's front, any other thread still holding one is in error (see ThreadFront).
+			if (poolFlags & ThreadFront) {
+				for (U32 i = 0; i < GALACTIC_OBJECTPOOL_MAX_FRONTS; i++) {
+					if (_poolFronts[i].poolID == poolID) {
+						_poolFronts[i].poolID = 0;
+						_poolFronts[i].head = NULL;
+						_poolFronts[i].count = 0;
+					}
+				}
+			}
+			releaseChunks();
+		}
+
+		void ObjectPoolBase::preallocate(U32 count) {
+			if (poolFlags & ThreadSafe) {
+				cSec.lock();
+			}
+			if (freeCount < count) {
+				addChunk(count - freeCount);
+			}
+			if (poolFlags & ThreadSafe) {
+				cSec.unlock();
+			}
+		}
+
+		U32 ObjectPoolBase::fetchCapacity() const {
+			return capacity;
+		}
+
+		U32 ObjectPoolBase::fetchFreeCount() const {
+			return freeCount;
+		}
+
+		any ObjectPoolBase::allocChunk(SIZE_T bytes) {
+			return Memory::gmallocTagged(bytes, MemoryTracker::resolveTag(MemoryTracker::Tag_Containers));
+		}
+
+		void ObjectPoolBase::freeChunk(any chunk, SIZE_T bytes) {
+			Memory::gfree(chunk);
+		}
+
+		void ObjectPoolBase::releaseChunks() {
+			ObjectPoolChunk *chunk = (ObjectPoolChunk *)chunks;
+			while (chunk != NULL) {
+				ObjectPoolChunk *next = chunk->next;
+				freeChunk(chunk->block, chunk->blockSize);
+				chunk = next;
+			}
+			chunks = NULL;
+			freeList = NULL;
+			freeCount = 0;
+			capacity = 0;
+		}
+
+		any ObjectPoolBase::allocObject() {
+			ObjectPoolFront *front = fetchFront();
+			if (front != NULL) {
+				if (front->head == NULL) {
+					//Refill the front with a batch from the pool
+					U32 popped = 0;
+					if (true) {
+						MutexLock lock(&cSec);
+						front->head = popChain(GALACTIC_OBJECTPOOL_FRONT_SIZE / 2 > 0 ? GALACTIC_OBJECTPOOL_FRONT_SIZE / 2 : 1, popped);
+					}
+					front->count = popped;
+					if (front->head == NULL) {
+						return NULL;
+					}
+				}
+				any object = front->head;
+				front->head = nextOf(object);
+				front->count--;
+				return object;
+			}
+			U32 popped = 0;
+			any object = NULL;
+			if (poolFlags & ThreadSafe) {
+				MutexLock lock(&cSec);
+				object = popChain(1, popped);
+			}
+			else {
+				object = popChain(1, popped);
+			}
+			return object;
+		}
+
+		void ObjectPoolBase::freeObject(any object) {
+			if (object == NULL) {
+				return;
+			}
+			if (ownerOf(object) != this) {
+				GC_Error("ObjectPool::destroy(): Attempted to release an object to a pool it was not allocated from.");
+				return;
+			}
+			ObjectPoolFront *front = fetchFront();
+			if (front != NULL) {
+				nextOf(object) = front->head;
+				front->head = object;
+				front->count++;
+				if (front->count >= GALACTIC_OBJECTPOOL_FRONT_SIZE) {
+					//Return half of the front to the pool
+					U32 keep = front->count / 2;
+					any last = front->head;
+					for (U32 i = 1; i < keep; i++) {
+						last = nextOf(last);
+					}
+					any first = nextOf(last);
+					any tail = first;
+					U32 moved = front->count - keep;
+					for (U32 i = 1; i < moved; i++) {
+						tail = nextOf(tail);
+					}
+					nextOf(last) = NULL;
+					front->count = keep;
+					MutexLock lock(&cSec);
+					pushChain(first, tail, moved);
+				}
+				return;
+			}
+			if (poolFlags & ThreadSafe) {
+				MutexLock lock(&cSec);
+				pushChain(object, object, 1);
+			}
+			else {
+				pushChain(object, object, 1);
+			}
+		}
+
+		bool ObjectPoolBase::addChunk(U32 objectCount) {
+			if (objectCount < chunkObjects) {
+				objectCount = chunkObjects;
+			}
+			SIZE_T headerSize = alignUp(sizeof(ObjectPoolChunk), slotAlignment);
+			//Allocater policies only guarantee minimum alignment, so reserve room to align the chunk by hand.
+			SIZE_T blockSize = headerSize + (SIZE_T)objectCount * slotSize + slotAlignment;
+			any block = allocChunk(blockSize);
+			if (block == NULL) {
+				GC_Error("ObjectPool::addChunk(): Failed to allocate a chunk of %i objects.", objectCount);
+				return false;
+			}
+			ObjectPoolChunk *chunk = (ObjectPoolChunk *)alignUp((SIZE_T)block, slotAlignment);
+			chunk->block = block;
+			chunk->blockSize = blockSize;
+			chunk->next = (ObjectPoolChunk *)chunks;
+			chunk->slotCount = objectCount;
+			chunks = chunk;
+			//Stamp the owner of every slot and thread them on to the free list (in address order).
+			UTX8 base = (UTX8)chunk + headerSize;
+			any first = base + objectOffset;
+			any prev = NULL;
+			for (U32 i = 0; i < objectCount; i++) {
+				UTX8 object = base + (SIZE_T)i * slotSize + objectOffset;
+				*((ObjectPoolBase **)(object - sizeof(ObjectPoolBase *))) = this;
+				if (prev != NULL) {
+					nextOf(prev) = object;
+				}
+				prev = object;
+			}
+			capacity += objectCount;
+			pushChain(first, prev, objectCount);
+			return true;
+		}
+
+		any ObjectPoolBase::popChain(U32 count, U32 &popped) {
+			popped = 0;
+			if (freeList == NULL && !addChunk(chunkObjects)) {
+				return NULL;
+			}
+			any head = freeList;
+			any last = head;
+			popped = 1;
+			while (popped < count && nextOf(last) != NULL) {
+				last = nextOf(last);
+				popped++;
+			}
+			freeList = nextOf(last);
+			nextOf(last) = NULL;
+			freeCount -= popped;
+			return head;
+		}
+
+		void ObjectPoolBase::pushChain(any first, any last, U32 count) {
+			nextOf(last) = freeList;
+			freeList = first;
+			freeCount += count;
+		}
+
+		ObjectPoolFront *ObjectPoolBase::fetchFront() {
+			if (!(poolFlags & ThreadFront)) {
+				return NULL;
+			}
+			ObjectPoolFront *unused = NULL;
+			for (U32 i = 0; i < GALACTIC_OBJECTPOOL_MAX_FRONTS; i++) {
+				if (_poolFronts[i].poolID == poolID) {
+					return &_poolFronts[i];
+				}
+				if (unused == NULL && _poolFronts[i].poolID == 0) {
+					unused = &_poolFronts[i];
+				}
+			}
+			if (unused != NULL) {
+				unused->poolID = poolID;
+				unused->head = NULL;
+				unused->count = 0;
+			}
+			return unused;
+		}
+
+		/*
+		ReferenceController Class Definitions
+		*/
+		//Fetch the shared pool used for ReferenceController instances, it is intentionally never destroyed so references released during shutdown remain valid.
+		static ObjectPoolBase *fetchControllerPool() {
+			static U64 poolStorage[(sizeof(ObjectPoolBase) + sizeof(U64) - 1) / sizeof(U64)];
+			static ObjectPoolBase *pool = new (poolStorage) ObjectPoolBase(sizeof(ReferenceController), sizeof(any), 
+				GALACTIC_OBJECTPOOL_CHUNK_SIZE * 4, ObjectPoolBase::ThreadFront);
+			return pool;
+		}
+
+		/*
+		ControllerPool: Exposes the protected slot methods of ObjectPoolBase to the ReferenceController operators.
+		*/
+		class ControllerPool : public ObjectPoolBase {
+			public:
+				//Fetch a slot from a pool
+				SFIN any alloc(ObjectPoolBase *pool) {
+					return ((ControllerPool *)pool)->allocObject();
+				}
+				//Return a slot to a pool
+				SFIN void release(ObjectPoolBase *pool, any ptr) {
+					((ControllerPool *)pool)->freeObject(ptr);
+				}
+		};
+
+		//Only exact sized requests are pooled, anything else (IE: a derived class) is served by the global allocater and routed back there by delete.
+		any ReferenceController::operator new(size_t amount) {
+			if (amount != sizeof(ReferenceController)) {
+				return Memory::gmalloc(amount);
+			}
+			any ptr = ControllerPool::alloc(fetchControllerPool());
+			if (ptr == NULL) {
+				PlatformMemory::onOutOfMem(amount, Memory::Default);
+			}
+			return ptr;
+		}
+
+		void ReferenceController::operator delete(any ptr, size_t amount) {
+			if (ptr == NULL) {
+				return;
+			}
+			if (amount != sizeof(ReferenceController)) {
+				Memory::gfree(ptr);
+				return;
+			}
+			ControllerPool::release(fetchControllerPool(), ptr);
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -0,0 +1,200 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Containers/objectPool.h
+* Defines the ObjectPool<T> template, a chunked free-list object allocater
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_OBJECTPOOL
+#define GALACTIC_INTERNAL_OBJECTPOOL
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		AlignmentOf: Determine the alignment requirement of a type without relying on compiler extensions.
+		*/
+		template <class T> struct AlignmentOf {
+			struct Helper {
+				C8 c;
+				T t;
+			};
+			enum {
+				value = sizeof(Helper) - sizeof(T),
+			};
+		};
+
+		/*
+		ObjectPoolBase: The untyped portion of ObjectPool<T>. Memory is allocated in chunks of fixed size slots and recycled through an intrusive free list.
+		 Each object is preceded by a pointer to it's owning pool, which allows an object to be released without knowing the pool (see ObjectPool<T>::releaseObj).
+		*/
+		class ObjectPoolBase {
+			public:
+				/* Public Class Members */
+				//Flags used to create the pool
+				enum PoolFlags {
+					//ThreadSafe: The pool can be used from any thread (the free list is protected by a critical section)
+					ThreadSafe = (1 << 0),
+					//ThreadFront: Each thread keeps a small lock free front of free objects (implies ThreadSafe). Only use this for pools that are never destroyed.
+					ThreadFront = (1 << 1),
+				};
+
+				/* Constructor / Destructor */
+				//Default Constructor
+				ObjectPoolBase(SIZE_T objectSize, SIZE_T objectAlignment, U32 objectsPerChunk = GALACTIC_OBJECTPOOL_CHUNK_SIZE, U32 flags = ThreadSafe);
+				//Destructor
+				virtual ~ObjectPoolBase();
+
+				/* Public Class Methods */
+				//Allocate enough chunks to hold at least the specified amount of free objects
+				void preallocate(U32 count);
+				//Fetch the total amount of objects the pool can hold without allocating
+				U32 fetchCapacity() const;
+				//Fetch the amount of free objects held by the pool itself (not including thread fronts)
+				U32 fetchFreeCount() const;
+				//Fetch the pool a slot (object) belongs to
+				SFIN ObjectPoolBase *ownerOf(cAny object) {
+					return *((ObjectPoolBase **)((UTX8)object - sizeof(ObjectPoolBase *)));
+				}
+
+			protected:
+				/* Protected Class Methods */
+				//Fetch a free object slot
+				any allocObject();
+				//Return an object slot to the pool
+				void freeObject(any object);
+				//Allocate the memory for a chunk, override this to route chunks to a different allocater
+				virtual any allocChunk(SIZE_T bytes);
+				//Release the memory of a chunk
+				virtual void freeChunk(any chunk, SIZE_T bytes);
+				//Release every chunk, derived classes overriding freeChunk() must call this from their destructor
+				void releaseChunks();
+
+			private:
+				/* Private Class Methods */
+				//Allocate a new chunk, must be called with the pool locked
+				bool addChunk(U32 objectCount);
+				//Pop up to count objects from the free list as a chain, must be called with the pool locked
+				any popChain(U32 count, U32 &popped);
+				//Push a chain of objects on to the free list, must be called with the pool locked
+				void pushChain(any first, any last, U32 count);
+				//Fetch this pool's front for the calling thread, returns NULL if none is available
+				struct ObjectPoolFront *fetchFront();
+
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				ObjectPoolBase(const ObjectPoolBase &);
+				//Assignment Operator
+				ObjectPoolBase &operator=(const ObjectPoolBase &);
+
+				/* Private Class Members */
+				//The critical section object protecting the free list
+				PlatformCriticalSection cSec;
+				//The creation flags
+				U32 poolFlags;
+				//Unique identifier of this pool (used to match thread fronts)
+				U32 poolID;
+				//The size of each slot (header and object)
+				SIZE_T slotSize;
+				//The offset of the object from the start of it's slot
+				SIZE_T objectOffset;
+				//The alignment of each slot
+				SIZE_T slotAlignment;
+				//The amount of objects allocated per chunk
+				U32 chunkObjects;
+				//The list of chunks
+				any chunks;
+				//The free list (linked through the object storage)
+				any freeList;
+				//The amount of objects in the free list
+				U32 freeCount;
+				//The total amount of objects in all chunks
+				U32 capacity;
+		};
+
+		/*
+		ObjectPool: A typed object pool. The second template parameter is the allocater policy used for the chunks (see allocaterPolicy.h).
+		 Objects are constructed in recycled slots with create() and returned with destroy(), createRef() returns a
+		 StrongReferencePtr that gives the object back to the pool when the last reference is released (this works with makeRefPtr<T> derived classes).
+		*/
+		template <class T, class A = GlobalAllocaterPolicy> class ObjectPool : public ObjectPoolBase {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor, with an optional allocater policy instance used for the chunks
+				ObjectPool(U32 objectsPerChunk = GALACTIC_OBJECTPOOL_CHUNK_SIZE, U32 flags = ThreadSafe, const A &alloc = A()) :
+					ObjectPoolBase(sizeof(T), AlignmentOf<T>::value, objectsPerChunk, flags), allocater(alloc) { }
+				//Destructor
+				~ObjectPool() {
+					releaseChunks();
+				}
+
+				/* Public Class Methods */
+				//Construct a new object in the pool
+				template <typename... Args> T *create(const Args &... args) {
+					any mem = allocObject();
+					return mem ? new (mem) T(args...) : NULL;
+				}
+				//Destroy an object and return it to the pool
+				void destroy(T *obj) {
+					if (obj == NULL) {
+						return;
+					}
+					obj->~T();
+					freeObject(obj);
+				}
+				//Construct a new object in the pool, and return a StrongReferencePtr to it
+				template <typename... Args> StrongReferencePtr<T> createRef(const Args &... args) {
+					T *obj = create(args...);
+					if (obj == NULL) {
+						return StrongReferencePtr<T>();
+					}
+					return StrongReferencePtr<T>(obj, &releaseObj);
+				}
+				//Destroy an object allocated from any ObjectPool<T, A>, this is the delete function used by createRef()
+				static void releaseObj(any obj) {
+					if (obj != NULL) {
+						((ObjectPool<T, A> *)ownerOf(obj))->destroy((T *)obj);
+					}
+				}
+
+			protected:
+				/* Protected Class Methods */
+				//Allocate the memory for a chunk through the allocater policy
+				any allocChunk(SIZE_T bytes) {
+					return allocater.allocate(bytes);
+				}
+				//Release the memory of a chunk through the allocater policy
+				void freeChunk(any chunk, SIZE_T bytes) {
+					allocater.deallocate(chunk, bytes);
+				}
+
+			private:
+				/* Private Class Members */
+				//The allocater policy used for the chunks
+				A allocater;
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_OBJECTPOOL
\ No newline at end of file
@@ -0,0 +1,267 @@
+/**
+* Galactic 2D
+* Source/EngineCore/GenericPlatform/memory.cpp
+* Defines the generic memory functions
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+#include "../allocaterOverloads.h"
+#ifndef GALACTIC_WINDOWS
+	#include <sys/mman.h>
+	#ifndef MAP_ANONYMOUS
+		#define MAP_ANONYMOUS MAP_ANON
+	#endif
+#endif
+
+namespace Galactic {
+
+	namespace Core {
+
+		Allocater *GenericPlatformMemory::Allocater() {
+			#if GALACTIC_DISABLE_MULTITHREADING == 0
+				class Allocater *allocater = new ThreadSafeAllocater();
+			#else
+				class Allocater *allocater = new StandardAllocater();
+			#endif
+			#if GALACTIC_GUARD_ALLOCATER == 1
+				allocater = new GuardAllocater(allocater);
+			#endif
+			return allocater;
+		}
+
+		MemoryStatistics GenericPlatformMemory::memStats;
+
+		MemoryStatistics GenericPlatformMemory::fetchStats() {
+			return memStats;
+		}
+
+		void GenericPlatformMemory::updateStats() {
+			MemoryTracker::sample();
+			S64 live = MemoryTracker::fetchTotalLiveBytes();
+			memStats.trackedUsed = live > 0 ? (SIZE_T)live : 0;
+			memStats.trackedPeak = (SIZE_T)MemoryTracker::fetchTotalPeakBytes();
+		}
+
+		void GenericPlatformMemory::onOutOfMem(U64 requestedAmt, U32 memAlignment) {
+			GC_CError("PlatformMemory::onOutOfMem(): Out of memory, failed to allocate %llu bytes (alignment %u).", (unsigned long long)requestedAmt, memAlignment);
+		}
+
+		SIZE_T GenericPlatformMemory::fetchPageSize() {
+			static SIZE_T pageSize = 0;
+			if (pageSize == 0) {
+				#ifdef GALACTIC_WINDOWS
+					SYSTEM_INFO sysInfo;
+					GetSystemInfo(&sysInfo);
+					pageSize = (SIZE_T)sysInfo.dwPageSize;
+				#else
+					pageSize = (SIZE_T)sysconf(_SC_PAGESIZE);
+				#endif
+			}
+			return pageSize;
+		}
+
+		#ifdef GALACTIC_WINDOWS
+			//Reserve (and optionally commit) a range of pages aligned to the specified power of 2
+			static any mapAlignedPages(SIZE_T amount, SIZE_T alignment, bool commit) {
+				DWORD allocType = commit ? (MEM_RESERVE | MEM_COMMIT) : MEM_RESERVE;
+				DWORD protection = commit ? PAGE_READWRITE : PAGE_NOACCESS;
+				//VirtualAlloc() already aligns to the allocation granularity (64K), anything larger needs to be placed by hand.
+				if (alignment <= 65536) {
+					return VirtualAlloc(NULL, amount, allocType, protection);
+				}
+				for (U32 attempt = 0; attempt < 8; attempt++) {
+					any reserved = VirtualAlloc(NULL, amount + alignment, MEM_RESERVE, PAGE_NOACCESS);
+					if (!reserved) {
+						return NULL;
+					}
+					any aligned = (any)(((IntPointer)reserved + alignment - 1) & ~((IntPointer)alignment - 1));
+					VirtualFree(reserved, 0, MEM_RELEASE);
+					//Another thread may claim the range between the two calls, in which case we try again.
+					any result = VirtualAlloc(aligned, amount, allocType, protection);
+					if (result) {
+						return result;
+					}
+				}
+				return NULL;
+			}
+		#else
+			//Map a range of pages aligned to the specified power of 2, trimming off the excess of the mapping
+			static any mapAlignedPages(SIZE_T amount, SIZE_T alignment, S32 protection, S32 flags) {
+				SIZE_T pageSize = GenericPlatformMemory::fetchPageSize();
+				SIZE_T mapSize = amount + (alignment > pageSize ? alignment : 0);
+				any mapped = mmap(NULL, mapSize, protection, flags, -1, 0);
+				if (mapped == MAP_FAILED) {
+					return NULL;
+				}
+				if (alignment <= pageSize) {
+					return mapped;
+				}
+				//Trim off the unaligned head and the unused tail of the mapping.
+				IntPointer start = (IntPointer)mapped;
+				IntPointer aligned = (start + alignment - 1) & ~((IntPointer)alignment - 1);
+				if (aligned > start) {
+					munmap(mapped, (SIZE_T)(aligned - start));
+				}
+				SIZE_T tail = (SIZE_T)((start + mapSize) - (aligned + amount));
+				if (tail > 0) {
+					munmap((any)(aligned + amount), tail);
+				}
+				return (any)aligned;
+			}
+
+			//Fetch the length actually mapped by pageAlloc() for a request (explicit huge page mappings are rounded up to the huge page size)
+			static SIZE_T pageRunLength(SIZE_T amount) {
+				SIZE_T pageSize = GenericPlatformMemory::fetchPageSize();
+				amount = (amount + pageSize - 1) & ~(pageSize - 1);
+				#if GALACTIC_HUGE_PAGES == 2
+					if (amount >= GALACTIC_HUGE_PAGE_SIZE) {
+						amount = (amount + GALACTIC_HUGE_PAGE_SIZE - 1) & ~((SIZE_T)GALACTIC_HUGE_PAGE_SIZE - 1);
+					}
+				#endif
+				return amount;
+			}
+		#endif
+
+		any GenericPlatformMemory::pageAlloc(SIZE_T amount, SIZE_T alignment) {
+			SIZE_T pageSize = fetchPageSize();
+			if (alignment < pageSize) {
+				alignment = pageSize;
+			}
+			#ifdef GALACTIC_WINDOWS
+				//Note: Large pages on Windows require the SeLockMemoryPrivilege, so GALACTIC_HUGE_PAGES is not applied here.
+				amount = (amount + pageSize - 1) & ~(pageSize - 1);
+				return mapAlignedPages(amount, alignment, true);
+			#else
+				amount = pageRunLength(amount);
+				#if GALACTIC_HUGE_PAGES != 0
+					if (amount >= GALACTIC_HUGE_PAGE_SIZE) {
+						#if GALACTIC_HUGE_PAGES == 2 && defined(MAP_HUGETLB)
+							//Huge page mappings are always aligned to the huge page size, fall back to regular pages if none are reserved.
+							if (alignment <= GALACTIC_HUGE_PAGE_SIZE) {
+								any huge = mmap(NULL, amount, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+								if (huge != MAP_FAILED) {
+									return huge;
+								}
+							}
+						#endif
+						//Align the run to the huge page size so the kernel can back it with transparent huge pages.
+						if (alignment < GALACTIC_HUGE_PAGE_SIZE) {
+							alignment = GALACTIC_HUGE_PAGE_SIZE;
+						}
+						any mapped = mapAlignedPages(amount, alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS);
+						#ifdef MADV_HUGEPAGE
+							if (mapped) {
+								madvise(mapped, amount, MADV_HUGEPAGE);
+							}
+						#endif
+						return mapped;
+					}
+				#endif
+				return mapAlignedPages(amount, alignment, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS);
+			#endif
+		}
+
+		void GenericPlatformMemory::pageFree(any ptr, SIZE_T amount) {
+			if (!ptr) {
+				return;
+			}
+			#ifdef GALACTIC_WINDOWS
+				VirtualFree(ptr, 0, MEM_RELEASE);
+			#else
+				munmap(ptr, pageRunLength(amount));
+			#endif
+		}
+
+		any GenericPlatformMemory::pageReserve(SIZE_T amount, SIZE_T alignment) {
+			SIZE_T pageSize = fetchPageSize();
+			amount = (amount + pageSize - 1) & ~(pageSize - 1);
+			if (alignment < pageSize) {
+				alignment = pageSize;
+			}
+			#ifdef GALACTIC_WINDOWS
+				return mapAlignedPages(amount, alignment, false);
+			#else
+				#ifdef MAP_NORESERVE
+					return mapAlignedPages(amount, alignment, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE);
+				#else
+					return mapAlignedPages(amount, alignment, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS);
+				#endif
+			#endif
+		}
+
+		bool GenericPlatformMemory::pageCommit(any ptr, SIZE_T amount) {
+			if (!ptr || amount == 0) {
+				return false;
+			}
+			#ifdef GALACTIC_WINDOWS
+				return VirtualAlloc(ptr, amount, MEM_COMMIT, PAGE_READWRITE) != NULL;
+			#else
+				if (mprotect(ptr, amount, PROT_READ | PROT_WRITE) != 0) {
+					return false;
+				}
+				#if GALACTIC_HUGE_PAGES != 0 && defined(MADV_HUGEPAGE)
+					if (amount >= GALACTIC_HUGE_PAGE_SIZE) {
+						madvise(ptr, amount, MADV_HUGEPAGE);
+					}
+				#endif
+				return true;
+			#endif
+		}
+
+		void GenericPlatformMemory::pageDecommit(any ptr, SIZE_T amount) {
+			if (!ptr || amount == 0) {
+				return;
+			}
+			#ifdef GALACTIC_WINDOWS
+				VirtualFree(ptr, amount, MEM_DECOMMIT);
+			#else
+				madvise(ptr, amount, MADV_DONTNEED);
+				mprotect(ptr, amount, PROT_NONE);
+			#endif
+		}
+
+		void GenericPlatformMemory::pageReset(any ptr, SIZE_T amount) {
+			if (!ptr || amount == 0) {
+				return;
+			}
+			#ifdef GALACTIC_WINDOWS
+				VirtualAlloc(ptr, amount, MEM_RESET, PAGE_READWRITE);
+			#else
+				madvise(ptr, amount, MADV_DONTNEED);
+			#endif
+		}
+
+		void GenericPlatformMemory::pageRelease(any ptr, SIZE_T amount) {
+			if (!ptr) {
+				return;
+			}
+			#ifdef GALACTIC_WINDOWS
+				VirtualFree(ptr, 0, MEM_RELEASE);
+			#else
+				SIZE_T pageSize = fetchPageSize();
+				munmap(ptr, (amount + pageSize - 1) & ~(pageSize - 1));
+			#endif
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -71,10 +71,16 @@ namespace Galactic {
 			SIZE_T physicalUsed;
 			//virtualUsed: How much virtual memory has been used
 			SIZE_T virtualUsed;
+			//physicalPeak: The most physical memory the process has used
+			SIZE_T physicalPeak;
+			//trackedUsed: How much memory is live through Memory::gmalloc() (see MemoryTracker)
+			SIZE_T trackedUsed;
+			//trackedPeak: The most memory that has been live through Memory::gmalloc()
+			SIZE_T trackedPeak;
 
 			/* Struct Methods */
 			//Default Constructor
-			MemoryStatistics() : physicalAvail(0), virtualAvail(0), physicalUsed(0), virtualUsed(0) { }
+			MemoryStatistics() : physicalAvail(0), virtualAvail(0), physicalUsed(0), virtualUsed(0), physicalPeak(0), trackedUsed(0), trackedPeak(0) { }
 		};
 
 		/*
@@ -116,11 +122,28 @@ namespace Galactic {
 				static any Alloc(SIZE_T amount);
 				//Free method for windows
 				static void Free(any ptr);
+				//Map a block of pages directly from the operating system, aligned to the specified power of 2 (the page size is used if 0). Blocks of at least
+				// GALACTIC_HUGE_PAGE_SIZE are backed by huge pages when GALACTIC_HUGE_PAGES is enabled.
+				static any pageAlloc(SIZE_T amount, SIZE_T alignment = 0);
+				//Return a block of pages obtained from pageAlloc() to the operating system
+				static void pageFree(any ptr, SIZE_T amount);
+				//Reserve a range of address space without committing memory to it, aligned to the specified power of 2 (the page size is used if 0)
+				static any pageReserve(SIZE_T amount, SIZE_T alignment = 0);
+				//Commit memory to pages of a reserved range, making them accessible
+				static bool pageCommit(any ptr, SIZE_T amount);
+				//Decommit pages of a reserved range, their memory is returned to the system and they are inaccessible until committed again
+				static void pageDecommit(any ptr, SIZE_T amount);
+				//Return the memory of committed pages to the system while keeping them accessible, their contents are lost
+				static void pageReset(any ptr, SIZE_T amount);
+				//Release a range obtained from pageReserve()
+				static void pageRelease(any ptr, SIZE_T amount);
+				//Fetch the size of a memory page on this system
+				static SIZE_T fetchPageSize();
 				//Returns the amount of physical memory in GB approximation
 				static U32 fetchGBMem();
 				//Operation to be called when the allocater is out of memory
 				static void onOutOfMem(U64 requestedAmt, U32 memAlignment);
-				//Fetch the current memory statistics
+				//Fetch the memory statistics as of the last call to updateStats()
 				static MemoryStatistics fetchStats();
 				//Update the memory statistics
 				static void updateStats();
@@ -140,6 +163,11 @@ namespace Galactic {
 				SFIN any gmemset(any dstPtr, S32 value, SIZE_T amount) {
 					return ::memset(dstPtr, value, amount);
 				}
+
+			protected:
+				/* Protected Class Members */
+				//The memory statistics, filled in by updateStats()
+				static MemoryStatistics memStats;
 		};
 
 	};
@@ -131,12 +131,12 @@ namespace Galactic {
 		}
 
 		String GenericPlatformOperations::fetchMACAddr() {
-			String result;
 			DynArray<U8> macAddr = PlatformOperations::fetchMACRaw();
+			StringBuilder result((U32)macAddr.size() * 2);
 			for (S32 i = 0; i < macAddr.size(); i++) {
-				result += String::ToStr("%02x", macAddr[i]);
+				result.appendHex(macAddr[i], 2);
 			}
-			return result;
+			return result.build();
 		}
 
 		DynArray<U8> GenericPlatformOperations::fetchMACRaw() {
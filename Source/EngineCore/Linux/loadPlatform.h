@@ -59,6 +59,7 @@
 #endif 
 
 //Load in the G2D platform files (see platformInclude.h for include order)
+#include "memory.h"
 #include "math.h"
 #include "time.h"
 #include "atomics.h"
\ No newline at end of file
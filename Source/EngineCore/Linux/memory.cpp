@@ -0,0 +1,85 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Linux/memory.cpp
+* Implements the Linux specific memory class
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+#ifdef GALACTIC_LINUX
+
+	#include <sys/sysinfo.h>
+	#include <sys/resource.h>
+
+	namespace Galactic {
+
+		namespace Core {
+
+			U32 PlatformMemory::fetchGBMem() {
+				struct sysinfo sysInfo;
+				if (sysinfo(&sysInfo) != 0) {
+					return 1;
+				}
+				U64 totalMem = (U64)sysInfo.totalram * sysInfo.mem_unit;
+				//Round to the nearest GB, but always report at least one.
+				U32 memGB = (U32)((totalMem + (U64DEF(1) << 29)) >> 30);
+				return memGB > 0 ? memGB : 1;
+			}
+
+			void PlatformMemory::updateStats() {
+				GenericPlatformMemory::updateStats();
+				//System wide memory
+				struct sysinfo sysInfo;
+				if (sysinfo(&sysInfo) == 0) {
+					U64 unit = sysInfo.mem_unit;
+					memStats.physicalMem = (SIZE_T)(sysInfo.totalram * unit);
+					memStats.physicalAvail = (SIZE_T)((sysInfo.freeram + sysInfo.bufferram) * unit);
+					memStats.virtualMem = (SIZE_T)((sysInfo.totalram + sysInfo.totalswap) * unit);
+					memStats.virtualAvail = (SIZE_T)((sysInfo.freeram + sysInfo.bufferram + sysInfo.freeswap) * unit);
+					memStats.memInGB = fetchGBMem();
+				}
+				//Process memory, statm reports the virtual size and resident set in pages
+				FILE *statm = fopen("/proc/self/statm", "r");
+				if (statm) {
+					unsigned long virtualPages = 0, residentPages = 0;
+					if (fscanf(statm, "%lu %lu", &virtualPages, &residentPages) == 2) {
+						SIZE_T pageSize = fetchPageSize();
+						memStats.virtualUsed = (SIZE_T)virtualPages * pageSize;
+						memStats.physicalUsed = (SIZE_T)residentPages * pageSize;
+					}
+					fclose(statm);
+				}
+				else {
+					GC_Warn("PlatformMemory::updateStats(): Unable to open /proc/self/statm, process memory usage is unavailable.");
+				}
+				//The resident high-water mark (ru_maxrss is in KB on Linux)
+				struct rusage usage;
+				if (getrusage(RUSAGE_SELF, &usage) == 0) {
+					memStats.physicalPeak = (SIZE_T)usage.ru_maxrss * 1024;
+				}
+			}
+
+		};
+
+	};
+
+#endif //GALACTIC_LINUX
\ No newline at end of file
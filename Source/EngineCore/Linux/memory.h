@@ -0,0 +1,53 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Linux/memory.h
+* Defines the platform specific memory class for Linux
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifdef GALACTIC_LINUX
+
+	#ifndef GALACTIC_PLATFORM_LINUX_PLATFORMMEMORY
+	#define GALACTIC_PLATFORM_LINUX_PLATFORMMEMORY
+
+	namespace Galactic {
+
+		namespace Core {
+
+			/*
+			PlatformMemory: Linux specific memory operations, memory statistics are read from /proc/self/statm, sysinfo() and getrusage().
+			*/
+			class PlatformMemory : public GenericPlatformMemory {
+				public:
+					/* Public Class Methods */
+					//Returns the amount of physical memory in GB approximation
+					static U32 fetchGBMem();
+					//Update the memory statistics
+					static void updateStats();
+			};
+
+		};
+
+	};
+
+	#endif //GALACTIC_PLATFORM_LINUX_PLATFORMMEMORY
+
+#endif //GALACTIC_LINUX
\ No newline at end of file
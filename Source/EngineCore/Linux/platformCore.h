@@ -68,6 +68,8 @@
 	#define GNU_ALIGN(x) __attribute__((aligned(x)))
 	//U64DEF: Macro for properly declaring and formatting 64-bit numerics
 	#define U64DEF(x) x##ULL
+	//THREADLOCAL: Declare a variable with thread local storage (one instance of the variable per thread)
+	#define THREADLOCAL __thread
 
 	#define GALACTIC_DLL_IMPORT 
 	#define GALACTIC_DLL_EXPORT
@@ -38,15 +38,20 @@
 //SendToGatesOfHeaven(): Send pointers and objects to the gates of memory heaven, I guess they aren't quite... dead... yet.
 #define SendToGatesOfHeaven(x) free(x);
 
-/* Console Messaging Shortcuts */
+/* Format Checking */
+//Fail to compile when the literal format x doesn't consume exactly the arguments after it (see Core::FormatCheck)
+#define GALACTIC_FORMAT_CHECK(x, ...) (void)sizeof(::Galactic::Core::FormatCheck::Verify<::Galactic::Core::FormatCheck::matches(sizeof(x), x, \
+	sizeof(::Galactic::Core::FormatCheck::argCount(__VA_ARGS__)) - 1)>)
+
+/* Console Messaging Shortcuts: These take a literal format, which is checked against the arguments at compile time */
 //Print shortut
-#define GC_Print(x, ...) ::Galactic::Console::print(x, __VA_ARGS__)
+#define GC_Print(x, ...) (GALACTIC_FORMAT_CHECK(x, __VA_ARGS__), ::Galactic::Console::print(x, __VA_ARGS__))
 //Warn shortut
-#define GC_Warn(x, ...) ::Galactic::Console::warn(x, __VA_ARGS__)
+#define GC_Warn(x, ...) (GALACTIC_FORMAT_CHECK(x, __VA_ARGS__), ::Galactic::Console::warn(x, __VA_ARGS__))
 //Error shortut
-#define GC_Error(x, ...) ::Galactic::Console::error(x, __VA_ARGS__)
+#define GC_Error(x, ...) (GALACTIC_FORMAT_CHECK(x, __VA_ARGS__), ::Galactic::Console::error(x, __VA_ARGS__))
 //CError shortut
-#define GC_CError(x, ...) ::Galactic::Console::cerr(x, __VA_ARGS__)
+#define GC_CError(x, ...) (GALACTIC_FORMAT_CHECK(x, __VA_ARGS__), ::Galactic::Console::cerr(x, __VA_ARGS__))
 
 /* Data Type Naming */
 #define DECL_TYPE_NAME(x) template<> struct type_name<x> { static const char* tName() {return #x;} }
@@ -0,0 +1,174 @@
+/**
+* Galactic 2D
+* Source/EngineCore/PlatformCore/memoryTracker.cpp
+* Implements the MemoryTracker class
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		MemoryTrackerCounters: The counters of a single thread, these are never released so totals remain correct after the thread exits.
+		*/
+		struct MemoryTrackerCounters {
+			//The live bytes of each tag
+			volatile S64 liveBytes[MemoryTracker::Tag_Count];
+			//The amount of allocations of each tag
+			volatile U64 allocCount[MemoryTracker::Tag_Count];
+			//The next thread's counters
+			MemoryTrackerCounters *next;
+		};
+
+		//The counters of the calling thread
+		static THREADLOCAL MemoryTrackerCounters *_threadCounters = NULL;
+		//The tag of the calling thread
+		static THREADLOCAL U32 _threadTag = MemoryTracker::Tag_General;
+		//The list of every thread's counters
+		static MemoryTrackerCounters *_counterList = NULL;
+		//The sampled high-water marks
+		static S64 _peakBytes[MemoryTracker::Tag_Count];
+		//The sampled high-water mark of all tags combined
+		static S64 _totalPeakBytes = 0;
+		//The display names of the tags
+		static UTF16 _tagNames[MemoryTracker::Tag_Count] = { "General", "Strings", "Containers", "Network", "Assets", "Scripts" };
+
+		//Fetch the counters of the calling thread, creating them on the first call, returns NULL if they could not be created (the allocation goes unrecorded)
+		static MemoryTrackerCounters *fetchThreadCounters() {
+			MemoryTrackerCounters *counters = _threadCounters;
+			if (counters == NULL) {
+				//Note: This cannot use Memory::gmalloc(), as it is called from inside of it.
+				counters = (MemoryTrackerCounters *)Memory::sysmalloc(sizeof(MemoryTrackerCounters));
+				if (counters == NULL) {
+					return NULL;
+				}
+				Memory::gmemset(counters, 0, sizeof(MemoryTrackerCounters));
+				any head;
+				do {
+					head = _counterList;
+					counters->next = (MemoryTrackerCounters *)head;
+				} while (PlatformAtomics::compareExchange((any *)&_counterList, counters, head) != head);
+				_threadCounters = counters;
+			}
+			return counters;
+		}
+
+		/*
+		MemoryTracker Class Definitions
+		*/
+		U32 MemoryTracker::fetchCurrentTag() {
+			return _threadTag;
+		}
+
+		U32 MemoryTracker::setCurrentTag(U32 tag) {
+			U32 previous = _threadTag;
+			_threadTag = tag < Tag_Count ? tag : (U32)Tag_General;
+			return previous;
+		}
+
+		U32 MemoryTracker::resolveTag(U32 defaultTag) {
+			return _threadTag != Tag_General ? _threadTag : defaultTag;
+		}
+
+		void MemoryTracker::onAlloc(U32 tag, SIZE_T bytes) {
+			MemoryTrackerCounters *counters = fetchThreadCounters();
+			if (counters != NULL) {
+				counters->liveBytes[tag] += (S64)bytes;
+				counters->allocCount[tag]++;
+			}
+		}
+
+		void MemoryTracker::onFree(U32 tag, SIZE_T bytes) {
+			MemoryTrackerCounters *counters = fetchThreadCounters();
+			if (counters != NULL) {
+				counters->liveBytes[tag] -= (S64)bytes;
+			}
+		}
+
+		void MemoryTracker::onResize(U32 tag, SIZE_T oldBytes, SIZE_T newBytes) {
+			MemoryTrackerCounters *counters = fetchThreadCounters();
+			if (counters != NULL) {
+				counters->liveBytes[tag] += (S64)newBytes - (S64)oldBytes;
+			}
+		}
+
+		void MemoryTracker::sample() {
+			S64 total = 0;
+			for (U32 i = 0; i < Tag_Count; i++) {
+				S64 live = fetchLiveBytes(i);
+				if (live > _peakBytes[i]) {
+					_peakBytes[i] = live;
+				}
+				total += live;
+			}
+			if (total > _totalPeakBytes) {
+				_totalPeakBytes = total;
+			}
+		}
+
+		S64 MemoryTracker::fetchLiveBytes(U32 tag) {
+			if (tag >= Tag_Count) {
+				return 0;
+			}
+			S64 live = 0;
+			for (MemoryTrackerCounters *counters = _counterList; counters != NULL; counters = counters->next) {
+				live += counters->liveBytes[tag];
+			}
+			return live;
+		}
+
+		S64 MemoryTracker::fetchPeakBytes(U32 tag) {
+			return tag < Tag_Count ? _peakBytes[tag] : 0;
+		}
+
+		U64 MemoryTracker::fetchAllocCount(U32 tag) {
+			if (tag >= Tag_Count) {
+				return 0;
+			}
+			U64 count = 0;
+			for (MemoryTrackerCounters *counters = _counterList; counters != NULL; counters = counters->next) {
+				count += counters->allocCount[tag];
+			}
+			return count;
+		}
+
+		S64 MemoryTracker::fetchTotalLiveBytes() {
+			S64 total = 0;
+			for (U32 i = 0; i < Tag_Count; i++) {
+				total += fetchLiveBytes(i);
+			}
+			return total;
+		}
+
+		S64 MemoryTracker::fetchTotalPeakBytes() {
+			return _totalPeakBytes;
+		}
+
+		UTF16 MemoryTracker::fetchTagName(U32 tag) {
+			return tag < Tag_Count ? _tagNames[tag] : "Invalid";
+		}
+
+	};
+
+};
\ No newline at end of file
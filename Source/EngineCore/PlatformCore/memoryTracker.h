@@ -0,0 +1,112 @@
+/**
+* Galactic 2D
+* Source/EngineCore/PlatformCore/memoryTracker.h
+* Defines the MemoryTracker, tagged accounting of engine memory usage
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_PLATFORM_MEMORYTRACKER
+#define GALACTIC_PLATFORM_MEMORYTRACKER
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		MemoryTracker: Keeps track of the live bytes (usable block sizes) allocated through Memory::gmalloc() per subsystem tag. The counters are held per-thread so allocating
+		 never touches shared memory, the totals are the sum of every thread's counters (a thread freeing memory allocated by another thread may hold a
+		 negative count). High-water marks are sampled by sample(), which is called once per frame by the main loop and by PlatformMemory::updateStats().
+		 Nothing is recorded unless GALACTIC_MEMORY_TRACKING is enabled.
+		*/
+		class MemoryTracker {
+			public:
+				/* Public Class Members */
+				//Tags: The subsystems memory is accounted to
+				enum Tags {
+					//Tag_General: Memory not belonging to a specific subsystem (Default)
+					Tag_General,
+					//Tag_Strings: String storage
+					Tag_Strings,
+					//Tag_Containers: DynArray, Map and ObjectPool storage
+					Tag_Containers,
+					//Tag_Network: Network buffers and streams
+					Tag_Network,
+					//Tag_Assets: Loaded asset data
+					Tag_Assets,
+					//Tag_Scripts: Scripting system memory
+					Tag_Scripts,
+					//Tag_Count: The amount of tags
+					Tag_Count,
+				};
+
+				/* Public Class Methods */
+				//Fetch the tag of the calling thread (see MemoryTagScope)
+				static U32 fetchCurrentTag();
+				//Set the tag of the calling thread, returns the previous tag
+				static U32 setCurrentTag(U32 tag);
+				//Fetch the calling thread's tag, or the specified tag if the thread is using Tag_General
+				static U32 resolveTag(U32 defaultTag);
+				//Record an allocation
+				static void onAlloc(U32 tag, SIZE_T bytes);
+				//Record a release
+				static void onFree(U32 tag, SIZE_T bytes);
+				//Record the resize of an allocation
+				static void onResize(U32 tag, SIZE_T oldBytes, SIZE_T newBytes);
+				//Update the high-water marks
+				static void sample();
+				//Fetch the live bytes of a tag
+				static S64 fetchLiveBytes(U32 tag);
+				//Fetch the highest sampled live bytes of a tag
+				static S64 fetchPeakBytes(U32 tag);
+				//Fetch the amount of allocations made with a tag
+				static U64 fetchAllocCount(U32 tag);
+				//Fetch the live bytes of every tag combined
+				static S64 fetchTotalLiveBytes();
+				//Fetch the highest sampled live bytes of every tag combined
+				static S64 fetchTotalPeakBytes();
+				//Fetch the display name of a tag
+				static UTF16 fetchTagName(U32 tag);
+		};
+
+		/*
+		MemoryTagScope: Accounts every allocation made by the current thread to a tag for the lifetime of the object, IE: MemoryTagScope scope(MemoryTracker::Tag_Network);
+		*/
+		class MemoryTagScope {
+			public:
+				/* Constructor / Destructor */
+				//Creation Constructor
+				MemoryTagScope(U32 tag) : previousTag(MemoryTracker::setCurrentTag(tag)) { }
+				//Destructor
+				~MemoryTagScope() {
+					MemoryTracker::setCurrentTag(previousTag);
+				}
+
+			private:
+				/* Private Class Members */
+				//The tag to restore
+				U32 previousTag;
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_PLATFORM_MEMORYTRACKER
\ No newline at end of file
@@ -39,6 +39,7 @@
 
 //Load Generic Template Classes
 #include "platformMemory.h"
+#include "memoryTracker.h"
 
 //Load The Generic Platform
 #include "../GenericPlatform/memory.h"
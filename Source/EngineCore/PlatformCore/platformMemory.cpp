@@ -23,7 +23,7 @@
 * THE SOFTWARE.
 **/
 
-#include "platformMemory.h"
+#include "../engineCore.h"
 
 namespace Galactic {
 
@@ -57,24 +57,77 @@ namespace Galactic {
 		}
 
 		any Memory::gmalloc(SIZE_T amount, U32 memAlignment) {
+			#if GALACTIC_MEMORY_TRACKING == 1
+				return gmallocTagged(amount, MemoryTracker::fetchCurrentTag(), memAlignment);
+			#else
+				if (!createAllocater("malloc")) {
+					return NULL;
+				}
+				return _GAllocater->gmalloc(amount, memAlignment);
+			#endif
+		}
+
+		any Memory::gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment) {
 			if (!createAllocater("malloc")) {
 				return NULL;
 			}
-			return _GAllocater->gmalloc(amount, memAlignment);
+			#if GALACTIC_MEMORY_TRACKING == 1
+				//The allocater keeps the tag with the block, the tracked size is the usable size of the block so the free charges back the same amount.
+				U32 tag = memTag < MemoryTracker::Tag_Count ? memTag : (U32)MemoryTracker::Tag_General;
+				any block = _GAllocater->gmallocTagged(amount, tag, memAlignment);
+				if (block) {
+					MemoryTracker::onAlloc(tag, _GAllocater->usableSize(block));
+				}
+				return block;
+			#else
+				return _GAllocater->gmalloc(amount, memAlignment);
+			#endif
 		}
 
 		any Memory::grealloc(any src, SIZE_T amount, U32 memAlignment) {
 			if (!createAllocater("realloc")) {
 				return NULL;
 			}
-			return _GAllocater->grealloc(src, amount, memAlignment);
+			#if GALACTIC_MEMORY_TRACKING == 1
+				if (!src) {
+					return gmalloc(amount, memAlignment);
+				}
+				if (amount == 0) {
+					gfree(src);
+					return NULL;
+				}
+				//The allocater carries the tag over to a moved block
+				U32 tag = _GAllocater->fetchTag(src);
+				SIZE_T oldSize = _GAllocater->usableSize(src);
+				any block = _GAllocater->grealloc(src, amount, memAlignment);
+				if (block) {
+					MemoryTracker::onResize(tag, oldSize, _GAllocater->usableSize(block));
+				}
+				return block;
+			#else
+				return _GAllocater->grealloc(src, amount, memAlignment);
+			#endif
+		}
+
+		void Memory::releaseIdleMemory() {
+			if (_GAllocater) {
+				_GAllocater->releaseIdleMemory();
+			}
 		}
 
 		void Memory::gfree(any trg) {
 			if (!createAllocater("free")) {
 				return;
 			}
-			_GAllocater->gfree(trg);
+			#if GALACTIC_MEMORY_TRACKING == 1
+				if (!trg) {
+					return;
+				}
+				MemoryTracker::onFree(_GAllocater->fetchTag(trg), _GAllocater->usableSize(trg));
+				_GAllocater->gfree(trg);
+			#else
+				_GAllocater->gfree(trg);
+			#endif
 		}
 
 	};
@@ -70,12 +70,16 @@ namespace Galactic {
 				}
 
 				/* Define global usage functions */
-				//malloc
+				//malloc (the memory is accounted to the calling thread's MemoryTracker tag)
 				static any gmalloc(SIZE_T amount, U32 memAlignment = Default);
+				//malloc, accounting the memory to a specific MemoryTracker tag
+				static any gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment = Default);
 				//realloc
 				static any grealloc(any src, SIZE_T amount, U32 memAlignment = Default);
 				//free
 				static void gfree(any trg);
+				//Return the global allocater's idle memory to the operating system (IE: after a level transition)
+				static void releaseIdleMemory();
 		};
 
 		/*
@@ -122,6 +126,14 @@ namespace Galactic {
 				virtual bool isThreadSafe() const { return false; }
 				//Validate the allocation heap
 				virtual bool validateHeap() { return true; }
+				//Return cached and idle memory to the operating system
+				virtual void releaseIdleMemory() { }
+				//Fetch the usable size of a block allocated by this allocater, 0 if unknown
+				virtual SIZE_T usableSize(cAny ptr) { return 0; }
+				//malloc, recording a MemoryTracker tag with the block for allocaters that support it (see fetchTag())
+				virtual any gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment = Memory::Default) { return gmalloc(amount, memAlignment); }
+				//Fetch the MemoryTracker tag recorded with a block, 0 (Tag_General) if the allocater does not record tags
+				virtual U32 fetchTag(cAny ptr) { return 0; }
 		};
 
 	};
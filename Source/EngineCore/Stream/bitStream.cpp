@@ -30,6 +30,65 @@ namespace Galactic {
 	namespace Core {
 		
 		namespace Streams {
+			/*
+			FloatQuantizer
+			*/
+
+			FloatQuantizer FloatQuantizer::fromPrecision(F32 min, F32 max, F32 precision) {
+				F64 range = F64(max) - F64(min), steps = precision > 0 ? ceil(range / precision) : 0;
+				if(steps > F64(0xFFFFFFFF)) {
+					if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+						Galactic::Console::warn("FloatQuantizer::fromPrecision(%f, %f, %f): The precision needs more than 32 bits, it will be limited to 32.", min, max, precision);
+					}
+					steps = F64(0xFFFFFFFF);
+				}
+				if(steps < 1) {
+					steps = 1;
+				}
+				FloatQuantizer quantizer;
+				quantizer.min = min;
+				quantizer.max = max;
+				quantizer.steps = U32(steps);
+				quantizer.bitCount = BitStream::bitsRequired(quantizer.steps);
+				quantizer.scale = range > 0 ? steps / range : 0;
+				quantizer.invScale = range / steps;
+				return quantizer;
+			}
+
+			FloatQuantizer FloatQuantizer::fromBits(F32 min, F32 max, U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					bitCount = bitCount == 0 ? 1 : 32;
+				}
+				F64 range = F64(max) - F64(min), steps = F64((U64DEF(1) << bitCount) - 1);
+				FloatQuantizer quantizer;
+				quantizer.min = min;
+				quantizer.max = max;
+				quantizer.steps = U32(steps);
+				quantizer.bitCount = bitCount;
+				quantizer.scale = range > 0 ? steps / range : 0;
+				quantizer.invScale = range / steps;
+				return quantizer;
+			}
+
+			U32 FloatQuantizer::quantize(F32 value) const {
+				//Written so NaN ends up on min
+				if(!(value > min)) {
+					return 0;
+				}
+				if(value >= max) {
+					return steps;
+				}
+				U64 step = U64((F64(value) - F64(min)) * scale + 0.5);
+				return step > steps ? steps : U32(step);
+			}
+
+			F32 FloatQuantizer::dequantize(U32 step) const {
+				if(step >= steps) {
+					return max;
+				}
+				return F32(F64(min) + F64(step) * invScale);
+			}
+
 			/*
 			BitStream
 			*/
@@ -44,7 +103,7 @@ namespace Galactic {
 			}
 
 			void BitStream::setBuffer(any bufData, S64 bufSize, S64 maxSize) {
-				if(maxSize < 0) {
+				if(maxSize <= 0) {
 					maxSize = bufSize;
 				}
 				data = (UTX8)bufData;
@@ -124,24 +183,18 @@ namespace Galactic {
 			}
 
 			void BitStream::writeS32(S32 value, S64 bitCount) {
-				if((bitCount != 32) || ((value >> bitCount) != 0)) {
+				if((bitCount < 32) && ((U32(value) >> bitCount) != 0)) {
 					if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS != 0) {
 						Galactic::Console::warn("BitStream::writeS32(%i, %i): The requested value [%i] is out of range of the bitcount [%i], this may cause some precision errors.", value, bitCount, value, bitCount);
 					}
 				}
-				value = convertSrcToLittleEndian(value);
-				writeBits(&value, bitCount);
+				//Values are packed least significant bit first, so there's no endian conversion to do here
+				writeBits32(U32(value), U32(bitCount));
 			}
 
 			S32 BitStream::readS32(S64 bitCount) {
-				S32 readValue = 0;
-				readBits(&readValue, bitCount);
-				readValue = convertLittleEndianToSrc(readValue);
-				//If we have a non 32-bit value, shift the bits to back out the original value
-				if(bitCount != 32) {
-					readValue &= BackBitShift(bitCount);
-				}
-				return readValue;
+				//readBits32() only returns the bits that were read, so non 32-bit values don't need to be backed out
+				return S32(readBits32(U32(bitCount)));
 			}
 
 			void BitStream::writeSignedS32(S32 value, S64 bitCount) {
@@ -195,26 +248,31 @@ namespace Galactic {
 					}
 					return;
 				}
-				if((bitNumber + bitCount) > maxWriteAmount) {
-					Galactic::Console::cerr("BitStream::writeBits(x, %i): The attempted write operation is accessing memory outside of range, halting and throwing exception.", bitCount);
-					errorFlag = true;
-					//ToDo: Throw an assert error here
-					return; //I know this return is redundant, but we want to dead-stop here, no memory violations please...
-				}
-				//Convert the buffer to a writable format
-				UTX16 bitBuffer = (UTX8)writeBuff;
-				//Write each bit to the Stream, Recall that bitNumber contains the bit position, not the Byte position.
-				for(S32 i = 0; i < bitCount; i++) {
-					//First Compare the bits of the write buffer to that of the index we're writing, If they don't match, we need to flip the BITOR Bits in our stream
-					if((*(bitBuffer + (i >> BuffSizeShift)) & (BuffRWShift << (i & 0x7))) != 0) {
-						*(data + (bitNumber >> BuffSizeShift)) |= (BuffRWShift << (i & 0x7));
+				if((bitNumber + bitCount) > maxWriteAmount && !expandBuffer(bitCount)) {
+					return;
+				}
+				UTX16 bitBuffer = (UTX16)writeBuff;
+				S64 wholeBytes = bitCount >> BuffSizeShift;
+				U32 remainingBits = U32(bitCount & 0x7);
+				if((bitNumber & 0x7) == 0) {
+					//Byte aligned, the whole bytes are a straight copy
+					memcpy(data + (bitNumber >> BuffSizeShift), bitBuffer, (size_t)wholeBytes);
+					bitNumber += wholeBytes << BuffSizeShift;
+				}
+				else {
+					//Move 7 bytes per window (a window holds 57 bits past the bit offset of the first byte)
+					S64 i = 0;
+					for(; i + 7 <= wholeBytes; i += 7) {
+						U64 value = 0;
+						memcpy(&value, bitBuffer + i, 7);
+						writeWindow(convertLittleEndianToSrc(value) & U64DEF(0x00FFFFFFFFFFFFFF), 56);
 					}
-					//Otherwise, we need to apply a BITAND Relation of the UNARY relation of the index shift
-					else {
-						*(data + (bitNumber >> BuffSizeShift)) &= ~(BuffRWShift << (i & 0x7));
+					for(; i < wholeBytes; i++) {
+						writeWindow(bitBuffer[i], 8);
 					}
-					//Increment our Stream value
-					bitNumber++;
+				}
+				if(remainingBits) {
+					writeWindow(bitBuffer[wholeBytes], remainingBits);
 				}
 			}
 
@@ -226,73 +284,367 @@ namespace Galactic {
 					return;
 				}
 				if((bitNumber + bitCount) > maxReadAmount) {
-					Galactic::Console::cerr("BitStream::readBits(x, %i): The attempted read operation is accessing memory outside of range, halting and throwing exception.", bitCount);
+					readOutOfRange(bitCount);
+					return;
+				}
+				UTX8 bitBuffer = (UTX8)readBuff;
+				S64 wholeBytes = bitCount >> BuffSizeShift;
+				U32 remainingBits = U32(bitCount & 0x7);
+				if((bitNumber & 0x7) == 0) {
+					memcpy(bitBuffer, data + (bitNumber >> BuffSizeShift), (size_t)wholeBytes);
+					bitNumber += wholeBytes << BuffSizeShift;
+				}
+				else {
+					S64 i = 0;
+					for(; i + 7 <= wholeBytes; i += 7) {
+						U64 value = convertSrcToLittleEndian(readWindow(56));
+						memcpy(bitBuffer + i, &value, 7);
+					}
+					for(; i < wholeBytes; i++) {
+						bitBuffer[i] = U8(readWindow(8));
+					}
+				}
+				if(remainingBits) {
+					bitBuffer[wholeBytes] = U8(readWindow(remainingBits));
+				}
+			}
+
+			void BitStream::writeTail(U64 value, U32 bitCount) {
+				while(bitCount) {
+					U32 shift = U32(bitNumber & 0x7), count = (8 - shift) < bitCount ? (8 - shift) : bitCount;
+					U8 mask = U8(((1 << count) - 1) << shift);
+					U8 &target = *(data + (bitNumber >> BuffSizeShift));
+					target = U8((target & ~mask) | (U8(value << shift) & mask));
+					value >>= count;
+					bitNumber += count;
+					bitCount -= count;
+				}
+			}
+
+			U64 BitStream::readTail(U32 bitCount) {
+				U64 value = 0;
+				U32 readCount = 0;
+				while(readCount < bitCount) {
+					U32 shift = U32(bitNumber & 0x7), count = (8 - shift) < (bitCount - readCount) ? (8 - shift) : (bitCount - readCount);
+					U64 bits = (*(data + (bitNumber >> BuffSizeShift)) >> shift) & ((1 << count) - 1);
+					value |= bits << readCount;
+					readCount += count;
+					bitNumber += count;
+				}
+				return value;
+			}
+
+			bool BitStream::expandBuffer(S64 bitCount) {
+				Galactic::Console::cerr("BitStream: The attempted write of %i bits is accessing memory outside of range, halting and throwing exception.", bitCount);
+				errorFlag = true;
+				//ToDo: Throw an assert error here
+				return false;
+			}
+
+			void BitStream::readOutOfRange(S64 bitCount) {
+				Galactic::Console::cerr("BitStream: The attempted read of %i bits is accessing memory outside of range, halting and throwing exception.", bitCount);
+				errorFlag = true;
+				//ToDo: Throw an assert error here
+			}
+
+			void BitStream::writeVarU32(U32 value) {
+				while(value > 0x7F) {
+					writeBits32((value & 0x7F) | 0x80, 8);
+					value >>= 7;
+				}
+				writeBits32(value, 8);
+			}
+
+			U32 BitStream::readVarU32() {
+				U32 value = 0;
+				for(U32 shift = 0; shift < 35; shift += 7) {
+					U32 group = readBits32(8);
+					//Only 4 bits of the fifth group fit, anything above them can't come from writeVarU32()
+					if(shift == 28 && (group & 0x70)) {
+						errorFlag = true;
+					}
+					value |= (group & 0x7F) << shift;
+					if(!(group & 0x80)) {
+						return value;
+					}
+				}
+				//More than 5 groups can't come from writeVarU32(), the packet is malformed
+				errorFlag = true;
+				return value;
+			}
+
+			void BitStream::writeVarU64(U64 value) {
+				while(value > 0x7F) {
+					writeBits32(U32(value & 0x7F) | 0x80, 8);
+					value >>= 7;
+				}
+				writeBits32(U32(value), 8);
+			}
+
+			U64 BitStream::readVarU64() {
+				U64 value = 0;
+				for(U32 shift = 0; shift < 70; shift += 7) {
+					U32 group = readBits32(8);
+					//Only 1 bit of the tenth group fits
+					if(shift == 63 && (group & 0x7E)) {
+						errorFlag = true;
+					}
+					value |= U64(group & 0x7F) << shift;
+					if(!(group & 0x80)) {
+						return value;
+					}
+				}
+				errorFlag = true;
+				return value;
+			}
+
+			void BitStream::writeVarS32(S32 value) {
+				writeVarU32(zigZagEncode(value));
+			}
+
+			S32 BitStream::readVarS32() {
+				return zigZagDecode(readVarU32());
+			}
+
+			void BitStream::writeVarS64(S64 value) {
+				writeVarU64(zigZagEncode64(value));
+			}
+
+			S64 BitStream::readVarS64() {
+				return zigZagDecode64(readVarU64());
+			}
+
+			void BitStream::writeRangedU32(U32 value, U32 min, U32 max) {
+				if(value < min || value > max) {
+					if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+						Galactic::Console::warn("BitStream::writeRangedU32(%u, %u, %u): The value is out of range, it will be clamped.", value, min, max);
+					}
+					value = value < min ? min : max;
+				}
+				U32 bitCount = bitsRequired(max - min);
+				if(bitCount) {
+					writeBits32(value - min, bitCount);
+				}
+			}
+
+			U32 BitStream::readRangedU32(U32 min, U32 max) {
+				U32 bitCount = bitsRequired(max - min);
+				U32 value = bitCount ? readBits32(bitCount) : 0;
+				if(value > max - min) {
+					//Only a malformed packet can send a value past the range, don't let it escape
+					errorFlag = true;
+					value = max - min;
+				}
+				return min + value;
+			}
+
+			void BitStream::writeEliasGamma(U32 value) {
+				if(value == 0) {
+					if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+						Galactic::Console::warn("BitStream::writeEliasGamma(0): Elias-gamma codes start at 1, writing 1 instead.");
+					}
+					value = 1;
+				}
+				writeGammaCode(value);
+			}
+
+			U32 BitStream::readEliasGamma() {
+				return U32(readGammaCode(31));
+			}
+
+			void BitStream::writeExpGolomb(U32 value, U32 k) {
+				if(k > 31) {
+					k = 31;
+				}
+				writeGammaCode((U64(value) >> k) + 1);
+				if(k) {
+					writeBits32(value & ((U32(1) << k) - 1), k);
+				}
+			}
+
+			U32 BitStream::readExpGolomb(U32 k) {
+				if(k > 31) {
+					k = 31;
+				}
+				U64 high = readGammaCode(32 - k) - 1;
+				U32 low = k ? readBits32(k) : 0;
+				if(high > (U64DEF(0xFFFFFFFF) >> k)) {
 					errorFlag = true;
-					//ToDo: Throw an assert error here
-					return; //I know this return is redundant, but we want to dead-stop here, no memory violations please...
-				}
-				//Define our Starting Point & end Point
-				UTX8 startingPtr = data + (bitNumber >> BuffSizeShift), bitBuffer = (UTX8)readBuff;
-				UTX16 endPtr = data + bufferSize;
-				//Ok, so for you people who are a little 'uneducated' in binary, here's how this works:
-				// We add 7 to the bit count to fill a single "Byte" with binary values: (7 = 0111).
-				// That number is then shifted by the size allocation for the byte in our Stream, which is defined in the header.
-				S64 numBytes = (bitCount + 7) >> BuffSizeShift;
-				//Define the points for a single shift up and down, 0x7 == 7. 
-				S64 upShift = (8 - (bitNumber & 0x7)), downShift = (bitNumber & 0x7);
-				//Get the current byte into a field
-				U8 currentByte = *startingPtr, nextByte = 0;
-				//Run through the Stream, read in the values we need into bitBuffer
-				while(numBytes--) {
-					startingPtr++;
-					nextByte = startingPtr < endPtr ? *startingPtr : 0;
-					*bitBuffer++ = (currentByte >> downShift) | (nextByte << upShift);
-					currentByte = nextByte;
-				}
-				//Increment the bit position
-				bitNumber += bitCount;
-			}
-
-			bool BitStream::writeFlag(bool val) {
-				//Recall from stream.cpp, that booleans have different size values based
-				// on the compiler, therefore we compress it to a static size.
-				if((bitNumber + 1) > maxWriteAmount) {
-					Galactic::Console::cerr("BitStream::writeFlag(%i): The attempted write operation is accessing memory outside of range, halting and throwing exception.", val == true ? 1 : 0);
+					return 0;
+				}
+				return U32(high << k) | low;
+			}
+
+			void BitStream::writeQuantized(F32 value, const FloatQuantizer &quantizer) {
+				writeBits32(quantizer.quantize(value), quantizer.bitCount);
+			}
+
+			F32 BitStream::readQuantized(const FloatQuantizer &quantizer) {
+				U32 step = readBits32(quantizer.bitCount);
+				if(step > quantizer.steps) {
+					//Only a malformed packet can send a step past the range (dequantize() clamps it to max)
 					errorFlag = true;
-					//ToDo: Throw an assert error here
-					return false; //I know this return is redundant, but we want to dead-stop here, no memory violations please...
 				}
-				//see writeBits for these two statements. Writing a compressed 1 bit boolean takes on the same logic.
-				// If the boolean is true, use a BITOR Shift, otherwise, use a BITAND against the UNARY Shift
-				if(val) {
-					*(data + (bitNumber >> BuffSizeShift)) |= (BuffRWShift << (bitNumber & 0x7));
+				return quantizer.dequantize(step);
+			}
+
+			void BitStream::writeQuantizedVector(const Math::Vector2F &v, const FloatQuantizer &xQuantizer, const FloatQuantizer &yQuantizer) {
+				writeQuantized(F32(v.x), xQuantizer);
+				writeQuantized(F32(v.y), yQuantizer);
+			}
+
+			void BitStream::readQuantizedVector(Math::Vector2F *v, const FloatQuantizer &xQuantizer, const FloatQuantizer &yQuantizer) {
+				v->x = readQuantized(xQuantizer);
+				v->y = readQuantized(yQuantizer);
+			}
+
+			//The smaller component of a unit 2D vector is never past this
+			static const F64 BitStreamNormalLimit = 0.70710678118654752;
+
+			void BitStream::writeNormalVector(const Math::Vector2F &v, U32 bitCount) {
+				F64 x = v.x, y = v.y, length = sqrt(x * x + y * y);
+				if(!(length > 0)) {
+					x = 1;
+					y = 0;
 				}
 				else {
-					*(data + (bitNumber >> BuffSizeShift)) &= ~(BuffRWShift << (bitNumber & 0x7));
+					x /= length;
+					y /= length;
+				}
+				bool yIsLarger = fabs(y) > fabs(x);
+				F64 larger = yIsLarger ? y : x, smaller = yIsLarger ? x : y;
+				writeFlag(yIsLarger);
+				writeFlag(larger < 0);
+				writeQuantized(F32(smaller), FloatQuantizer::fromBits(F32(-BitStreamNormalLimit), F32(BitStreamNormalLimit), bitCount));
+			}
+
+			void BitStream::readNormalVector(Math::Vector2F *v, U32 bitCount) {
+				bool yIsLarger = readFlag();
+				bool negative = readFlag();
+				F64 smaller = readQuantized(FloatQuantizer::fromBits(F32(-BitStreamNormalLimit), F32(BitStreamNormalLimit), bitCount));
+				F64 larger = sqrt(smaller < 1 ? 1.0 - smaller * smaller : 0.0);
+				if(negative) {
+					larger = -larger;
 				}
-				//Add one to the BitNumber
-				bitNumber++;
-				//Return
-				return val;
+				v->x = yIsLarger ? smaller : larger;
+				v->y = yIsLarger ? larger : smaller;
 			}
 
-			bool BitStream::writeFlag(any val) {
-				return writeFlag(val != 0);
+			static const F64 BitStreamTwoPi = 6.28318530717958648;
+
+			void BitStream::writeAngle(F32 radians, U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					return;
+				}
+				//Angles wrap around, so the step past the last one is step 0 again (pi and -pi are the same step)
+				F64 turns = (F64(radians) + BitStreamTwoPi * 0.5) / BitStreamTwoPi;
+				turns -= floor(turns);
+				if(!(turns >= 0 && turns < 1)) {
+					//NaN or infinity
+					turns = 0.5;
+				}
+				U64 step = U64(turns * F64(U64DEF(1) << bitCount) + 0.5);
+				writeBits32(U32(step & ((U64DEF(1) << bitCount) - 1)), bitCount);
 			}
 
-			bool BitStream::readFlag() {
-				if((bitNumber) > maxReadAmount) {
-					Galactic::Console::cerr("BitStream::readFlag(): The attempted read operation is accessing memory outside of range, halting and throwing exception.");
-					errorFlag = true;
-					//ToDo: Throw an assert error here
-					return false; //I know this return is redundant, but we want to dead-stop here, no memory violations please...
-				}			
-				S32 bitShift = BuffRWShift << (bitNumber & 0x7);
-				bool value = (*(data + (bitNumber >> BuffSizeShift)) & bitShift) != 0;
-				bitNumber++;
+			F32 BitStream::readAngle(U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					return 0;
+				}
+				return F32(F64(readBits32(bitCount)) * BitStreamTwoPi / F64(U64DEF(1) << bitCount) - BitStreamTwoPi * 0.5);
+			}
+
+			void BitStream::writeHalfF32(F32 value) {
+				writeBits32(floatToHalf(value), 16);
+			}
+
+			F32 BitStream::readHalfF32() {
+				return halfToFloat(U16(readBits32(16)));
+			}
+
+			U16 BitStream::floatToHalf(F32 value) {
+				U32 bits;
+				memcpy(&bits, &value, sizeof(bits));
+				U32 sign = (bits >> 16) & 0x8000, exponent = (bits >> 23) & 0xFF, mantissa = bits & 0x7FFFFF;
+				if(exponent == 0xFF) {
+					//Infinity, or NaN (keeping it a NaN even if the payload is in the low bits)
+					return U16(sign | 0x7C00 | (mantissa ? 0x200 | (mantissa >> 13) : 0));
+				}
+				S32 halfExponent = S32(exponent) - 127 + 15;
+				if(halfExponent >= 0x1F) {
+					return U16(sign | 0x7C00);
+				}
+				U32 half, remainder, halfway;
+				if(halfExponent <= 0) {
+					//Subnormal half (or zero), the implicit bit becomes part of the mantissa
+					if(halfExponent < -10) {
+						return U16(sign);
+					}
+					U32 shift = U32(14 - halfExponent);
+					mantissa |= 0x800000;
+					half = mantissa >> shift;
+					remainder = mantissa & ((1u << shift) - 1);
+					halfway = 1u << (shift - 1);
+				}
+				else {
+					half = (U32(halfExponent) << 10) | (mantissa >> 13);
+					remainder = mantissa & 0x1FFF;
+					halfway = 0x1000;
+				}
+				//Round to nearest even, a carry out of the mantissa correctly bumps the exponent (up to infinity)
+				if(remainder > halfway || (remainder == halfway && (half & 1))) {
+					half++;
+				}
+				return U16(sign | half);
+			}
+
+			F32 BitStream::halfToFloat(U16 half) {
+				U32 sign = U32(half & 0x8000) << 16, exponent = (half >> 10) & 0x1F, mantissa = half & 0x3FF, bits;
+				if(exponent == 0x1F) {
+					bits = sign | 0x7F800000 | (mantissa << 13);
+				}
+				else if(exponent == 0) {
+					if(mantissa == 0) {
+						bits = sign;
+					}
+					else {
+						//Subnormal half, normalize it
+						exponent = 113;
+						while(!(mantissa & 0x400)) {
+							mantissa <<= 1;
+							exponent--;
+						}
+						bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+					}
+				}
+				else {
+					bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+				}
+				F32 value;
+				memcpy(&value, &bits, sizeof(value));
 				return value;
 			}
 
+			void BitStream::writeGammaCode(U64 value) {
+				//floor(log2(value)) zeros, then the top bit of the value (the 1 ending the zeros) followed by the bits below it
+				U32 zeros = bitsRequired64(value) - 1;
+				if(zeros) {
+					writeBits32(0, zeros);
+				}
+				writeBits64(((value & ((U64DEF(1) << zeros) - 1)) << 1) | 1, zeros + 1);
+			}
+
+			U64 BitStream::readGammaCode(U32 maxZeros) {
+				U32 zeros = 0;
+				while(!readFlag()) {
+					if(++zeros > maxZeros || errorFlag) {
+						errorFlag = true;
+						return 1;
+					}
+				}
+				return (U64DEF(1) << zeros) | (zeros ? readBits64(zeros) : 0);
+			}
+
 			void BitStream::writeString(UTF16 stringBuff, S32 maxLen) {
 				if(!stringBuff) {
 					stringBuff = "";
@@ -314,6 +666,10 @@ namespace Galactic {
 				HuffCoder::G_HuffCoder.compressStringToBitStream(stringBuff, this, maxLen);
 			}
 
+			void BitStream::writeString(UTF16 stringBuff, U64 length) {
+				writeString(stringBuff, S32(length > 255 ? 255 : length));
+			}
+
 			void BitStream::readString(C8 stringBuff[256]) {
 				if(strData) {
 					if(readFlag()) {
@@ -337,6 +693,10 @@ namespace Galactic {
 				return !errorFlag;
 			}
 
+			void BitStream::setError() {
+				errorFlag = true;
+			}
+
 			BitStream *BitStream::getTransmissionStream(U64 writeSize) {
 				if(!writeSize) {
 					writeSize = ::Galactic::Network::MaxPacketDataSize;
@@ -398,14 +758,9 @@ namespace Galactic {
 				str.write(data, getPosition());
 			}
 
-			void InfiniteBitStream::writeBits(cAny writeBuff, S64 bitCount) {
+			bool InfiniteBitStream::expandBuffer(S64 bitCount) {
 				validate((bitCount >> BuffSizeShift) + 1);
-				BitStream::writeBits(writeBuff, bitCount);
-			}
-
-			bool InfiniteBitStream::writeFlag(bool val) {
-				validate(1);
-				return BitStream::writeFlag(val);
+				return true;
 			}
 
 		};
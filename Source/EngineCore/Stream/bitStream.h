@@ -30,6 +30,9 @@
 #include "../../Net/NetConnection.h"
 #include "../Tools/huffman.h"
 #include "../Math/mVector.h"
+#if defined(_MSC_VER)
+	#include <intrin.h>
+#endif
 
 namespace Galactic {
 
@@ -40,6 +43,32 @@ namespace Galactic {
 		
 		namespace Streams {
 
+			/*
+			FloatQuantizer: Maps floats in [min, max] to the integers [0, steps] (and back) for BitStream::writeQuantized(). Create these once per
+			 replicated field, the scale factors are computed up front so quantizing is a multiply and a round.
+			*/
+			struct FloatQuantizer {
+				/* Public Class Methods */
+				//Create a quantizer for [min, max] where every value is sent to within precision
+				static FloatQuantizer fromPrecision(F32 min, F32 max, F32 precision);
+				//Create a quantizer for [min, max] that uses bitCount (1 - 32) bits
+				static FloatQuantizer fromBits(F32 min, F32 max, U32 bitCount);
+				//Clamp a value to the range and fetch its step
+				U32 quantize(F32 value) const;
+				//Fetch the value of a step
+				F32 dequantize(U32 step) const;
+
+				/* Public Class Members */
+				//The range of values
+				F32 min, max;
+				//The amount of steps (the largest value sent)
+				U32 steps;
+				//The amount of bits each value takes
+				U32 bitCount;
+				//steps / (max - min) and the inverse
+				F64 scale, invScale;
+			};
+
 			/*
 			BitStream: A Stream that compresses various forms of data into a single binary stream that can be safely transmitted
 			 across the network, specifically between client and server instances.
@@ -108,18 +137,104 @@ namespace Galactic {
 					void writeVector(const Math::Vector2F &v, S64 bitCount);
 					//Read Vector2
 					void readVector(Math::Vector2F *v, S64 bitCount);
-					//Write Bits
-					virtual void writeBits(cAny writeBuff, S64 bitCount);
-					//Read Bits
-					virtual void readBits(any readBuff, S64 bitCount);
+					//Write Bits: Write bitCount bits from a buffer (bit 0 of the first byte first)
+					void writeBits(cAny writeBuff, S64 bitCount);
+					//Read Bits: Read bitCount bits into a buffer, unused bits of the last byte are cleared
+					void readBits(any readBuff, S64 bitCount);
+					//Write the low bitCount (1 - 32) bits of a value
+					FINLINE void writeBits32(U32 value, U32 bitCount);
+					//Read a value of bitCount (1 - 32) bits
+					FINLINE U32 readBits32(U32 bitCount);
+					//Write the low bitCount (1 - 64) bits of a value
+					FINLINE void writeBits64(U64 value, U32 bitCount);
+					//Read a value of bitCount (1 - 64) bits
+					FINLINE U64 readBits64(U32 bitCount);
 					//Write Boolean (Flag)
-					virtual bool writeFlag(bool val);
+					FINLINE bool writeFlag(bool val);
 					//Write Flag Using Non-Boolean Value
 					FINLINE bool writeFlag(any val);
 					//Read Flag
-					virtual bool readFlag();
+					FINLINE bool readFlag();
+					/* Variable Length Encodings: Use these for values that are usually small (IDs, counts, deltas) instead of a fixed bit count */
+					//Write an unsigned value as a LEB128 varint, 7 bits per byte with the high bit flagging another byte (0 - 127 take 8 bits)
+					void writeVarU32(U32 value);
+					//Read a LEB128 varint
+					U32 readVarU32();
+					//Write an unsigned 64 bit value as a LEB128 varint
+					void writeVarU64(U64 value);
+					//Read a 64 bit LEB128 varint
+					U64 readVarU64();
+					//Write a signed value as a zigzag encoded varint, small negative values stay small (-64 - 63 take 8 bits) and no sign bit is needed
+					void writeVarS32(S32 value);
+					//Read a zigzag encoded varint
+					S32 readVarS32();
+					//Write a signed 64 bit value as a zigzag encoded varint
+					void writeVarS64(S64 value);
+					//Read a 64 bit zigzag encoded varint
+					S64 readVarS64();
+					//Write a value in [min, max] using exactly the bits needed for max - min (nothing at all when min == max)
+					void writeRangedU32(U32 value, U32 min, U32 max);
+					//Read a value written by writeRangedU32() with the same range
+					U32 readRangedU32(U32 min, U32 max);
+					//Write a value of 1 or more as an Elias-gamma code, 2 * floor(log2(value)) + 1 bits (1: 1 bit, 2 - 3: 3 bits, 4 - 7: 5 bits)
+					void writeEliasGamma(U32 value);
+					//Read an Elias-gamma code
+					U32 readEliasGamma();
+					//Write a value as an exponential-Golomb code of order k, the low k bits as is and the rest as the Elias-gamma code of (value >> k) + 1
+					void writeExpGolomb(U32 value, U32 k = 0);
+					//Read an exponential-Golomb code of order k
+					U32 readExpGolomb(U32 k = 0);
+					/* Lossy Float Encodings: Use these for replicated state (positions, velocities, directions) */
+					//Write a value using a FloatQuantizer, values outside of its range are clamped
+					void writeQuantized(F32 value, const FloatQuantizer &quantizer);
+					//Read a value written by writeQuantized() with the same quantizer, the result is always within the quantizer's range
+					F32 readQuantized(const FloatQuantizer &quantizer);
+					//Write a Vector2 using a quantizer for each component
+					void writeQuantizedVector(const Math::Vector2F &v, const FloatQuantizer &xQuantizer, const FloatQuantizer &yQuantizer);
+					//Read a Vector2 written by writeQuantizedVector()
+					void readQuantizedVector(Math::Vector2F *v, const FloatQuantizer &xQuantizer, const FloatQuantizer &yQuantizer);
+					/* Write a unit length direction in bitCount + 2 bits: The 2D version of "smallest three", the axis and sign of the larger component are
+					    sent as flags, and only the smaller component (always within +-1/sqrt(2)) is quantized, the larger one is rebuilt from it. */
+					void writeNormalVector(const Math::Vector2F &v, U32 bitCount);
+					//Read a direction written by writeNormalVector()
+					void readNormalVector(Math::Vector2F *v, U32 bitCount);
+					//Write an angle (in radians, wrapped into [-pi, pi)) using bitCount (1 - 32) bits
+					void writeAngle(F32 radians, U32 bitCount);
+					//Read an angle written by writeAngle()
+					F32 readAngle(U32 bitCount);
+					//Write a F32 as an IEEE 754 half float, 16 bits with 11 bits of precision and a range of +-65504
+					void writeHalfF32(F32 value);
+					//Read a half float
+					F32 readHalfF32();
+					/* Encoding Helpers */
+					//Fetch the amount of bits needed to hold values up to value (0 for 0)
+					SFIN U32 bitsRequired(U32 value);
+					//Fetch the amount of bits needed to hold values up to value (0 for 0)
+					SFIN U32 bitsRequired64(U64 value);
+					//Convert a F32 to the bits of a half float (rounded to nearest even, too large values become infinity)
+					static U16 floatToHalf(F32 value);
+					//Convert the bits of a half float to a F32
+					static F32 halfToFloat(U16 half);
+					//Map signed values to unsigned ones (0, -1, 1, -2, ... to 0, 1, 2, 3, ...)
+					SFIN U32 zigZagEncode(S32 value) {
+						return (U32(value) << 1) ^ U32(value >> 31);
+					}
+					//Undo zigZagEncode()
+					SFIN S32 zigZagDecode(U32 value) {
+						return S32(value >> 1) ^ -S32(value & 1);
+					}
+					//Map signed 64 bit values to unsigned ones
+					SFIN U64 zigZagEncode64(S64 value) {
+						return (U64(value) << 1) ^ U64(value >> 63);
+					}
+					//Undo zigZagEncode64()
+					SFIN S64 zigZagDecode64(U64 value) {
+						return S64(value >> 1) ^ -S64(value & 1);
+					}
 					//Write String
 					void writeString(UTF16 stringBuff, S32 maxLen = 255);
+					//Write String (Stream::writeString() override, so strings written through a Stream reference match readString())
+					void writeString(UTF16 stringBuff, U64 length);
 					//Read String
 					void readString(C8 stringBuff[256]);
 					/* A Few Extras */
@@ -127,6 +242,8 @@ namespace Galactic {
 					bool isFull();
 					//Test for errors
 					bool isValid();
+					//Flag the stream as failed (IE: a reader found malformed data), isValid() returns false afterwards
+					void setError();
 					//Obtain the Packet Transmission BitStream
 					static BitStream *getTransmissionStream(U64 writeSize = 0);
 					//Send the Packet Transmission BitStream to a specified location
@@ -155,10 +272,159 @@ namespace Galactic {
 					S64 maxWriteAmount;
 					// Boolean to test if errors occured in the process
 					bool errorFlag;
+					/* Protected Class Methods */
+					//Called when a write of bitCount bits doesn't fit, returns true if the buffer was grown to fit it
+					virtual bool expandBuffer(S64 bitCount);
+					//Report a read of bitCount bits past the end of the stream
+					void readOutOfRange(S64 bitCount);
+					/* 
+					Bits are packed through a 64 bit window loaded from (and stored to) the byte holding the current bit, so any value of up to 57 bits
+					 takes a single unaligned load / store. The tail functions handle the last 7 bytes of the buffer, where a full window doesn't fit.
+					*/
+					//Write up to 57 bits at the current position (the space has been checked)
+					FINLINE void writeWindow(U64 value, U32 bitCount);
+					//Read up to 57 bits from the current position (the space has been checked)
+					FINLINE U64 readWindow(U32 bitCount);
+					//Byte at a time versions of the above
+					void writeTail(U64 value, U32 bitCount);
+					U64 readTail(U32 bitCount);
+					//Write the gamma code of a value from 1 to 2^33 - 1
+					void writeGammaCode(U64 value);
+					//Read a gamma code of up to maxZeros leading zeros (more than that is malformed)
+					U64 readGammaCode(U32 maxZeros);
 					//Apply the "friend" access level to HuffCoder to allow access to these fields
 					friend class HuffCoder;
 			};
 
+			/*
+			BitStream Inline Definitions
+			*/
+
+			FINLINE U32 BitStream::bitsRequired(U32 value) {
+				if(value == 0) {
+					return 0;
+				}
+				#if defined(_MSC_VER)
+					unsigned long index;
+					_BitScanReverse(&index, value);
+					return U32(index) + 1;
+				#else
+					return 32 - U32(__builtin_clz(value));
+				#endif
+			}
+
+			FINLINE U32 BitStream::bitsRequired64(U64 value) {
+				return (value >> 32) ? 32 + bitsRequired(U32(value >> 32)) : bitsRequired(U32(value));
+			}
+
+			FINLINE void BitStream::writeWindow(U64 value, U32 bitCount) {
+				U64 byteIndex = U64(bitNumber >> BuffSizeShift);
+				U32 shift = U32(bitNumber & 0x7);
+				if(byteIndex + sizeof(U64) <= U64(maxWriteAmount >> BuffSizeShift)) {
+					U64 mask = ((U64DEF(1) << bitCount) - 1) << shift, window;
+					memcpy(&window, data + byteIndex, sizeof(U64));
+					window = convertLittleEndianToSrc(window);
+					window = (window & ~mask) | ((value << shift) & mask);
+					window = convertSrcToLittleEndian(window);
+					memcpy(data + byteIndex, &window, sizeof(U64));
+					bitNumber += bitCount;
+					return;
+				}
+				writeTail(value, bitCount);
+			}
+
+			FINLINE U64 BitStream::readWindow(U32 bitCount) {
+				U64 byteIndex = U64(bitNumber >> BuffSizeShift);
+				U32 shift = U32(bitNumber & 0x7);
+				if(byteIndex + sizeof(U64) <= U64(maxReadAmount >> BuffSizeShift)) {
+					U64 window;
+					memcpy(&window, data + byteIndex, sizeof(U64));
+					bitNumber += bitCount;
+					return (convertLittleEndianToSrc(window) >> shift) & ((U64DEF(1) << bitCount) - 1);
+				}
+				return readTail(bitCount);
+			}
+
+			FINLINE void BitStream::writeBits32(U32 value, U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					return;
+				}
+				if((bitNumber + bitCount) > maxWriteAmount && !expandBuffer(bitCount)) {
+					return;
+				}
+				writeWindow(value, bitCount);
+			}
+
+			FINLINE U32 BitStream::readBits32(U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					return 0;
+				}
+				if((bitNumber + bitCount) > maxReadAmount) {
+					readOutOfRange(bitCount);
+					return 0;
+				}
+				return U32(readWindow(bitCount));
+			}
+
+			FINLINE void BitStream::writeBits64(U64 value, U32 bitCount) {
+				if(bitCount == 0 || bitCount > 64) {
+					return;
+				}
+				if((bitNumber + bitCount) > maxWriteAmount && !expandBuffer(bitCount)) {
+					return;
+				}
+				//A window can't take more than 57 bits, so values past 32 bits are written as two halves
+				if(bitCount > 32) {
+					writeWindow(value & 0xFFFFFFFF, 32);
+					writeWindow(value >> 32, bitCount - 32);
+					return;
+				}
+				writeWindow(value, bitCount);
+			}
+
+			FINLINE U64 BitStream::readBits64(U32 bitCount) {
+				if(bitCount == 0 || bitCount > 64) {
+					return 0;
+				}
+				if((bitNumber + bitCount) > maxReadAmount) {
+					readOutOfRange(bitCount);
+					return 0;
+				}
+				if(bitCount > 32) {
+					U64 low = readWindow(32);
+					return low | (readWindow(bitCount - 32) << 32);
+				}
+				return readWindow(bitCount);
+			}
+
+			FINLINE bool BitStream::writeFlag(bool val) {
+				//Recall from stream.cpp, that booleans have different size values based
+				// on the compiler, therefore we compress it to a static size.
+				if((bitNumber + 1) > maxWriteAmount && !expandBuffer(1)) {
+					return false;
+				}
+				//Clear the bit, then set it again from the value (no branch on the value)
+				U8 &target = *(data + (bitNumber >> BuffSizeShift));
+				U8 shift = U8(bitNumber & 0x7);
+				target = U8((target & ~(BuffRWShift << shift)) | (U8(val) << shift));
+				bitNumber++;
+				return val;
+			}
+
+			FINLINE bool BitStream::writeFlag(any val) {
+				return writeFlag(val != 0);
+			}
+
+			FINLINE bool BitStream::readFlag() {
+				if((bitNumber + 1) > maxReadAmount) {
+					readOutOfRange(1);
+					return false;
+				}
+				bool value = ((*(data + (bitNumber >> BuffSizeShift)) >> (bitNumber & 0x7)) & BuffRWShift) != 0;
+				bitNumber++;
+				return value;
+			}
+
 			/*
 			InfiniteBitStream: This is an extension of the existing BitStream class that allows you to create a Stream that constantly expands as
 			 the needs of the memory exist.
@@ -177,11 +443,9 @@ namespace Galactic {
 					void compact();
 					//Write the buffer of the Infinite Stream to a standard Stream
 					void writetoStream(Stream &str);
-					//Write Bits
-					virtual void writeBits(cAny writeBuff, S64 bitCount);
-					//Write Boolean (Flag)
-					virtual bool writeFlag(bool val);
 				protected:
+					//Grow the buffer when a write doesn't fit
+					virtual bool expandBuffer(S64 bitCount);
 					//Value containing the minimum space needed by this Stream
 					U64 minimumSpace;
 			};
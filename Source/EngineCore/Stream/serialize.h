@@ -0,0 +1,650 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Stream/serialize.h
+* Compile time field lists that generate BitStream and Stream serializers
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_SERIALIZE
+#define GALACTIC_INTERNAL_SERIALIZE
+
+#include "bitStream.h"
+
+/*
+GALACTIC_SERIALIZE: Declares the serialized fields of a struct, generating inlined BitStream and Stream serializers for it (see Serialize::write()
+ and friends). Place it in the namespace of the type, after the type, with the type's unqualified name and a GALACTIC_FIELD() for each member:
+
+  GALACTIC_SERIALIZE(PlayerState,
+	GALACTIC_FIELD(health).bits(10),
+	GALACTIC_FIELD(x).quantized(-4096, 4096, 0.01f),
+	GALACTIC_FIELD(heading).half(),
+	GALACTIC_FIELD(score).varint(),
+	GALACTIC_FIELD(name).since(2))
+
+ The field list is built once (the first time the type is serialized), and every field is coded by a template chosen by its type, so there's
+ no per-field dispatch at runtime. Members may be bool, the S8 - U64 types, F32, F64, String or another type with a GALACTIC_SERIALIZE().
+*/
+#define GALACTIC_SERIALIZE(Type, ...) \
+	struct GalacticSerializeFields_##Type { \
+		typedef Type SerializeType; \
+		static auto create() -> decltype(::Galactic::Core::Streams::Serialize::createSchema<Type>(__VA_ARGS__)) { \
+			return ::Galactic::Core::Streams::Serialize::createSchema<Type>(__VA_ARGS__); \
+		} \
+	}; \
+	inline auto galacticSerializeSchema(const Type *) -> const decltype(GalacticSerializeFields_##Type::create()) & { \
+		static const decltype(GalacticSerializeFields_##Type::create()) schema = GalacticSerializeFields_##Type::create(); \
+		return schema; \
+	}
+
+//A member of the type given to GALACTIC_SERIALIZE(), the attributes of Serialize::Field can be chained onto it
+#define GALACTIC_FIELD(member) ::Galactic::Core::Streams::Serialize::field(&SerializeType::member)
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Streams {
+
+			namespace Serialize {
+
+				//The version that includes every field, the default for the BitStream serializers
+				const U32 Latest = 0xFFFFFFFF;
+
+				//How a field is packed into a BitStream (Streams always store the full value)
+				enum Encodings {
+					//Integers take their full width and floats their full 32 / 64 bits
+					Encode_Default,
+					//Integers take bitCount bits (signed ones are sign extended when read)
+					Encode_Bits,
+					//Integers are sent as varints (zigzag varints when signed)
+					Encode_Var,
+					//F32 goes through a FloatQuantizer
+					Encode_Quantized,
+					//F32 is sent as a half float
+					Encode_Half,
+				};
+
+				/*
+				FieldAttributes: How a field is sent and the version it was added in.
+				*/
+				struct FieldAttributes {
+					//The encoding
+					U32 encoding;
+					//The bit count of Encode_Bits
+					U32 bitCount;
+					//The version the field was added in, it isn't sent to (or read from) older versions
+					U32 since;
+					//The quantizer of Encode_Quantized
+					FloatQuantizer quantizer;
+				};
+
+				/*
+				Field: A member of a serialized type and its attributes, created by GALACTIC_FIELD(). The attributes return a copy, so they chain.
+				*/
+				template <class C, class T> struct Field {
+					/* Public Class Methods */
+					//Constructor
+					Field(T C::*member) : member(member) {
+						memset(&attributes, 0, sizeof(attributes));
+						attributes.encoding = Encode_Default;
+					}
+					//Send the low bitCount (1 - 64) bits of an integer
+					Field bits(U32 bitCount) const {
+						Field f(*this);
+						f.attributes.encoding = Encode_Bits;
+						f.attributes.bitCount = bitCount;
+						return f;
+					}
+					//Send an integer as a varint
+					Field varint() const {
+						Field f(*this);
+						f.attributes.encoding = Encode_Var;
+						return f;
+					}
+					//Send a F32 in [min, max] to within precision
+					Field quantized(F32 min, F32 max, F32 precision) const {
+						Field f(*this);
+						f.attributes.encoding = Encode_Quantized;
+						f.attributes.quantizer = FloatQuantizer::fromPrecision(min, max, precision);
+						return f;
+					}
+					//Send a F32 in [min, max] with bitCount (1 - 32) bits
+					Field quantizedBits(F32 min, F32 max, U32 bitCount) const {
+						Field f(*this);
+						f.attributes.encoding = Encode_Quantized;
+						f.attributes.quantizer = FloatQuantizer::fromBits(min, max, bitCount);
+						return f;
+					}
+					//Send a F32 as a half float
+					Field half() const {
+						Field f(*this);
+						f.attributes.encoding = Encode_Half;
+						return f;
+					}
+					//The field was added in a version
+					Field since(U32 version) const {
+						Field f(*this);
+						f.attributes.since = version;
+						return f;
+					}
+
+					/* Public Class Members */
+					//The member
+					T C::*member;
+					//The attributes
+					FieldAttributes attributes;
+				};
+
+				//Create the Field of a member, used by GALACTIC_FIELD()
+				template <class C, class T> FINLINE Field<C, T> field(T C::*member) {
+					return Field<C, T>(member);
+				}
+
+				/*
+				FieldList: The fields of a type, a head and the list of the rest. Visiting the list calls the visitor with each field in order, which
+				 the compiler unrolls and inlines.
+				*/
+				template <class... Fields> struct FieldList {
+					//Visit each field (none here)
+					template <class Visitor> FINLINE void visit(Visitor &) const {}
+					//Fetch the newest version of any field
+					U32 fetchVersion() const {
+						return 0;
+					}
+				};
+
+				template <class Head, class... Tail> struct FieldList<Head, Tail...> {
+					//Constructor
+					FieldList(const Head &head, const Tail &... tail) : head(head), tail(tail...) {}
+					//Visit each field
+					template <class Visitor> FINLINE void visit(Visitor &visitor) const {
+						visitor(head);
+						tail.visit(visitor);
+					}
+					//Fetch the newest version of any field
+					U32 fetchVersion() const {
+						U32 rest = tail.fetchVersion();
+						return head.attributes.since > rest ? head.attributes.since : rest;
+					}
+
+					//The field
+					Head head;
+					//The rest
+					FieldList<Tail...> tail;
+				};
+
+				/*
+				Schema: The fields of a serialized type and its version (the newest version of its fields).
+				*/
+				template <class C, class... Fields> struct Schema : public FieldList<Fields...> {
+					//Constructor
+					Schema(const Fields &... fields) : FieldList<Fields...>(fields...) {
+						version = this->fetchVersion();
+					}
+
+					//The version
+					U32 version;
+				};
+
+				//Create the Schema of a type, used by GALACTIC_SERIALIZE()
+				template <class C, class... Fields> Schema<C, Fields...> createSchema(const Fields &... fields) {
+					return Schema<C, Fields...>(fields...);
+				}
+
+				//Fetch the Schema of a type (declared by GALACTIC_SERIALIZE(), which is found by argument dependent lookup)
+				template <class T> FINLINE auto fetchSchema() -> decltype(galacticSerializeSchema((const T *)NULL)) {
+					return galacticSerializeSchema((const T *)NULL);
+				}
+
+				/* Forward declarations for members that are serialized types themselves */
+				template <class T> void write(BitStream &stream, const T &value, U32 version);
+				template <class T> bool read(BitStream &stream, T *value, U32 version);
+				template <class T> bool changed(const T &value, const T &baseline, U32 version);
+				template <class T> bool write(Stream &stream, const T &value);
+				template <class T> bool read(Stream &stream, T *value);
+
+				/*
+				Value Coders: The BitStream coding of each member type, chosen by overload resolution. Members that aren't one of these types are
+				 serialized types (the templates at the end of each group).
+				*/
+
+				//Write an unsigned integer of size bytes
+				FINLINE void packUnsigned(BitStream &stream, U64 value, U32 size, const FieldAttributes &attributes) {
+					if(attributes.encoding == Encode_Var) {
+						stream.writeVarU64(value);
+					}
+					else {
+						stream.writeBits64(value, attributes.encoding == Encode_Bits ? attributes.bitCount : size << 3);
+					}
+				}
+
+				//Read an unsigned integer of size bytes
+				FINLINE U64 unpackUnsigned(BitStream &stream, U32 size, const FieldAttributes &attributes) {
+					if(attributes.encoding == Encode_Var) {
+						return stream.readVarU64();
+					}
+					return stream.readBits64(attributes.encoding == Encode_Bits ? attributes.bitCount : size << 3);
+				}
+
+				//Write a signed integer of size bytes
+				FINLINE void packSigned(BitStream &stream, S64 value, U32 size, const FieldAttributes &attributes) {
+					if(attributes.encoding == Encode_Var) {
+						stream.writeVarS64(value);
+					}
+					else {
+						stream.writeBits64(U64(value), attributes.encoding == Encode_Bits ? attributes.bitCount : size << 3);
+					}
+				}
+
+				//Read a signed integer of size bytes
+				FINLINE S64 unpackSigned(BitStream &stream, U32 size, const FieldAttributes &attributes) {
+					if(attributes.encoding == Encode_Var) {
+						return stream.readVarS64();
+					}
+					U32 bitCount = attributes.encoding == Encode_Bits ? attributes.bitCount : size << 3;
+					//Sign extend from the top bit that was sent
+					return S64(stream.readBits64(bitCount) << (64 - bitCount)) >> (64 - bitCount);
+				}
+
+				//Test if two integers are sent differently
+				FINLINE bool integerChanged(U64 value, U64 baseline, const FieldAttributes &attributes) {
+					if(attributes.encoding == Encode_Bits && attributes.bitCount < 64) {
+						return ((value ^ baseline) & ((U64DEF(1) << attributes.bitCount) - 1)) != 0;
+					}
+					return value != baseline;
+				}
+
+				FINLINE void packValue(BitStream &stream, bool value, const FieldAttributes &, U32) {
+					stream.writeFlag(value);
+				}
+				FINLINE void packValue(BitStream &stream, U8 value, const FieldAttributes &attributes, U32) {
+					packUnsigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, U16 value, const FieldAttributes &attributes, U32) {
+					packUnsigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, U32 value, const FieldAttributes &attributes, U32) {
+					packUnsigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, U64 value, const FieldAttributes &attributes, U32) {
+					packUnsigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, S8 value, const FieldAttributes &attributes, U32) {
+					packSigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, S16 value, const FieldAttributes &attributes, U32) {
+					packSigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, S32 value, const FieldAttributes &attributes, U32) {
+					packSigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, S64 value, const FieldAttributes &attributes, U32) {
+					packSigned(stream, value, sizeof(value), attributes);
+				}
+				FINLINE void packValue(BitStream &stream, F32 value, const FieldAttributes &attributes, U32) {
+					if(attributes.encoding == Encode_Quantized) {
+						stream.writeQuantized(value, attributes.quantizer);
+					}
+					else if(attributes.encoding == Encode_Half) {
+						stream.writeHalfF32(value);
+					}
+					else {
+						U32 bits;
+						memcpy(&bits, &value, sizeof(bits));
+						stream.writeBits32(bits, 32);
+					}
+				}
+				FINLINE void packValue(BitStream &stream, F64 value, const FieldAttributes &, U32) {
+					U64 bits;
+					memcpy(&bits, &value, sizeof(bits));
+					stream.writeBits64(bits, 64);
+				}
+				//Strings are sent as a varint length and the bytes, so they have no length limit
+				FINLINE void packValue(BitStream &stream, strRef value, const FieldAttributes &, U32) {
+					stream.writeVarU32(value.length());
+					stream.write(value.c_str(), value.length());
+				}
+				template <class T> FINLINE void packValue(BitStream &stream, const T &value, const FieldAttributes &, U32 version) {
+					write(stream, value, version);
+				}
+
+				FINLINE void unpackValue(BitStream &stream, bool *value, const FieldAttributes &, U32) {
+					*value = stream.readFlag();
+				}
+				FINLINE void unpackValue(BitStream &stream, U8 *value, const FieldAttributes &attributes, U32) {
+					*value = U8(unpackUnsigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, U16 *value, const FieldAttributes &attributes, U32) {
+					*value = U16(unpackUnsigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, U32 *value, const FieldAttributes &attributes, U32) {
+					*value = U32(unpackUnsigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, U64 *value, const FieldAttributes &attributes, U32) {
+					*value = unpackUnsigned(stream, sizeof(*value), attributes);
+				}
+				FINLINE void unpackValue(BitStream &stream, S8 *value, const FieldAttributes &attributes, U32) {
+					*value = S8(unpackSigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, S16 *value, const FieldAttributes &attributes, U32) {
+					*value = S16(unpackSigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, S32 *value, const FieldAttributes &attributes, U32) {
+					*value = S32(unpackSigned(stream, sizeof(*value), attributes));
+				}
+				FINLINE void unpackValue(BitStream &stream, S64 *value, const FieldAttributes &attributes, U32) {
+					*value = unpackSigned(stream, sizeof(*value), attributes);
+				}
+				FINLINE void unpackValue(BitStream &stream, F32 *value, const FieldAttributes &attributes, U32) {
+					if(attributes.encoding == Encode_Quantized) {
+						*value = stream.readQuantized(attributes.quantizer);
+					}
+					else if(attributes.encoding == Encode_Half) {
+						*value = stream.readHalfF32();
+					}
+					else {
+						U32 bits = stream.readBits32(32);
+						memcpy(value, &bits, sizeof(bits));
+					}
+				}
+				FINLINE void unpackValue(BitStream &stream, F64 *value, const FieldAttributes &, U32) {
+					U64 bits = stream.readBits64(64);
+					memcpy(value, &bits, sizeof(bits));
+				}
+				FINLINE void unpackValue(BitStream &stream, String *value, const FieldAttributes &, U32) {
+					U32 length = stream.readVarU32();
+					//A length past the end of the stream is malformed, fail the read rather than allocating for it
+					if(!stream.isValid() || U64(length) > stream.getReadBytes()) {
+						stream.setError();
+						*value = String();
+						return;
+					}
+					UTF8 buffer = (UTF8)malloc(length + 1);
+					stream.read(buffer, length);
+					*value = String(buffer, length);
+					SendToGatesOfHeaven(buffer);
+				}
+				template <class T> FINLINE void unpackValue(BitStream &stream, T *value, const FieldAttributes &, U32 version) {
+					read(stream, value, version);
+				}
+
+				//A field changed when the value it would be sent as changed
+				FINLINE bool valueChanged(bool value, bool baseline, const FieldAttributes &, U32) {
+					return value != baseline;
+				}
+				FINLINE bool valueChanged(U8 value, U8 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(value, baseline, attributes);
+				}
+				FINLINE bool valueChanged(U16 value, U16 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(value, baseline, attributes);
+				}
+				FINLINE bool valueChanged(U32 value, U32 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(value, baseline, attributes);
+				}
+				FINLINE bool valueChanged(U64 value, U64 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(value, baseline, attributes);
+				}
+				FINLINE bool valueChanged(S8 value, S8 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(U64(value), U64(baseline), attributes);
+				}
+				FINLINE bool valueChanged(S16 value, S16 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(U64(value), U64(baseline), attributes);
+				}
+				FINLINE bool valueChanged(S32 value, S32 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(U64(value), U64(baseline), attributes);
+				}
+				FINLINE bool valueChanged(S64 value, S64 baseline, const FieldAttributes &attributes, U32) {
+					return integerChanged(U64(value), U64(baseline), attributes);
+				}
+				FINLINE bool valueChanged(F32 value, F32 baseline, const FieldAttributes &attributes, U32) {
+					if(attributes.encoding == Encode_Quantized) {
+						return attributes.quantizer.quantize(value) != attributes.quantizer.quantize(baseline);
+					}
+					if(attributes.encoding == Encode_Half) {
+						return BitStream::floatToHalf(value) != BitStream::floatToHalf(baseline);
+					}
+					//Compare the bits, so NaNs and signed zeros are handled
+					return memcmp(&value, &baseline, sizeof(value)) != 0;
+				}
+				FINLINE bool valueChanged(F64 value, F64 baseline, const FieldAttributes &, U32) {
+					return memcmp(&value, &baseline, sizeof(value)) != 0;
+				}
+				FINLINE bool valueChanged(strRef value, strRef baseline, const FieldAttributes &, U32) {
+					return value != baseline;
+				}
+				template <class T> FINLINE bool valueChanged(const T &value, const T &baseline, const FieldAttributes &, U32 version) {
+					return changed(value, baseline, version);
+				}
+
+				/*
+				Stream Coders: Streams store the full value of each member with the Stream::write() / Stream::read() overloads.
+				*/
+				#define GALACTIC_SERIALIZE_STREAM_VALUE(Type) \
+					FINLINE bool storeValue(Stream &stream, const Type &value) { return stream.write(value); } \
+					FINLINE bool loadValue(Stream &stream, Type *value) { return stream.read(value); }
+				GALACTIC_SERIALIZE_STREAM_VALUE(bool)
+				GALACTIC_SERIALIZE_STREAM_VALUE(U8)
+				GALACTIC_SERIALIZE_STREAM_VALUE(U16)
+				GALACTIC_SERIALIZE_STREAM_VALUE(U32)
+				GALACTIC_SERIALIZE_STREAM_VALUE(U64)
+				GALACTIC_SERIALIZE_STREAM_VALUE(S8)
+				GALACTIC_SERIALIZE_STREAM_VALUE(S16)
+				GALACTIC_SERIALIZE_STREAM_VALUE(S32)
+				GALACTIC_SERIALIZE_STREAM_VALUE(S64)
+				GALACTIC_SERIALIZE_STREAM_VALUE(F32)
+				GALACTIC_SERIALIZE_STREAM_VALUE(F64)
+				GALACTIC_SERIALIZE_STREAM_VALUE(String)
+				#undef GALACTIC_SERIALIZE_STREAM_VALUE
+				template <class T> FINLINE bool storeValue(Stream &stream, const T &value) {
+					return write(stream, value);
+				}
+				template <class T> FINLINE bool loadValue(Stream &stream, T *value) {
+					return read(stream, value);
+				}
+
+				/*
+				Visitors: The per field steps of the serializers, each one is called with every Field of the type.
+				*/
+
+				template <class C> struct WriteVisitor {
+					BitStream &stream;
+					const C &value;
+					U32 version;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(field.attributes.since <= version) {
+							packValue(stream, value.*field.member, field.attributes, version);
+						}
+					}
+				};
+
+				template <class C> struct ReadVisitor {
+					BitStream &stream;
+					C *value;
+					U32 version;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(field.attributes.since <= version) {
+							unpackValue(stream, &(value->*field.member), field.attributes, version);
+						}
+					}
+				};
+
+				template <class C> struct ChangedVisitor {
+					const C &value;
+					const C &baseline;
+					U32 version;
+					bool result;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(!result && field.attributes.since <= version) {
+							result = valueChanged(value.*field.member, baseline.*field.member, field.attributes, version);
+						}
+					}
+				};
+
+				template <class C> struct WriteDeltaVisitor {
+					BitStream &stream;
+					const C &value;
+					const C &baseline;
+					U32 version;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(field.attributes.since <= version &&
+						    stream.writeFlag(valueChanged(value.*field.member, baseline.*field.member, field.attributes, version))) {
+							packValue(stream, value.*field.member, field.attributes, version);
+						}
+					}
+				};
+
+				template <class C> struct ReadDeltaVisitor {
+					BitStream &stream;
+					C *value;
+					U32 version;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(field.attributes.since <= version && stream.readFlag()) {
+							unpackValue(stream, &(value->*field.member), field.attributes, version);
+						}
+					}
+				};
+
+				template <class C> struct StoreVisitor {
+					Stream &stream;
+					const C &value;
+					bool result;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						result = storeValue(stream, value.*field.member) && result;
+					}
+				};
+
+				template <class C> struct LoadVisitor {
+					Stream &stream;
+					C *value;
+					U32 version;
+					bool result;
+
+					template <class T> FINLINE void operator()(const Field<C, T> &field) {
+						if(result && field.attributes.since <= version) {
+							result = loadValue(stream, &(value->*field.member));
+						}
+					}
+				};
+
+				/*
+				Serializers
+				*/
+
+				//Write the fields of a value that exist in version (Latest sends them all, both ends have to agree on the version)
+				template <class T> void write(BitStream &stream, const T &value, U32 version) {
+					WriteVisitor<T> visitor = { stream, value, version };
+					fetchSchema<T>().visit(visitor);
+				}
+
+				//Write every field of a value
+				template <class T> FINLINE void write(BitStream &stream, const T &value) {
+					write(stream, value, Latest);
+				}
+
+				//Read the fields of a value that exist in version, fields that don't are left as they are. Returns false for a malformed stream.
+				template <class T> bool read(BitStream &stream, T *value, U32 version) {
+					ReadVisitor<T> visitor = { stream, value, version };
+					fetchSchema<T>().visit(visitor);
+					return stream.isValid();
+				}
+
+				//Read every field of a value
+				template <class T> FINLINE bool read(BitStream &stream, T *value) {
+					return read(stream, value, Latest);
+				}
+
+				//Test if any field of value would be sent differently than the same field of baseline
+				template <class T> bool changed(const T &value, const T &baseline, U32 version) {
+					ChangedVisitor<T> visitor = { value, baseline, version, false };
+					fetchSchema<T>().visit(visitor);
+					return visitor.result;
+				}
+
+				//Test if any field changed
+				template <class T> FINLINE bool changed(const T &value, const T &baseline) {
+					return changed(value, baseline, Latest);
+				}
+
+				//Write a value as a delta of a baseline the reader has, each field is sent behind a changed flag (a member of a serialized type is sent in full)
+				template <class T> void writeDelta(BitStream &stream, const T &value, const T &baseline, U32 version) {
+					WriteDeltaVisitor<T> visitor = { stream, value, baseline, version };
+					fetchSchema<T>().visit(visitor);
+				}
+
+				//Write a delta of every field
+				template <class T> FINLINE void writeDelta(BitStream &stream, const T &value, const T &baseline) {
+					writeDelta(stream, value, baseline, Latest);
+				}
+
+				//Read a delta written against baseline into value (value may be the baseline itself)
+				template <class T> bool readDelta(BitStream &stream, T *value, const T &baseline, U32 version) {
+					if(value != &baseline) {
+						*value = baseline;
+					}
+					ReadDeltaVisitor<T> visitor = { stream, value, version };
+					fetchSchema<T>().visit(visitor);
+					return stream.isValid();
+				}
+
+				//Read a delta of every field
+				template <class T> FINLINE bool readDelta(BitStream &stream, T *value, const T &baseline) {
+					return readDelta(stream, value, baseline, Latest);
+				}
+
+				//Write the version of the type and every field to a Stream (ex: a save file)
+				template <class T> bool write(Stream &stream, const T &value) {
+					StoreVisitor<T> visitor = { stream, value, stream.write(fetchSchema<T>().version) };
+					fetchSchema<T>().visit(visitor);
+					return visitor.result;
+				}
+
+				//Read a value written to a Stream by any version up to the current one, fields added since are left as they are
+				template <class T> bool read(Stream &stream, T *value) {
+					U32 version;
+					if(!stream.read(&version)) {
+						return false;
+					}
+					if(version > fetchSchema<T>().version) {
+						if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+							Galactic::Console::warn("Serialize::read(): The stored version (%u) is newer than the type (%u).", version, fetchSchema<T>().version);
+						}
+						return false;
+					}
+					LoadVisitor<T> visitor = { stream, value, version, true };
+					fetchSchema<T>().visit(visitor);
+					return visitor.result;
+				}
+
+			};
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_SERIALIZE
\ No newline at end of file
@@ -0,0 +1,508 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Stream/snapshot.cpp
+* Delta compressed object state snapshots against acknowledged baselines
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "snapshot.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Streams {
+
+			//Fetch the value at a byte offset of a state
+			template <class T> static FINLINE T fetchStateValue(cAny state, U32 offset) {
+				T value;
+				memcpy(&value, (UTX16)state + offset, sizeof(T));
+				return value;
+			}
+
+			//Store a value at a byte offset of a state
+			template <class T> static FINLINE void storeStateValue(any state, U32 offset, T value) {
+				memcpy((UTX8)state + offset, &value, sizeof(T));
+			}
+
+			/*
+			SnapshotSchema
+			*/
+
+			SnapshotSchema::SnapshotSchema(U32 stateSize) : stateSize(stateSize) {
+
+			}
+
+			SnapshotSchema &SnapshotSchema::addField(SnapshotField::Type type, U32 offset, U32 size) {
+				if(offset + size > stateSize) {
+					GC_Error("SnapshotSchema::addField(): The field at offset %u is outside of the state (%u bytes), ignoring it.", offset, stateSize);
+					return *this;
+				}
+				SnapshotField field;
+				memset(&field, 0, sizeof(field));
+				field.type = type;
+				field.offset = offset;
+				fields.pushToBack(field);
+				return *this;
+			}
+
+			SnapshotSchema &SnapshotSchema::addU32(U32 offset, U32 bitCount) {
+				if(bitCount == 0 || bitCount > 32) {
+					GC_Error("SnapshotSchema::addU32(): The bit count must be from 1 to 32, ignoring the field.");
+					return *this;
+				}
+				U32 count = getFieldCount();
+				addField(SnapshotField::Field_U32, offset, sizeof(U32));
+				if(getFieldCount() > count) {
+					fields.back().bitCount = bitCount;
+				}
+				return *this;
+			}
+
+			SnapshotSchema &SnapshotSchema::addVarU32(U32 offset) {
+				return addField(SnapshotField::Field_VarU32, offset, sizeof(U32));
+			}
+
+			SnapshotSchema &SnapshotSchema::addVarS32(U32 offset) {
+				return addField(SnapshotField::Field_VarS32, offset, sizeof(S32));
+			}
+
+			SnapshotSchema &SnapshotSchema::addQuantizedF32(U32 offset, const FloatQuantizer &quantizer) {
+				U32 count = getFieldCount();
+				addField(SnapshotField::Field_QuantizedF32, offset, sizeof(F32));
+				if(getFieldCount() > count) {
+					fields.back().quantizer = quantizer;
+				}
+				return *this;
+			}
+
+			SnapshotSchema &SnapshotSchema::addHalfF32(U32 offset) {
+				return addField(SnapshotField::Field_HalfF32, offset, sizeof(F32));
+			}
+
+			SnapshotSchema &SnapshotSchema::addF32(U32 offset) {
+				return addField(SnapshotField::Field_F32, offset, sizeof(F32));
+			}
+
+			U32 SnapshotSchema::getStateSize() const {
+				return stateSize;
+			}
+
+			U32 SnapshotSchema::getFieldCount() const {
+				return U32(fields.size());
+			}
+
+			const SnapshotField &SnapshotSchema::getField(U32 index) const {
+				return fields[index];
+			}
+
+			bool SnapshotSchema::stateChanged(cAny state, cAny baseline) const {
+				//Identical bytes are by far the most common case, only compare the sent values when something is different
+				if(memcmp(state, baseline, stateSize) == 0) {
+					return false;
+				}
+				for(U32 i = 0; i < getFieldCount(); i++) {
+					if(fieldChanged(i, state, baseline)) {
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool SnapshotSchema::fieldChanged(U32 index, cAny state, cAny baseline) const {
+				const SnapshotField &field = fields[index];
+				switch(field.type) {
+					case SnapshotField::Field_U32: {
+						U32 mask = field.bitCount == 32 ? 0xFFFFFFFF : ((1u << field.bitCount) - 1);
+						return ((fetchStateValue<U32>(state, field.offset) ^ fetchStateValue<U32>(baseline, field.offset)) & mask) != 0;
+					}
+					case SnapshotField::Field_QuantizedF32:
+						return field.quantizer.quantize(fetchStateValue<F32>(state, field.offset)) != field.quantizer.quantize(fetchStateValue<F32>(baseline, field.offset));
+					case SnapshotField::Field_HalfF32:
+						return BitStream::floatToHalf(fetchStateValue<F32>(state, field.offset)) != BitStream::floatToHalf(fetchStateValue<F32>(baseline, field.offset));
+					default:
+						//Varints and full floats are sent as is, so compare the bits
+						return fetchStateValue<U32>(state, field.offset) != fetchStateValue<U32>(baseline, field.offset);
+				}
+			}
+
+			void SnapshotSchema::writeField(BitStream &stream, U32 index, cAny state) const {
+				const SnapshotField &field = fields[index];
+				switch(field.type) {
+					case SnapshotField::Field_U32:
+						stream.writeBits32(fetchStateValue<U32>(state, field.offset), field.bitCount);
+						break;
+					case SnapshotField::Field_VarU32:
+						stream.writeVarU32(fetchStateValue<U32>(state, field.offset));
+						break;
+					case SnapshotField::Field_VarS32:
+						stream.writeVarS32(fetchStateValue<S32>(state, field.offset));
+						break;
+					case SnapshotField::Field_QuantizedF32:
+						stream.writeQuantized(fetchStateValue<F32>(state, field.offset), field.quantizer);
+						break;
+					case SnapshotField::Field_HalfF32:
+						stream.writeHalfF32(fetchStateValue<F32>(state, field.offset));
+						break;
+					case SnapshotField::Field_F32:
+						stream.writeBits32(fetchStateValue<U32>(state, field.offset), 32);
+						break;
+				}
+			}
+
+			void SnapshotSchema::readField(BitStream &stream, U32 index, any state) const {
+				const SnapshotField &field = fields[index];
+				switch(field.type) {
+					case SnapshotField::Field_U32:
+						storeStateValue<U32>(state, field.offset, stream.readBits32(field.bitCount));
+						break;
+					case SnapshotField::Field_VarU32:
+						storeStateValue<U32>(state, field.offset, stream.readVarU32());
+						break;
+					case SnapshotField::Field_VarS32:
+						storeStateValue<S32>(state, field.offset, stream.readVarS32());
+						break;
+					case SnapshotField::Field_QuantizedF32:
+						storeStateValue<F32>(state, field.offset, stream.readQuantized(field.quantizer));
+						break;
+					case SnapshotField::Field_HalfF32:
+						storeStateValue<F32>(state, field.offset, stream.readHalfF32());
+						break;
+					case SnapshotField::Field_F32:
+						storeStateValue<U32>(state, field.offset, stream.readBits32(32));
+						break;
+				}
+			}
+
+			/*
+			Snapshot
+			*/
+
+			Snapshot::Snapshot() : sequence(0), valid(false) {
+
+			}
+
+			void Snapshot::reset(U32 newSequence) {
+				sequence = newSequence;
+				valid = false;
+				entries.clear();
+				stateData.clear();
+			}
+
+			any Snapshot::addObject(U32 id, U32 schemaID, U32 stateSize) {
+				if(!entries.isEmpty() && entries.back().id >= id) {
+					GC_Error("Snapshot::addObject(%u): Objects must be added in increasing order of ID.", id);
+					return NULL;
+				}
+				Entry entry;
+				entry.id = id;
+				entry.schemaID = schemaID;
+				entry.stateOffset = U32(stateData.size());
+				entry.stateSize = stateSize;
+				entries.pushToBack(entry);
+				stateData.setSize(entry.stateOffset + stateSize);
+				memset(stateData.addr() + entry.stateOffset, 0, stateSize);
+				return stateData.addr() + entry.stateOffset;
+			}
+
+			void Snapshot::addObject(U32 id, U32 schemaID, U32 stateSize, cAny state) {
+				any target = addObject(id, schemaID, stateSize);
+				if(target) {
+					memcpy(target, state, stateSize);
+				}
+			}
+
+			U32 Snapshot::getSequence() const {
+				return sequence;
+			}
+
+			bool Snapshot::isValid() const {
+				return valid;
+			}
+
+			void Snapshot::setValid(bool isValid) {
+				valid = isValid;
+			}
+
+			void Snapshot::swap(Snapshot &other) {
+				U32 otherSequence = other.sequence;
+				bool otherValid = other.valid;
+				other.sequence = sequence;
+				other.valid = valid;
+				sequence = otherSequence;
+				valid = otherValid;
+				entries.swap(other.entries);
+				stateData.swap(other.stateData);
+			}
+
+			U32 Snapshot::getObjectCount() const {
+				return U32(entries.size());
+			}
+
+			const Snapshot::Entry &Snapshot::getEntry(U32 index) const {
+				return entries[index];
+			}
+
+			cAny Snapshot::getState(U32 index) const {
+				return stateData.addr() + entries[index].stateOffset;
+			}
+
+			any Snapshot::getState(U32 index) {
+				return stateData.addr() + entries[index].stateOffset;
+			}
+
+			/*
+			SnapshotHistory
+			*/
+
+			SnapshotHistory::SnapshotHistory() {
+
+			}
+
+			Snapshot &SnapshotHistory::beginSnapshot(U32 sequence) {
+				Snapshot &slot = slots[sequence % GALACTIC_SNAPSHOT_HISTORY];
+				slot.reset(sequence);
+				return slot;
+			}
+
+			Snapshot &SnapshotHistory::beginScratch(U32 sequence) {
+				scratch.reset(sequence);
+				return scratch;
+			}
+
+			const Snapshot *SnapshotHistory::commitScratch() {
+				Snapshot &slot = slots[scratch.getSequence() % GALACTIC_SNAPSHOT_HISTORY];
+				slot.swap(scratch);
+				slot.setValid(true);
+				//Keep the memory of the old slot for the next decode, but not it's contents
+				scratch.setValid(false);
+				return &slot;
+			}
+
+			bool SnapshotHistory::isStale(U32 sequence) const {
+				const Snapshot &slot = slots[sequence % GALACTIC_SNAPSHOT_HISTORY];
+				//Sequences wrap, compare the distance between them
+				return slot.isValid() && S32(sequence - slot.getSequence()) < 0;
+			}
+
+			const Snapshot *SnapshotHistory::fetchSnapshot(U32 sequence) const {
+				const Snapshot &slot = slots[sequence % GALACTIC_SNAPSHOT_HISTORY];
+				return (slot.isValid() && slot.getSequence() == sequence) ? &slot : NULL;
+			}
+
+			/*
+			SnapshotBaseline
+			*/
+
+			SnapshotBaseline::SnapshotBaseline() : acknowledged(0), hasAcknowledged(false) {
+
+			}
+
+			void SnapshotBaseline::acknowledge(U32 sequence) {
+				//Sequence numbers wrap around, compare the distance
+				if(!hasAcknowledged || S32(sequence - acknowledged) > 0) {
+					acknowledged = sequence;
+					hasAcknowledged = true;
+				}
+			}
+
+			void SnapshotBaseline::reset() {
+				hasAcknowledged = false;
+			}
+
+			const Snapshot *SnapshotBaseline::fetchBaseline(const SnapshotHistory &history, U32 sequence) const {
+				if(!hasAcknowledged || sequence - acknowledged >= SnapshotHistory::getCapacity()) {
+					return NULL;
+				}
+				return history.fetchSnapshot(acknowledged);
+			}
+
+			/*
+			SnapshotCoder
+			*/
+
+			SnapshotCoder::SnapshotCoder(const DynArray<const SnapshotSchema *> &schemaList) : schemas(schemaList) {
+
+			}
+
+			const SnapshotSchema *SnapshotCoder::fetchSchema(U32 schemaID) const {
+				return schemaID < U32(schemas.size()) ? schemas[schemaID] : NULL;
+			}
+
+			void SnapshotCoder::writeSkip(BitStream &stream, U32 &run) const {
+				if(run) {
+					stream.writeRangedU32(Op_Skip, 0, Op_Max);
+					stream.writeVarU32(run);
+					run = 0;
+				}
+			}
+
+			void SnapshotCoder::write(BitStream &stream, const Snapshot &current, const Snapshot *baseline) const {
+				stream.writeVarU32(current.getSequence());
+				if(stream.writeFlag(baseline != NULL)) {
+					stream.writeVarU32(current.getSequence() - baseline->getSequence());
+				}
+				U32 currentCount = current.getObjectCount(), baselineCount = baseline ? baseline->getObjectCount() : 0;
+				U32 c = 0, b = 0, nextID = 0, skipRun = 0;
+				//Walk both snapshots in order of ID, the reader follows the same walk over its copy of the baseline
+				while(c < currentCount || b < baselineCount) {
+					const Snapshot::Entry *object = c < currentCount ? &current.getEntry(c) : NULL;
+					const Snapshot::Entry *base = b < baselineCount ? &baseline->getEntry(b) : NULL;
+					if(base && (!object || base->id < object->id || (base->id == object->id && base->schemaID != object->schemaID))) {
+						//Removed (or replaced by an object of another type, which is added next)
+						writeSkip(stream, skipRun);
+						stream.writeRangedU32(Op_Remove, 0, Op_Max);
+						nextID = base->id;
+						b++;
+						continue;
+					}
+					const SnapshotSchema *schema = fetchSchema(object->schemaID);
+					if(!schema) {
+						GC_Error("SnapshotCoder::write(): Object %u has an unknown schema (%u), it is not sent.", object->id, object->schemaID);
+						c++;
+						continue;
+					}
+					if(!base || object->id < base->id) {
+						writeSkip(stream, skipRun);
+						stream.writeRangedU32(Op_Add, 0, Op_Max);
+						stream.writeVarU32(object->id - nextID);
+						stream.writeRangedU32(object->schemaID, 0, U32(schemas.size()) - 1);
+						cAny state = current.getState(c);
+						for(U32 i = 0; i < schema->getFieldCount(); i++) {
+							schema->writeField(stream, i, state);
+						}
+					}
+					else {
+						cAny state = current.getState(c), baseState = baseline->getState(b);
+						if(!schema->stateChanged(state, baseState)) {
+							skipRun++;
+						}
+						else {
+							writeSkip(stream, skipRun);
+							stream.writeRangedU32(Op_Update, 0, Op_Max);
+							for(U32 i = 0; i < schema->getFieldCount(); i++) {
+								if(stream.writeFlag(schema->fieldChanged(i, state, baseState))) {
+									schema->writeField(stream, i, state);
+								}
+							}
+						}
+						b++;
+					}
+					nextID = object->id + 1;
+					c++;
+				}
+				//A pending run of unchanged objects is the rest of the baseline, the end of the snapshot covers it
+				stream.writeRangedU32(Op_Skip, 0, Op_Max);
+				stream.writeVarU32(0);
+			}
+
+			const Snapshot *SnapshotCoder::read(BitStream &stream, SnapshotHistory &history) const {
+				U32 sequence = stream.readVarU32();
+				const Snapshot *baseline = NULL;
+				if(stream.readFlag()) {
+					U32 distance = stream.readVarU32();
+					//A baseline this far back would share the slot of the snapshot being read
+					if(distance == 0 || distance >= SnapshotHistory::getCapacity()) {
+						return NULL;
+					}
+					baseline = history.fetchSnapshot(sequence - distance);
+					if(!baseline) {
+						return NULL;
+					}
+				}
+				if(!stream.isValid() || history.isStale(sequence)) {
+					return NULL;
+				}
+				//Decode into the scratch snapshot, the slot (and the snapshot it still holds) is only replaced once this one is known to be good.
+				Snapshot &snapshot = history.beginScratch(sequence);
+				U32 baselineCount = baseline ? baseline->getObjectCount() : 0, b = 0, nextID = 0;
+				while(true) {
+					U32 operation = stream.readRangedU32(0, Op_Max);
+					if(!stream.isValid()) {
+						return NULL;
+					}
+					if(operation == Op_Skip) {
+						U32 run = stream.readVarU32();
+						U32 end = run ? b + run : baselineCount;
+						if(end > baselineCount || end < b) {
+							return NULL;
+						}
+						for(; b < end; b++) {
+							const Snapshot::Entry &base = baseline->getEntry(b);
+							snapshot.addObject(base.id, base.schemaID, base.stateSize, baseline->getState(b));
+							nextID = base.id + 1;
+						}
+						if(!run) {
+							break;
+						}
+					}
+					else if(operation == Op_Update) {
+						if(b >= baselineCount) {
+							return NULL;
+						}
+						const Snapshot::Entry &base = baseline->getEntry(b);
+						const SnapshotSchema *schema = fetchSchema(base.schemaID);
+						if(!schema) {
+							return NULL;
+						}
+						any state = snapshot.addObject(base.id, base.schemaID, base.stateSize);
+						memcpy(state, baseline->getState(b), base.stateSize);
+						for(U32 i = 0; i < schema->getFieldCount(); i++) {
+							if(stream.readFlag()) {
+								schema->readField(stream, i, state);
+							}
+						}
+						nextID = base.id + 1;
+						b++;
+					}
+					else if(operation == Op_Remove) {
+						if(b >= baselineCount) {
+							return NULL;
+						}
+						nextID = baseline->getEntry(b).id;
+						b++;
+					}
+					else {
+						U32 id = nextID + stream.readVarU32();
+						U32 schemaID = stream.readRangedU32(0, U32(schemas.size()) - 1);
+						const SnapshotSchema *schema = fetchSchema(schemaID);
+						//IDs have to keep increasing, and stay below the next baseline object (which isn't removed yet)
+						if(!schema || id < nextID || (b < baselineCount && id >= baseline->getEntry(b).id) || !stream.isValid()) {
+							return NULL;
+						}
+						any state = snapshot.addObject(id, schemaID, schema->getStateSize());
+						for(U32 i = 0; i < schema->getFieldCount(); i++) {
+							schema->readField(stream, i, state);
+						}
+						nextID = id + 1;
+					}
+				}
+				if(!stream.isValid()) {
+					return NULL;
+				}
+				return history.commitScratch();
+			}
+
+		};
+
+	};
+
+};
\ No newline at end of file
@@ -0,0 +1,279 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Stream/snapshot.h
+* Delta compressed object state snapshots against acknowledged baselines
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_SNAPSHOT
+#define GALACTIC_INTERNAL_SNAPSHOT
+
+#include "bitStream.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Streams {
+
+			/*
+			SnapshotField: A single replicated field of an object's state, see SnapshotSchema.
+			*/
+			struct SnapshotField {
+				//How the field is stored in the state and sent over the BitStream
+				enum Type {
+					//U32 sent with a fixed bit count (1 - 32)
+					Field_U32,
+					//U32 sent as a varint
+					Field_VarU32,
+					//S32 sent as a zigzag varint
+					Field_VarS32,
+					//F32 sent through a FloatQuantizer
+					Field_QuantizedF32,
+					//F32 sent as a half float
+					Field_HalfF32,
+					//F32 sent as is
+					Field_F32,
+				};
+
+				//The type of the field
+				Type type;
+				//The byte offset of the field in the state
+				U32 offset;
+				//The bit count of a Field_U32
+				U32 bitCount;
+				//The quantizer of a Field_QuantizedF32
+				FloatQuantizer quantizer;
+			};
+
+			/*
+			SnapshotSchema: Describes the state of one type of replicated object, a block of stateSize bytes (usually a plain struct) and the fields in it
+			 that are sent. A field counts as changed when the value it would be sent as changes, so a quantized value moving less than the precision or
+			 bits above the bit count of a Field_U32 don't cost anything.
+			*/
+			class SnapshotSchema {
+				public:
+					/* Public Class Methods */
+					//Constructor
+					SnapshotSchema(U32 stateSize);
+					//Add a U32 field sent with bitCount bits
+					SnapshotSchema &addU32(U32 offset, U32 bitCount);
+					//Add a U32 field sent as a varint
+					SnapshotSchema &addVarU32(U32 offset);
+					//Add a S32 field sent as a zigzag varint
+					SnapshotSchema &addVarS32(U32 offset);
+					//Add a F32 field sent through a quantizer
+					SnapshotSchema &addQuantizedF32(U32 offset, const FloatQuantizer &quantizer);
+					//Add a F32 field sent as a half float
+					SnapshotSchema &addHalfF32(U32 offset);
+					//Add a F32 field sent in full
+					SnapshotSchema &addF32(U32 offset);
+					//Fetch the size of the state
+					U32 getStateSize() const;
+					//Fetch the amount of fields
+					U32 getFieldCount() const;
+					//Fetch a field
+					const SnapshotField &getField(U32 index) const;
+					//Test if any field would be sent differently for the two states
+					bool stateChanged(cAny state, cAny baseline) const;
+					//Test if a field would be sent differently for the two states
+					bool fieldChanged(U32 index, cAny state, cAny baseline) const;
+					//Write a field of a state to the stream
+					void writeField(BitStream &stream, U32 index, cAny state) const;
+					//Read a field into a state
+					void readField(BitStream &stream, U32 index, any state) const;
+
+				private:
+					/* Private Class Methods */
+					//Add a field of a type
+					SnapshotSchema &addField(SnapshotField::Type type, U32 offset, U32 size);
+
+					/* Private Class Members */
+					//The size of the state
+					U32 stateSize;
+					//The fields
+					DynArray<SnapshotField> fields;
+			};
+
+			/*
+			Snapshot: The state of all replicated objects at one point in time (one sequence number). Objects are kept in order of their ID, and each one
+			 has the ID of its schema (an index to the schema list given to the SnapshotCoder) and a block of state.
+			*/
+			class Snapshot {
+				public:
+					/* Public Class Members */
+					//An object in the snapshot
+					struct Entry {
+						//The object's ID
+						U32 id;
+						//The object's schema
+						U32 schemaID;
+						//The location of the state in the snapshot's state buffer
+						U32 stateOffset;
+						//The size of the state
+						U32 stateSize;
+					};
+
+					/* Public Class Methods */
+					//Constructor
+					Snapshot();
+					//Empty the snapshot (keeping the memory) and give it a sequence number
+					void reset(U32 newSequence);
+					//Add an object, IDs must be added in increasing order. Returns the cleared state to fill in, valid until the next addObject().
+					any addObject(U32 id, U32 schemaID, U32 stateSize);
+					//Add an object with a copy of another state
+					void addObject(U32 id, U32 schemaID, U32 stateSize, cAny state);
+					//Fetch the sequence number
+					U32 getSequence() const;
+					//Is the snapshot complete? (A snapshot that failed to decode is not)
+					bool isValid() const;
+					//Mark the snapshot as complete
+					void setValid(bool valid);
+					//Exchange the contents of two snapshots without copying the state
+					void swap(Snapshot &other);
+					//Fetch the amount of objects
+					U32 getObjectCount() const;
+					//Fetch an object
+					const Entry &getEntry(U32 index) const;
+					//Fetch the state of an object
+					cAny getState(U32 index) const;
+					//Fetch the state of an object
+					any getState(U32 index);
+
+				private:
+					/* Private Class Members */
+					//The sequence number
+					U32 sequence;
+					//Is it complete?
+					bool valid;
+					//The objects, in order of ID
+					DynArray<Entry> entries;
+					//The state of all objects
+					DynArray<U8> stateData;
+			};
+
+			/*
+			SnapshotHistory: A ring of the last GALACTIC_SNAPSHOT_HISTORY snapshots by sequence number. The server keeps one for the world (shared by all
+			 clients) and each client keeps one of the snapshots it received, these are the baselines deltas are written against.
+			*/
+			class SnapshotHistory {
+				public:
+					/* Public Class Methods */
+					//Constructor
+					SnapshotHistory();
+					//Fetch the slot for a sequence number, reset to it. The snapshot is not valid until setValid(true) is called.
+					Snapshot &beginSnapshot(U32 sequence);
+					//Fetch the scratch snapshot, reset to a sequence number. Snapshots are decoded here so a malformed one doesn't replace a slot.
+					Snapshot &beginScratch(U32 sequence);
+					//Move the scratch snapshot into the slot of it's sequence and mark it valid, returns the stored snapshot
+					const Snapshot *commitScratch();
+					//Test if a sequence is older than the valid snapshot in it's slot, such a snapshot arrived out of order and is dropped
+					bool isStale(U32 sequence) const;
+					//Fetch the snapshot of a sequence number, or NULL if it is no longer (or never was) in the history
+					const Snapshot *fetchSnapshot(U32 sequence) const;
+					//Fetch the amount of snapshots kept
+					SFIN U32 getCapacity() {
+						return GALACTIC_SNAPSHOT_HISTORY;
+					}
+
+				private:
+					/* Private Class Members */
+					//The snapshots, by sequence % GALACTIC_SNAPSHOT_HISTORY
+					Snapshot slots[GALACTIC_SNAPSHOT_HISTORY];
+					//The snapshot being decoded
+					Snapshot scratch;
+			};
+
+			/*
+			SnapshotBaseline: The server's record of the newest snapshot a client acknowledged, which is the baseline of the next delta. When the
+			 acknowledged snapshot has left the history (or reset() is called, ex: after the client reports it lost the baseline) full state is sent.
+			*/
+			class SnapshotBaseline {
+				public:
+					/* Public Class Methods */
+					//Constructor
+					SnapshotBaseline();
+					//The client acknowledged a snapshot, older acknowledgements than the current one are ignored
+					void acknowledge(U32 sequence);
+					//Forget the baseline, the next snapshot is sent in full
+					void reset();
+					//Fetch the baseline to write the snapshot of sequence against, NULL if full state has to be sent
+					const Snapshot *fetchBaseline(const SnapshotHistory &history, U32 sequence) const;
+
+				private:
+					/* Private Class Members */
+					//The newest acknowledged sequence
+					U32 acknowledged;
+					//Has anything been acknowledged?
+					bool hasAcknowledged;
+			};
+
+			/*
+			SnapshotCoder: Writes a snapshot as a delta of a baseline, and reads it back. Objects are compared to the baseline in ID order, a run of
+			 unchanged objects is sent as a single skip (the run that ends the snapshot costs nothing at all), changed objects send each field behind a
+			 changed flag, and objects that aren't in the baseline are sent in full. Without a baseline every object is sent in full.
+			*/
+			class SnapshotCoder {
+				public:
+					/* Public Class Methods */
+					//Constructor, the schemas are indexed by the schema ID of the objects and have to be the same on both ends
+					SnapshotCoder(const DynArray<const SnapshotSchema *> &schemas);
+					//Write current to the stream as a delta of baseline (or in full, if baseline is NULL)
+					void write(BitStream &stream, const Snapshot &current, const Snapshot *baseline) const;
+					/* Read a snapshot into the history, returns it or NULL if the stream is malformed, the snapshot is older than the one in its slot, or the
+					    baseline it was written against isn't in the history (the server should then be told to reset() the baseline). The history is only
+					    changed when NULL isn't returned. Acknowledge the sequence of the returned snapshot to the server. */
+					const Snapshot *read(BitStream &stream, SnapshotHistory &history) const;
+
+				private:
+					/* Private Class Members */
+					//The operations of the object stream
+					enum Operations {
+						//A run of unchanged objects (varint length), a run of 0 ends the snapshot with the rest of the baseline unchanged
+						Op_Skip,
+						//The next baseline object changed, each field follows behind a changed flag
+						Op_Update,
+						//The next baseline object was removed
+						Op_Remove,
+						//A new object (varint ID delta, schema ID, then every field)
+						Op_Add,
+						//The largest operation
+						Op_Max = Op_Add
+					};
+
+					/* Private Class Methods */
+					//Write a run of skipped objects
+					void writeSkip(BitStream &stream, U32 &run) const;
+					//Fetch the schema of an ID, NULL if it isn't valid
+					const SnapshotSchema *fetchSchema(U32 schemaID) const;
+
+					/* Private Class Members */
+					//The schemas by ID
+					DynArray<const SnapshotSchema *> schemas;
+			};
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_SNAPSHOT
\ No newline at end of file
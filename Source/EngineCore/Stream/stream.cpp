@@ -79,11 +79,8 @@ namespace Galactic {
 			}
 
 			void Stream::readString(C8 strBuff[256]) {
-				U8 readLen;
-				read(&readLen);
-
-				read(strBuff, (S32)readLen);
-				strBuff[readLen] = NULL;
+				//writeString() stores a U64 length, read it the same way
+				readString(255, strBuff);
 			}
 
 			void Stream::readString(U64 length, UTF8 strBuff) {
@@ -345,17 +342,19 @@ namespace Galactic {
 
 			void Stream::__write(strRef str) {
 				U32 writeLen = str.length();
-				if(writeLen < 256) {
+				//255 is the marker of a U16 length, so it can't be a length itself
+				if(writeLen < 255) {
 					write(U8(writeLen));
 				}
 				else {
 					write(U8(255));
-					if(writeLen > (1 << 16)) {
-						//ToDo: Throw an assert error here
+					if(writeLen > 0xFFFF) {
+						if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+							Galactic::Console::warn("Stream::__write(): The String is too long (%u), only the first 65535 characters are written.", writeLen);
+						}
+						writeLen = 0xFFFF;
 					}
-					//Set the correct length (16 bits) - 1 (NULL Termination) & write it.
-					writeLen &= (1 << 16) - 1;
-					write((U16)writeLen);
+					write(U16(writeLen));
 				}
 				//Write the String
 				write(str.c_str(), writeLen);
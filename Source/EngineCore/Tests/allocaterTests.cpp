@@ -0,0 +1,197 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/allocaterTests.cpp
+* Cross-thread allocation and free tests of the installed allocater
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			//The amount of blocks handed across in each direction
+			static const U32 allocaterTestBlockCount = 512;
+
+			//The size of a test block, every eighth block is larger than the size classes and comes from a page run
+			static SIZE_T allocaterTestSize(U32 index) {
+				return (index % 8) == 7 ? 40000 + index : 16 + ((index * 37) % 2000);
+			}
+
+			//Fill a block with a pattern unique to it's index
+			static void fillAllocaterTestBlock(any block, SIZE_T size, U32 index) {
+				U8 *bytes = (U8 *)block;
+				for(SIZE_T i = 0; i < size; i++) {
+					bytes[i] = U8((index * 13) ^ i);
+				}
+			}
+
+			//Test if a block still holds the pattern written by fillAllocaterTestBlock()
+			static bool allocaterTestBlockIntact(cAny block, SIZE_T size, U32 index) {
+				const U8 *bytes = (const U8 *)block;
+				for(SIZE_T i = 0; i < size; i++) {
+					if(bytes[i] != U8((index * 13) ^ i)) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			/*
+			AllocaterTestThread: Checks and frees the blocks allocated by the test's thread, then allocates the same amount of blocks for the test's thread to free.
+			*/
+			class AllocaterTestThread : public ObjectThread {
+				public:
+					/* Constructor */
+					//Creation Constructor
+					AllocaterTestThread(any *blocks) : blocks(blocks), intact(true), allocated(true), finished(0) { }
+
+					/* Public Class Methods */
+					//Free the handed blocks, then replace them with blocks allocated on this thread
+					virtual U32 run() {
+						for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+							intact = intact && allocaterTestBlockIntact(blocks[i], allocaterTestSize(i), i);
+							Memory::gfree(blocks[i]);
+						}
+						for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+							blocks[i] = Memory::gmallocTagged(allocaterTestSize(i), MemoryTracker::Tag_Network);
+							if(blocks[i] == NULL) {
+								allocated = false;
+								continue;
+							}
+							fillAllocaterTestBlock(blocks[i], allocaterTestSize(i), i + allocaterTestBlockCount);
+						}
+						return 0;
+					}
+					//The thread is done with this object once stop() is called
+					virtual void stop() {
+						PlatformAtomics::exchange(&finished, 1);
+					}
+
+					/* Public Class Members */
+					//The handed blocks, replaced by the ones allocated by the thread
+					any *blocks;
+					//Set if every handed block still held it's pattern
+					bool intact;
+					//Set if every allocation made by the thread succeeded
+					bool allocated;
+					//Set once the thread no longer touches this object
+					volatile S32 finished;
+			};
+
+			bool runAllocaterTests() {
+				TestContext test("Allocater");
+				Memory::gfree(Memory::gmalloc(1));
+				#if GALACTIC_MEMORY_TRACKING == 1
+					S64 assetBase = MemoryTracker::fetchLiveBytes(MemoryTracker::Tag_Assets);
+					S64 networkBase = MemoryTracker::fetchLiveBytes(MemoryTracker::Tag_Network);
+				#endif
+				any blocks[allocaterTestBlockCount];
+				bool allocated = true;
+				for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+					blocks[i] = Memory::gmallocTagged(allocaterTestSize(i), MemoryTracker::Tag_Assets);
+					if(blocks[i] == NULL) {
+						allocated = false;
+						break;
+					}
+					fillAllocaterTestBlock(blocks[i], allocaterTestSize(i), i);
+				}
+				GALACTIC_TEST(allocated);
+				if(!allocated) {
+					for(U32 i = 0; i < allocaterTestBlockCount && blocks[i] != NULL; i++) {
+						Memory::gfree(blocks[i]);
+					}
+					return test.finish();
+				}
+				//The thread deletes itself when it exits, so the pointer is never used after init()
+				AllocaterTestThread worker(blocks);
+				if(ContinualThread::init("AllocaterTestThread", &worker, false, true) != NULL) {
+					//Keep this thread's magazine busy while the other thread frees into it
+					for(U32 i = 0; worker.finished == 0; i++) {
+						Memory::gfree(Memory::gmalloc(16 + (i % 512)));
+						if((i % 256) == 255) {
+							PlatformProcess::sleep(0.001f);
+						}
+					}
+				}
+				else {
+					//Single threaded platforms (or a failed thread) run the exchange here
+					worker.run();
+					worker.stop();
+				}
+				GALACTIC_TEST(worker.intact);
+				GALACTIC_TEST(worker.allocated);
+				GALACTIC_TEST(_GAllocater->validateHeap());
+				//The frees made by the other thread were charged back to the tag the blocks were allocated with
+				#if GALACTIC_MEMORY_TRACKING == 1
+					GALACTIC_TEST(MemoryTracker::fetchLiveBytes(MemoryTracker::Tag_Assets) == assetBase);
+				#endif
+				//Free the other thread's blocks here, their magazine may already be abandoned
+				bool intact = true, tagged = true;
+				S64 networkBytes = 0;
+				for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+					if(blocks[i] == NULL) {
+						continue;
+					}
+					intact = intact && allocaterTestBlockIntact(blocks[i], allocaterTestSize(i), i + allocaterTestBlockCount);
+					tagged = tagged && _GAllocater->fetchTag(blocks[i]) == (GALACTIC_MEMORY_TRACKING == 1 ? (U32)MemoryTracker::Tag_Network : 0);
+					networkBytes += (S64)_GAllocater->usableSize(blocks[i]);
+				}
+				GALACTIC_TEST(intact);
+				GALACTIC_TEST(tagged);
+				#if GALACTIC_MEMORY_TRACKING == 1
+					GALACTIC_TEST(MemoryTracker::fetchLiveBytes(MemoryTracker::Tag_Network) == networkBase + networkBytes);
+				#endif
+				for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+					Memory::gfree(blocks[i]);
+				}
+				#if GALACTIC_MEMORY_TRACKING == 1
+					GALACTIC_TEST(MemoryTracker::fetchLiveBytes(MemoryTracker::Tag_Network) == networkBase);
+				#endif
+				//Allocate the same sizes again, which drains the blocks freed by the other thread back into this thread's magazine
+				for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+					blocks[i] = Memory::gmalloc(allocaterTestSize(i));
+					if(blocks[i] != NULL) {
+						fillAllocaterTestBlock(blocks[i], allocaterTestSize(i), i);
+					}
+				}
+				intact = true;
+				for(U32 i = 0; i < allocaterTestBlockCount; i++) {
+					intact = intact && blocks[i] != NULL && allocaterTestBlockIntact(blocks[i], allocaterTestSize(i), i);
+					Memory::gfree(blocks[i]);
+				}
+				GALACTIC_TEST(intact);
+				GALACTIC_TEST(_GAllocater->validateHeap());
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,357 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/bitStreamTests.cpp
+* BitStream packing, variable length code and float encoding tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+#include "../Stream/bitStream.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			using namespace Streams;
+
+			//The size of the streams used by the packing tests, and of the guard bytes behind them which must never be written
+			static const U32 bitTestStreamBytes = 16;
+			static const U32 bitTestGuardBytes = 8;
+			static const U8 bitTestGuardValue = 0xCD;
+
+			//Fetch the next test value (xorshift, so every run uses the same values)
+			static U64 nextBitTestValue(U64 &state) {
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				return state;
+			}
+
+			//Fetch the mask of the low bitCount bits
+			static U64 bitTestMask(U32 bitCount) {
+				return bitCount >= 64 ? ~U64DEF(0) : ((U64DEF(1) << bitCount) - 1);
+			}
+
+			//Test if the guard bytes behind a test stream are untouched
+			static bool bitTestGuardIntact(const U8 *buffer) {
+				for(U32 i = 0; i < bitTestGuardBytes; i++) {
+					if(buffer[bitTestStreamBytes + i] != bitTestGuardValue) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			//Unaligned values of every width ending on (or just before) the last bit of the buffer, followed by a write that doesn't fit
+			static void testWritesNearEnd(TestContext &test) {
+				U8 buffer[bitTestStreamBytes + bitTestGuardBytes];
+				U64 state = U64DEF(0x9E3779B97F4A7C15);
+				U32 mismatches = 0, invalid = 0, overruns = 0;
+				for(U32 bitCount = 1; bitCount <= 64; bitCount++) {
+					for(U32 slack = 0; slack < 8; slack++) {
+						U64 value = nextBitTestValue(state) & bitTestMask(bitCount);
+						U64 start = bitTestStreamBytes * 8 - bitCount - slack;
+						memset(buffer, bitTestGuardValue, sizeof(buffer));
+						BitStream writer(buffer, bitTestStreamBytes);
+						writer.setCurrentPos(start);
+						if(bitCount <= 32) {
+							writer.writeBits32(U32(value), bitCount);
+						}
+						else {
+							writer.writeBits64(value, bitCount);
+						}
+						//One more bit than the slack leaves room for
+						writer.writeBits32(0, slack + 1);
+						if(writer.isValid() || writer.getCurrentPos() != S64(start + bitCount)) {
+							invalid++;
+						}
+						if(!bitTestGuardIntact(buffer)) {
+							overruns++;
+						}
+						BitStream reader(buffer, bitTestStreamBytes);
+						reader.setCurrentPos(start);
+						U64 read = bitCount <= 32 ? reader.readBits32(bitCount) : reader.readBits64(bitCount);
+						if(read != value || !reader.isValid()) {
+							mismatches++;
+						}
+					}
+				}
+				GALACTIC_TEST(mismatches == 0);
+				GALACTIC_TEST(invalid == 0);
+				GALACTIC_TEST(overruns == 0);
+
+				//Byte buffers at every bit offset, ending on the last bit
+				U8 source[bitTestStreamBytes], copy[bitTestStreamBytes];
+				for(U32 i = 0; i < bitTestStreamBytes; i++) {
+					source[i] = U8(nextBitTestValue(state));
+				}
+				mismatches = 0;
+				overruns = 0;
+				for(U32 offset = 0; offset < 8; offset++) {
+					S64 bitCount = (bitTestStreamBytes - 1) * 8 - offset + 3;
+					memset(buffer, bitTestGuardValue, sizeof(buffer));
+					BitStream writer(buffer, bitTestStreamBytes);
+					writer.setCurrentPos(bitTestStreamBytes * 8 - bitCount);
+					writer.writeBits(source, bitCount);
+					if(!writer.isValid() || !bitTestGuardIntact(buffer)) {
+						overruns++;
+					}
+					memset(copy, 0, sizeof(copy));
+					BitStream reader(buffer, bitTestStreamBytes);
+					reader.setCurrentPos(bitTestStreamBytes * 8 - bitCount);
+					reader.readBits(copy, bitCount);
+					S64 wholeBytes = bitCount >> 3;
+					if(memcmp(copy, source, (size_t)wholeBytes) != 0 || (copy[wholeBytes] != (source[wholeBytes] & bitTestMask(U32(bitCount & 7))))) {
+						mismatches++;
+					}
+				}
+				GALACTIC_TEST(mismatches == 0);
+				GALACTIC_TEST(overruns == 0);
+			}
+
+			//Reads that run into the end of the stream fail, leave the position and output alone, and mark the stream invalid
+			static void testReadsAtEnd(TestContext &test) {
+				U8 buffer[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+				BitStream bits(buffer, sizeof(buffer));
+				GALACTIC_TEST(bits.readBits32(30) == 0x3FFFFFFF);
+				GALACTIC_TEST(bits.isValid());
+				GALACTIC_TEST(bits.readBits32(3) == 0);
+				GALACTIC_TEST(!bits.isValid());
+				GALACTIC_TEST(bits.getCurrentPos() == 30);
+
+				BitStream wide(buffer, sizeof(buffer));
+				GALACTIC_TEST(wide.readBits64(33) == 0);
+				GALACTIC_TEST(!wide.isValid());
+
+				BitStream flags(buffer, 1);
+				U32 set = 0;
+				for(U32 i = 0; i < 8; i++) {
+					set += flags.readFlag() ? 1 : 0;
+				}
+				GALACTIC_TEST(set == 8 && flags.isValid());
+				GALACTIC_TEST(!flags.readFlag());
+				GALACTIC_TEST(!flags.isValid());
+
+				U8 out[8] = { 0 };
+				BitStream bytes(buffer, sizeof(buffer));
+				bytes.readBits(out, 33);
+				GALACTIC_TEST(!bytes.isValid());
+				GALACTIC_TEST(out[0] == 0 && out[4] == 0);
+			}
+
+			//Read a varint from raw bytes, returns if the stream is still valid
+			static bool readVarU32From(const U8 *bytes, U32 length, U32 &value) {
+				U8 buffer[16];
+				memcpy(buffer, bytes, length);
+				BitStream stream(buffer, length);
+				value = stream.readVarU32();
+				return stream.isValid();
+			}
+
+			//Read a 64 bit varint from raw bytes, returns if the stream is still valid
+			static bool readVarU64From(const U8 *bytes, U32 length, U64 &value) {
+				U8 buffer[16];
+				memcpy(buffer, bytes, length);
+				BitStream stream(buffer, length);
+				value = stream.readVarU64();
+				return stream.isValid();
+			}
+
+			//Varint round trips at an unaligned position, and malformed varints
+			static void testVarints(TestContext &test) {
+				static const U32 unsignedValues[] = { 0, 1, 127, 128, 16383, 16384, 0x0FFFFFFF, 0x10000000, 0xFFFFFFFF };
+				static const S32 signedValues[] = { 0, -1, 1, -64, 63, -65, 64, S32(0x80000000), 0x7FFFFFFF };
+				static const U64 longValues[] = { 0, 0x7F, U64DEF(1) << 63, ~U64DEF(0) };
+				U8 buffer[128];
+				BitStream writer(buffer, sizeof(buffer));
+				writer.writeBits32(5, 3);
+				for(U32 i = 0; i < getArrayCount(unsignedValues); i++) {
+					writer.writeVarU32(unsignedValues[i]);
+				}
+				for(U32 i = 0; i < getArrayCount(signedValues); i++) {
+					writer.writeVarS32(signedValues[i]);
+				}
+				for(U32 i = 0; i < getArrayCount(longValues); i++) {
+					writer.writeVarU64(longValues[i]);
+				}
+				GALACTIC_TEST(writer.isValid());
+				BitStream reader(buffer, sizeof(buffer));
+				GALACTIC_TEST(reader.readBits32(3) == 5);
+				U32 mismatches = 0;
+				for(U32 i = 0; i < getArrayCount(unsignedValues); i++) {
+					mismatches += reader.readVarU32() != unsignedValues[i] ? 1 : 0;
+				}
+				for(U32 i = 0; i < getArrayCount(signedValues); i++) {
+					mismatches += reader.readVarS32() != signedValues[i] ? 1 : 0;
+				}
+				for(U32 i = 0; i < getArrayCount(longValues); i++) {
+					mismatches += reader.readVarU64() != longValues[i] ? 1 : 0;
+				}
+				GALACTIC_TEST(mismatches == 0);
+				GALACTIC_TEST(reader.isValid() && reader.getCurrentPos() == writer.getCurrentPos());
+
+				//The largest U32 fills 4 bits of the fifth group, anything above them or a sixth group can't come from writeVarU32()
+				U32 value = 0;
+				static const U8 largest[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+				static const U8 overflow[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x1F };
+				static const U8 highBits[] = { 0x80, 0x80, 0x80, 0x80, 0x70 };
+				static const U8 sixGroups[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+				static const U8 truncated[] = { 0x80, 0x80 };
+				GALACTIC_TEST(readVarU32From(largest, sizeof(largest), value) && value == 0xFFFFFFFF);
+				GALACTIC_TEST(!readVarU32From(overflow, sizeof(overflow), value));
+				GALACTIC_TEST(!readVarU32From(highBits, sizeof(highBits), value));
+				GALACTIC_TEST(!readVarU32From(sixGroups, sizeof(sixGroups), value));
+				GALACTIC_TEST(!readVarU32From(truncated, sizeof(truncated), value));
+
+				//The tenth group of a U64 holds a single bit
+				U64 longValue = 0;
+				U8 longBytes[11];
+				memset(longBytes, 0xFF, sizeof(longBytes));
+				longBytes[9] = 0x01;
+				GALACTIC_TEST(readVarU64From(longBytes, 10, longValue) && longValue == ~U64DEF(0));
+				longBytes[9] = 0x03;
+				GALACTIC_TEST(!readVarU64From(longBytes, 10, longValue));
+				memset(longBytes, 0x80, sizeof(longBytes));
+				longBytes[10] = 0x00;
+				GALACTIC_TEST(!readVarU64From(longBytes, 11, longValue));
+			}
+
+			//Elias-gamma and exponential-Golomb round trips, and malformed codes
+			static void testGammaCodes(TestContext &test) {
+				static const U32 orders[] = { 0, 1, 5, 31 };
+				static const U32 values[] = { 0, 1, 2, 1000, 0x7FFFFFFF, 0xFFFFFFFF };
+				U8 buffer[512];
+				BitStream writer(buffer, sizeof(buffer));
+				for(U32 value = 1; value <= 64; value++) {
+					writer.writeEliasGamma(value);
+				}
+				writer.writeEliasGamma(0xFFFFFFFF);
+				for(U32 k = 0; k < getArrayCount(orders); k++) {
+					for(U32 i = 0; i < getArrayCount(values); i++) {
+						writer.writeExpGolomb(values[i], orders[k]);
+					}
+				}
+				GALACTIC_TEST(writer.isValid());
+				BitStream reader(buffer, sizeof(buffer));
+				U32 mismatches = 0;
+				for(U32 value = 1; value <= 64; value++) {
+					mismatches += reader.readEliasGamma() != value ? 1 : 0;
+				}
+				mismatches += reader.readEliasGamma() != 0xFFFFFFFF ? 1 : 0;
+				for(U32 k = 0; k < getArrayCount(orders); k++) {
+					for(U32 i = 0; i < getArrayCount(values); i++) {
+						mismatches += reader.readExpGolomb(orders[k]) != values[i] ? 1 : 0;
+					}
+				}
+				GALACTIC_TEST(mismatches == 0);
+				GALACTIC_TEST(reader.isValid() && reader.getCurrentPos() == writer.getCurrentPos());
+
+				//A run of zeros longer than any code
+				U8 zeros[8] = { 0 };
+				BitStream gammaZeros(zeros, sizeof(zeros));
+				gammaZeros.readEliasGamma();
+				GALACTIC_TEST(!gammaZeros.isValid());
+				BitStream golombZeros(zeros, sizeof(zeros));
+				golombZeros.readExpGolomb(0);
+				GALACTIC_TEST(!golombZeros.isValid());
+
+				//32 zeros make a valid gamma prefix for exp-Golomb, but the value after it doesn't fit in a U32
+				U8 large[16];
+				BitStream largeWriter(large, sizeof(large));
+				largeWriter.writeBits32(0, 32);
+				largeWriter.writeFlag(true);
+				largeWriter.writeBits32(0xFFFFFFFF, 32);
+				BitStream largeGolomb(large, sizeof(large));
+				largeGolomb.readExpGolomb(0);
+				GALACTIC_TEST(!largeGolomb.isValid());
+				BitStream largeGamma(large, sizeof(large));
+				largeGamma.readEliasGamma();
+				GALACTIC_TEST(!largeGamma.isValid());
+
+				//A code cut off by the end of the stream
+				U8 cut[8];
+				BitStream cutWriter(cut, sizeof(cut));
+				cutWriter.writeEliasGamma(100000);
+				BitStream cutReader(cut, 2);
+				cutReader.readEliasGamma();
+				GALACTIC_TEST(!cutReader.isValid());
+			}
+
+			//Half float conversions and round trips
+			static void testHalfFloats(TestContext &test) {
+				//Every half converts to a F32 and back unchanged (NaNs stay NaNs)
+				U32 mismatches = 0;
+				for(U32 half = 0; half < 0x10000; half++) {
+					U16 back = BitStream::floatToHalf(BitStream::halfToFloat(U16(half)));
+					bool isNaN = (half & 0x7C00) == 0x7C00 && (half & 0x3FF) != 0;
+					if(isNaN ? ((back & 0x7C00) != 0x7C00 || (back & 0x3FF) == 0) : back != half) {
+						mismatches++;
+					}
+				}
+				GALACTIC_TEST(mismatches == 0);
+
+				//Range and rounding (to nearest even)
+				GALACTIC_TEST(BitStream::halfToFloat(BitStream::floatToHalf(65504.0f)) == 65504.0f);
+				GALACTIC_TEST(BitStream::floatToHalf(65520.0f) == 0x7C00);
+				GALACTIC_TEST(BitStream::floatToHalf(-1e10f) == 0xFC00);
+				GALACTIC_TEST(BitStream::floatToHalf(1.0f + 1.0f / 2048.0f) == 0x3C00);
+				GALACTIC_TEST(BitStream::floatToHalf(1.0f + 3.0f / 2048.0f) == 0x3C02);
+				GALACTIC_TEST(BitStream::floatToHalf(5.9604645e-8f) == 0x0001);
+				GALACTIC_TEST(BitStream::floatToHalf(2.0e-8f) == 0x0000);
+				GALACTIC_TEST(BitStream::floatToHalf(-0.0f) == 0x8000);
+
+				//Through a stream, at an unaligned position
+				U8 buffer[8];
+				BitStream writer(buffer, sizeof(buffer));
+				writer.writeFlag(true);
+				writer.writeHalfF32(-3.140625f);
+				writer.writeHalfF32(0.1f);
+				writer.writeHalfF32(100000.0f);
+				BitStream reader(buffer, sizeof(buffer));
+				GALACTIC_TEST(reader.readFlag());
+				GALACTIC_TEST(reader.readHalfF32() == -3.140625f);
+				F32 tenth = reader.readHalfF32();
+				GALACTIC_TEST(tenth > 0.1f - 0.1f / 2048.0f && tenth < 0.1f + 0.1f / 2048.0f);
+				GALACTIC_TEST(BitStream::floatToHalf(reader.readHalfF32()) == 0x7C00);
+				GALACTIC_TEST(reader.isValid() && reader.getCurrentPos() == 49);
+			}
+
+			bool runBitStreamTests() {
+				TestContext test("BitStream");
+				testWritesNearEnd(test);
+				testReadsAtEnd(test);
+				testVarints(test);
+				testGammaCodes(test);
+				testHalfFloats(test);
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/charConvTests.cpp
+* CharConv shortest round trip and parsing tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			//The amount of random values sent through each round trip
+			static const U32 charConvTestRounds = 20000;
+
+			//Step the xorshift generator used to pick the test values
+			static U64 nextCharConvTestValue(U64 &state) {
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				return state;
+			}
+
+			//Test if a value is written as the expected text
+			template <typename T> static bool charConvWrites(T value, UTF16 expected) {
+				C8 buffer[CharConv::MaxChars];
+				U32 length = CharConv::toChars(buffer, value);
+				return StringView(buffer, length) == StringView(expected);
+			}
+
+			//Test if a value is written and parsed back to the same bits
+			template <typename T, typename Bits> static bool charConvRoundTrips(T value) {
+				C8 buffer[CharConv::MaxChars];
+				U32 length = CharConv::toChars(buffer, value);
+				T result = T(0);
+				CharConv::ParseResult r = CharConv::fromChars(buffer, buffer + length, result);
+				Bits sent, received;
+				Memory::gmemcpy(&sent, &value, sizeof(T));
+				Memory::gmemcpy(&received, &result, sizeof(T));
+				return r.ok() && r.end == buffer + length && sent == received;
+			}
+
+			bool runCharConvTests() {
+				TestContext test("CharConv");
+				//Floats are written in their shortest form
+				GALACTIC_TEST(charConvWrites(0.1, "0.1"));
+				GALACTIC_TEST(charConvWrites(0.3, "0.3"));
+				GALACTIC_TEST(charConvWrites(0.1f, "0.1"));
+				GALACTIC_TEST(charConvWrites(1.5, "1.5"));
+				GALACTIC_TEST(charConvWrites(-2.0, "-2"));
+				GALACTIC_TEST(charConvWrites(0.0001, "0.0001"));
+				GALACTIC_TEST(charConvWrites(1e30, "1e+30"));
+				GALACTIC_TEST(charConvWrites(5e-324, "5e-324"));
+				GALACTIC_TEST(charConvWrites(1.7976931348623157e308, "1.7976931348623157e+308"));
+				GALACTIC_TEST(charConvWrites(-2.2250738585072014e-308, "-2.2250738585072014e-308"));
+				GALACTIC_TEST(charConvWrites(0.0, "0"));
+				F64 zero = 0.0;
+				GALACTIC_TEST(charConvWrites(1.0 / zero, "inf"));
+				GALACTIC_TEST(charConvWrites(-1.0 / zero, "-inf"));
+				GALACTIC_TEST(charConvWrites(zero / zero, "nan"));
+				//Integers
+				GALACTIC_TEST(charConvWrites((S64)0, "0"));
+				GALACTIC_TEST(charConvWrites((S64)(-9223372036854775807ll - 1), "-9223372036854775808"));
+				GALACTIC_TEST(charConvWrites((U64)18446744073709551615ull, "18446744073709551615"));
+				GALACTIC_TEST(charConvWrites((S32)-42, "-42"));
+				//Random bit patterns round trip exactly, infinities and nans are skipped
+				U64 state = 0x9E3779B97F4A7C15ull;
+				bool doublesRoundTrip = true, floatsRoundTrip = true, integersRoundTrip = true;
+				for(U32 i = 0; i < charConvTestRounds; i++) {
+					U64 bits = nextCharConvTestValue(state);
+					F64 d;
+					Memory::gmemcpy(&d, &bits, sizeof(d));
+					if(d == d && d - d == 0.0) {
+						doublesRoundTrip = doublesRoundTrip && charConvRoundTrips<F64, U64>(d);
+					}
+					U32 floatBits = U32(bits >> 32);
+					F32 f;
+					Memory::gmemcpy(&f, &floatBits, sizeof(f));
+					if(f == f && f - f == 0.0f) {
+						floatsRoundTrip = floatsRoundTrip && charConvRoundTrips<F32, U32>(f);
+					}
+					C8 buffer[CharConv::MaxChars];
+					S64 value = (S64)bits >> (bits & 63);
+					S64 result = 0;
+					U32 length = CharConv::toChars(buffer, value);
+					integersRoundTrip = integersRoundTrip && CharConv::fromChars(buffer, buffer + length, result).ok() && result == value;
+				}
+				GALACTIC_TEST(doublesRoundTrip);
+				GALACTIC_TEST(floatsRoundTrip);
+				GALACTIC_TEST(integersRoundTrip);
+				//Parsing stops at the first character that is not part of the number, the range needs no terminator
+				UTF16 text = "123abc";
+				S32 s32 = 7;
+				CharConv::ParseResult r = CharConv::fromChars(text, text + 6, s32);
+				GALACTIC_TEST(r.ok() && r.end == text + 3 && s32 == 123);
+				r = CharConv::fromChars(text, text + 2, s32);
+				GALACTIC_TEST(r.ok() && r.end == text + 2 && s32 == 12);
+				r = CharConv::fromChars(text + 3, text + 6, s32);
+				GALACTIC_TEST(r.status == CharConv::Conv_Invalid && r.end == text + 3 && s32 == 12);
+				text = "-2147483648 2147483648 ff";
+				r = CharConv::fromChars(text, text + 11, s32);
+				GALACTIC_TEST(r.ok() && s32 == (-2147483647 - 1));
+				r = CharConv::fromChars(text + 12, text + 22, s32);
+				GALACTIC_TEST(r.status == CharConv::Conv_OutOfRange && r.end == text + 22 && s32 == (-2147483647 - 1));
+				U32 u32 = 0;
+				r = CharConv::fromChars(text + 23, text + 25, u32, 16);
+				GALACTIC_TEST(r.ok() && u32 == 255);
+				//Float parsing
+				F64 f64 = 0.0;
+				text = "-1.25e-3x";
+				r = CharConv::fromChars(text, text + 9, f64);
+				GALACTIC_TEST(r.ok() && r.end == text + 8 && f64 == -1.25e-3);
+				text = "1e400";
+				f64 = 2.0;
+				r = CharConv::fromChars(text, text + 5, f64);
+				GALACTIC_TEST(r.status == CharConv::Conv_OutOfRange && f64 == 2.0);
+				text = "-infinity";
+				r = CharConv::fromChars(text, text + 9, f64);
+				GALACTIC_TEST(r.ok() && r.end == text + 9 && f64 == -1.0 / zero);
+				text = "nan";
+				r = CharConv::fromChars(text, text + 3, f64);
+				GALACTIC_TEST(r.ok() && f64 != f64);
+				//parse() takes the whole view or nothing
+				F32 f32 = 1.0f;
+				GALACTIC_TEST(CharConv::parse(StringView("2.5"), f32) && f32 == 2.5f);
+				GALACTIC_TEST(!CharConv::parse(StringView("2.5 "), f32) && f32 == 2.5f);
+				GALACTIC_TEST(!CharConv::parse(StringView(""), f32) && f32 == 2.5f);
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,82 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/engineTests.cpp
+* Runs the engine's self tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			/*
+			TestContext Class Definitions
+			*/
+			TestContext::TestContext(UTF16 suiteName) : suite(suiteName), passed(0), failed(0) {
+
+			}
+
+			bool TestContext::check(bool result, UTF16 expression, UTF16 file, U32 line) {
+				if(result) {
+					passed++;
+				}
+				else {
+					failed++;
+					GC_Error("{} test failed: {} ({}:{})", suite, expression, file, line);
+				}
+				return result;
+			}
+
+			bool TestContext::finish() {
+				if(failed) {
+					GC_Error("{} tests: {} of {} checks failed.", suite, failed, passed + failed);
+					return false;
+				}
+				GC_Print("{} tests: All {} checks passed.", suite, passed);
+				return true;
+			}
+
+			bool runAll() {
+				//Every suite runs, even after a failure, so one run reports everything.
+				bool result = runBitStreamTests();
+				result = runSnapshotTests() && result;
+				result = runSerializeTests() && result;
+				result = runSlabHeapTests() && result;
+				result = runAllocaterTests() && result;
+				result = runFormatTests() && result;
+				result = runCharConvTests() && result;
+				result = runUnicodeTests() && result;
+				return result;
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
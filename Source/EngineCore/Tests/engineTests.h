@@ -0,0 +1,95 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/engineTests.h
+* Defines the engine's self tests, run with the -runTests command line parameter
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_ENGINETESTS
+#define GALACTIC_INTERNAL_ENGINETESTS
+
+#include "../engineCore.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			/*
+			TestContext: Counts the checks made by one test suite, failed checks are reported through the console with the expression and location.
+			*/
+			class TestContext {
+				public:
+					/* Constructor */
+					//Creation Constructor
+					TestContext(UTF16 suiteName);
+
+					/* Public Class Methods */
+					//Record the result of a check, returns the result
+					bool check(bool result, UTF16 expression, UTF16 file, U32 line);
+					//Print the summary of the suite, returns true if every check passed
+					bool finish();
+
+				private:
+					/* Private Class Members */
+					//The name of the suite
+					UTF16 suite;
+					//The amount of passed checks
+					U32 passed;
+					//The amount of failed checks
+					U32 failed;
+			};
+
+			/* Test Suites: Each returns true if all of its checks passed */
+			//BitStream packing, variable length codes and float encodings
+			bool runBitStreamTests();
+			//Snapshot delta coding
+			bool runSnapshotTests();
+			//GALACTIC_SERIALIZE() generated serializers
+			bool runSerializeTests();
+			//SlabHeap size classes, block tags, span reuse and foreign pointers
+			bool runSlabHeapTests();
+			//Blocks allocated on one thread and freed on another through the installed allocater
+			bool runAllocaterTests();
+			//Format placeholders, specifications, precision and printf style formats
+			bool runFormatTests();
+			//CharConv shortest float output, round trips and parse results
+			bool runCharConvTests();
+			//UTF-8 validation, code point counting and transcoding
+			bool runUnicodeTests();
+			//Run every suite, returns true if all of them passed
+			bool runAll();
+
+		};
+
+	};
+
+};
+
+//Check a condition inside of a test suite, the TestContext has to be named test
+#define GALACTIC_TEST(x) test.check((x), #x, __FILE__, __LINE__)
+
+#endif //GALACTIC_BUILD_TESTS
+
+#endif //GALACTIC_INTERNAL_ENGINETESTS
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/formatTests.cpp
+* Format placeholder, specification, precision and printf compatibility tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			bool runFormatTests() {
+				TestContext test("Format");
+				//Placeholders take the next argument, or the numbered one
+				GALACTIC_TEST(Format::toString("{} + {} = {}", 1, 2, 3) == String("1 + 2 = 3"));
+				GALACTIC_TEST(Format::toString("{1} {0} {1}", "a", "b") == String("b a b"));
+				GALACTIC_TEST(Format::toString("{{}} {}", 5) == String("{} 5"));
+				GALACTIC_TEST(Format::toString("{} {}", 1) == String("1 <missing>"));
+				//Every argument type
+				GALACTIC_TEST(Format::toString("{} {} {} {}", true, false, 'c', (signed char)-1) == String("true false c -1"));
+				GALACTIC_TEST(Format::toString("{} {}", (unsigned char)200, 18446744073709551615ull) == String("200 18446744073709551615"));
+				GALACTIC_TEST(Format::toString("{} {}", String("str"), StringView("view of a string", 4)) == String("str view"));
+				GALACTIC_TEST(Format::toString("{}", (const char *)NULL) == String("(null)"));
+				//Specifications
+				GALACTIC_TEST(Format::toString("{:>5}|{:<5}|{:^5}", 1, 2, 3) == String("    1|2    |  3  "));
+				GALACTIC_TEST(Format::toString("{:*^7}", "ab") == String("**ab***"));
+				GALACTIC_TEST(Format::toString("{:x} {:X} {:#x} {:o} {:b}", 255, 255, 255, 8, 5) == String("ff FF 0xff 10 101"));
+				GALACTIC_TEST(Format::toString("{:+} {: } {:05}", 5, 5, -42) == String("+5  5 -0042"));
+				GALACTIC_TEST(Format::toString("{:x}", -1) == String("ffffffff"));
+				//Float precision, floats without one are written in their shortest round trip form
+				GALACTIC_TEST(Format::toString("{:.2f}", 3.14159) == String("3.14"));
+				GALACTIC_TEST(Format::toString("{:8.3f}", -1.5) == String("  -1.500"));
+				GALACTIC_TEST(Format::toString("{:e}", 1.5) == String("1.500000e+00"));
+				GALACTIC_TEST(Format::toString("{:06}", -1.5) == String("-001.5"));
+				GALACTIC_TEST(Format::toString("{} {} {}", 0.1, 0.1f, 1e21) == String("0.1 0.1 1e+21"));
+				//String precision
+				GALACTIC_TEST(Format::toString("[{:.3}]", "abcdef") == String("[abc]"));
+				GALACTIC_TEST(Format::toString("[{:>6.2}]", "abcdef") == String("[    ab]"));
+				//printf style formats, picked only when the format has no braces
+				GALACTIC_TEST(Format::toString("%d %s %5.2f %%", 7, "x", 3.14159) == String("7 x  3.14 %"));
+				GALACTIC_TEST(Format::toString("%x %08.3f %-5d|", 255, 3.14159, 3) == String("ff 0003.142 3    |"));
+				GALACTIC_TEST(Format::toString("%*d %.*f", 5, 42, 2, 1.23456) == String("   42 1.23"));
+				GALACTIC_TEST(Format::toString("100% of {}", 5) == String("100% of 5"));
+				GALACTIC_TEST(Format::toString("{{%s}}") == String("{%s}"));
+				//Mismatched specifiers convert the argument rather than reading it as the wrong type
+				GALACTIC_TEST(Format::toString("%s and %d", String("str"), "text") == String("str and text"));
+				GALACTIC_TEST(Format::toString("%s %.1f %d", 7, 3, 2.5) == String("7 3.0 2"));
+				//A precision stops a string argument, which does not have to be terminated
+				UTF8 unterminated = (UTF8)Memory::gmalloc(5);
+				Memory::gmemcpy(unterminated, "abcde", 5);
+				GALACTIC_TEST(Format::toString("%.*s!", 3, (UTF16)unterminated) == String("abc!"));
+				GALACTIC_TEST(Format::toString("%.5s!", (UTF16)unterminated) == String("abcde!"));
+				GALACTIC_TEST(Format::toString("[{:.5}]", (UTF16)unterminated) == String("[abcde]"));
+				Memory::gfree(unterminated);
+				GALACTIC_TEST(Format::toString("%.*s", 9, "xy") == String("xy"));
+				//Buffer output truncates, but returns the full length
+				C8 buffer[8];
+				GALACTIC_TEST(Format::toBuffer(buffer, sizeof(buffer), "{}", "0123456789") == 10);
+				GALACTIC_TEST(String(buffer) == String("0123456"));
+				GALACTIC_TEST(Format::toBuffer(buffer, sizeof(buffer), "{}-{}", 1, 2) == 3);
+				GALACTIC_TEST(String(buffer) == String("1-2"));
+				StringBuilder builder;
+				builder.appendFormat("{}:", "key").appendFormat("%d", 10);
+				GALACTIC_TEST(builder.build() == String("key:10"));
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,190 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/serializeTests.cpp
+* GALACTIC_SERIALIZE() serializer tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+#include "../Stream/serialize.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			using namespace Streams;
+
+			/*
+			SerializeTestCell: A serialized type used as a member of another one.
+			*/
+			struct SerializeTestCell {
+				S16 x;
+				S16 y;
+			};
+
+			GALACTIC_SERIALIZE(SerializeTestCell,
+				GALACTIC_FIELD(x).bits(12),
+				GALACTIC_FIELD(y).varint())
+
+			/*
+			SerializeTestState: A serialized type with every encoding, team was added in version 2.
+			*/
+			struct SerializeTestState {
+				bool alive;
+				U32 health;
+				S32 score;
+				U64 id;
+				F32 position;
+				F32 heading;
+				F64 time;
+				SerializeTestCell cell;
+				String name;
+				U8 team;
+			};
+
+			GALACTIC_SERIALIZE(SerializeTestState,
+				GALACTIC_FIELD(alive),
+				GALACTIC_FIELD(health).bits(10),
+				GALACTIC_FIELD(score).varint(),
+				GALACTIC_FIELD(id),
+				GALACTIC_FIELD(position).quantized(-4096, 4096, 0.01f),
+				GALACTIC_FIELD(heading).half(),
+				GALACTIC_FIELD(time),
+				GALACTIC_FIELD(cell),
+				GALACTIC_FIELD(name),
+				GALACTIC_FIELD(team).bits(3).since(2))
+
+			//The size of the stream buffers
+			static const U32 serializeTestBufferBytes = 256;
+
+			//Fill the test state
+			static void fillSerializeTestState(SerializeTestState &state) {
+				state.alive = true;
+				state.health = 1000;
+				state.score = -123456;
+				state.id = U64DEF(0x0123456789ABCDEF);
+				state.position = -1234.567f;
+				state.heading = 3.140625f;
+				state.time = 98765.4321;
+				state.cell.x = -1000;
+				state.cell.y = 32767;
+				state.name = String("Galactic");
+				state.team = 5;
+			}
+
+			//Test if the fields that are sent exactly match, and the rest match to the precision they're sent with
+			static bool serializeStatesMatch(const SerializeTestState &a, const SerializeTestState &b) {
+				return a.alive == b.alive && a.health == b.health && a.score == b.score && a.id == b.id && a.time == b.time && a.cell.x == b.cell.x
+					&& a.cell.y == b.cell.y && a.name == b.name && a.team == b.team && !Serialize::changed(a, b);
+			}
+
+			bool runSerializeTests() {
+				TestContext test("Serialize");
+				SerializeTestState state, result;
+				fillSerializeTestState(state);
+				U8 buffer[serializeTestBufferBytes];
+
+				//BitStream round trip, at an unaligned position
+				BitStream writer(buffer, sizeof(buffer));
+				writer.writeFlag(true);
+				Serialize::write(writer, state);
+				S64 fullBits = writer.getCurrentPos();
+				GALACTIC_TEST(writer.isValid());
+				BitStream reader(buffer, sizeof(buffer));
+				GALACTIC_TEST(reader.readFlag());
+				GALACTIC_TEST(Serialize::read(reader, &result));
+				GALACTIC_TEST(serializeStatesMatch(state, result));
+				GALACTIC_TEST(result.position > state.position - 0.01f && result.position < state.position + 0.01f);
+				GALACTIC_TEST(result.heading == state.heading);
+				GALACTIC_TEST(reader.getCurrentPos() == fullBits);
+
+				//An older version skips the fields added since, leaving them as they are when read
+				BitStream oldWriter(buffer, sizeof(buffer));
+				Serialize::write(oldWriter, state, 1);
+				GALACTIC_TEST(oldWriter.getCurrentPos() == fullBits - 1 - 3);
+				result.team = 0;
+				BitStream oldReader(buffer, sizeof(buffer));
+				GALACTIC_TEST(Serialize::read(oldReader, &result, 1));
+				GALACTIC_TEST(result.team == 0 && result.score == state.score && result.name == state.name);
+
+				//A stream that ends inside the value
+				BitStream cutReader(buffer, U32((fullBits >> 3) / 2));
+				GALACTIC_TEST(!Serialize::read(cutReader, &result));
+
+				//A String length running past the end of the stream fails the read
+				SerializeTestState longName = state;
+				longName.name = String();
+				BitStream emptyWriter(buffer, sizeof(buffer));
+				Serialize::write(emptyWriter, longName);
+				//Everything in front of the name, the name's length (a single byte) and the team are left
+				S64 nameBits = emptyWriter.getCurrentPos() - 8 - 3;
+				longName.name = String("The length of this name is sent, but the stream ends right after it");
+				BitStream longWriter(buffer, sizeof(buffer));
+				Serialize::write(longWriter, longName);
+				GALACTIC_TEST(longWriter.isValid());
+				BitStream shortReader(buffer, U32(((nameBits + 8 + 7) >> 3) + 4));
+				GALACTIC_TEST(!Serialize::read(shortReader, &result));
+				GALACTIC_TEST(!shortReader.isValid() && result.name.length() == 0);
+
+				//Deltas send the changed fields only
+				SerializeTestState next = state;
+				GALACTIC_TEST(!Serialize::changed(next, state));
+				next.score += 7;
+				next.heading = -0.5f;
+				next.position += 0.001f;
+				GALACTIC_TEST(Serialize::changed(next, state));
+				BitStream deltaWriter(buffer, sizeof(buffer));
+				Serialize::writeDelta(deltaWriter, next, state);
+				GALACTIC_TEST(deltaWriter.isValid() && deltaWriter.getCurrentPos() < fullBits / 2);
+				BitStream deltaReader(buffer, sizeof(buffer));
+				GALACTIC_TEST(Serialize::readDelta(deltaReader, &result, state));
+				GALACTIC_TEST(serializeStatesMatch(next, result));
+				GALACTIC_TEST(result.heading == -0.5f && result.position == state.position);
+
+				//A delta read into the baseline itself
+				SerializeTestState baseline = state;
+				BitStream inPlaceReader(buffer, sizeof(buffer));
+				GALACTIC_TEST(Serialize::readDelta(inPlaceReader, &baseline, baseline));
+				GALACTIC_TEST(serializeStatesMatch(next, baseline));
+
+				//Streams store every value in full
+				BitStream streamWriter(buffer, sizeof(buffer));
+				GALACTIC_TEST(Serialize::write(static_cast<Stream &>(streamWriter), state));
+				memset(&result.cell, 0, sizeof(result.cell));
+				result.name = String();
+				BitStream streamReader(buffer, sizeof(buffer));
+				GALACTIC_TEST(Serialize::read(static_cast<Stream &>(streamReader), &result));
+				GALACTIC_TEST(serializeStatesMatch(state, result));
+				GALACTIC_TEST(result.position == state.position);
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
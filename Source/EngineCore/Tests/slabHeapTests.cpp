@@ -0,0 +1,171 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/slabHeapTests.cpp
+* SlabHeap size class, alignment, block tag, span reuse and foreign pointer tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+#include "../allocaterOverloads.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			//The request sizes, both sides of the largest size class are included
+			static const SIZE_T slabTestSizes[] = { 1, 16, 17, 100, 1000, 5000, 32767, 32768, 32769, 100000 };
+			//The requested alignments, 4096 is past the classes and always takes a page run
+			static const U32 slabTestAlignments[] = { 16, 32, 64, 4096 };
+			//The amount of request sizes and alignments
+			static const U32 slabTestSizeCount = sizeof(slabTestSizes) / sizeof(slabTestSizes[0]);
+			static const U32 slabTestAlignmentCount = sizeof(slabTestAlignments) / sizeof(slabTestAlignments[0]);
+
+			//Fill a block with a pattern unique to it's index
+			static void fillSlabTestBlock(any block, SIZE_T size, U32 index) {
+				U8 *bytes = (U8 *)block;
+				for(SIZE_T i = 0; i < size; i++) {
+					bytes[i] = U8((index * 31) + i);
+				}
+			}
+
+			//Test if a block still holds the pattern written by fillSlabTestBlock()
+			static bool slabTestBlockIntact(cAny block, SIZE_T size, U32 index) {
+				const U8 *bytes = (const U8 *)block;
+				for(SIZE_T i = 0; i < size; i++) {
+					if(bytes[i] != U8((index * 31) + i)) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			bool runSlabHeapTests() {
+				TestContext test("SlabHeap");
+				//The heaps outlive the suite, a SlabHeap keeps the last span of every class it has used until it is destroyed
+				static SlabHeap heap;
+				static SlabHeap spanHeap(2);
+				//Every small request is given the smallest class that holds it
+				bool classesFit = true;
+				for(SIZE_T amount = 1; amount <= SlabHeap::MaximumSmall; amount += (amount < 1024 ? 1 : 61)) {
+					U32 sizeClass = SlabHeap::sizeToClass(amount);
+					if(sizeClass >= SlabHeap::ClassCount || SlabHeap::classToSize(sizeClass) < amount || (sizeClass > 0 && SlabHeap::classToSize(sizeClass - 1) >= amount)) {
+						classesFit = false;
+					}
+				}
+				GALACTIC_TEST(classesFit);
+				GALACTIC_TEST(SlabHeap::sizeToClass(SlabHeap::MaximumSmall) == SlabHeap::ClassCount - 1);
+				GALACTIC_TEST(SlabHeap::classToSize(SlabHeap::ClassCount - 1) == SlabHeap::MaximumSmall);
+				GALACTIC_TEST(SlabHeap::sizeToClass(SlabHeap::MaximumSmall + 1) == SlabHeap::ClassCount);
+				//Blocks of every size and alignment, each carrying a tag
+				any blocks[slabTestSizeCount * slabTestAlignmentCount];
+				bool allocated = true, aligned = true, sized = true, owned = true, tagged = true;
+				for(U32 i = 0; i < slabTestSizeCount * slabTestAlignmentCount; i++) {
+					SIZE_T size = slabTestSizes[i / slabTestAlignmentCount];
+					U32 alignment = slabTestAlignments[i % slabTestAlignmentCount];
+					U32 tag = i % MemoryTracker::Tag_Count;
+					blocks[i] = heap.alloc(size, alignment, tag);
+					if(blocks[i] == NULL) {
+						allocated = false;
+						continue;
+					}
+					aligned = aligned && ((IntPointer)blocks[i] & (alignment - 1)) == 0;
+					sized = sized && heap.usableSize(blocks[i]) >= size;
+					owned = owned && SlabHeap::ownerOf(blocks[i]) == &heap;
+					tagged = tagged && SlabHeap::fetchTag(blocks[i]) == (GALACTIC_MEMORY_TRACKING == 1 ? tag : 0);
+					fillSlabTestBlock(blocks[i], size, i);
+				}
+				GALACTIC_TEST(allocated);
+				GALACTIC_TEST(aligned);
+				GALACTIC_TEST(sized);
+				GALACTIC_TEST(owned);
+				GALACTIC_TEST(tagged);
+				//No block overlaps another (or the tag tables)
+				bool intact = true;
+				for(U32 i = 0; i < slabTestSizeCount * slabTestAlignmentCount; i++) {
+					intact = intact && blocks[i] != NULL && slabTestBlockIntact(blocks[i], slabTestSizes[i / slabTestAlignmentCount], i);
+				}
+				GALACTIC_TEST(intact);
+				GALACTIC_TEST(heap.validate());
+				for(U32 i = 0; i < slabTestSizeCount * slabTestAlignmentCount; i++) {
+					heap.release(blocks[i]);
+				}
+				GALACTIC_TEST(heap.validate());
+				//Released page runs are unmapped and forgotten
+				GALACTIC_TEST(SlabHeap::ownerOf(blocks[slabTestSizeCount * slabTestAlignmentCount - 1]) == NULL);
+				//The last released block of a class is the next one handed out
+				any first = heap.alloc(100);
+				heap.release(first);
+				any second = heap.alloc(100);
+				GALACTIC_TEST(first == second);
+				heap.release(second);
+				//Fill several spans of one class, then release it all, the heap keeps a single span of the class
+				U32 count = (U32)((GALACTIC_SLAB_SPAN_SIZE * 3) / 1024);
+				any *spanBlocks = (any *)Memory::gmalloc(count * sizeof(any));
+				bool spansAllocated = true;
+				for(U32 i = 0; i < count; i++) {
+					spanBlocks[i] = spanHeap.alloc(1024);
+					if(spanBlocks[i] == NULL) {
+						spansAllocated = false;
+						count = i;
+						break;
+					}
+					fillSlabTestBlock(spanBlocks[i], 1024, i);
+				}
+				GALACTIC_TEST(spansAllocated);
+				GALACTIC_TEST(spanHeap.fetchMappedBytes() >= (SIZE_T)GALACTIC_SLAB_SPAN_SIZE * 3);
+				bool spansIntact = true;
+				for(U32 i = 0; i < count; i++) {
+					spansIntact = spansIntact && slabTestBlockIntact(spanBlocks[i], 1024, i);
+				}
+				GALACTIC_TEST(spansIntact);
+				GALACTIC_TEST(spanHeap.validate());
+				for(U32 i = 0; i < count; i++) {
+					spanHeap.release(spanBlocks[i]);
+				}
+				GALACTIC_TEST(spanHeap.validate());
+				spanHeap.trim();
+				GALACTIC_TEST(spanHeap.fetchMappedBytes() == (SIZE_T)GALACTIC_SLAB_SPAN_SIZE);
+				//The first span emptied first, so it is no longer mapped. The registry rejects the pointer without reading the old header.
+				GALACTIC_TEST(SlabHeap::ownerOf(spanBlocks[0]) == NULL);
+				GALACTIC_TEST(spanHeap.usableSize(spanBlocks[0]) == 0);
+				Memory::gfree(spanBlocks);
+				//Pointers that never came from a heap are rejected
+				static U8 staticBytes[64];
+				U8 stackBytes[64];
+				GALACTIC_TEST(SlabHeap::ownerOf(staticBytes) == NULL);
+				GALACTIC_TEST(SlabHeap::ownerOf(stackBytes) == NULL);
+				GALACTIC_TEST(heap.usableSize(stackBytes) == 0);
+				GALACTIC_TEST(SlabHeap::fetchTag(stackBytes) == 0);
+				GALACTIC_TEST(SlabHeap::ownerOf(NULL) == NULL);
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
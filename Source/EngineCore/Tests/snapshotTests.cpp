@@ -0,0 +1,178 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/snapshotTests.cpp
+* Snapshot delta coding tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+#include "../Stream/snapshot.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			using namespace Streams;
+
+			/*
+			SnapshotTestState: The state of the replicated test objects, every field type of SnapshotSchema is used.
+			*/
+			struct SnapshotTestState {
+				U32 flags;
+				S32 score;
+				F32 x;
+				F32 heading;
+				F32 exact;
+				U32 count;
+			};
+
+			//The size of the packet buffers
+			static const U32 snapshotTestPacketBytes = 4096;
+
+			//Fill a snapshot with the objects of a tick, objects come and go and a few of them change every tick
+			static void fillTestSnapshot(Snapshot &snapshot, U32 tick) {
+				for(U32 id = 0; id < 64; id++) {
+					if((id + tick) % 9 == 0) {
+						continue;
+					}
+					SnapshotTestState state;
+					memset(&state, 0, sizeof(state));
+					state.flags = id * 37;
+					state.score = S32(id) - 32;
+					state.x = F32(id) * 10.5f;
+					state.heading = F32(id) / 64.0f;
+					state.exact = F32(id) * 0.1f;
+					state.count = id << 20;
+					if(id % 5 == tick % 5) {
+						state.x += F32(tick);
+						state.score -= S32(tick * 1000);
+					}
+					snapshot.addObject(id * 3, 0, sizeof(state), &state);
+				}
+				snapshot.setValid(true);
+			}
+
+			//Test if a received snapshot holds the objects of the sent one (as they'd be sent, quantized fields only match to their precision)
+			static bool snapshotsMatch(const SnapshotSchema &schema, const Snapshot &sent, const Snapshot *received) {
+				if(!received || received->getSequence() != sent.getSequence() || received->getObjectCount() != sent.getObjectCount()) {
+					return false;
+				}
+				for(U32 i = 0; i < sent.getObjectCount(); i++) {
+					const Snapshot::Entry &a = sent.getEntry(i), &b = received->getEntry(i);
+					if(a.id != b.id || a.schemaID != b.schemaID || a.stateSize != b.stateSize || schema.stateChanged(sent.getState(i), received->getState(i))) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			//Write a snapshot into a packet, returns the size in bits
+			static S64 writeTestPacket(const SnapshotCoder &coder, U8 *packet, const Snapshot &current, const Snapshot *baseline) {
+				BitStream stream(packet, snapshotTestPacketBytes);
+				coder.write(stream, current, baseline);
+				return stream.isValid() ? stream.getCurrentPos() : -1;
+			}
+
+			//Read a packet (cut to byteCount bytes) into a client's history
+			static const Snapshot *readTestPacket(const SnapshotCoder &coder, U8 *packet, U32 byteCount, SnapshotHistory &history) {
+				BitStream stream(packet, byteCount);
+				return coder.read(stream, history);
+			}
+
+			bool runSnapshotTests() {
+				TestContext test("Snapshot");
+				SnapshotSchema schema(sizeof(SnapshotTestState));
+				schema.addU32(offsetof(SnapshotTestState, flags), 12)
+					.addVarS32(offsetof(SnapshotTestState, score))
+					.addQuantizedF32(offsetof(SnapshotTestState, x), FloatQuantizer::fromPrecision(-1024.0f, 1024.0f, 0.01f))
+					.addHalfF32(offsetof(SnapshotTestState, heading))
+					.addF32(offsetof(SnapshotTestState, exact))
+					.addVarU32(offsetof(SnapshotTestState, count));
+				DynArray<const SnapshotSchema *> schemas;
+				schemas.pushToBack(&schema);
+				SnapshotCoder coder(schemas);
+				SnapshotHistory server, client;
+				SnapshotBaseline baseline;
+				U8 fullPacket[snapshotTestPacketBytes], deltaPacket[snapshotTestPacketBytes], packet[snapshotTestPacketBytes];
+				const U32 first = 100, capacity = SnapshotHistory::getCapacity();
+
+				//Full state, with nothing acknowledged
+				Snapshot &full = server.beginSnapshot(first);
+				fillTestSnapshot(full, first);
+				GALACTIC_TEST(baseline.fetchBaseline(server, first) == NULL);
+				S64 fullBits = writeTestPacket(coder, fullPacket, full, NULL);
+				GALACTIC_TEST(fullBits > 0);
+				GALACTIC_TEST(snapshotsMatch(schema, full, readTestPacket(coder, fullPacket, snapshotTestPacketBytes, client)));
+
+				//A delta against the acknowledged snapshot
+				baseline.acknowledge(first);
+				Snapshot &delta = server.beginSnapshot(first + 1);
+				fillTestSnapshot(delta, first + 1);
+				const Snapshot *base = baseline.fetchBaseline(server, first + 1);
+				GALACTIC_TEST(base == &full);
+				S64 deltaBits = writeTestPacket(coder, deltaPacket, delta, base);
+				GALACTIC_TEST(deltaBits > 0 && deltaBits < fullBits);
+				GALACTIC_TEST(snapshotsMatch(schema, delta, readTestPacket(coder, deltaPacket, snapshotTestPacketBytes, client)));
+
+				//The same packet again (a duplicate) is read again
+				GALACTIC_TEST(snapshotsMatch(schema, delta, readTestPacket(coder, deltaPacket, snapshotTestPacketBytes, client)));
+
+				//A delta against a snapshot the client never received is dropped
+				SnapshotHistory fresh;
+				GALACTIC_TEST(readTestPacket(coder, deltaPacket, snapshotTestPacketBytes, fresh) == NULL);
+
+				//A truncated packet for the slot of the first snapshot leaves that snapshot alone
+				SnapshotHistory ahead;
+				Snapshot &later = ahead.beginSnapshot(first + capacity);
+				fillTestSnapshot(later, first + capacity);
+				S64 laterBits = writeTestPacket(coder, packet, later, NULL);
+				GALACTIC_TEST(readTestPacket(coder, packet, U32(laterBits >> 4), client) == NULL);
+				GALACTIC_TEST(snapshotsMatch(schema, full, client.fetchSnapshot(first)));
+				GALACTIC_TEST(client.fetchSnapshot(first + capacity) == NULL);
+
+				//An older sequence for the slot of a newer snapshot is stale
+				SnapshotHistory older;
+				Snapshot &stale = older.beginSnapshot(first + 1 - capacity);
+				fillTestSnapshot(stale, first + 1 - capacity);
+				writeTestPacket(coder, packet, stale, NULL);
+				GALACTIC_TEST(client.isStale(first + 1 - capacity));
+				GALACTIC_TEST(readTestPacket(coder, packet, snapshotTestPacketBytes, client) == NULL);
+				GALACTIC_TEST(snapshotsMatch(schema, delta, client.fetchSnapshot(first + 1)));
+
+				//Once the acknowledged snapshot has left the history full state is sent again
+				GALACTIC_TEST(baseline.fetchBaseline(server, first + capacity) == NULL);
+				baseline.acknowledge(first + 1);
+				baseline.reset();
+				GALACTIC_TEST(baseline.fetchBaseline(server, first + 2) == NULL);
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tests/unicodeTests.cpp
+* UTF-8 validation, counting and transcoding tests
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineTests.h"
+
+#if GALACTIC_BUILD_TESTS == 1
+
+namespace Galactic {
+
+	namespace Core {
+
+		namespace Tests {
+
+			//Well formed sequences at the edges of each sequence length and around the surrogate range
+			static UTF16 const unicodeTestValid[] = { "\xC2\x80", "\xC3\xA9", "\xDF\xBF", "\xE0\xA0\x80", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+				"\xF0\x90\x80\x80", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF" };
+			//Malformed sequences: stray continuations, overlong forms, surrogates, code points past U+10FFFF, bytes that never appear and truncated sequences
+			static UTF16 const unicodeTestInvalid[] = { "\x80", "\xBF", "\xC0\xAF", "\xC1\xBF", "\xE0\x80\xAF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xF0\x80\x80\xAF",
+				"\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFE", "\xFF", "\xC3", "\xE2\x82", "\xF0\x9F\x98" };
+			//The text placed around the sequences, one pure ASCII and one that keeps the vector paths off of their ASCII shortcut
+			static UTF16 const unicodeTestFillers[] = { "a", "\xC3\xA9z" };
+			//The code points in each filler
+			static const U32 unicodeTestFillerCodePoints[] = { 1, 2 };
+			//The amount of filler placed before a sequence ranges up to this, which moves it across several 16 and 32 byte blocks
+			static const U32 unicodeTestMaxLead = 40;
+			//The amount of filler placed after a sequence
+			static const U32 unicodeTestTrail = 20;
+			//The size of the text buffers
+			static const U32 unicodeTestBufferSize = 512;
+
+			//Build the filler repeated lead times, the sequence, then the filler repeated trail times, returns the length
+			static U32 buildUnicodeTestText(C8 *out, UTF16 filler, U32 lead, UTF16 sequence, U32 trail) {
+				U32 fillerLength = (U32)strlen(filler), sequenceLength = (U32)strlen(sequence), length = 0;
+				for(U32 i = 0; i < lead; i++, length += fillerLength) {
+					Memory::gmemcpy(out + length, filler, fillerLength);
+				}
+				Memory::gmemcpy(out + length, sequence, sequenceLength);
+				length += sequenceLength;
+				for(U32 i = 0; i < trail; i++, length += fillerLength) {
+					Memory::gmemcpy(out + length, filler, fillerLength);
+				}
+				return length;
+			}
+
+			bool runUnicodeTests() {
+				TestContext test("Unicode");
+				C8 text[unicodeTestBufferSize];
+				//Every sequence at every position, the error is reported at the first byte of the malformed sequence
+				bool validAccepted = true, validCounted = true, invalidRejected = true, invalidFound = true, truncatedFound = true;
+				for(U32 f = 0; f < sizeof(unicodeTestFillers) / sizeof(unicodeTestFillers[0]); f++) {
+					U32 fillerLength = (U32)strlen(unicodeTestFillers[f]);
+					for(U32 lead = 0; lead <= unicodeTestMaxLead; lead++) {
+						for(U32 i = 0; i < sizeof(unicodeTestValid) / sizeof(unicodeTestValid[0]); i++) {
+							U32 length = buildUnicodeTestText(text, unicodeTestFillers[f], lead, unicodeTestValid[i], unicodeTestTrail);
+							U32 codePoints = ((lead + unicodeTestTrail) * unicodeTestFillerCodePoints[f]) + 1;
+							validAccepted = validAccepted && Unicode::validateUTF8(text, length) && Unicode::findInvalidUTF8(text, length) == length;
+							validCounted = validCounted && Unicode::countCodePoints(text, length) == codePoints
+								&& Unicode::utf16Length(text, length) == codePoints + (strlen(unicodeTestValid[i]) == 4 ? 1 : 0);
+						}
+						for(U32 i = 0; i < sizeof(unicodeTestInvalid) / sizeof(unicodeTestInvalid[0]); i++) {
+							U32 length = buildUnicodeTestText(text, unicodeTestFillers[f], lead, unicodeTestInvalid[i], unicodeTestTrail);
+							invalidRejected = invalidRejected && !Unicode::validateUTF8(text, length);
+							invalidFound = invalidFound && Unicode::findInvalidUTF8(text, length) == lead * fillerLength;
+							//The same sequence cut off by the end of the text
+							length = buildUnicodeTestText(text, unicodeTestFillers[f], lead, unicodeTestInvalid[i], 0);
+							truncatedFound = truncatedFound && !Unicode::validateUTF8(text, length) && Unicode::findInvalidUTF8(text, length) == lead * fillerLength;
+						}
+					}
+				}
+				GALACTIC_TEST(validAccepted);
+				GALACTIC_TEST(validCounted);
+				GALACTIC_TEST(invalidRejected);
+				GALACTIC_TEST(invalidFound);
+				GALACTIC_TEST(truncatedFound);
+				//A complete sequence cut short by the length is malformed, even if the next byte in memory would finish it
+				GALACTIC_TEST(!Unicode::validateUTF8("\xE2\x82\xAC", 2));
+				GALACTIC_TEST(Unicode::validateUTF8("", 0));
+				GALACTIC_TEST(Unicode::findInvalidUTF8("", 0) == 0);
+				//Transcoding round trips through UTF-16 and UTF-32
+				U32 length = 0;
+				for(U32 i = 0; i < sizeof(unicodeTestValid) / sizeof(unicodeTestValid[0]); i++) {
+					length += buildUnicodeTestText(text + length, "ab", 3, unicodeTestValid[i], 0);
+				}
+				U16 utf16[unicodeTestBufferSize];
+				U32 utf32[unicodeTestBufferSize];
+				C8 back[unicodeTestBufferSize];
+				U32 written = 0, backWritten = 0;
+				GALACTIC_TEST(Unicode::convertUTF8ToUTF16(text, length, utf16, written) && written == Unicode::utf16Length(text, length));
+				GALACTIC_TEST(Unicode::utf8LengthFromUTF16(utf16, written) == length);
+				GALACTIC_TEST(Unicode::convertUTF16ToUTF8(utf16, written, back, backWritten) && backWritten == length && Memory::gmemcmp(back, text, length) == 0);
+				GALACTIC_TEST(Unicode::convertUTF8ToUTF32(text, length, utf32, written) && written == Unicode::countCodePoints(text, length));
+				GALACTIC_TEST(utf32[6] == 0x80 && utf32[written - 1] == 0x10FFFF);
+				GALACTIC_TEST(Unicode::utf8LengthFromUTF32(utf32, written) == length);
+				GALACTIC_TEST(Unicode::convertUTF32ToUTF8(utf32, written, back, backWritten) && backWritten == length && Memory::gmemcmp(back, text, length) == 0);
+				//Malformed input is rejected by every conversion
+				length = buildUnicodeTestText(text, "ab", 20, "\xED\xA0\x80", 2);
+				GALACTIC_TEST(!Unicode::convertUTF8ToUTF16(text, length, utf16, written));
+				GALACTIC_TEST(!Unicode::convertUTF8ToUTF32(text, length, utf32, written));
+				const U16 unpairedHigh[] = { 0x61, 0xD800, 0x62 };
+				const U16 unpairedLow[] = { 0x61, 0xDC00 };
+				const U16 highAtEnd[] = { 0x61, 0xD83D };
+				GALACTIC_TEST(!Unicode::convertUTF16ToUTF8(unpairedHigh, 3, back, written));
+				GALACTIC_TEST(!Unicode::convertUTF16ToUTF8(unpairedLow, 2, back, written));
+				GALACTIC_TEST(!Unicode::convertUTF16ToUTF8(highAtEnd, 2, back, written));
+				const U32 surrogate[] = { 0x61, 0xD800 };
+				const U32 pastMaximum[] = { 0x110000 };
+				GALACTIC_TEST(!Unicode::convertUTF32ToUTF8(surrogate, 2, back, written));
+				GALACTIC_TEST(!Unicode::convertUTF32ToUTF8(pastMaximum, 1, back, written));
+				return test.finish();
+			}
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_BUILD_TESTS
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Thread/lockTools.cpp
+* Spin backoff, contention statistics and lock-order checking shared by the critical section classes
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		THREADLOCAL U8 _lockThreadIdentity = 0;
+
+		#if GALACTIC_DEBUG_LOCK_ORDER == 1
+			/*
+			HeldLock: A single entry on a thread's held lock stack
+			*/
+			struct HeldLock {
+				//The lock object
+				cAny lock;
+				//The order level the lock was constructed with
+				U32 orderLevel;
+			};
+
+			//The stack of ordered locks held by this thread, and the amount of entries on it.
+			static THREADLOCAL HeldLock heldLocks[LockOrderChecker::maxHeldLocks];
+			static THREADLOCAL U32 heldLockCount = 0;
+		#endif
+
+		/*
+		LockOrderChecker Class Definitions
+		*/
+		void LockOrderChecker::onAcquire(cAny lock, U32 orderLevel) {
+			#if GALACTIC_DEBUG_LOCK_ORDER == 1
+				if (orderLevel == 0) {
+					//Unordered locks are not checked.
+					return;
+				}
+				//Every lock we already hold must have a lower level than the one we just took.
+				for (U32 i = 0; i < heldLockCount; i++) {
+					if (heldLocks[i].orderLevel >= orderLevel) {
+						GC_Error("LockOrderChecker::onAcquire(): Lock order violation, acquired a level %i lock while holding a level %i lock, this may deadlock.", orderLevel, heldLocks[i].orderLevel);
+						break;
+					}
+				}
+				if (heldLockCount >= maxHeldLocks) {
+					GC_Warn("LockOrderChecker::onAcquire(): Thread is holding more than %i ordered locks, the newest lock will not be checked.", maxHeldLocks);
+					return;
+				}
+				heldLocks[heldLockCount].lock = lock;
+				heldLocks[heldLockCount].orderLevel = orderLevel;
+				heldLockCount++;
+			#endif
+		}
+
+		void LockOrderChecker::onRelease(cAny lock, U32 orderLevel) {
+			#if GALACTIC_DEBUG_LOCK_ORDER == 1
+				if (orderLevel == 0) {
+					return;
+				}
+				//Locks are usually released in reverse order, so search from the top of the stack.
+				for (S32 i = (S32)heldLockCount - 1; i >= 0; i--) {
+					if (heldLocks[i].lock == lock) {
+						for (U32 j = (U32)i; j + 1 < heldLockCount; j++) {
+							heldLocks[j] = heldLocks[j + 1];
+						}
+						heldLockCount--;
+						return;
+					}
+				}
+			#endif
+		}
+
+	};
+
+};
\ No newline at end of file
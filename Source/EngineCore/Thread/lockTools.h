@@ -0,0 +1,151 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Thread/lockTools.h
+* Spin backoff, contention statistics and lock-order checking shared by the critical section classes
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_THREAD_LOCKTOOLS
+#define GALACTIC_THREAD_LOCKTOOLS
+
+//If we have SSE on the target, we use _mm_pause() for the spin phase of our locks
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#include <xmmintrin.h>
+	#define GALACTIC_SPIN_PAUSE() _mm_pause()
+#elif defined(__arm__) || defined(__aarch64__)
+	#define GALACTIC_SPIN_PAUSE() __asm__ __volatile__("yield")
+#else
+	#define GALACTIC_SPIN_PAUSE()
+#endif
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		SpinBackoff: Implements a bounded exponential back-off for spinning on a contended lock. Each call to spin() burns twice the amount of pause
+		 instructions as the previous call (capped at maxPausesPerSpin) until the total budget is spent, at which point the caller should park.
+		*/
+		class SpinBackoff {
+			public:
+				/* Public Class Members */
+				//The largest amount of pause instructions issued by a single call to spin()
+				static const U32 maxPausesPerSpin = 64;
+
+				/* Constructor / Destructor */
+				//Default Constructor
+				FINLINE SpinBackoff(U32 spinBudget = GALACTIC_CRITICALSECTION_SPINCOUNT) : budget(spinBudget), pauses(1), remaining(spinBudget) { }
+
+				/* Public Class Methods */
+				//Spin once, returns false when the spin budget has been spent and the caller should park instead.
+				FINLINE bool spin() {
+					if (remaining == 0) {
+						return false;
+					}
+					U32 count = pauses < remaining ? pauses : remaining;
+					for (U32 i = 0; i < count; i++) {
+						GALACTIC_SPIN_PAUSE();
+					}
+					remaining -= count;
+					if (pauses < maxPausesPerSpin) {
+						pauses <<= 1;
+					}
+					return true;
+				}
+				//Fetch the amount of pause instructions that have been issued so far
+				FINLINE U32 spent() const {
+					return budget - remaining;
+				}
+
+			private:
+				/* Private Class Members */
+				//The total pause budget of this instance
+				U32 budget;
+				//The amount of pauses the next call to spin() will issue
+				U32 pauses;
+				//The remaining pause budget
+				U32 remaining;
+		};
+
+		/*
+		LockStatistics: Contention information gathered by a critical section when GALACTIC_LOCK_CONTENTION_STATS is enabled. These values are only
+		 written by the thread that owns the lock (except failedTries), so they can be read at any time for reporting purposes (but may be a little out of date).
+		*/
+		struct LockStatistics {
+			/* Struct Members */
+			//The total amount of times the lock was acquired (recursive acquisitions are not counted)
+			U64 acquisitions;
+			//The amount of acquisitions that did not succeed on the first attempt
+			U64 contended;
+			//The amount of acquisitions that had to park the thread in the kernel
+			U64 parked;
+			//The total amount of pause instructions spent spinning on this lock
+			U64 spins;
+			//The amount of tryLock() calls that failed or timed out, written by the threads that don't own the lock so it is updated atomically
+			volatile S64 failedTries;
+
+			/* Struct Methods */
+			//Default Constructor
+			LockStatistics() : acquisitions(0), contended(0), parked(0), spins(0), failedTries(0) { }
+			//Reset all of the counters
+			void reset() {
+				acquisitions = contended = parked = spins = failedTries = 0;
+			}
+		};
+
+		/*
+		LockOrderChecker: Debug tool used by the critical section classes when GALACTIC_DEBUG_LOCK_ORDER is enabled. Each thread keeps a small stack of
+		 the ordered locks it holds, taking a lock with an order level that is not higher than the level of every held lock is a potential deadlock and is
+		 reported to the console along with both levels.
+		*/
+		class LockOrderChecker {
+			public:
+				/* Public Class Members */
+				//The maximum amount of ordered locks a single thread can track at once
+				static const U32 maxHeldLocks = 32;
+
+				/* Public Class Methods */
+				//Called after a thread acquires an ordered lock
+				static void onAcquire(cAny lock, U32 orderLevel);
+				//Called before a thread releases an ordered lock
+				static void onRelease(cAny lock, U32 orderLevel);
+		};
+
+		//Thread local marker byte, the address of this variable is used to identify a thread (see LockTools::threadIdentity())
+		extern THREADLOCAL U8 _lockThreadIdentity;
+
+		/*
+		LockTools: Small helpers shared by all platform versions of PlatformCriticalSection
+		*/
+		class LockTools {
+			public:
+				/* Public Class Methods */
+				//Returns a pointer that uniquely identifies the calling thread for as long as it lives, used to track recursive lock owners.
+				SFIN any threadIdentity() {
+					return &_lockThreadIdentity;
+				}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_THREAD_LOCKTOOLS
\ No newline at end of file
@@ -218,6 +218,8 @@
 				myself->preRun();
 				myself->run();
 				myself->postRun();
+				//Hand back the thread's cached resources, myself may be gone at this point
+				ContinualThread::onThreadExit();
 				//And exit....
 				pthread_exit(NULL);
 				return NULL;
@@ -31,47 +31,203 @@
 
 	#include <pthread.h>
 	#include <errno.h>
+	#include <time.h>
+	#include "lockTools.h"
 
 	namespace Galactic {
 
 		namespace Core {
 
 			/*
-			PlatformCriticalSection: Implements a mutex locking module for all platforms that use pThread. 
+			PlatformCriticalSection: Implements a recursive hybrid spin/park mutex for all platforms that use pThread. Uncontended locks are taken with a
+			 single atomic operation, contended locks spin with an exponential back-off (see GALACTIC_CRITICALSECTION_SPINCOUNT) before the thread is
+			 parked on a condition variable. The lock word uses three states: 0 (free), 1 (locked), and 2 (locked with parked waiters), only an unlock
+			 from state 2 needs to touch the kernel.
 			 WARNING: Please be mindful that any methods you add here MUST also have a Windows equivalent in 
 			 Platform/Windows/WinCriticalSection.h
 			*/
 			class PlatformCriticalSection {
 				public:
 					/* Constructor / Destructor */
-					//Default Constructor
-					FINLINE PlatformCriticalSection() {
-						pthread_mutexattr_t attrb;
-						pthread_mutexattr_init(&attrb);
-						pthread_mutexattr_settype(&attrb, PTHREAD_MUTEX_RECURSIVE);
-						pthread_mutex_init(&cSec, &attrb);
+					//Default Constructor, orderLevel is used by the debug lock-order checker (0 = not checked)
+					FINLINE PlatformCriticalSection(U32 orderLevel = 0) : lockState(0), owner(NULL), recursion(0), lockOrder(orderLevel) {
+						pthread_mutex_init(&parkMutex, NULL);
+						pthread_cond_init(&parkCond, NULL);
 					}
 
 					//Destructor
 					FINLINE ~PlatformCriticalSection() {
-						pthread_mutex_destroy(&cSec);
+						pthread_cond_destroy(&parkCond);
+						pthread_mutex_destroy(&parkMutex);
 					}
 
 					/* Public Class Methods */
 					//Lock
 					FINLINE void lock() {
-						pthread_mutex_lock(&cSec);
+						any self = LockTools::threadIdentity();
+						if (owner == self) {
+							recursion++;
+							return;
+						}
+						//Fast Path: nobody has the lock.
+						if (PlatformAtomics::compareExchange(&lockState, 1, 0) != 0) {
+							lockSlow();
+						}
+						onAcquired(self);
+					}
+
+					//Try to lock, waiting at most timeInMS miliseconds. Passing 0 will only attempt the lock once. Returns true if the lock was obtained.
+					FINLINE bool tryLock(U32 timeInMS = 0) {
+						any self = LockTools::threadIdentity();
+						if (owner == self) {
+							recursion++;
+							return true;
+						}
+						if (PlatformAtomics::compareExchange(&lockState, 1, 0) != 0) {
+							if (timeInMS == 0 || !tryLockSlow(timeInMS)) {
+								#if GALACTIC_LOCK_CONTENTION_STATS == 1
+									PlatformAtomics::increment(&stats.failedTries);
+								#endif
+								return false;
+							}
+						}
+						onAcquired(self);
+						return true;
 					}
 
 					//Unlock
 					FINLINE void unlock() {
-						pthread_mutex_unlock(&cSec);
+						if (--recursion != 0) {
+							return;
+						}
+						LockOrderChecker::onRelease(this, lockOrder);
+						owner = NULL;
+						//We use a compare-exchange loop here instead of exchange() to get a full memory barrier on the release.
+						S32 prev = lockState, cur;
+						while ((cur = PlatformAtomics::compareExchange(&lockState, 0, prev)) != prev) {
+							prev = cur;
+						}
+						if (prev == 2) {
+							//Someone is parked on us, wake one of them up.
+							pthread_mutex_lock(&parkMutex);
+							pthread_cond_signal(&parkCond);
+							pthread_mutex_unlock(&parkMutex);
+						}
+					}
+
+					//Fetch the contention statistics of this lock (all zero unless GALACTIC_LOCK_CONTENTION_STATS is enabled)
+					FINLINE const LockStatistics &fetchStatistics() const {
+						return stats;
+					}
+
+					//Reset the contention statistics of this lock
+					FINLINE void resetStatistics() {
+						stats.reset();
 					}
 				
 				private:
+					/* Private Class Methods */
+					//Bookkeeping performed once the lock has been obtained
+					FINLINE void onAcquired(any self) {
+						owner = self;
+						recursion = 1;
+						#if GALACTIC_LOCK_CONTENTION_STATS == 1
+							stats.acquisitions++;
+						#endif
+						LockOrderChecker::onAcquire(this, lockOrder);
+					}
+
+					//Spin on the lock word with back-off, returns true if the lock was obtained before the spin budget ran out
+					bool spinForLock(U32 &spins) {
+						SpinBackoff backoff;
+						bool obtained = false;
+						while (backoff.spin()) {
+							//Only attempt the (expensive) atomic operation when the lock looks free
+							if (lockState == 0 && PlatformAtomics::compareExchange(&lockState, 1, 0) == 0) {
+								obtained = true;
+								break;
+							}
+						}
+						spins = backoff.spent();
+						return obtained;
+					}
+
+					//Contended lock path: spin, then park until the lock is ours.
+					void lockSlow() {
+						U32 spins = 0, parks = 0;
+						if (!spinForLock(spins)) {
+							//Mark the lock as contended (2), if the previous value was 0, we now own the lock.
+							while (PlatformAtomics::exchange(&lockState, 2) != 0) {
+								parks++;
+								pthread_mutex_lock(&parkMutex);
+								while (lockState == 2) {
+									pthread_cond_wait(&parkCond, &parkMutex);
+								}
+								pthread_mutex_unlock(&parkMutex);
+							}
+						}
+						#if GALACTIC_LOCK_CONTENTION_STATS == 1
+							stats.contended++;
+							stats.spins += spins;
+							stats.parked += (parks != 0 ? 1 : 0);
+						#endif
+					}
+
+					//Contended tryLock path: spin, then park until the lock is ours or the time runs out.
+					bool tryLockSlow(U32 timeInMS) {
+						U32 spins = 0, parks = 0;
+						if (!spinForLock(spins)) {
+							struct timespec deadline;
+							clock_gettime(CLOCK_REALTIME, &deadline);
+							deadline.tv_sec += timeInMS / 1000;
+							deadline.tv_nsec += (long)(timeInMS % 1000) * 1000000L;
+							if (deadline.tv_nsec >= 1000000000L) {
+								deadline.tv_sec++;
+								deadline.tv_nsec -= 1000000000L;
+							}
+							while (PlatformAtomics::exchange(&lockState, 2) != 0) {
+								parks++;
+								S32 errCode = 0;
+								pthread_mutex_lock(&parkMutex);
+								while (lockState == 2 && errCode != ETIMEDOUT) {
+									errCode = pthread_cond_timedwait(&parkCond, &parkMutex, &deadline);
+								}
+								pthread_mutex_unlock(&parkMutex);
+								if (errCode == ETIMEDOUT) {
+									//Note: we may have left the lock word at 2 without owning the lock, this only costs the owner a spurious wake-up.
+									return false;
+								}
+							}
+						}
+						#if GALACTIC_LOCK_CONTENTION_STATS == 1
+							stats.contended++;
+							stats.spins += spins;
+							stats.parked += (parks != 0 ? 1 : 0);
+						#endif
+						return true;
+					}
+
+					/* Private (Blocked) Constructors / Operators */
+					//Copy Constructor
+					PlatformCriticalSection(const PlatformCriticalSection &);
+					//Assignment Operator
+					PlatformCriticalSection &operator=(const PlatformCriticalSection &);
+
 					/* Private Class Members */
-					//The Critical Section Object
-					pthread_mutex_t cSec;
+					//The lock word (0: free, 1: locked, 2: locked with parked waiters)
+					volatile S32 lockState;
+					//The thread identity of the current owner (see LockTools::threadIdentity()), NULL when the lock is free
+					any volatile owner;
+					//The recursion depth of the owning thread
+					U32 recursion;
+					//The order level of this lock, used by LockOrderChecker
+					U32 lockOrder;
+					//The mutex guarding the parking condition
+					pthread_mutex_t parkMutex;
+					//The condition parked threads wait on
+					pthread_cond_t parkCond;
+					//Contention statistics for this lock
+					LockStatistics stats;
 			};
 
 		};
@@ -32,6 +32,25 @@ namespace Galactic {
 		/*
 		EventPool Class Definitions
 		*/
+		//The per-thread event cache, since there is only ever one EventPool these are kept at file scope.
+		static THREADLOCAL Event *_eventCacheHead = NULL;
+		static THREADLOCAL Event *_eventCacheTail = NULL;
+		static THREADLOCAL U32 _eventCacheCount = 0;
+
+		EventPool::EventPool() : freeHead(NULL) {
+			prewarm(GALACTIC_EVENTPOOL_PREWARM_COUNT);
+		}
+
+		EventPool::~EventPool() {
+			//Note: Events still sitting in the caches of running threads belong to those threads, exited threads handed theirs back in releaseThreadCache().
+			Event *e = (Event *)PlatformAtomics::exchange((any *)&freeHead, NULL);
+			while (e != NULL) {
+				Event *next = e->poolNext;
+				SendToPitsOfHell(e);
+				e = next;
+			}
+		}
+
 		EventPool &EventPool::fetchInstance() {
 			if (managedSingleton<EventPool>::instance() == NULL) {
 				managedSingleton<EventPool>::createInstance();
@@ -40,15 +59,41 @@ namespace Galactic {
 		}
 
 		Event *EventPool::fetchFromPool() {
-			if (ePool.size() < 1) {
-				return PlatformProcess::createEvent();
+			Event *e = _eventCacheHead;
+			if (e == NULL) {
+				//The local cache is empty, take the entire shared list. Taking the whole list (rather than popping one node) keeps the list free of ABA issues.
+				e = (Event *)PlatformAtomics::exchange((any *)&freeHead, NULL);
+				if (e == NULL) {
+					//Pool is dry, this is the only path that creates an event.
+					return PlatformProcess::createEvent();
+				}
+				//Keep up to the cache size locally and return the rest to the shared list.
+				Event *last = e;
+				U32 count = 1;
+				while (last->poolNext != NULL && count < GALACTIC_EVENTPOOL_THREAD_CACHE_SIZE) {
+					last = last->poolNext;
+					count++;
+				}
+				Event *rest = last->poolNext;
+				last->poolNext = NULL;
+				if (rest != NULL) {
+					Event *restLast = rest;
+					while (restLast->poolNext != NULL) {
+						restLast = restLast->poolNext;
+					}
+					pushChain(rest, restLast);
+				}
+				_eventCacheHead = e;
+				_eventCacheTail = last;
+				_eventCacheCount = count;
 			}
-			Event *last = ePool[ePool.size() - 1];
-			ePool.popBack();
-			if (last == NULL) {
-				last = PlatformProcess::createEvent();
+			_eventCacheHead = e->poolNext;
+			_eventCacheCount--;
+			if (_eventCacheHead == NULL) {
+				_eventCacheTail = NULL;
 			}
-			return last;
+			e->poolNext = NULL;
+			return e;
 		}
 
 		void EventPool::returnToPool(Event *e) {
@@ -56,7 +101,59 @@ namespace Galactic {
 				GC_Error("EventPool::returnToPool(): Cannot send NULL to the event pool.");
 				return;
 			}
-			ePool.pushToBack(e);
+			e->poolNext = _eventCacheHead;
+			_eventCacheHead = e;
+			if (_eventCacheTail == NULL) {
+				_eventCacheTail = e;
+			}
+			_eventCacheCount++;
+			if (_eventCacheCount > GALACTIC_EVENTPOOL_THREAD_CACHE_SIZE) {
+				//Cache is overfull, keep the newest half (still warm) and hand the older half back to the shared list.
+				U32 keep = GALACTIC_EVENTPOOL_THREAD_CACHE_SIZE / 2;
+				Event *split = _eventCacheHead;
+				for (U32 i = 1; i < keep; i++) {
+					split = split->poolNext;
+				}
+				Event *first = split->poolNext;
+				Event *last = _eventCacheTail;
+				split->poolNext = NULL;
+				_eventCacheTail = split;
+				_eventCacheCount = keep;
+				pushChain(first, last);
+			}
+		}
+
+		void EventPool::releaseThreadCache() {
+			if (_eventCacheHead == NULL) {
+				//Nothing cached, don't create the pool for nothing
+				return;
+			}
+			fetchInstance().pushChain(_eventCacheHead, _eventCacheTail);
+			_eventCacheHead = NULL;
+			_eventCacheTail = NULL;
+			_eventCacheCount = 0;
+		}
+
+		void EventPool::prewarm(U32 count) {
+			if (count == 0) {
+				return;
+			}
+			Event *first = PlatformProcess::createEvent();
+			Event *last = first;
+			for (U32 i = 1; i < count; i++) {
+				Event *e = PlatformProcess::createEvent();
+				e->poolNext = first;
+				first = e;
+			}
+			pushChain(first, last);
+		}
+
+		void EventPool::pushChain(Event *first, Event *last) {
+			Event *oldHead;
+			do {
+				oldHead = freeHead;
+				last->poolNext = oldHead;
+			} while (PlatformAtomics::compareExchange((any *)&freeHead, first, oldHead) != oldHead);
 		}
 
 		/*
@@ -161,6 +258,11 @@ namespace Galactic {
 			return onThreadDestroyedDelegate;
 		}
 
+		void ContinualThread::onThreadExit() {
+			EventPool::releaseThreadCache();
+			FrameArena::releaseThread();
+		}
+
 		/*
 		threadRegistry Class Definitions
 		*/
@@ -174,7 +276,7 @@ namespace Galactic {
 		void threadRegistry::add(U32 id, ContinualThread *t) {
 			//Whenever we manipulate the registry, we need to lock the threads first.
 			lock();
-			if (tRegistry.find(id) == NULL) {
+			if (tRegistry.find(id) == tRegistry.end()) {
 				//We need to add it...
 				tRegistry.insert(Pair<U32, ContinualThread *>(id, t));
 			}
@@ -193,7 +295,9 @@ namespace Galactic {
 		}
 
 		ContinualThread *threadRegistry::fetch(U32 id) {
-			return tRegistry.at(id).second;
+			//Don't use at() here, it would add an entry for an unknown thread
+			Map<U32, ContinualThread *>::iterator it = tRegistry.find(id);
+			return it != tRegistry.end() ? it->second : NULL;
 		}
 
 		S32 threadRegistry::count() {
@@ -59,6 +59,8 @@ namespace Galactic {
 		class Event : public ThreadBase {
 			public:
 				/* Constructor / Destructor */
+				//Default Constructor
+				Event() : poolNext(NULL) {}
 				//Destructor
 				virtual ~Event() {}
 				/* Public Class Methods */
@@ -70,25 +72,48 @@ namespace Galactic {
 				virtual void fire() = 0;
 				//wait(): hold the execution of the event until the stated amount of MS has passed, passing no variable sets the event to wait infinitely
 				virtual bool wait(U32 timeInMS = ((U32)0xffffffff)) = 0;
+
+			private:
+				/* Private Class Members */
+				//Intrusive link used by the EventPool while this event is stored in the pool
+				Event *poolNext;
+
+				friend class EventPool;
 		};
 
 		/*
-		EventPool: A special container class instance that holds all of the Events queued in the engine
+		EventPool: A special container class instance that holds all of the Events queued in the engine. Events are stored in a lock-free free list shared
+		 by all threads, with a small per-thread cache in front of it. The cache is used on the hot path and requires no locks or atomic operations, the
+		 shared list is only touched to refill an empty cache (by taking the entire list at once) or to hand back half of an overfull cache.
 		*/
 		class EventPool {
 			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				EventPool();
+				//Destructor
+				~EventPool();
+
 				/* Public Class Methods */
 				//Fetch the managedSingleton instance of this class
 				static EventPool &fetchInstance();
-				//Fetch the 'last' event from the pool
+				//Fetch an event from the pool
 				Event *fetchFromPool();
 				//Return an event to the pool
 				void returnToPool(Event *e);
+				//Create the specified amount of events and store them in the shared pool
+				void prewarm(U32 count);
+				//Hand the calling thread's cached events back to the shared list, called when a thread exits (see ContinualThread::onThreadExit())
+				static void releaseThreadCache();
 
 			private:
+				/* Private Class Methods */
+				//Push a linked chain of events onto the shared list
+				void pushChain(Event *first, Event *last);
+
 				/* Private Class Members */
-				//The list of events stored in the engine
-				DynArray<Event *>ePool;
+				//The head of the shared lock-free list of events
+				Event * volatile freeHead;
 		};
 
 		/*
@@ -175,6 +200,8 @@ namespace Galactic {
 				virtual void waitForCompletion() = 0;
 				//Returns a delegate for thread destruction
 				BasicMulticastDelegate &onDestroyed();
+				//onThreadExit(): Release the per-thread caches of the engine, called on the exiting thread as the last step of its entry point
+				static void onThreadExit();
 
 			protected:
 				/* Protected Class Methods */
@@ -0,0 +1,219 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Thread/threadSync.cpp
+* Defines fan-in synchronization classes (Latch, CountdownEvent, Barrier)
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		//The amount of pause instructions to spend spinning before a waiting thread parks on the event
+		static const U32 syncWaitSpinBudget = 256;
+		//The amount of time (in ms) a thread helping the pool will sleep on the event if no jobs are available
+		static const U32 syncHelpWaitSlice = 1;
+
+		//Shared wait loop for the synchronization classes. The flag is checked through the spin phase before the thread is parked on the event, which is
+		// only done once per wait unless the caller asked to help the thread pool.
+		static bool syncWaitOn(Event *ev, volatile S32 *doneFlag, S32 doneValue, U32 timeInMS, bool helpWithWork) {
+			SpinBackoff backoff(syncWaitSpinBudget);
+			while (*doneFlag != doneValue) {
+				if (!backoff.spin()) {
+					break;
+				}
+			}
+			if (*doneFlag == doneValue) {
+				return true;
+			}
+			if (!helpWithWork || !G_ThreadPool) {
+				return ev->wait(timeInMS);
+			}
+			//Help out the pool until the flag is set, parking briefly whenever there is nothing to do.
+			F64 deadline = PlatformTime::fetchSeconds() + ((F64)timeInMS / 1000.0);
+			while (*doneFlag != doneValue) {
+				if (timeInMS != ((U32)0xffffffff) && PlatformTime::fetchSeconds() >= deadline) {
+					return false;
+				}
+				if (!G_ThreadPool->performPendingWork()) {
+					ev->wait(syncHelpWaitSlice);
+				}
+			}
+			return true;
+		}
+
+		/*
+		Latch Class Definitions
+		*/
+		Latch::Latch(S32 count) : counter(count), doneEvent(NULL) {
+			if (count < 0) {
+				GC_Error("Latch::Latch(): Cannot create a latch with a negative count (%i), setting to 0.", count);
+				counter = 0;
+			}
+			doneEvent = PlatformProcess::createEvent(true);
+			if (counter == 0) {
+				doneEvent->fire();
+			}
+		}
+
+		Latch::~Latch() {
+			if (doneEvent) {
+				SendToHell(doneEvent);
+			}
+		}
+
+		void Latch::countDown(S32 amount) {
+			if (amount <= 0) {
+				return;
+			}
+			S32 previous = PlatformAtomics::add(&counter, -amount);
+			if (previous <= 0 || previous - amount < 0) {
+				GC_Error("Latch::countDown(): Latch counted down past zero (previous count %i, amount %i).", previous, amount);
+			}
+			if (previous > 0 && previous - amount <= 0) {
+				//We are the arrival that released the latch.
+				doneEvent->fire();
+			}
+		}
+
+		bool Latch::tryWait() const {
+			return counter <= 0;
+		}
+
+		bool Latch::wait(U32 timeInMS, bool helpWithWork) {
+			if (counter <= 0) {
+				return true;
+			}
+			return syncWaitOn(doneEvent, &counter, 0, timeInMS, helpWithWork) || counter <= 0;
+		}
+
+		void Latch::arriveAndWait(S32 amount, bool helpWithWork) {
+			countDown(amount);
+			wait(((U32)0xffffffff), helpWithWork);
+		}
+
+		S32 Latch::fetchCount() const {
+			return counter;
+		}
+
+		/*
+		CountdownEvent Class Definitions
+		*/
+		CountdownEvent::CountdownEvent(S32 count) : Latch(count) { }
+
+		void CountdownEvent::signal(S32 amount) {
+			countDown(amount);
+		}
+
+		bool CountdownEvent::addCount(S32 amount) {
+			if (amount <= 0) {
+				return true;
+			}
+			S32 current = counter;
+			while (current > 0) {
+				S32 previous = PlatformAtomics::compareExchange(&counter, current + amount, current);
+				if (previous == current) {
+					return true;
+				}
+				current = previous;
+			}
+			GC_Error("CountdownEvent::addCount(): Cannot add to an event that has already been signaled, call reset() instead.");
+			return false;
+		}
+
+		void CountdownEvent::reset(S32 count) {
+			if (count < 0) {
+				GC_Error("CountdownEvent::reset(): Cannot reset to a negative count (%i), setting to 0.", count);
+				count = 0;
+			}
+			if (count > 0) {
+				doneEvent->reset();
+			}
+			PlatformAtomics::exchange(&counter, count);
+			if (count == 0) {
+				doneEvent->fire();
+			}
+		}
+
+		/*
+		Barrier Class Definitions
+		*/
+		Barrier::Barrier(S32 participants) : participants(participants), remaining(participants), phase(0) {
+			if (participants <= 0) {
+				GC_Error("Barrier::Barrier(): A barrier requires at least one participant (%i given), setting to 1.", participants);
+				this->participants = remaining = 1;
+			}
+			phaseEvents[0] = PlatformProcess::createEvent(true);
+			phaseEvents[1] = PlatformProcess::createEvent(true);
+		}
+
+		Barrier::~Barrier() {
+			SendToHell(phaseEvents[0]);
+			SendToHell(phaseEvents[1]);
+		}
+
+		bool Barrier::arriveAndWait(bool helpWithWork) {
+			U32 myPhase;
+			if (true) {
+				MutexLock lock(&cSec);
+				myPhase = phase;
+				remaining--;
+				if (remaining == 0) {
+					completePhase();
+					return true;
+				}
+			}
+			//Wait for the phase number to move on, the event for this phase stays fired until the phase after the next one starts.
+			syncWaitOn(phaseEvents[myPhase & 1], (volatile S32 *)&phase, (S32)(myPhase + 1), ((U32)0xffffffff), helpWithWork);
+			return false;
+		}
+
+		void Barrier::arriveAndDrop() {
+			MutexLock lock(&cSec);
+			participants--;
+			remaining--;
+			if (remaining == 0) {
+				completePhase();
+			}
+		}
+
+		U32 Barrier::fetchPhase() const {
+			return phase;
+		}
+
+		S32 Barrier::fetchParticipants() const {
+			return participants;
+		}
+
+		void Barrier::completePhase() {
+			//Every waiter of the previous phase has re-arrived, so the other event is safe to re-arm for the next phase.
+			U32 current = phase;
+			remaining = participants;
+			phaseEvents[(current + 1) & 1]->reset();
+			PlatformAtomics::exchange((volatile S32 *)&phase, (S32)(current + 1));
+			phaseEvents[current & 1]->fire();
+		}
+
+	};
+
+};
\ No newline at end of file
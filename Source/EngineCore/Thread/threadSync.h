@@ -0,0 +1,144 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Thread/threadSync.h
+* Defines fan-in synchronization classes (Latch, CountdownEvent, Barrier)
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_THREADSYNC
+#define GALACTIC_THREADSYNC
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		Latch: A single use synchronization class. The latch is created with a count, threads count it down as they finish their piece of a task, and any
+		 amount of waiting threads are released once it reaches zero. Unlike using one SingleEvent per job, all of the waiters park on a single event which
+		 is fired exactly once, by the arrival that takes the count to zero.
+		*/
+		class Latch {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				Latch(S32 count);
+				//Destructor
+				virtual ~Latch();
+
+				/* Public Class Methods */
+				//Count the latch down by the specified amount, the waiting threads are released when the count reaches zero
+				void countDown(S32 amount = 1);
+				//Returns true if the latch has reached zero (never blocks)
+				bool tryWait() const;
+				//Wait for the latch to reach zero, returns false if the time ran out. Set helpWithWork to run queued thread pool jobs while waiting.
+				bool wait(U32 timeInMS = ((U32)0xffffffff), bool helpWithWork = false);
+				//Count down and then wait for the latch to reach zero
+				void arriveAndWait(S32 amount = 1, bool helpWithWork = false);
+				//Fetch the current count of the latch
+				S32 fetchCount() const;
+
+			protected:
+				/* Protected Class Members */
+				//The remaining count on the latch
+				volatile S32 counter;
+				//The manual reset event fired when the counter reaches zero
+				Event *doneEvent;
+
+			private:
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				Latch(const Latch &);
+				//Assignment Operator
+				Latch &operator=(const Latch &);
+		};
+
+		/*
+		CountdownEvent: A re-usable version of Latch. Work can be added to the event while it has not yet reached zero (for jobs spawning more jobs), and the
+		 event can be reset to a new count once all waiting threads have been released, which allows one instance to be kept around for the per-frame
+		 "wait for all chunks" pattern.
+		*/
+		class CountdownEvent : public Latch {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				CountdownEvent(S32 count = 0);
+
+				/* Public Class Methods */
+				//Signal the event by the specified amount, identical to countDown()
+				void signal(S32 amount = 1);
+				//Add to the count, fails (returns false) if the event has already reached zero
+				bool addCount(S32 amount = 1);
+				//Reset the event to a new count. Note: Only call this when no threads are waiting on the event.
+				void reset(S32 count);
+		};
+
+		/*
+		Barrier: A re-usable synchronization point for a fixed group of threads. Each participant calls arriveAndWait() and is held until all of the
+		 participants have arrived, at which point the phase is completed and every thread is released together. Phases alternate between two events so the
+		 barrier can be used again immediately without racing the threads still waking from the prior phase.
+		*/
+		class Barrier {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				Barrier(S32 participants);
+				//Destructor
+				~Barrier();
+
+				/* Public Class Methods */
+				//Arrive at the barrier and wait for the other participants, returns true for the one thread that completed the phase.
+				bool arriveAndWait(bool helpWithWork = false);
+				//Arrive at the barrier and remove the calling thread from future phases.
+				void arriveAndDrop();
+				//Fetch the current phase number
+				U32 fetchPhase() const;
+				//Fetch the amount of participants
+				S32 fetchParticipants() const;
+
+			private:
+				/* Private Class Methods */
+				//Complete the current phase (must be called with cSec locked)
+				void completePhase();
+
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				Barrier(const Barrier &);
+				//Assignment Operator
+				Barrier &operator=(const Barrier &);
+
+				/* Private Class Members */
+				//The critical section object protecting the arrival counts
+				PlatformCriticalSection cSec;
+				//The total amount of participants
+				S32 participants;
+				//The amount of participants yet to arrive in this phase
+				S32 remaining;
+				//The current phase number
+				volatile U32 phase;
+				//The two manual reset events alternated between phases
+				Event *phaseEvents[2];
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_THREADSYNC
\ No newline at end of file
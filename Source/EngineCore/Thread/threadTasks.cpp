@@ -433,6 +433,27 @@ namespace Galactic {
 			return false;
 		}
 
+		bool WorkPool::performPendingWork() {
+			//This method is used by threads waiting on a Latch or Barrier to help the pool along instead of sitting idle.
+			if (!cSec || isBeingDeleted) {
+				return false;
+			}
+			Work *nextJob = NULL;
+			if (true) {
+				MutexLock lock(cSec);
+				if (jobsToDo.size() > 0) {
+					nextJob = jobsToDo[0];
+					jobsToDo.erase((U32)0);
+				}
+			}
+			if (!nextJob) {
+				return false;
+			}
+			//Run the job outside of the lock so the worker threads can continue to pull from the queue.
+			nextJob->perform();
+			return true;
+		}
+
 	};
 
 };
\ No newline at end of file
@@ -202,6 +202,8 @@ namespace Galactic {
 				virtual Work *fetchNextTask(WorkerThread *toPool) = 0;
 				//Remove a work object from the pool
 				virtual bool removeWork(Work *w) = 0;
+				//Perform the oldest queued job on the calling thread, returns false if there was nothing to do
+				virtual bool performPendingWork() = 0;
 		};
 
 		/*
@@ -256,6 +258,8 @@ namespace Galactic {
 				virtual Work *fetchNextTask(WorkerThread *toPool);
 				//Remove a work object from the pool
 				virtual bool removeWork(Work *w);
+				//Perform the oldest queued job on the calling thread, returns false if there was nothing to do
+				virtual bool performPendingWork();
 
 			protected:
 				/* Protected Class Members */
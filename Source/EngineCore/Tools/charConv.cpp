@@ -0,0 +1,614 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/charConv.cpp
+* Defines the conversions between numbers and their text form
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/* Grisu2: Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers" (2010) */
+
+		//A floating point value with a 64 bit significand: f * 2^e
+		struct DiyFp {
+			DiyFp() : f(0), e(0) { }
+			DiyFp(U64 significand, S32 exponent) : f(significand), e(exponent) { }
+
+			//The difference of two values with the same exponent
+			DiyFp operator-(const DiyFp &rhs) const {
+				return DiyFp(f - rhs.f, e);
+			}
+
+			//The product, keeping (and rounding) the upper 64 bits of the significand
+			DiyFp operator*(const DiyFp &rhs) const {
+				U64 lo = f, hi = rhs.f;
+				Hash::multiply128(lo, hi);
+				return DiyFp(hi + (lo >> 63), e + rhs.e + 64);
+			}
+
+			//Shift the significand up until the top bit is set
+			DiyFp normalize() const {
+				DiyFp result = *this;
+				while (!(result.f & (U64DEF(1) << 63))) {
+					result.f <<= 1;
+					result.e--;
+				}
+				return result;
+			}
+
+			U64 f;
+			S32 e;
+		};
+
+		//Normalized 10^k for k = -348, -340, ..., 340, significands and binary exponents
+		static const U64 charConvPowerSignificands[] = {
+			U64DEF(0xfa8fd5a0081c0288), U64DEF(0xbaaee17fa23ebf76), U64DEF(0x8b16fb203055ac76),
+			U64DEF(0xcf42894a5dce35ea), U64DEF(0x9a6bb0aa55653b2d), U64DEF(0xe61acf033d1a45df),
+			U64DEF(0xab70fe17c79ac6ca), U64DEF(0xff77b1fcbebcdc4f), U64DEF(0xbe5691ef416bd60c),
+			U64DEF(0x8dd01fad907ffc3c), U64DEF(0xd3515c2831559a83), U64DEF(0x9d71ac8fada6c9b5),
+			U64DEF(0xea9c227723ee8bcb), U64DEF(0xaecc49914078536d), U64DEF(0x823c12795db6ce57),
+			U64DEF(0xc21094364dfb5637), U64DEF(0x9096ea6f3848984f), U64DEF(0xd77485cb25823ac7),
+			U64DEF(0xa086cfcd97bf97f4), U64DEF(0xef340a98172aace5), U64DEF(0xb23867fb2a35b28e),
+			U64DEF(0x84c8d4dfd2c63f3b), U64DEF(0xc5dd44271ad3cdba), U64DEF(0x936b9fcebb25c996),
+			U64DEF(0xdbac6c247d62a584), U64DEF(0xa3ab66580d5fdaf6), U64DEF(0xf3e2f893dec3f126),
+			U64DEF(0xb5b5ada8aaff80b8), U64DEF(0x87625f056c7c4a8b), U64DEF(0xc9bcff6034c13053),
+			U64DEF(0x964e858c91ba2655), U64DEF(0xdff9772470297ebd), U64DEF(0xa6dfbd9fb8e5b88f),
+			U64DEF(0xf8a95fcf88747d94), U64DEF(0xb94470938fa89bcf), U64DEF(0x8a08f0f8bf0f156b),
+			U64DEF(0xcdb02555653131b6), U64DEF(0x993fe2c6d07b7fac), U64DEF(0xe45c10c42a2b3b06),
+			U64DEF(0xaa242499697392d3), U64DEF(0xfd87b5f28300ca0e), U64DEF(0xbce5086492111aeb),
+			U64DEF(0x8cbccc096f5088cc), U64DEF(0xd1b71758e219652c), U64DEF(0x9c40000000000000),
+			U64DEF(0xe8d4a51000000000), U64DEF(0xad78ebc5ac620000), U64DEF(0x813f3978f8940984),
+			U64DEF(0xc097ce7bc90715b3), U64DEF(0x8f7e32ce7bea5c70), U64DEF(0xd5d238a4abe98068),
+			U64DEF(0x9f4f2726179a2245), U64DEF(0xed63a231d4c4fb27), U64DEF(0xb0de65388cc8ada8),
+			U64DEF(0x83c7088e1aab65db), U64DEF(0xc45d1df942711d9a), U64DEF(0x924d692ca61be758),
+			U64DEF(0xda01ee641a708dea), U64DEF(0xa26da3999aef774a), U64DEF(0xf209787bb47d6b85),
+			U64DEF(0xb454e4a179dd1877), U64DEF(0x865b86925b9bc5c2), U64DEF(0xc83553c5c8965d3d),
+			U64DEF(0x952ab45cfa97a0b3), U64DEF(0xde469fbd99a05fe3), U64DEF(0xa59bc234db398c25),
+			U64DEF(0xf6c69a72a3989f5c), U64DEF(0xb7dcbf5354e9bece), U64DEF(0x88fcf317f22241e2),
+			U64DEF(0xcc20ce9bd35c78a5), U64DEF(0x98165af37b2153df), U64DEF(0xe2a0b5dc971f303a),
+			U64DEF(0xa8d9d1535ce3b396), U64DEF(0xfb9b7cd9a4a7443c), U64DEF(0xbb764c4ca7a44410),
+			U64DEF(0x8bab8eefb6409c1a), U64DEF(0xd01fef10a657842c), U64DEF(0x9b10a4e5e9913129),
+			U64DEF(0xe7109bfba19c0c9d), U64DEF(0xac2820d9623bf429), U64DEF(0x80444b5e7aa7cf85),
+			U64DEF(0xbf21e44003acdd2d), U64DEF(0x8e679c2f5e44ff8f), U64DEF(0xd433179d9c8cb841),
+			U64DEF(0x9e19db92b4e31ba9), U64DEF(0xeb96bf6ebadf77d9), U64DEF(0xaf87023b9bf0ee6b),
+		};
+
+		static const S16 charConvPowerExponents[] = {
+			-1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007, -980, -954, -927, -901, -874, -847,
+			-821, -794, -768, -741, -715, -688, -661, -635, -608, -582, -555, -529, -502, -475, -449,
+			-422, -396, -369, -343, -316, -289, -263, -236, -210, -183, -157, -130, -103, -77, -50,
+			-24, 3, 30, 56, 83, 109, 136, 162, 189, 216, 242, 269, 295, 322, 348,
+			375, 402, 428, 455, 481, 508, 534, 561, 588, 614, 641, 667, 694, 720, 747,
+			774, 800, 827, 853, 880, 907, 933, 960, 986, 1013, 1039, 1066,
+		};
+
+		static const U64 charConvPow10[] = {
+			U64DEF(1), U64DEF(10), U64DEF(100), U64DEF(1000), U64DEF(10000), U64DEF(100000), U64DEF(1000000), U64DEF(10000000), U64DEF(100000000),
+			U64DEF(1000000000), U64DEF(10000000000), U64DEF(100000000000), U64DEF(1000000000000), U64DEF(10000000000000), U64DEF(100000000000000),
+			U64DEF(1000000000000000), U64DEF(10000000000000000), U64DEF(100000000000000000), U64DEF(1000000000000000000),
+			U64DEF(10000000000000000000),
+		};
+
+		//Split a float into it's significand and exponent (and the boundaries halfway to it's neighbours), significandBits is 52 for F64 and 23 for F32
+		static void charConvBoundaries(U64 bits, U32 significandBits, U32 exponentBits, DiyFp &value, DiyFp &minus, DiyFp &plus) {
+			U64 hiddenBit = U64DEF(1) << significandBits;
+			S32 bias = (1 << (exponentBits - 1)) - 1 + (S32)significandBits;
+			U64 significand = bits & (hiddenBit - 1);
+			S32 biasedExponent = (S32)((bits >> significandBits) & ((1u << exponentBits) - 1));
+			if (biasedExponent != 0) {
+				value = DiyFp(significand + hiddenBit, biasedExponent - bias);
+			}
+			else {
+				value = DiyFp(significand, 1 - bias);
+			}
+			//The upper boundary, normalized so there's room for the lower one
+			plus = DiyFp((value.f << 1) + 1, value.e - 1);
+			while (!(plus.f & (hiddenBit << 1))) {
+				plus.f <<= 1;
+				plus.e--;
+			}
+			plus.f <<= 64 - significandBits - 2;
+			plus.e -= 64 - significandBits - 2;
+			//The lower boundary is closer when the value is a power of two (the exponent below has smaller steps)
+			minus = (value.f == hiddenBit) ? DiyFp((value.f << 2) - 1, value.e - 2) : DiyFp((value.f << 1) - 1, value.e - 1);
+			minus.f <<= minus.e - plus.e;
+			minus.e = plus.e;
+		}
+
+		//Fetch the cached power of ten that brings a value with binary exponent e into the range Grisu works in, k is the decimal exponent
+		static DiyFp charConvCachedPower(S32 e, S32 &k) {
+			F64 dk = (-61 - e) * 0.30102999566398114 + 347;
+			S32 ik = (S32)dk;
+			if (dk - ik > 0.0) {
+				ik++;
+			}
+			U32 index = (U32)((ik >> 3) + 1);
+			k = -(-348 + (S32)(index << 3));
+			return DiyFp(charConvPowerSignificands[index], charConvPowerExponents[index]);
+		}
+
+		//Walk the last digit down towards the value while it stays inside of the boundaries and gets closer
+		static void charConvRound(UTF8 buffer, U32 len, U64 delta, U64 rest, U64 tenKappa, U64 wpW) {
+			while (rest < wpW && delta - rest >= tenKappa && (rest + tenKappa < wpW || wpW - rest > rest + tenKappa - wpW)) {
+				buffer[len - 1]--;
+				rest += tenKappa;
+			}
+		}
+
+		//Count the decimal digits of the integer part (which is below 10^9)
+		static U32 charConvCountDigits(U32 n) {
+			U32 count = 1;
+			while (count < 9 && n >= (U32)charConvPow10[count]) {
+				count++;
+			}
+			return count;
+		}
+
+		//Generate the shortest digits in [W - delta, Mp], k is adjusted to the decimal exponent of the last digit
+		static void charConvDigits(const DiyFp &W, const DiyFp &Mp, U64 delta, UTF8 buffer, U32 &len, S32 &k) {
+			const DiyFp one(U64DEF(1) << -Mp.e, Mp.e);
+			const DiyFp wpW = Mp - W;
+			U32 p1 = (U32)(Mp.f >> -one.e);
+			U64 p2 = Mp.f & (one.f - 1);
+			S32 kappa = (S32)charConvCountDigits(p1);
+			len = 0;
+			while (kappa > 0) {
+				U32 divisor = (U32)charConvPow10[kappa - 1];
+				U32 d = p1 / divisor;
+				p1 %= divisor;
+				if (d || len) {
+					buffer[len++] = (C8)('0' + d);
+				}
+				kappa--;
+				U64 rest = ((U64)p1 << -one.e) + p2;
+				if (rest <= delta) {
+					k += kappa;
+					charConvRound(buffer, len, delta, rest, charConvPow10[kappa] << -one.e, wpW.f);
+					return;
+				}
+			}
+			for (;;) {
+				p2 *= 10;
+				delta *= 10;
+				C8 d = (C8)(p2 >> -one.e);
+				if (d || len) {
+					buffer[len++] = (C8)('0' + d);
+				}
+				p2 &= one.f - 1;
+				kappa--;
+				if (p2 < delta) {
+					k += kappa;
+					S32 index = -kappa;
+					charConvRound(buffer, len, delta, p2, one.f, wpW.f * (index < 20 ? charConvPow10[index] : 0));
+					return;
+				}
+			}
+		}
+
+		//Produce the shortest digits of a positive, finite, non zero float, the value is digits * 10^k
+		static void charConvGrisu(U64 bits, U32 significandBits, U32 exponentBits, UTF8 buffer, U32 &len, S32 &k) {
+			DiyFp value, minus, plus;
+			charConvBoundaries(bits, significandBits, exponentBits, value, minus, plus);
+			const DiyFp cached = charConvCachedPower(plus.e, k);
+			const DiyFp W = value.normalize() * cached;
+			DiyFp Wp = plus * cached, Wm = minus * cached;
+			//Shrink the interval by the error of the products, so every digit string inside of it reads back to the value
+			Wm.f++;
+			Wp.f--;
+			charConvDigits(W, Wp, Wp.f - Wm.f, buffer, len, k);
+		}
+
+		//Lay the digits out as %g does (decimal for exponents from -4 up to the amount of digits a F64 can hold, scientific otherwise)
+		static U32 charConvLayout(UTF8 out, UTF16 digits, U32 len, S32 k) {
+			UTF8 start = out;
+			//The position of the decimal point relative to the first digit
+			S32 point = (S32)len + k;
+			if (point > 0 && point <= 17) {
+				if ((S32)len <= point) {
+					//An integer, pad with zeros
+					memcpy(out, digits, len);
+					out += len;
+					for (S32 i = (S32)len; i < point; i++) {
+						*out++ = '0';
+					}
+				}
+				else {
+					memcpy(out, digits, point);
+					out += point;
+					*out++ = '.';
+					memcpy(out, digits + point, len - point);
+					out += len - point;
+				}
+			}
+			else if (point <= 0 && point > -4) {
+				*out++ = '0';
+				*out++ = '.';
+				for (S32 i = point; i < 0; i++) {
+					*out++ = '0';
+				}
+				memcpy(out, digits, len);
+				out += len;
+			}
+			else {
+				*out++ = digits[0];
+				if (len > 1) {
+					*out++ = '.';
+					memcpy(out, digits + 1, len - 1);
+					out += len - 1;
+				}
+				S32 exponent = point - 1;
+				*out++ = 'e';
+				*out++ = exponent < 0 ? '-' : '+';
+				if (exponent < 0) {
+					exponent = -exponent;
+				}
+				//At least two exponent digits, like printf
+				if (exponent >= 100) {
+					*out++ = (C8)('0' + exponent / 100);
+					exponent %= 100;
+				}
+				*out++ = (C8)('0' + exponent / 10);
+				*out++ = (C8)('0' + exponent % 10);
+			}
+			return (U32)(out - start);
+		}
+
+		//Write a float given it's bits and layout
+		static U32 charConvFloat(UTF8 buffer, U64 bits, U32 significandBits, U32 exponentBits) {
+			UTF8 out = buffer;
+			U32 totalBits = significandBits + exponentBits + 1;
+			U64 exponentMask = ((U64DEF(1) << exponentBits) - 1) << significandBits;
+			U64 significandMask = (U64DEF(1) << significandBits) - 1;
+			if ((bits & exponentMask) == exponentMask) {
+				if (bits & significandMask) {
+					memcpy(out, "nan", 3);
+					return 3;
+				}
+				if (bits >> (totalBits - 1)) {
+					*out++ = '-';
+				}
+				memcpy(out, "inf", 3);
+				return (U32)(out - buffer) + 3;
+			}
+			if (bits >> (totalBits - 1)) {
+				*out++ = '-';
+				bits &= ~(U64DEF(1) << (totalBits - 1));
+			}
+			if (bits == 0) {
+				*out++ = '0';
+				return (U32)(out - buffer);
+			}
+			C8 digits[20];
+			U32 len;
+			S32 k;
+			charConvGrisu(bits, significandBits, exponentBits, digits, len, k);
+			return (U32)(out - buffer) + charConvLayout(out, digits, len, k);
+		}
+
+		//Fetch the value of a digit in bases up to 36, or 36 for anything that isn't a digit
+		SFIN U32 charConvDigitValue(C8 c) {
+			if (c >= '0' && c <= '9') {
+				return (U32)(c - '0');
+			}
+			if (c >= 'a' && c <= 'z') {
+				return (U32)(c - 'a' + 10);
+			}
+			if (c >= 'A' && c <= 'Z') {
+				return (U32)(c - 'A' + 10);
+			}
+			return 36;
+		}
+
+		//Parse the digits of an unsigned value no larger than limit, the shared body of the integer parsers
+		static CharConv::ParseResult charConvParseInteger(UTF16 first, UTF16 last, U64 limit, U32 base, U64 &value) {
+			CharConv::ParseResult result = { first, CharConv::Conv_Invalid };
+			if (base < 2 || base > 36) {
+				GC_Error("CharConv::fromChars(): Base %u is not supported, use 2 - 36", base);
+				return result;
+			}
+			U64 accumulated = 0;
+			bool overflow = false;
+			UTF16 p = first;
+			for (; p < last; p++) {
+				U32 digit = charConvDigitValue(*p);
+				if (digit >= base) {
+					break;
+				}
+				//Keep consuming digits after an overflow, so end is past the whole number
+				if (!overflow) {
+					if (accumulated > (limit - digit) / base) {
+						overflow = true;
+					}
+					else {
+						accumulated = accumulated * base + digit;
+					}
+				}
+			}
+			if (p == first) {
+				return result;
+			}
+			result.end = p;
+			result.status = overflow ? CharConv::Conv_OutOfRange : CharConv::Conv_Ok;
+			value = accumulated;
+			return result;
+		}
+
+		//Parse an optionally signed integer whose magnitude is limited to maxPositive (and maxPositive + 1 when negative)
+		static CharConv::ParseResult charConvParseSigned(UTF16 first, UTF16 last, U64 maxPositive, U32 base, U64 &magnitude, bool &negative) {
+			UTF16 p = first;
+			negative = false;
+			if (p < last && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				p++;
+			}
+			CharConv::ParseResult result = charConvParseInteger(p, last, negative ? maxPositive + 1 : maxPositive, base, magnitude);
+			if (result.status == CharConv::Conv_Invalid) {
+				result.end = first;
+			}
+			return result;
+		}
+
+		//Parse an unsigned integer, a leading + is allowed but a - is not
+		static CharConv::ParseResult charConvParseUnsigned(UTF16 first, UTF16 last, U64 maxValue, U32 base, U64 &value) {
+			UTF16 p = (first < last && *first == '+') ? first + 1 : first;
+			CharConv::ParseResult result = charConvParseInteger(p, last, maxValue, base, value);
+			if (result.status == CharConv::Conv_Invalid) {
+				result.end = first;
+			}
+			return result;
+		}
+
+		//Match a word (case insensitive) at p, used for inf / infinity / nan
+		static bool charConvMatchWord(UTF16 p, UTF16 last, UTF16 word) {
+			for (; *word; word++, p++) {
+				if (p >= last || (*p | 0x20) != *word) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		//Was the parsed text inf / infinity (rather than a number too large for the type)?
+		static bool charConvIsInfinityText(UTF16 first, UTF16 end) {
+			C8 lastChar = (C8)(end[-1] | 0x20);
+			return lastChar == 'f' || lastChar == 'y';
+		}
+
+		//Powers of ten that are exact in a F64 / F32, for the fast path of the float parser
+		static const F64 charConvExactPow10[] = {
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+		};
+
+		static const F32 charConvExactPow10F[] = {
+			1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+		};
+
+		//Parse a float, single selects F32 rounding, the result is returned in value (as a F64 holding the F32 when single is set)
+		static CharConv::ParseResult charConvParseFloat(UTF16 first, UTF16 last, bool single, F64 &value) {
+			CharConv::ParseResult result = { first, CharConv::Conv_Invalid };
+			UTF16 p = first;
+			bool negative = false;
+			if (p < last && (*p == '-' || *p == '+')) {
+				negative = (*p == '-');
+				p++;
+			}
+			//The special values
+			if (charConvMatchWord(p, last, "inf")) {
+				result.end = charConvMatchWord(p, last, "infinity") ? p + 8 : p + 3;
+				result.status = CharConv::Conv_Ok;
+				value = negative ? -HUGE_VAL : HUGE_VAL;
+				return result;
+			}
+			if (charConvMatchWord(p, last, "nan")) {
+				result.end = p + 3;
+				result.status = CharConv::Conv_Ok;
+				value = negative ? -(F64)NAN : (F64)NAN;
+				return result;
+			}
+			//Collect up to 19 significant digits (which always fit in a U64), the rest only move the exponent
+			U64 mantissa = 0;
+			U32 significantDigits = 0;
+			S32 exponent = 0;
+			bool anyDigits = false, truncated = false, inFraction = false;
+			for (; p < last; p++) {
+				if (*p == '.' && !inFraction) {
+					inFraction = true;
+					continue;
+				}
+				if (*p < '0' || *p > '9') {
+					break;
+				}
+				U32 digit = (U32)(*p - '0');
+				anyDigits = true;
+				if (mantissa == 0 && digit == 0) {
+					//A leading zero, only the position matters
+					exponent -= inFraction ? 1 : 0;
+				}
+				else if (significantDigits < 19) {
+					mantissa = mantissa * 10 + digit;
+					significantDigits++;
+					exponent -= inFraction ? 1 : 0;
+				}
+				else {
+					truncated |= (digit != 0);
+					exponent += inFraction ? 0 : 1;
+				}
+			}
+			if (!anyDigits) {
+				return result;
+			}
+			//The exponent is only part of the number when there are digits after the e (and it's sign)
+			if (p < last && (*p == 'e' || *p == 'E')) {
+				UTF16 q = p + 1;
+				bool negativeExponent = false;
+				if (q < last && (*q == '-' || *q == '+')) {
+					negativeExponent = (*q == '-');
+					q++;
+				}
+				if (q < last && *q >= '0' && *q <= '9') {
+					S32 written = 0;
+					for (; q < last && *q >= '0' && *q <= '9'; q++) {
+						//Anything past this overflows or underflows every float, so stop counting
+						if (written < 100000) {
+							written = written * 10 + (*q - '0');
+						}
+					}
+					exponent += negativeExponent ? -written : written;
+					p = q;
+				}
+			}
+			result.end = p;
+			result.status = CharConv::Conv_Ok;
+			if (mantissa == 0) {
+				value = negative ? -0.0 : 0.0;
+				return result;
+			}
+			//The fast path: an exact mantissa and an exact power of ten give a correctly rounded result from a single operation
+			if (!truncated && single && mantissa <= (U64DEF(1) << 24) && exponent >= -10 && exponent <= 10) {
+				F32 f = (F32)mantissa;
+				f = exponent < 0 ? f / charConvExactPow10F[-exponent] : f * charConvExactPow10F[exponent];
+				value = negative ? -f : f;
+				return result;
+			}
+			if (!truncated && !single && mantissa <= (U64DEF(1) << 53) && exponent >= -22 && exponent <= 22) {
+				F64 d = (F64)mantissa;
+				d = exponent < 0 ? d / charConvExactPow10[-exponent] : d * charConvExactPow10[exponent];
+				value = negative ? -d : d;
+				return result;
+			}
+			//Everything else goes through the C library, which rounds correctly in all cases. The number is copied out to terminate it, and the
+			// syntax was already checked so strtod() can't read anything else (Note: strtod() uses the decimal point of the C locale).
+			U32 length = (U32)(p - first);
+			C8 local[128];
+			UTF8 text = length < sizeof(local) ? local : (UTF8)Memory::gmalloc(length + 1);
+			memcpy(text, first, length);
+			text[length] = '\0';
+			value = single ? (F64)strtof(text, NULL) : strtod(text, NULL);
+			if (text != local) {
+				Memory::gfree(text);
+			}
+			return result;
+		}
+
+		/*
+		 CharConv Class Definitions
+		*/
+
+		U32 CharConv::toChars(C8 (&buffer)[MaxChars], F64 value) {
+			U64 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return charConvFloat(buffer, bits, 52, 11);
+		}
+
+		U32 CharConv::toChars(C8 (&buffer)[MaxChars], F32 value) {
+			U32 bits;
+			memcpy(&bits, &value, sizeof(bits));
+			return charConvFloat(buffer, bits, 23, 8);
+		}
+
+		U32 CharConv::toChars(C8 (&buffer)[MaxChars], S64 value) {
+			if (value < 0) {
+				buffer[0] = '-';
+				//Negate as unsigned so the lowest S64 converts correctly.
+				UTF8 start = Format::writeDecimal((U64)0 - (U64)value, buffer + MaxChars);
+				U32 len = (U32)(buffer + MaxChars - start);
+				memmove(buffer + 1, start, len);
+				return len + 1;
+			}
+			return toChars(buffer, (U64)value);
+		}
+
+		U32 CharConv::toChars(C8 (&buffer)[MaxChars], U64 value) {
+			UTF8 start = Format::writeDecimal(value, buffer + MaxChars);
+			U32 len = (U32)(buffer + MaxChars - start);
+			memmove(buffer, start, len);
+			return len;
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, S32 &value, U32 base) {
+			U64 magnitude;
+			bool negative;
+			ParseResult result = charConvParseSigned(first, last, 0x7FFFFFFF, base, magnitude, negative);
+			if (result.ok()) {
+				value = negative ? (S32)(0 - (U32)magnitude) : (S32)magnitude;
+			}
+			return result;
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, U32 &value, U32 base) {
+			U64 parsed;
+			ParseResult result = charConvParseUnsigned(first, last, 0xFFFFFFFF, base, parsed);
+			if (result.ok()) {
+				value = (U32)parsed;
+			}
+			return result;
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, S64 &value, U32 base) {
+			U64 magnitude;
+			bool negative;
+			ParseResult result = charConvParseSigned(first, last, U64DEF(0x7FFFFFFFFFFFFFFF), base, magnitude, negative);
+			if (result.ok()) {
+				value = negative ? (S64)(0 - magnitude) : (S64)magnitude;
+			}
+			return result;
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, U64 &value, U32 base) {
+			return charConvParseUnsigned(first, last, ~U64DEF(0), base, value);
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, F32 &value) {
+			F64 parsed;
+			ParseResult result = charConvParseFloat(first, last, true, parsed);
+			if (result.ok()) {
+				//A finite number too large for a F32 rounds to infinity
+				if ((parsed == HUGE_VAL || parsed == -HUGE_VAL) && !charConvIsInfinityText(first, result.end)) {
+					result.status = Conv_OutOfRange;
+				}
+				else {
+					value = (F32)parsed;
+				}
+			}
+			return result;
+		}
+
+		CharConv::ParseResult CharConv::fromChars(UTF16 first, UTF16 last, F64 &value) {
+			F64 parsed;
+			ParseResult result = charConvParseFloat(first, last, false, parsed);
+			if (result.ok()) {
+				if ((parsed == HUGE_VAL || parsed == -HUGE_VAL) && !charConvIsInfinityText(first, result.end)) {
+					result.status = Conv_OutOfRange;
+				}
+				else {
+					value = parsed;
+				}
+			}
+			return result;
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/charConv.h
+* Defines the conversions between numbers and their text form
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_CHARCONV
+#define GALACTIC_INTERNAL_CHARCONV
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		CharConv: Conversions between numbers and text that don't go through printf / scanf (or the C locale). toChars() writes the shortest text
+		 that reads back to exactly the same value (Grisu2) for floats, and uses the Format digit pair writer for integers. fromChars() parses a
+		 number from a range of characters and reports how far it got and why it stopped, without requiring a terminator.
+		 Floats are written as %g would lay them out (1.5, 0.0001, 1e+30), but with as many digits as the value needs, inf and nan are written as
+		 "inf" and "nan". Parsing accepts an optional sign, digits with an optional fraction and exponent, and inf / infinity / nan.
+		*/
+		class CharConv {
+			public:
+				//The result of a parse
+				enum ConvStatus {
+					//The number was parsed, end points past it
+					Conv_Ok,
+					//There was no number at the start of the range, end is the start of the range
+					Conv_Invalid,
+					//The number doesn't fit in the type, end points past it and the value is left unchanged
+					Conv_OutOfRange,
+				};
+
+				//The result of fromChars()
+				struct ParseResult {
+					//The first character that is not part of the number
+					UTF16 end;
+					//How the parse went
+					ConvStatus status;
+
+					//Did the parse succeed?
+					bool ok() const { return status == Conv_Ok; }
+				};
+
+				//The largest amount of characters toChars() writes for any float ("-2.2250738585072014e-308") or integer, plus a terminator
+				enum {
+					MaxChars = 32,
+				};
+
+				/* Public Class Methods */
+				//Write the shortest representation of a F64 that parses back to the same value, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], F64 value);
+				//Write the shortest representation of a F32 that parses back to the same value, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], F32 value);
+				//Write a S64 in decimal, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], S64 value);
+				//Write a U64 in decimal, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], U64 value);
+				//Write a S32 in decimal, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], S32 value) { return toChars(buffer, (S64)value); }
+				//Write a U32 in decimal, returns the length (the text is not terminated)
+				static U32 toChars(C8 (&buffer)[MaxChars], U32 value) { return toChars(buffer, (U64)value); }
+
+				//Parse a S32 in the specified base (2 - 36) from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, S32 &value, U32 base = 10);
+				//Parse a U32 in the specified base (2 - 36) from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, U32 &value, U32 base = 10);
+				//Parse a S64 in the specified base (2 - 36) from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, S64 &value, U32 base = 10);
+				//Parse a U64 in the specified base (2 - 36) from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, U64 &value, U32 base = 10);
+				//Parse a F32 from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, F32 &value);
+				//Parse a F64 from [first, last)
+				static ParseResult fromChars(UTF16 first, UTF16 last, F64 &value);
+
+				//Parse a whole StringView as a number, anything left over (or a failed parse) returns false and leaves value unchanged
+				template <typename T> static bool parse(const StringView &text, T &value) {
+					T result;
+					ParseResult r = fromChars(text.begin(), text.end(), result);
+					if (!r.ok() || r.end != text.end()) {
+						return false;
+					}
+					value = result;
+					return true;
+				}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_CHARCONV
\ No newline at end of file
@@ -59,12 +59,21 @@ namespace Galactic {
 				void append(UTF16 toAppend) {
 					strncat(cmdLine, toAppend, getArrayCount(cmdLine));
 				}
+				//Split the command line parameters into a dynArray of views of the parameter tokens, the views point into cmdLineTxt.
+				void splitToTokens(UTF16 cmdLineTxt, DynArray<StringView> &tokens) {
+					StringView nextTokenInst;
+					while (StrTools::fetchCmdLineToken(cmdLineTxt, nextTokenInst)) {
+						if (nextTokenInst[0] == '-') {
+							tokens.pushToBack(nextTokenInst);
+						}
+					}
+				}
 				//Split the command line parameters into a dynArray of string token instances for individual parsing.
 				void splitToTokens(UTF16 cmdLineTxt, DynArray<String> &tokens) {
-					String nextTokenInst;
-					while (StrTools::fetchCmdLineToken(cmdLineTxt, nextTokenInst, false)) {
-						if (*(nextTokenInst.c_str()) == '-') {
-							tokens.pushToBack(nextTokenInst);
+					StringView nextTokenInst;
+					while (StrTools::fetchCmdLineToken(cmdLineTxt, nextTokenInst)) {
+						if (nextTokenInst[0] == '-') {
+							tokens.pushToBack(String(nextTokenInst));
 						}
 					}
 				}
@@ -46,6 +46,12 @@ namespace Galactic {
 			__split(path);
 		}
 
+		FilePath::FilePath(const StringView &path) {
+			fileNameDirty = true;
+			filePathDirty = true;
+			__split(String(path));
+		}
+
 		bool FilePath::empty() const {
 			return getFullPath().empty();
 		}
@@ -154,47 +160,49 @@ namespace Galactic {
 			return true;
 		}
 
-		String FilePath::join(strRef p1, strRef p2, C8 sep) {
+		String FilePath::join(const StringView &p1, const StringView &p2, C8 sep) {
+			//The result is built in one go from the two views, so joining never creates intermediate Strings
+			StringBuilder result(p1.length() + p2.length() + 1);
 			if(sep == '/') {
-				if(p2.empty() || (p2.length() == 1 && (p2.c_str()[0] == '/'))) {
-					return p1;
+				if(p2.empty() || (p2.length() == 1 && (p2[0] == '/'))) {
+					return String(p1);
 				}
 				if(p1.empty()) {
-					return p2;
+					return String(p2);
 				}
 				//Grab the last char from p1.
 				C8 tmp = p1[p1.length() - 1];
 				//Test for special cases.
 				// We perform an xOR operation here to test and toggle the boolean status
-				if(tmp == ':' || ((tmp == '/') ^ (p2.c_str()[0] == '/'))) {
+				if(tmp == ':' || ((tmp == '/') ^ (p2[0] == '/'))) {
 					//If this is the case, then we can skip the separator.
-					return p1 + p2;
+					return result.append(p1).append(p2).build();
 				}
-				if(tmp == '/' && p2.c_str()[0] == '/') {
+				if(tmp == '/' && p2[0] == '/') {
 					//Another example is if we're adding a absolute to a relative. We simply chop off the last char from p1 and add p2 to it.
-					return p1.substr(0, p1.length() - 1) + p2;
+					return result.append(p1.dropBack(1)).append(p2).build();
 				}
 			}
 			else if(sep == ':') {
 				if(p1.empty()) {
-					return p2;
+					return String(p2);
 				}
 				if(p2.empty()) {
-					return p1 + ':';
+					return result.append(p1).append(':').build();
 				}
 			}
 			else if(sep == '.') {
 				if(p2.empty()) {
-					return p1;
+					return String(p1);
 				}
 				if(p1.empty()) {
-					return '.' + p2;
+					return result.append('.').append(p2).build();
 				}					
 			}
 			else {
 				//Do nothing..
 			}
-			return p1 + sep + p2;
+			return result.append(p1).append(sep).append(p2).build();
 		}
 
 		String FilePath::fixSeparators(String path) {
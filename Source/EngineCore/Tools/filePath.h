@@ -46,6 +46,8 @@ namespace Galactic {
 				FilePath(UTF16 path);
 				//Create from String
 				FilePath(strRef path);
+				//Create from StringView
+				FilePath(const StringView &path);
 
 				/* Class Functions */
 				//Check if the path is empty
@@ -73,7 +75,7 @@ namespace Galactic {
 
 				/* Static Methods */
 				//Join Two Paths
-				static String join(strRef p1, strRef p2, C8 sep);
+				static String join(const StringView &p1, const StringView &p2, C8 sep);
 				//Fix the separators to a platform accepted form
 				static String fixSeparators(String path);
 				//Remove relative paths
@@ -0,0 +1,625 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/format.cpp
+* Defines the type safe string formatter used by String::ToStr() and the Console
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		//Two digit pairs for 00 - 99, converting two digits per division halves the work of a number conversion.
+		static const C8 formatDigitPairs[201] =
+			"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+			"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		/*
+		FormatSpec: The parsed specification of a placeholder.
+		*/
+		struct FormatSpec {
+			//The padding character
+			C8 fill;
+			//The alignment (<, > or ^), 0 for the default of the type
+			C8 align;
+			//The sign to print for positive numbers (+ or space), 0 for none
+			C8 sign;
+			//Print the 0x / 0b / 0 prefix, or keep the decimal point
+			bool alternate;
+			//Pad numbers with zeros after the sign
+			bool zeroPad;
+			//The minimum width
+			U32 width;
+			//The precision, -1 when not specified
+			S32 precision;
+			//The type character, 0 when not specified
+			C8 type;
+
+			FormatSpec() : fill(' '), align(0), sign(0), alternate(false), zeroPad(false), width(0), precision(-1), type(0) { }
+		};
+
+		/*
+		FormatOutput: The destination of the formatter.
+		*/
+		class FormatOutput {
+			public:
+				virtual ~FormatOutput() { }
+				//Write characters
+				virtual void write(UTF16 str, U32 len) = 0;
+				//Write a character count times
+				void fill(C8 c, U32 count) {
+					C8 chunk[32];
+					Memory::gmemset(chunk, c, count < sizeof(chunk) ? count : sizeof(chunk));
+					while (count > 0) {
+						U32 amount = count < sizeof(chunk) ? count : (U32)sizeof(chunk);
+						write(chunk, amount);
+						count -= amount;
+					}
+				}
+		};
+
+		//Writes to a StringBuilder
+		class BuilderFormatOutput : public FormatOutput {
+			public:
+				BuilderFormatOutput(StringBuilder &b) : builder(b) { }
+				virtual void write(UTF16 str, U32 len) {
+					builder.append(str, len);
+				}
+
+			private:
+				StringBuilder &builder;
+		};
+
+		//Writes to a fixed buffer, counting the characters that did not fit
+		class BufferFormatOutput : public FormatOutput {
+			public:
+				BufferFormatOutput(UTF8 b, U32 s) : buffer(b), size(s), total(0) { }
+				virtual void write(UTF16 str, U32 len) {
+					if (total + 1 < size) {
+						U32 room = size - 1 - total;
+						Memory::gmemcpy(buffer + total, str, len < room ? len : room);
+					}
+					total += len;
+				}
+				U32 finish() {
+					if (size > 0) {
+						buffer[total < size ? total : size - 1] = '\0';
+					}
+					return total;
+				}
+
+			private:
+				UTF8 buffer;
+				U32 size;
+				U32 total;
+		};
+
+		//Writes to a block in the FrameArena, which grows in place while it's the last allocation of the thread
+		class ArenaFormatOutput : public FormatOutput {
+			public:
+				ArenaFormatOutput() : buffer(NULL), capacity(0), used(0) { }
+				virtual void write(UTF16 str, U32 len) {
+					if (used + len + 1 > capacity) {
+						U32 newCapacity = (used + len + 1) > capacity * 2 ? (used + len + 1) : capacity * 2;
+						if (newCapacity < 64) {
+							newCapacity = 64;
+						}
+						buffer = buffer ? (UTF8)FrameArena::realloc(buffer, capacity, newCapacity, 1) : (UTF8)FrameArena::alloc(newCapacity, 1);
+						capacity = newCapacity;
+					}
+					Memory::gmemcpy(buffer + used, str, len);
+					used += len;
+				}
+				UTF8 finish() {
+					if (buffer == NULL) {
+						write("", 0);
+					}
+					buffer[used] = '\0';
+					return buffer;
+				}
+
+			private:
+				UTF8 buffer;
+				U32 capacity;
+				U32 used;
+		};
+
+		//Test if a type character asks for an integer presentation
+		SFIN bool isIntegerType(C8 type) {
+			return type == 'd' || type == 'i' || type == 'u' || type == 'x' || type == 'X' || type == 'o' || type == 'b' || type == 'B';
+		}
+
+		//Test if a type character asks for a floating point presentation
+		SFIN bool isFloatType(C8 type) {
+			return type == 'f' || type == 'F' || type == 'e' || type == 'E' || type == 'g' || type == 'G' || type == 'a' || type == 'A';
+		}
+
+		//Write a prefix and a body, padded to the width of the spec
+		static void writePadded(FormatOutput &out, const FormatSpec &spec, UTF16 prefix, U32 prefixLen, UTF16 body, U32 bodyLen, C8 defaultAlign,
+			bool numeric) {
+			U32 total = prefixLen + bodyLen;
+			U32 padding = spec.width > total ? spec.width - total : 0;
+			if (padding > 0 && numeric && spec.zeroPad && spec.align == 0) {
+				if (prefixLen > 0) {
+					out.write(prefix, prefixLen);
+				}
+				out.fill('0', padding);
+				out.write(body, bodyLen);
+				return;
+			}
+			C8 align = spec.align ? spec.align : defaultAlign;
+			U32 before = align == '<' ? 0 : (align == '^' ? padding / 2 : padding);
+			out.fill(spec.fill, before);
+			if (prefixLen > 0) {
+				out.write(prefix, prefixLen);
+			}
+			out.write(body, bodyLen);
+			out.fill(spec.fill, padding - before);
+		}
+
+		//Write an integer
+		static void writeInteger(FormatOutput &out, const FormatSpec &spec, U64 magnitude, bool negative) {
+			C8 digits[72];
+			UTF8 end = digits + sizeof(digits), start;
+			C8 prefix[3];
+			U32 prefixLen = 0;
+			if (negative) {
+				prefix[prefixLen++] = '-';
+			}
+			else if (spec.sign == '+' || spec.sign == ' ') {
+				prefix[prefixLen++] = spec.sign;
+			}
+			switch (spec.type) {
+				case 'x':
+				case 'X': {
+					UTF16 hexDigits = spec.type == 'x' ? "0123456789abcdef" : "0123456789ABCDEF";
+					start = end;
+					do {
+						*--start = hexDigits[magnitude & 0xF];
+						magnitude >>= 4;
+					} while (magnitude != 0);
+					if (spec.alternate) {
+						prefix[prefixLen++] = '0';
+						prefix[prefixLen++] = spec.type;
+					}
+					break;
+				}
+				case 'o':
+					start = end;
+					do {
+						*--start = (C8)('0' + (magnitude & 7));
+						magnitude >>= 3;
+					} while (magnitude != 0);
+					if (spec.alternate && *start != '0') {
+						*--start = '0';
+					}
+					break;
+				case 'b':
+				case 'B':
+					start = end;
+					do {
+						*--start = (C8)('0' + (magnitude & 1));
+						magnitude >>= 1;
+					} while (magnitude != 0);
+					if (spec.alternate) {
+						prefix[prefixLen++] = '0';
+						prefix[prefixLen++] = spec.type;
+					}
+					break;
+				default:
+					start = Format::writeDecimal(magnitude, end);
+					break;
+			}
+			//An integer precision is the minimum amount of digits (printf)
+			while (spec.precision > 0 && end - start < spec.precision && start > digits) {
+				*--start = '0';
+			}
+			writePadded(out, spec, prefix, prefixLen, start, (U32)(end - start), '>', true);
+		}
+
+		//Write a floating point value, single is set for F32 arguments so their shortest form is used
+		static void writeFloat(FormatOutput &out, const FormatSpec &spec, F64 v, bool single = false) {
+			if (!isFloatType(spec.type) && spec.precision < 0) {
+				//No type or precision, write the shortest text that reads back to the same value (CharConv)
+				C8 shortest[CharConv::MaxChars];
+				U32 len = single ? CharConv::toChars(shortest, (F32)v) : CharConv::toChars(shortest, v);
+				if (shortest[0] == '-') {
+					writePadded(out, spec, shortest, 1, shortest + 1, len - 1, '>', true);
+				}
+				else if (spec.sign == '+' || spec.sign == ' ') {
+					writePadded(out, spec, &spec.sign, 1, shortest, len, '>', true);
+				}
+				else {
+					writePadded(out, spec, NULL, 0, shortest, len, '>', true);
+				}
+				return;
+			}
+			//Build the printf specification, the padding is applied by writePadded
+			C8 printfSpec[16];
+			U32 pos = 0;
+			printfSpec[pos++] = '%';
+			if (spec.sign == '+' || spec.sign == ' ') {
+				printfSpec[pos++] = spec.sign;
+			}
+			if (spec.alternate) {
+				printfSpec[pos++] = '#';
+			}
+			printfSpec[pos++] = '.';
+			printfSpec[pos++] = '*';
+			printfSpec[pos++] = isFloatType(spec.type) ? spec.type : 'g';
+			printfSpec[pos] = '\0';
+			//The precision is limited so the largest %f output (309 digits) always fits.
+			S32 precision = spec.precision < 0 ? 6 : (spec.precision > 100 ? 100 : spec.precision);
+			C8 digits[512];
+			S32 len = snprintf(digits, sizeof(digits), printfSpec, precision, v);
+			if (len < 0) {
+				len = 0;
+			}
+			//Keep the sign in front of zero padding
+			U32 signLen = (len > 0 && (digits[0] == '-' || digits[0] == '+' || digits[0] == ' ')) ? 1 : 0;
+			writePadded(out, spec, digits, signLen, digits + signLen, (U32)len - signLen, '>', true);
+		}
+
+		//Write a string
+		static void writeString(FormatOutput &out, const FormatSpec &spec, UTF16 str, U32 len) {
+			if (str == NULL) {
+				str = "(null)";
+				len = 6;
+			}
+			else if (len == U32(~0)) {
+				//With a precision the string only has to be terminated within it (ex: '%.*s' of a view), so never scan past it
+				if (spec.precision >= 0) {
+					cAny end = memchr(str, 0, (size_t)spec.precision);
+					len = end ? (U32)((UTF16)end - str) : (U32)spec.precision;
+				}
+				else {
+					len = (U32)strlen(str);
+				}
+			}
+			if (spec.precision >= 0 && (U32)spec.precision < len) {
+				len = (U32)spec.precision;
+			}
+			if (spec.width == 0) {
+				out.write(str, len);
+				return;
+			}
+			writePadded(out, spec, NULL, 0, str, len, '<', false);
+		}
+
+		//Write an argument using a spec
+		static void writeArg(FormatOutput &out, const FormatSpec &spec, const FormatArg &arg) {
+			switch (arg.type) {
+				case FormatArg::Type_Bool:
+					if (isIntegerType(spec.type)) {
+						writeInteger(out, spec, arg.value.u, false);
+					}
+					else {
+						writeString(out, spec, arg.value.u ? "true" : "false", arg.value.u ? 4 : 5);
+					}
+					break;
+				case FormatArg::Type_Char:
+					if (isIntegerType(spec.type)) {
+						writeInteger(out, spec, arg.value.s < 0 ? (U64)0 - (U64)arg.value.s : (U64)arg.value.s, arg.value.s < 0);
+					}
+					else {
+						C8 c = (C8)arg.value.s;
+						writeString(out, spec, &c, 1);
+					}
+					break;
+				case FormatArg::Type_Signed:
+				case FormatArg::Type_Unsigned: {
+					if (spec.type == 'c') {
+						C8 c = (C8)arg.value.u;
+						writeString(out, spec, &c, 1);
+					}
+					else if (isFloatType(spec.type)) {
+						writeFloat(out, spec, arg.type == FormatArg::Type_Signed ? (F64)arg.value.s : (F64)arg.value.u);
+					}
+					else if (arg.type == FormatArg::Type_Signed && arg.value.s < 0) {
+						if (spec.type == 'u' || spec.type == 'x' || spec.type == 'X' || spec.type == 'o' || spec.type == 'b' || spec.type == 'B') {
+							//Print the bits of the original type, as printf would.
+							U64 mask = arg.size >= 8 ? ~(U64)0 : (((U64)1 << (arg.size * 8)) - 1);
+							writeInteger(out, spec, arg.value.u & mask, false);
+						}
+						else {
+							writeInteger(out, spec, (U64)0 - arg.value.u, true);
+						}
+					}
+					else {
+						writeInteger(out, spec, arg.value.u, false);
+					}
+					break;
+				}
+				case FormatArg::Type_Float:
+					if (isIntegerType(spec.type)) {
+						writeInteger(out, spec, arg.value.f < 0 ? (U64)(-arg.value.f) : (U64)arg.value.f, arg.value.f < 0);
+					}
+					else {
+						writeFloat(out, spec, arg.value.f, arg.size == sizeof(F32));
+					}
+					break;
+				case FormatArg::Type_String:
+					writeString(out, spec, arg.value.str, arg.length);
+					break;
+				case FormatArg::Type_Pointer: {
+					FormatSpec pointerSpec = spec;
+					if (!isIntegerType(spec.type)) {
+						pointerSpec.type = 'x';
+						pointerSpec.alternate = true;
+					}
+					writeInteger(out, pointerSpec, (U64)(IntPointer)arg.value.ptr, false);
+					break;
+				}
+				default:
+					writeString(out, spec, "<missing>", 9);
+					break;
+			}
+		}
+
+		//Parse a decimal number
+		SFIN U32 parseFormatNumber(UTF16 &p) {
+			U32 result = 0;
+			while (*p >= '0' && *p <= '9') {
+				result = result * 10 + (*p++ - '0');
+			}
+			return result;
+		}
+
+		//Parse the inside of a {} placeholder (after the opening brace), returns false if it's not a valid placeholder
+		static bool parseBraceSpec(UTF16 &p, FormatSpec &spec, U32 &index, bool &indexed) {
+			indexed = false;
+			if (*p >= '0' && *p <= '9') {
+				index = parseFormatNumber(p);
+				indexed = true;
+			}
+			if (*p == ':') {
+				p++;
+				if (p[0] != '\0' && (p[1] == '<' || p[1] == '>' || p[1] == '^')) {
+					spec.fill = p[0];
+					spec.align = p[1];
+					p += 2;
+				}
+				else if (*p == '<' || *p == '>' || *p == '^') {
+					spec.align = *p++;
+				}
+				if (*p == '+' || *p == ' ') {
+					spec.sign = *p++;
+				}
+				else if (*p == '-') {
+					p++;
+				}
+				if (*p == '#') {
+					spec.alternate = true;
+					p++;
+				}
+				if (*p == '0') {
+					spec.zeroPad = true;
+					p++;
+				}
+				spec.width = parseFormatNumber(p);
+				if (*p == '.') {
+					p++;
+					spec.precision = (S32)parseFormatNumber(p);
+				}
+				if (*p != '}' && *p != '\0') {
+					spec.type = *p++;
+				}
+			}
+			if (*p != '}') {
+				return false;
+			}
+			p++;
+			return true;
+		}
+
+		//Fetch an integer argument used as a * width or precision
+		static S32 fetchStarArg(const FormatArg *args, U32 count, U32 &nextArg) {
+			if (nextArg >= count) {
+				return 0;
+			}
+			const FormatArg &arg = args[nextArg++];
+			return (arg.type == FormatArg::Type_Signed || arg.type == FormatArg::Type_Unsigned) ? (S32)arg.value.s : 0;
+		}
+
+		//Parse a printf specification (after the %), returns false if it's not a valid specification
+		static bool parsePercentSpec(UTF16 &p, FormatSpec &spec, const FormatArg *args, U32 count, U32 &nextArg) {
+			spec.align = '>';
+			for (;; p++) {
+				if (*p == '-') {
+					spec.align = '<';
+				}
+				else if (*p == '+' || (*p == ' ' && spec.sign != '+')) {
+					spec.sign = *p;
+				}
+				else if (*p == '#') {
+					spec.alternate = true;
+				}
+				else if (*p == '0') {
+					spec.zeroPad = true;
+				}
+				else {
+					break;
+				}
+			}
+			if (*p == '*') {
+				S32 width = fetchStarArg(args, count, nextArg);
+				if (width < 0) {
+					spec.align = '<';
+					width = -width;
+				}
+				spec.width = (U32)width;
+				p++;
+			}
+			else {
+				spec.width = parseFormatNumber(p);
+			}
+			if (*p == '.') {
+				p++;
+				if (*p == '*') {
+					spec.precision = fetchStarArg(args, count, nextArg);
+					p++;
+				}
+				else {
+					spec.precision = (S32)parseFormatNumber(p);
+				}
+			}
+			//The size modifiers are not needed, the argument knows it's own size.
+			while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'z' || *p == 'j' || *p == 't' || *p == 'q') {
+				p++;
+			}
+			if (*p == 'I') {
+				p++;
+				if ((p[0] == '6' && p[1] == '4') || (p[0] == '3' && p[1] == '2')) {
+					p += 2;
+				}
+			}
+			C8 type = *p;
+			if (type == 'd' || type == 'i' || type == 'u' || type == 'x' || type == 'X' || type == 'o' || type == 'c' || type == 's' || type == 'p'
+				|| isFloatType(type)) {
+				//Zero padding is ignored when left aligning, leave the alignment to the zero padding otherwise.
+				if (spec.zeroPad && spec.align == '>') {
+					spec.align = 0;
+				}
+				spec.type = (type == 's' || type == 'p') ? 0 : type;
+				p++;
+				return true;
+			}
+			return false;
+		}
+
+		//Test if a format string is written in the printf syntax, which is the case when it has no braces at all
+		static bool usesPercentSyntax(UTF16 format) {
+			for (UTF16 p = format; *p; p++) {
+				if (*p == '{' || *p == '}') {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		//The formatter
+		static void formatCore(FormatOutput &out, UTF16 format, const FormatArg *args, U32 count) {
+			if (format == NULL) {
+				GC_Error("Format::formatArgs(): Cannot format a NULL format string.");
+				return;
+			}
+			//The syntax is picked once for the whole string, a % in a {} format (or a brace in a printf format) is plain text.
+			const bool percentSyntax = usesPercentSyntax(format);
+			U32 nextArg = 0;
+			UTF16 p = format;
+			while (*p) {
+				//Copy the literal text up to the next special character in one write
+				UTF16 literal = p;
+				while (*p && (percentSyntax ? *p != '%' : (*p != '{' && *p != '}'))) {
+					p++;
+				}
+				if (p != literal) {
+					out.write(literal, (U32)(p - literal));
+				}
+				if (*p == '\0') {
+					break;
+				}
+				UTF16 start = p++;
+				FormatSpec spec;
+				if (*start == '{') {
+					if (*p == '{') {
+						out.write("{", 1);
+						p++;
+						continue;
+					}
+					U32 index = 0;
+					bool indexed = false;
+					if (!parseBraceSpec(p, spec, index, indexed)) {
+						out.write("{", 1);
+						p = start + 1;
+						continue;
+					}
+					if (!indexed) {
+						index = nextArg++;
+					}
+					writeArg(out, spec, index < count ? args[index] : FormatArg());
+				}
+				else if (*start == '}') {
+					out.write("}", 1);
+					if (*p == '}') {
+						p++;
+					}
+				}
+				else {
+					if (*p == '%') {
+						out.write("%", 1);
+						p++;
+						continue;
+					}
+					if (!parsePercentSpec(p, spec, args, count, nextArg)) {
+						out.write("%", 1);
+						p = start + 1;
+						continue;
+					}
+					U32 index = nextArg++;
+					writeArg(out, spec, index < count ? args[index] : FormatArg());
+				}
+			}
+		}
+
+		/*
+		Format Class Definitions
+		*/
+		void Format::formatArgs(StringBuilder &out, UTF16 format, const FormatArg *args, U32 count) {
+			BuilderFormatOutput output(out);
+			formatCore(output, format, args, count);
+		}
+
+		U32 Format::formatArgs(UTF8 buffer, U32 size, UTF16 format, const FormatArg *args, U32 count) {
+			BufferFormatOutput output(buffer, size);
+			formatCore(output, format, args, count);
+			return output.finish();
+		}
+
+		UTF8 Format::formatArgsToArena(UTF16 format, const FormatArg *args, U32 count) {
+			ArenaFormatOutput output;
+			formatCore(output, format, args, count);
+			return output.finish();
+		}
+
+		UTF8 Format::writeDecimal(U64 v, UTF8 end) {
+			while (v >= 100) {
+				U32 pair = (U32)(v % 100) * 2;
+				v /= 100;
+				*--end = formatDigitPairs[pair + 1];
+				*--end = formatDigitPairs[pair];
+			}
+			if (v >= 10) {
+				*--end = formatDigitPairs[v * 2 + 1];
+				*--end = formatDigitPairs[v * 2];
+			}
+			else {
+				*--end = (C8)('0' + v);
+			}
+			return end;
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -0,0 +1,241 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/format.h
+* Defines the type safe string formatter used by String::ToStr() and the Console
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_FORMAT
+#define GALACTIC_INTERNAL_FORMAT
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		FormatArg: A single argument to the formatter. Every supported type has a constructor, so passing an argument of a type the formatter does not
+		 know how to print is a compile error rather than undefined behaviour at runtime. Strings are referenced, not copied, so a FormatArg must not
+		 outlive the argument it was created from.
+		*/
+		class FormatArg {
+			public:
+				/* Public Class Members */
+				//The kinds of values held by a FormatArg
+				enum Types {
+					Type_None,
+					Type_Bool,
+					Type_Char,
+					Type_Signed,
+					Type_Unsigned,
+					Type_Float,
+					Type_String,
+					Type_Pointer,
+				};
+
+				/* Constructors */
+				//Default Constructor, used to terminate argument lists
+				FormatArg() : type(Type_None), size(0), length(0) { value.u = 0; }
+				FormatArg(bool v) : type(Type_Bool), size(1), length(0) { value.u = v ? 1 : 0; }
+				FormatArg(char v) : type(Type_Char), size(1), length(0) { value.s = v; }
+				FormatArg(signed char v) : type(Type_Signed), size(sizeof(v)), length(0) { value.s = v; }
+				FormatArg(unsigned char v) : type(Type_Unsigned), size(sizeof(v)), length(0) { value.u = v; }
+				FormatArg(short v) : type(Type_Signed), size(sizeof(v)), length(0) { value.s = v; }
+				FormatArg(unsigned short v) : type(Type_Unsigned), size(sizeof(v)), length(0) { value.u = v; }
+				FormatArg(int v) : type(Type_Signed), size(sizeof(v)), length(0) { value.s = v; }
+				FormatArg(unsigned int v) : type(Type_Unsigned), size(sizeof(v)), length(0) { value.u = v; }
+				FormatArg(long v) : type(Type_Signed), size(sizeof(v)), length(0) { value.s = v; }
+				FormatArg(unsigned long v) : type(Type_Unsigned), size(sizeof(v)), length(0) { value.u = v; }
+				FormatArg(long long v) : type(Type_Signed), size(sizeof(v)), length(0) { value.s = v; }
+				FormatArg(unsigned long long v) : type(Type_Unsigned), size(sizeof(v)), length(0) { value.u = v; }
+				FormatArg(float v) : type(Type_Float), size(sizeof(v)), length(0) { value.f = v; }
+				FormatArg(double v) : type(Type_Float), size(sizeof(v)), length(0) { value.f = v; }
+				FormatArg(long double v) : type(Type_Float), size(sizeof(F64)), length(0) { value.f = (F64)v; }
+				FormatArg(const char *v) : type(Type_String), size(0), length(U32(~0)) { value.str = v; }
+				FormatArg(char *v) : type(Type_String), size(0), length(U32(~0)) { value.str = v; }
+				FormatArg(const String &v) : type(Type_String), size(0), length(v.length()) { value.str = v.c_str(); }
+				FormatArg(const Name &v) : type(Type_String), size(0), length(v.length()) { value.str = v.c_str(); }
+				FormatArg(const StringView &v) : type(Type_String), size(0), length(v.length()) { value.str = v.data(); }
+				template <class T> FormatArg(T *v) : type(Type_Pointer), size(sizeof(v)), length(0) { value.ptr = (cAny)v; }
+
+				/* Public Class Members */
+				//The value
+				union {
+					S64 s;
+					U64 u;
+					F64 f;
+					UTF16 str;
+					cAny ptr;
+				} value;
+				//The kind of value (see Types)
+				U8 type;
+				//The size of the original integer type in bytes, used to print negative numbers as unsigned
+				U8 size;
+				//The length of a string, or U32(~0) when it's not yet known
+				U32 length;
+		};
+
+		/*
+		FormatCheck: Compile time validation of literal format strings (see GALACTIC_FORMAT_CHECK). The placeholders are counted the same way the
+		 formatter reads them, so a GC_Print/Warn/Error/CError call with too few or too many arguments fails to compile. Formats longer than
+		 GALACTIC_FORMAT_CHECK_LENGTH are not checked to stay inside the compiler's constant evaluation depth.
+		*/
+		class FormatCheck {
+			public:
+				/* Public Class Methods */
+				//argCount(): Never called, the size of the returned array is the amount of arguments plus one
+				template <typename... Args> static char (&argCount(const Args &...))[sizeof...(Args) + 1];
+				//matches(): Test if a format (of size bytes, including the terminator) consumes exactly count arguments
+				static constexpr bool matches(U32 size, UTF16 format, U32 count) {
+					return size > GALACTIC_FORMAT_CHECK_LENGTH || placeholders(format) == count;
+				}
+				//placeholders(): The amount of arguments a format consumes
+				static constexpr U32 placeholders(UTF16 format) {
+					return hasBraces(format) ? braces(format, 0, 0) : percents(format, 0);
+				}
+
+				/* Public Class Members */
+				//Verify: Fails to compile when the format doesn't match it's arguments
+				template <bool Matches> struct Verify {
+					static_assert(Matches, "The amount of placeholders in the format string does not match the amount of arguments.");
+				};
+
+			private:
+				/* Private Class Methods */
+				//Character tests
+				static constexpr bool isDigit(C8 c) { return c >= '0' && c <= '9'; }
+				static constexpr bool isAlign(C8 c) { return c == '<' || c == '>' || c == '^'; }
+				static constexpr bool isFlag(C8 c) { return c == '-' || c == '+' || c == ' ' || c == '#' || c == '0'; }
+				static constexpr bool isModifier(C8 c) { return c == 'h' || c == 'l' || c == 'L' || c == 'z' || c == 'j' || c == 't' || c == 'q'; }
+				static constexpr bool isConversion(C8 c) {
+					return c == 'd' || c == 'i' || c == 'u' || c == 'x' || c == 'X' || c == 'o' || c == 'c' || c == 's' || c == 'p' || c == 'f' || c == 'F'
+						|| c == 'e' || c == 'E' || c == 'g' || c == 'G' || c == 'a' || c == 'A';
+				}
+				static constexpr bool hasBraces(UTF16 p) { return *p != '\0' && (*p == '{' || *p == '}' || hasBraces(p + 1)); }
+				static constexpr U32 maxOf(U32 a, U32 b) { return a > b ? a : b; }
+				static constexpr U32 number(UTF16 p, U32 value) { return isDigit(*p) ? number(p + 1, value * 10 + U32(*p - '0')) : value; }
+				static constexpr UTF16 skipDigits(UTF16 p) { return isDigit(*p) ? skipDigits(p + 1) : p; }
+				static constexpr UTF16 skipIf(UTF16 p, bool skip) { return skip ? p + 1 : p; }
+				//{} syntax, each step mirrors parseBraceSpec() and returns where it stops
+				static constexpr UTF16 braceAlign(UTF16 p) { return (p[0] != '\0' && isAlign(p[1])) ? p + 2 : skipIf(p, isAlign(*p)); }
+				static constexpr UTF16 braceSign(UTF16 p) { return skipIf(p, *p == '+' || *p == ' ' || *p == '-'); }
+				static constexpr UTF16 braceAlternate(UTF16 p) { return skipIf(p, *p == '#'); }
+				static constexpr UTF16 braceZero(UTF16 p) { return skipIf(p, *p == '0'); }
+				static constexpr UTF16 bracePrecision(UTF16 p) { return *p == '.' ? skipDigits(p + 1) : p; }
+				static constexpr UTF16 braceType(UTF16 p) { return skipIf(p, *p != '}' && *p != '\0'); }
+				static constexpr UTF16 braceSpec(UTF16 p) {
+					return *p != ':' ? p : braceType(bracePrecision(skipDigits(braceZero(braceAlternate(braceSign(braceAlign(p + 1)))))));
+				}
+				//Count the {} placeholders, next is the next unnumbered argument and top the highest numbered argument plus one
+				static constexpr U32 braces(UTF16 p, U32 next, U32 top) {
+					return *p == '\0' ? maxOf(next, top)
+						: (p[0] == '{' && p[1] == '{') ? braces(p + 2, next, top)
+						: (*p != '{' || *braceSpec(skipDigits(p + 1)) != '}') ? braces(p + 1, next, top)
+						: isDigit(p[1]) ? braces(braceSpec(skipDigits(p + 1)) + 1, next, maxOf(top, number(p + 1, 0) + 1))
+						: braces(braceSpec(p + 1) + 1, next + 1, top);
+				}
+				//printf syntax, each step mirrors parsePercentSpec(), start is the character after the %
+				static constexpr UTF16 percentFlags(UTF16 p) { return isFlag(*p) ? percentFlags(p + 1) : p; }
+				static constexpr UTF16 percentWidth(UTF16 p) { return *p == '*' ? p + 1 : skipDigits(p); }
+				static constexpr UTF16 percentPrecision(UTF16 p) { return *p != '.' ? p : p[1] == '*' ? p + 2 : skipDigits(p + 1); }
+				static constexpr UTF16 percentModifiers(UTF16 p) {
+					return isModifier(*p) ? percentModifiers(p + 1)
+						: *p != 'I' ? p
+						: ((p[1] == '6' && p[2] == '4') || (p[1] == '3' && p[2] == '2')) ? p + 3 : p + 1;
+				}
+				static constexpr U32 percentType(UTF16 start, UTF16 p, U32 count) {
+					return isConversion(*p) ? percents(p + 1, count + 1) : percents(start, count);
+				}
+				static constexpr U32 percentAfterWidth(UTF16 start, UTF16 p, U32 count) {
+					return percentType(start, percentModifiers(percentPrecision(p)), count + ((p[0] == '.' && p[1] == '*') ? 1 : 0));
+				}
+				static constexpr U32 percentAfterFlags(UTF16 start, UTF16 p, U32 count) {
+					return percentAfterWidth(start, percentWidth(p), count + (*p == '*' ? 1 : 0));
+				}
+				//Count the printf conversions, * widths and precisions take an argument of their own
+				static constexpr U32 percents(UTF16 p, U32 count) {
+					return *p == '\0' ? count
+						: *p != '%' ? percents(p + 1, count)
+						: p[1] == '%' ? percents(p + 2, count)
+						: percentAfterFlags(p + 1, percentFlags(p + 1), count);
+				}
+		};
+
+		/*
+		Format: The engine's string formatter. Formats are written with {} placeholders (fmt style), each of which takes the next argument, or a specific
+		 one when numbered ({0}, {1}). A placeholder can have a specification after a colon: {:[[fill]align][sign][#][0][width][.precision][type]}, where
+		 align is one of < > ^ and type is one of d x X o b c e E f F g G s p. Use {{ and }} for literal braces. Floats without a type or precision
+		 are written in the shortest form that reads back to the same value (see CharConv).
+		 For compatibility, a format without any braces is read as a printf style format (%d, %5.2f, %s, %p, %%) instead. The syntax is picked once
+		 for the whole string, so a % in a {} format is plain text. printf specifiers are matched to the actual type of the argument, so a mismatched
+		 specifier or a String passed to %s is printed correctly rather than crashing. There is no limit on the length of the output. Missing
+		 arguments are printed as <missing>.
+		*/
+		class Format {
+			public:
+				/* Public Class Methods */
+				//Format into a StringBuilder
+				static void formatArgs(StringBuilder &out, UTF16 format, const FormatArg *args, U32 count);
+				//Format into a caller provided buffer (always terminated, truncating if needed), returns the full length of the formatted string
+				static U32 formatArgs(UTF8 buffer, U32 size, UTF16 format, const FormatArg *args, U32 count);
+				//Format into the FrameArena, the result is valid until the end of the frame
+				static UTF8 formatArgsToArena(UTF16 format, const FormatArg *args, U32 count);
+				//Write the decimal digits of a value, ending at end, returns the first digit
+				static UTF8 writeDecimal(U64 v, UTF8 end);
+
+				//Format into a StringBuilder
+				template <typename... Args> static StringBuilder &to(StringBuilder &out, UTF16 format, const Args &... args) {
+					const FormatArg list[] = { FormatArg(args)..., FormatArg() };
+					formatArgs(out, format, list, sizeof...(Args));
+					return out;
+				}
+				//Format into a caller provided buffer (always terminated, truncating if needed), returns the full length of the formatted string
+				template <typename... Args> static U32 toBuffer(UTF8 buffer, U32 size, UTF16 format, const Args &... args) {
+					const FormatArg list[] = { FormatArg(args)..., FormatArg() };
+					return formatArgs(buffer, size, format, list, sizeof...(Args));
+				}
+				//Format into the FrameArena, the result is valid until the end of the frame
+				template <typename... Args> static UTF8 toArena(UTF16 format, const Args &... args) {
+					const FormatArg list[] = { FormatArg(args)..., FormatArg() };
+					return formatArgsToArena(format, list, sizeof...(Args));
+				}
+				//Format into a String
+				template <typename... Args> static String toString(UTF16 format, const Args &... args) {
+					const FormatArg list[] = { FormatArg(args)..., FormatArg() };
+					StringBuilder out;
+					formatArgs(out, format, list, sizeof...(Args));
+					return out.build();
+				}
+		};
+
+		/* Formatting members of String and StringBuilder, defined here as they need the Format class */
+		template <typename... Args> String String::ToStr(UTF16 format, const Args &... args) {
+			return Format::toString(format, args...);
+		}
+
+		template <typename... Args> StringBuilder &StringBuilder::appendFormat(UTF16 format, const Args &... args) {
+			return Format::to(*this, format, args...);
+		}
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_FORMAT
\ No newline at end of file
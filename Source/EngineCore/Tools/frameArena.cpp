@@ -0,0 +1,258 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/frameArena.cpp
+* Defines the FrameArena, a per-frame linear allocater
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		FrameBlock: A block of memory for an allocation too large for a sub-arena's reserved range, the memory follows the header.
+		*/
+		struct FrameBlock {
+			//The next block in the chain
+			FrameBlock *next;
+			//The total mapped size of the block (including this header)
+			SIZE_T size;
+		};
+
+		/*
+		FrameSubArena: The per-thread portion of the FrameArena. Each sub-arena reserves GALACTIC_FRAMEARENA_RESERVE_SIZE bytes of address space and
+		 commits it in GALACTIC_FRAMEARENA_BLOCK_SIZE steps as it grows, so the frame's memory is always contiguous.
+		*/
+		struct FrameSubArena {
+			//The reserved address range
+			UTX8 base;
+			UTX8 reserveEnd;
+			//The end of the committed part of the range
+			UTX8 committed;
+			//Allocations too large for the reserved range, released at the end of the frame
+			FrameBlock *oversizedBlocks;
+			//The bump pointer
+			UTX8 cursor;
+			//The last allocation made, this one can be resized in place
+			UTX8 lastAlloc;
+			//The frame this sub-arena was last reset for
+			U32 frame;
+			//Bytes used this frame
+			SIZE_T used;
+			//The most bytes of the range used by a frame since the last decommit check
+			SIZE_T highWater;
+			//The amount of frames since the last decommit check
+			U32 checkFrames;
+		};
+
+		//The size of a block header, kept at a multiple of 64 so the allocation in the block is cache line aligned
+		static const SIZE_T frameBlockHeaderSize = (sizeof(FrameBlock) + 63) & ~((SIZE_T)63);
+		//The amount of frames between checks for committed memory that has gone unused, and can be returned to the system
+		static const U32 frameDecommitInterval = 256;
+		//The current frame
+		static volatile S32 frameArenaFrame = 0;
+		//The calling thread's sub-arena
+		static THREADLOCAL FrameSubArena *_frameSubArena = NULL;
+
+		//Map a new block from the system
+		static FrameBlock *createFrameBlock(SIZE_T size) {
+			FrameBlock *block = (FrameBlock *)PlatformMemory::pageAlloc(size);
+			if (block != NULL) {
+				block->next = NULL;
+				block->size = size;
+			}
+			return block;
+		}
+
+		//Commit enough of a sub-arena's range to hold everything up to the specified address
+		static bool growSubArena(FrameSubArena *arena, UTX8 needEnd) {
+			if (needEnd > arena->reserveEnd) {
+				return false;
+			}
+			SIZE_T commitSize = (SIZE_T)(needEnd - arena->base);
+			commitSize = (commitSize + GALACTIC_FRAMEARENA_BLOCK_SIZE - 1) & ~((SIZE_T)GALACTIC_FRAMEARENA_BLOCK_SIZE - 1);
+			UTX8 newCommitted = arena->base + commitSize;
+			if (newCommitted > arena->reserveEnd) {
+				newCommitted = arena->reserveEnd;
+			}
+			if (!PlatformMemory::pageCommit(arena->committed, (SIZE_T)(newCommitted - arena->committed))) {
+				return false;
+			}
+			arena->committed = newCommitted;
+			return true;
+		}
+
+		//Return the blocks of the allocations that didn't fit in a sub-arena's range to the system
+		static void releaseOversizedBlocks(FrameSubArena *arena) {
+			while (arena->oversizedBlocks != NULL) {
+				FrameBlock *next = arena->oversizedBlocks->next;
+				PlatformMemory::pageFree(arena->oversizedBlocks, arena->oversizedBlocks->size);
+				arena->oversizedBlocks = next;
+			}
+		}
+
+		//Fetch the calling thread's sub-arena, resetting it if the frame has moved on
+		static FrameSubArena *fetchSubArena() {
+			FrameSubArena *arena = _frameSubArena;
+			if (arena == NULL) {
+				arena = (FrameSubArena *)Memory::sysmalloc(sizeof(FrameSubArena));
+				if (arena == NULL) {
+					return NULL;
+				}
+				arena->base = (UTX8)PlatformMemory::pageReserve(GALACTIC_FRAMEARENA_RESERVE_SIZE);
+				if (arena->base == NULL) {
+					Memory::sysfree(arena);
+					return NULL;
+				}
+				arena->reserveEnd = arena->base + GALACTIC_FRAMEARENA_RESERVE_SIZE;
+				arena->committed = arena->base;
+				if (!growSubArena(arena, arena->base + GALACTIC_FRAMEARENA_BLOCK_SIZE)) {
+					PlatformMemory::pageRelease(arena->base, GALACTIC_FRAMEARENA_RESERVE_SIZE);
+					Memory::sysfree(arena);
+					return NULL;
+				}
+				arena->oversizedBlocks = NULL;
+				arena->cursor = arena->base;
+				arena->lastAlloc = NULL;
+				arena->frame = (U32)frameArenaFrame;
+				arena->used = 0;
+				arena->highWater = 0;
+				arena->checkFrames = 0;
+				_frameSubArena = arena;
+				return arena;
+			}
+			if (arena->frame != (U32)frameArenaFrame) {
+				SIZE_T frameBytes = (SIZE_T)(arena->cursor - arena->base);
+				#if GALACTIC_DEBUG_FRAMEARENA != 0
+					//Poison everything handed out so escaped pointers are easy to spot.
+					Memory::gmemset(arena->base, 0xDD, frameBytes);
+				#endif
+				releaseOversizedBlocks(arena);
+				//Return committed memory no frame has needed for a while (IE: after a loading spike) to the system.
+				if (frameBytes > arena->highWater) {
+					arena->highWater = frameBytes;
+				}
+				if (++arena->checkFrames >= frameDecommitInterval) {
+					SIZE_T keep = arena->highWater > GALACTIC_FRAMEARENA_BLOCK_SIZE ? arena->highWater : GALACTIC_FRAMEARENA_BLOCK_SIZE;
+					keep = (keep + GALACTIC_FRAMEARENA_BLOCK_SIZE - 1) & ~((SIZE_T)GALACTIC_FRAMEARENA_BLOCK_SIZE - 1);
+					if (arena->base + keep < arena->committed) {
+						PlatformMemory::pageDecommit(arena->base + keep, (SIZE_T)(arena->committed - (arena->base + keep)));
+						arena->committed = arena->base + keep;
+					}
+					arena->highWater = 0;
+					arena->checkFrames = 0;
+				}
+				arena->cursor = arena->base;
+				arena->lastAlloc = NULL;
+				arena->frame = (U32)frameArenaFrame;
+				arena->used = 0;
+			}
+			return arena;
+		}
+
+		/*
+		FrameArena Class Definitions
+		*/
+		any FrameArena::alloc(SIZE_T amount, U32 memAlignment) {
+			FrameSubArena *arena = fetchSubArena();
+			if (arena == NULL) {
+				return NULL;
+			}
+			if (memAlignment < DefaultAlignment) {
+				memAlignment = DefaultAlignment;
+			}
+			UTX8 result = alignVal(arena->cursor, (S32)memAlignment);
+			if (result + amount > arena->committed && !growSubArena(arena, result + amount)) {
+				//The reserved range is exhausted, give the allocation a block of it's own.
+				FrameBlock *block = createFrameBlock(frameBlockHeaderSize + amount + memAlignment);
+				if (block == NULL) {
+					PlatformMemory::onOutOfMem(amount, memAlignment);
+					return NULL;
+				}
+				block->next = arena->oversizedBlocks;
+				arena->oversizedBlocks = block;
+				arena->used += amount;
+				return alignVal((UTX8)block + frameBlockHeaderSize, (S32)memAlignment);
+			}
+			arena->cursor = result + amount;
+			arena->lastAlloc = result;
+			arena->used += amount;
+			return result;
+		}
+
+		any FrameArena::realloc(any ptr, SIZE_T oldAmount, SIZE_T newAmount, U32 memAlignment) {
+			if (ptr == NULL) {
+				return alloc(newAmount, memAlignment);
+			}
+			FrameSubArena *arena = fetchSubArena();
+			if (arena != NULL && (UTX8)ptr == arena->lastAlloc && ((UTX8)ptr + newAmount <= arena->committed || growSubArena(arena, (UTX8)ptr + newAmount))) {
+				//This was the last allocation, just move the bump pointer.
+				arena->cursor = (UTX8)ptr + newAmount;
+				arena->used = arena->used - oldAmount + newAmount;
+				return ptr;
+			}
+			if (newAmount <= oldAmount) {
+				return ptr;
+			}
+			any newPtr = alloc(newAmount, memAlignment);
+			if (newPtr != NULL) {
+				Memory::gmemcpy(newPtr, ptr, oldAmount);
+			}
+			return newPtr;
+		}
+
+		void FrameArena::endFrame() {
+			PlatformAtomics::increment(&frameArenaFrame);
+			//Reset the calling thread right away, the other threads reset on their next allocation.
+			if (_frameSubArena != NULL) {
+				fetchSubArena();
+			}
+		}
+
+		void FrameArena::releaseThread() {
+			FrameSubArena *arena = _frameSubArena;
+			if (arena == NULL) {
+				return;
+			}
+			_frameSubArena = NULL;
+			releaseOversizedBlocks(arena);
+			//Releasing the reserved range returns the committed part of it as well
+			PlatformMemory::pageRelease(arena->base, GALACTIC_FRAMEARENA_RESERVE_SIZE);
+			Memory::sysfree(arena);
+		}
+
+		U32 FrameArena::fetchFrame() {
+			return (U32)frameArenaFrame;
+		}
+
+		SIZE_T FrameArena::fetchUsedBytes() {
+			FrameSubArena *arena = _frameSubArena;
+			if (arena == NULL || arena->frame != (U32)frameArenaFrame) {
+				return 0;
+			}
+			return arena->used;
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -0,0 +1,226 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/frameArena.h
+* Defines the FrameArena, a per-frame linear allocater
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_FRAMEARENA
+#define GALACTIC_INTERNAL_FRAMEARENA
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		FrameArena: A bump pointer allocater for memory that only needs to live until the end of the current frame (formatted strings, event lists,
+		 packet scratch space, ...). Each thread allocates from it's own sub-arena so no locking is required, and all of the memory is released at once
+		 when the main loop calls endFrame(). Memory from the FrameArena must never be freed, and must never be used after the frame it was allocated in.
+		 Note: Sub-arenas of other threads are reset the next time that thread allocates, jobs that span multiple frames should not use the FrameArena.
+		*/
+		class FrameArena {
+			public:
+				/* Public Class Members */
+				//Constants used by the arena
+				enum FrameArenaConstants {
+					//The default alignment of FrameArena allocations
+					DefaultAlignment = 16,
+				};
+
+				/* Public Class Methods */
+				//Allocate a block of memory for the current frame
+				static any alloc(SIZE_T amount, U32 memAlignment = DefaultAlignment);
+				//Resize a block of memory, grows in place if the block was the last allocation made by this thread
+				static any realloc(any ptr, SIZE_T oldAmount, SIZE_T newAmount, U32 memAlignment = DefaultAlignment);
+				//End the current frame, releasing all of the memory allocated in it
+				static void endFrame();
+				//Fetch the current frame number
+				static U32 fetchFrame();
+				//Fetch the amount of bytes used by the calling thread in this frame
+				static SIZE_T fetchUsedBytes();
+				//Release the calling thread's sub-arena (IE: the thread is exiting), nothing it allocated may be used afterwards
+				static void releaseThread();
+				//Construct an object in the FrameArena (the destructor is never called)
+				template <class T> static T *create() {
+					any mem = alloc(sizeof(T));
+					return mem ? new (mem) T : NULL;
+				}
+		};
+
+		/*
+		FramePtr: A pointer to memory in the FrameArena, which reports any use after the frame it was created in when GALACTIC_DEBUG_FRAMEARENA is set.
+		*/
+		template <class T> class FramePtr {
+			public:
+				/* Constructor */
+				//Default Constructor
+				FramePtr(T *p = NULL) : ptr(p), frame(FrameArena::fetchFrame()) { }
+
+				/* Public Class Methods */
+				//Fetch the pointer
+				T *get() const {
+					validate();
+					return ptr;
+				}
+				//Returns true if the pointer is still in it's frame
+				bool isLive() const {
+					return frame == FrameArena::fetchFrame();
+				}
+
+				/* Operators */
+				T *operator->() const {
+					return get();
+				}
+				T &operator*() const {
+					return *get();
+				}
+				operator bool() const {
+					return ptr != NULL;
+				}
+
+			private:
+				/* Private Class Methods */
+				//Report a pointer that has escaped it's frame
+				void validate() const {
+					#if GALACTIC_DEBUG_FRAMEARENA != 0
+						if (ptr != NULL && !isLive()) {
+							GC_Error("FramePtr::validate(): Pointer %p from frame %u was used in frame %u.", ptr, frame, FrameArena::fetchFrame());
+						}
+					#endif
+				}
+
+				/* Private Class Members */
+				//The pointer
+				T *ptr;
+				//The frame the pointer was created in
+				U32 frame;
+		};
+
+		/*
+		FrameArenaPolicy: Allocater policy for containers holding per-frame temporaries (IE: DynArray<S32, FrameArenaPolicy>). Memory is released at the end
+		 of the frame, so the container must be destroyed before then.
+		*/
+		class FrameArenaPolicy {
+			public:
+				/* Constructor */
+				//Default Constructor
+				FrameArenaPolicy() : frame(FrameArena::fetchFrame()) { }
+
+				/* Public Class Methods */
+				//Allocate a block of memory
+				FINLINE any allocate(SIZE_T bytes) {
+					validate();
+					return FrameArena::alloc(bytes);
+				}
+				//Resize a block of memory, the contents are preserved
+				FINLINE any reallocate(any ptr, SIZE_T oldBytes, SIZE_T newBytes) {
+					validate();
+					return FrameArena::realloc(ptr, oldBytes, newBytes);
+				}
+				//Release a block of memory (memory is released at the end of the frame)
+				FINLINE void deallocate(any ptr, SIZE_T bytes) {
+					if (ptr != NULL) {
+						validate();
+					}
+				}
+
+			private:
+				/* Private Class Methods */
+				//Report a container that has escaped it's frame
+				void validate() const {
+					#if GALACTIC_DEBUG_FRAMEARENA != 0
+						if (frame != FrameArena::fetchFrame()) {
+							GC_Error("FrameArenaPolicy::validate(): Container from frame %u was used in frame %u.", frame, FrameArena::fetchFrame());
+						}
+					#endif
+				}
+
+				/* Private Class Members */
+				//The frame the container was created in
+				U32 frame;
+		};
+
+		/*
+		FrameSTLAllocater: STL compatible allocater adapter for the FrameArena (IE: std::vector<S32, FrameSTLAllocater<S32> >).
+		*/
+		template <class T> class FrameSTLAllocater {
+			public:
+				/* Public Class Members */
+				//Standard allocater type definitions
+				typedef T value_type;
+				typedef T *pointer;
+				typedef const T *const_pointer;
+				typedef T &reference;
+				typedef const T &const_reference;
+				typedef SIZE_T size_type;
+				typedef ptrdiff_t difference_type;
+				//Rebind to another type
+				template <class U> struct rebind {
+					typedef FrameSTLAllocater<U> other;
+				};
+
+				/* Constructor */
+				//Default Constructor
+				FrameSTLAllocater() { }
+				//Copy Constructor
+				template <class U> FrameSTLAllocater(const FrameSTLAllocater<U> &) { }
+
+				/* Public Class Methods */
+				//Allocate storage for count objects
+				T *allocate(SIZE_T count, cAny hint = NULL) {
+					return (T *)FrameArena::alloc(count * sizeof(T));
+				}
+				//Release storage (memory is released at the end of the frame)
+				void deallocate(T *ptr, SIZE_T count) { }
+				//Construct an object in allocated storage
+				void construct(T *ptr, const T &value) {
+					new ((any)ptr) T(value);
+				}
+				//Destroy an object in allocated storage
+				void destroy(T *ptr) {
+					ptr->~T();
+				}
+				//Fetch the maximum amount of objects that can be allocated
+				SIZE_T max_size() const {
+					return ((SIZE_T)-1) / sizeof(T);
+				}
+				//Fetch the address of an object
+				T *address(T &value) const {
+					return &value;
+				}
+				const T *address(const T &value) const {
+					return &value;
+				}
+		};
+
+		//All FrameSTLAllocaters share the same arena, so they always compare equal
+		template <class T, class U> inline bool operator==(const FrameSTLAllocater<T> &, const FrameSTLAllocater<U> &) {
+			return true;
+		}
+		template <class T, class U> inline bool operator!=(const FrameSTLAllocater<T> &, const FrameSTLAllocater<U> &) {
+			return false;
+		}
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_FRAMEARENA
\ No newline at end of file
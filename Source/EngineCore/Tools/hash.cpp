@@ -0,0 +1,111 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/hash.cpp
+* Defines the engine's hashing functions for byte ranges, strings and integers
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		//Unaligned little endian reads of the input
+		SFIN U64 hashRead64(const U8 *p) {
+			U64 v;
+			memcpy(&v, p, sizeof(U64));
+			return v;
+		}
+
+		SFIN U64 hashRead32(const U8 *p) {
+			U32 v;
+			memcpy(&v, p, sizeof(U32));
+			return v;
+		}
+
+		//Read 1 - 3 bytes as a single value (the first, middle and last byte, which overlap for short inputs)
+		SFIN U64 hashRead3(const U8 *p, SIZE_T len) {
+			return ((U64)p[0] << 16) | ((U64)p[len >> 1] << 8) | p[len - 1];
+		}
+
+		/*
+		 Hash Class Definitions
+		*/
+
+		U64 Hash::hashBytes(cAny data, SIZE_T len, U64 seed) {
+			const U8 *p = (const U8 *)data;
+			U64 a, b;
+			seed ^= mix(seed ^ secretA, secretB);
+			if (len <= 16) {
+				if (len >= 4) {
+					//Two overlapping pairs of 32 bit reads cover anything from 4 to 16 bytes
+					SIZE_T middle = (len >> 3) << 2;
+					a = (hashRead32(p) << 32) | hashRead32(p + middle);
+					b = (hashRead32(p + len - 4) << 32) | hashRead32(p + len - 4 - middle);
+				}
+				else if (len > 0) {
+					a = hashRead3(p, len);
+					b = 0;
+				}
+				else {
+					a = b = 0;
+				}
+			}
+			else {
+				SIZE_T remaining = len;
+				if (remaining > 48) {
+					//Three independent lanes keep the multipliers busy on long inputs
+					U64 lane1 = seed, lane2 = seed;
+					do {
+						seed = mix(hashRead64(p) ^ secretB, hashRead64(p + 8) ^ seed);
+						lane1 = mix(hashRead64(p + 16) ^ secretC, hashRead64(p + 24) ^ lane1);
+						lane2 = mix(hashRead64(p + 32) ^ secretD, hashRead64(p + 40) ^ lane2);
+						p += 48;
+						remaining -= 48;
+					} while (remaining > 48);
+					seed ^= lane1 ^ lane2;
+				}
+				while (remaining > 16) {
+					seed = mix(hashRead64(p) ^ secretB, hashRead64(p + 8) ^ seed);
+					p += 16;
+					remaining -= 16;
+				}
+				//The last 16 bytes (which may overlap the ones already consumed)
+				a = hashRead64(p + remaining - 16);
+				b = hashRead64(p + remaining - 8);
+			}
+			a ^= secretB;
+			b ^= seed;
+			multiply128(a, b);
+			return mix(a ^ secretA ^ (U64)len, b ^ secretB);
+		}
+
+		U64 Hash::hashString(UTF16 str, U64 seed) {
+			if (!str) {
+				return hashBytes(NULL, 0, seed);
+			}
+			return hashBytes(str, strlen(str), seed);
+		}
+
+	};
+
+};
\ No newline at end of file
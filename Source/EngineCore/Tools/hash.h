@@ -0,0 +1,130 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/hash.h
+* Defines the engine's hashing functions for byte ranges, strings and integers
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_HASH
+#define GALACTIC_INTERNAL_HASH
+
+#include "../engineCore.h"
+
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <intrin.h>
+#endif
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		Hash: The engine's hash functions. Byte ranges are hashed with wyhash, which reads 16 to 48 bytes per round using 64x64 -> 128 bit multiplies,
+		 and integers with a single multiply and fold. These are fast, well distributed hashes for hash tables and caches, they are NOT cryptographic,
+		 never use them for anything security related. The results are stable between runs, but use a seed if the input is under outside control.
+		*/
+		class Hash {
+			public:
+				/* Public Class Methods */
+				//hashBytes(): Hash a range of bytes
+				static U64 hashBytes(cAny data, SIZE_T len, U64 seed = 0);
+				//hashString(): Hash the characters of a NULL terminated string (see String::hash() for Strings)
+				static U64 hashString(UTF16 str, U64 seed = 0);
+
+				//hashU64(): Hash a 64 bit integer
+				SFIN U64 hashU64(U64 value, U64 seed = 0) {
+					return mix(value ^ secretA, seed ^ secretB);
+				}
+
+				//hashU32(): Hash a 32 bit integer
+				SFIN U64 hashU32(U32 value, U64 seed = 0) {
+					return hashU64((U64)value, seed);
+				}
+
+				//hashPointer(): Hash an address
+				SFIN U64 hashPointer(cAny ptr, U64 seed = 0) {
+					return hashU64((U64)(IntPointer)ptr, seed);
+				}
+
+				//combine(): Combine a hash with another value (or hash), the order of the values matters
+				SFIN U64 combine(U64 hash, U64 value) {
+					return mix(hash ^ secretC, value ^ secretB);
+				}
+
+				//fold32(): Reduce a hash to 32 bits, keeping bits from both halves
+				SFIN U32 fold32(U64 hash) {
+					return (U32)(hash ^ (hash >> 32));
+				}
+
+				//multiply128(): Multiply two 64 bit values, the low half of the result is left in a and the high half in b
+				SFIN void multiply128(U64 &a, U64 &b) {
+					#if defined(__SIZEOF_INT128__)
+						__uint128_t result = (__uint128_t)a * b;
+						a = (U64)result;
+						b = (U64)(result >> 64);
+					#elif defined(_MSC_VER) && defined(_M_X64)
+						a = _umul128(a, b, &b);
+					#else
+						U64 ha = a >> 32, hb = b >> 32, la = (U32)a, lb = (U32)b;
+						U64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32), c = t < rl;
+						U64 lo = t + (rm1 << 32);
+						c += lo < t;
+						a = lo;
+						b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+					#endif
+				}
+
+				//mix(): Multiply two values to 128 bits and fold the halves together, the core of both hashes
+				SFIN U64 mix(U64 a, U64 b) {
+					multiply128(a, b);
+					return a ^ b;
+				}
+
+			private:
+				/* Private Class Members */
+				//The wyhash secrets, odd 64 bit constants with an even mix of set bits
+				static const U64 secretA = U64DEF(0xa0761d6478bd642f);
+				static const U64 secretB = U64DEF(0xe7037ed1a0b428db);
+				static const U64 secretC = U64DEF(0x8ebc6af09c88c6e3);
+				static const U64 secretD = U64DEF(0x589965cc75374cc3);
+		};
+
+		/*
+		Hasher: The hash function object used by hash based containers, specialize it for types that can be used as keys. Integers, enumerations and
+		 pointers are covered here, String and Name add their own specializations.
+		*/
+		template <typename T> struct Hasher {
+			U64 operator()(const T &value) const {
+				return Hash::hashU64((U64)value);
+			}
+		};
+
+		template <typename T> struct Hasher<T *> {
+			U64 operator()(const T *value) const {
+				return Hash::hashPointer(value);
+			}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_HASH
\ No newline at end of file
@@ -45,12 +45,16 @@ namespace Galactic {
 			}
 			//Fetch the length.
 			S32 stringLen = string ? (S32)strlen(string) : 0;
-			if(stringLen > 255) {
-				//The string is too long for BitStream::writeString, push a warning.
-			}
 			if(stringLen > maxLength) {
 				stringLen = maxLength;
 			}
+			//The length is sent with 8 bits, and BitStream::readString() reads into 256 characters
+			if(stringLen > 255) {
+				if(GALACTIC_DONT_REPORT_INTERNAL_ERRORS == 0) {
+					Galactic::Console::warn("HuffCoder::compressStringToBitStream(): The string is too long (%i), only the first 255 characters are sent.", stringLen);
+				}
+				stringLen = 255;
+			}
 			//While the String may exceed the writeString maxima, the compression algorithm is bitCount enforced
 			// rather than string length enforced, so test this.
 			S32 numBits = 0, index = 0;
@@ -73,6 +77,7 @@ namespace Galactic {
 					stream->writeBits(&refLeaf.huffCode, refLeaf.bitCount);
 				}
 			}
+			return true;
 		}
 
 		bool HuffCoder::decompressStringFromBitStream(UTF8 string, Streams::BitStream *stream) {
@@ -285,7 +290,7 @@ namespace Galactic {
 			HuffTree *tree = new HuffTree[256];
 			for(Index = 0; Index < 256; Index++) {
 				HuffLeaf &leaf = huffLeaves[Index];
-				leaf.value = freqTable.at(Index)->second + 1;
+				leaf.value = freqTable.at(Index).second + 1;
 				leaf.letter = (U8)Index;
 
 				memset(&leaf.huffCode, 0, sizeof(leaf.huffCode));
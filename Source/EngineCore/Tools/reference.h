@@ -148,6 +148,12 @@ namespace Galactic {
 					obj(trgObj),
 					deleteObj(trgDeleteParams) { }
 
+				/* Operators */
+				//new: ReferenceControllers are allocated from a shared ObjectPool (see objectPool.cpp)
+				static any operator new(size_t amount);
+				//delete: Sized, so an allocation that didn't come from the pool goes back to the allocater that made it
+				static void operator delete(any ptr, size_t amount);
+
 				/* Public Class Members */
 				//The stored object pointer
 				any obj;
@@ -332,6 +338,8 @@ namespace Galactic {
 			FINLINE StrongObject() : controller(NULL) { }
 			//Direct Creation (From Object) Contructor
 			template <class T> FINLINE explicit StrongObject(T* obj) : controller(new ReferenceController(obj, &deleteObj<T>)) { }
+			//Direct Creation (From Object) Constructor with a custom delete function (IE: ObjectPool<T>::releaseObj)
+			template <class T> FINLINE StrongObject(T* obj, void (*deleteFunc)(any)) : controller(new ReferenceController(obj, deleteFunc)) { }
 			//Copy Constructor (Copy From Strong)
 			FINLINE StrongObject(const StrongObject &c) : controller(c.controller) {
 				//Since we already have a controller and an object, simply add one to the strong reference count
@@ -553,6 +561,16 @@ namespace Galactic {
 					//Cast to makeRefPtr.
 					makeRefPtr(this, object, object);
 				}
+				//Explicit Creation Constructor with a custom delete function, used for objects that are not allocated with new (IE: ObjectPool<T>)
+				template <class objType> FINLINE StrongReference(objType *object, void (*deleteFunc)(any)) : obj(object), ref(object, deleteFunc) {
+					if (!valid()) {
+						//Strong references cannot be NULL, throw an error.
+						GC_Error("StrongReference(): Cannot initialize a NULL instance to a StrongReference, consider using StrongReferencePtr instead.");
+						return;
+					}
+					//Cast to makeRefPtr.
+					makeRefPtr(this, object, object);
+				}
 				//Copy Constructor
 				template <class objType> FINLINE StrongReference(const StrongReference<objType, m> &c) : obj(c.obj), ref(c.ref) {
 					//Since the existing strong reference has already been verified, we're good to go!
@@ -678,6 +696,11 @@ namespace Galactic {
 					//Cast to makeRefPtr.
 					makeRefPtr(this, object, object);
 				}
+				//Explicit Creation Constructor with a custom delete function, used for objects that are not allocated with new (IE: ObjectPool<T>)
+				template <class objType> FINLINE StrongReferencePtr(objType *object, void (*deleteFunc)(any)) : obj(object), ref(object, deleteFunc) {
+					//Cast to makeRefPtr.
+					makeRefPtr(this, object, object);
+				}
 				//Copy Constructor
 				template <class objType> FINLINE StrongReferencePtr(const StrongReferencePtr<objType, m> &c) : obj(c.obj), ref(c.ref) { }
 				//Copy Constructor with target object parameter
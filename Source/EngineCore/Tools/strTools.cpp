@@ -25,10 +25,344 @@
 
 #include "../engineCore.h"
 
+#if GALACTIC_STRTOOLS_SIMD != 0 && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+	#define GALACTIC_STRTOOLS_X86 1
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		//MSVC allows the use of any intrinsic without flagging the function
+		#define STRTOOLS_TARGET_SSE2
+		#define STRTOOLS_TARGET_AVX2
+	#else
+		#include <cpuid.h>
+		#include <immintrin.h>
+		//GCC & Clang only emit AVX2 (and SSE2 on 32 bit) inside functions that are flagged for it, the dispatch makes sure we never call them otherwise
+		#define STRTOOLS_TARGET_SSE2 __attribute__((target("sse2")))
+		#define STRTOOLS_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#else
+	#define GALACTIC_STRTOOLS_X86 0
+#endif
+
 namespace Galactic {
 
 	namespace Core {
 
+		/* Scalar Kernels: Always available, and used for the tails of the vector loops */
+
+		//foldLower(): ASCII lower case conversion, unlike tolower() this doesn't depend on the C locale
+		SFIN C8 foldLower(C8 c) {
+			return (c >= 'A' && c <= 'Z') ? (C8)(c + ('a' - 'A')) : c;
+		}
+
+		//foldUpper(): ASCII upper case conversion
+		SFIN C8 foldUpper(C8 c) {
+			return (c >= 'a' && c <= 'z') ? (C8)(c - ('a' - 'A')) : c;
+		}
+
+		//lowestSetBit(): Fetch the index of the lowest set bit in a non-zero movemask
+		SFIN U32 lowestSetBit(U32 mask) {
+			#if defined(_MSC_VER)
+				unsigned long index;
+				_BitScanForward(&index, mask);
+				return (U32)index;
+			#else
+				return (U32)__builtin_ctz(mask);
+			#endif
+		}
+
+		//rangeMatches(): Compare the inner characters of a candidate found by the first / last character filter
+		static bool rangeMatches(UTF16 str, UTF16 needle, U32 len, bool caseSensitive) {
+			if (caseSensitive) {
+				return memcmp(str, needle, len) == 0;
+			}
+			for (U32 i = 0; i < len; i++) {
+				if (foldLower(str[i]) != foldLower(needle[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static UTF16 scalarFindChar(UTF16 str, U32 len, C8 c, bool caseSensitive) {
+			if (caseSensitive) {
+				return (UTF16)memchr(str, c, len);
+			}
+			c = foldLower(c);
+			for (U32 i = 0; i < len; i++) {
+				if (foldLower(str[i]) == c) {
+					return str + i;
+				}
+			}
+			return NULL;
+		}
+
+		static UTF16 scalarFindSubstring(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive) {
+			for (U32 i = 0; i + needleLen <= len; i++) {
+				if (rangeMatches(str + i, needle, needleLen, caseSensitive)) {
+					return str + i;
+				}
+			}
+			return NULL;
+		}
+
+		static S32 scalarCompareNoCase(UTF16 str1, UTF16 str2, U32 len) {
+			for (U32 i = 0; i < len; i++) {
+				S32 diff = (S32)(U8)foldLower(str1[i]) - (S32)(U8)foldLower(str2[i]);
+				if (diff != 0) {
+					return diff;
+				}
+			}
+			return 0;
+		}
+
+		static UTF16 scalarFindInSet(UTF16 str, U32 len, UTF16 set, bool wantInSet) {
+			bool table[256] = { false };
+			while (*set) {
+				table[(U8)*set++] = true;
+			}
+			for (U32 i = 0; i < len; i++) {
+				if (table[(U8)str[i]] == wantInSet) {
+					return str + i;
+				}
+			}
+			return NULL;
+		}
+
+		static void scalarConvertCase(UTF8 str, U32 len, bool toUpper) {
+			for (U32 i = 0; i < len; i++) {
+				str[i] = toUpper ? foldUpper(str[i]) : foldLower(str[i]);
+			}
+		}
+
+		#if GALACTIC_STRTOOLS_X86
+
+			/* SSE2 Kernels */
+
+			//sseFoldCase(): Flip the case bit (0x20) of every character in [first, first + 26), first being 'A' to lower, or 'a' to upper
+			STRTOOLS_TARGET_SSE2 static inline __m128i sseFoldCase(__m128i v, C8 first) {
+				//Shift the range down to the bottom of the signed range so a single signed compare can test it
+				__m128i shifted = _mm_add_epi8(v, _mm_set1_epi8((C8)(-128 - first)));
+				__m128i inRange = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+				return _mm_xor_si128(v, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+			}
+
+			STRTOOLS_TARGET_SSE2 static UTF16 sseFindChar(UTF16 str, U32 len, C8 c, bool caseSensitive) {
+				C8 other = caseSensitive ? c : (foldLower(c) != c ? foldLower(c) : foldUpper(c));
+				__m128i first = _mm_set1_epi8(c), second = _mm_set1_epi8(other);
+				U32 i = 0;
+				for (; i + 16 <= len; i += 16) {
+					__m128i block = _mm_loadu_si128((const __m128i *)(str + i));
+					U32 mask = (U32)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(block, second)));
+					if (mask != 0) {
+						return str + i + lowestSetBit(mask);
+					}
+				}
+				return scalarFindChar(str + i, len - i, c, caseSensitive);
+			}
+
+			//sseFindSubstring(): Compare the first and last characters of the needle against every position at once, and only check the inner characters of candidates
+			STRTOOLS_TARGET_SSE2 static UTF16 sseFindSubstring(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive) {
+				C8 firstChar = caseSensitive ? needle[0] : foldLower(needle[0]);
+				C8 lastChar = caseSensitive ? needle[needleLen - 1] : foldLower(needle[needleLen - 1]);
+				__m128i first = _mm_set1_epi8(firstChar), last = _mm_set1_epi8(lastChar);
+				U32 i = 0;
+				for (; i + needleLen - 1 + 16 <= len; i += 16) {
+					__m128i blockFirst = _mm_loadu_si128((const __m128i *)(str + i));
+					__m128i blockLast = _mm_loadu_si128((const __m128i *)(str + i + needleLen - 1));
+					if (!caseSensitive) {
+						blockFirst = sseFoldCase(blockFirst, 'A');
+						blockLast = sseFoldCase(blockLast, 'A');
+					}
+					U32 mask = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last)));
+					while (mask != 0) {
+						U32 pos = i + lowestSetBit(mask);
+						if (needleLen <= 2 || rangeMatches(str + pos + 1, needle + 1, needleLen - 2, caseSensitive)) {
+							return str + pos;
+						}
+						mask &= mask - 1;
+					}
+				}
+				return scalarFindSubstring(str + i, len - i, needle, needleLen, caseSensitive);
+			}
+
+			STRTOOLS_TARGET_SSE2 static S32 sseCompareNoCase(UTF16 str1, UTF16 str2, U32 len) {
+				U32 i = 0;
+				for (; i + 16 <= len; i += 16) {
+					__m128i a = sseFoldCase(_mm_loadu_si128((const __m128i *)(str1 + i)), 'A');
+					__m128i b = sseFoldCase(_mm_loadu_si128((const __m128i *)(str2 + i)), 'A');
+					U32 mask = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xFFFF;
+					if (mask != 0) {
+						U32 pos = i + lowestSetBit(mask);
+						return (S32)(U8)foldLower(str1[pos]) - (S32)(U8)foldLower(str2[pos]);
+					}
+				}
+				return scalarCompareNoCase(str1 + i, str2 + i, len - i);
+			}
+
+			//sseFindInSet(): Sets of up to 16 characters are tested with one compare per member, larger sets use the scalar lookup table
+			STRTOOLS_TARGET_SSE2 static UTF16 sseFindInSet(UTF16 str, U32 len, UTF16 set, bool wantInSet) {
+				U32 setLen = (U32)strlen(set);
+				if (setLen > 16) {
+					return scalarFindInSet(str, len, set, wantInSet);
+				}
+				__m128i members[16];
+				for (U32 j = 0; j < setLen; j++) {
+					members[j] = _mm_set1_epi8(set[j]);
+				}
+				U32 wantMask = wantInSet ? 0 : 0xFFFF;
+				U32 i = 0;
+				for (; i + 16 <= len; i += 16) {
+					__m128i block = _mm_loadu_si128((const __m128i *)(str + i));
+					__m128i hits = _mm_setzero_si128();
+					for (U32 j = 0; j < setLen; j++) {
+						hits = _mm_or_si128(hits, _mm_cmpeq_epi8(block, members[j]));
+					}
+					U32 mask = (U32)_mm_movemask_epi8(hits) ^ wantMask;
+					if (mask != 0) {
+						return str + i + lowestSetBit(mask);
+					}
+				}
+				return scalarFindInSet(str + i, len - i, set, wantInSet);
+			}
+
+			STRTOOLS_TARGET_SSE2 static void sseConvertCase(UTF8 str, U32 len, bool toUpper) {
+				C8 first = toUpper ? 'a' : 'A';
+				U32 i = 0;
+				for (; i + 16 <= len; i += 16) {
+					__m128i block = _mm_loadu_si128((const __m128i *)(str + i));
+					_mm_storeu_si128((__m128i *)(str + i), sseFoldCase(block, first));
+				}
+				scalarConvertCase(str + i, len - i, toUpper);
+			}
+
+			/* AVX2 Kernels: Only the loops that scan long ranges, the rest gain little over SSE2 */
+
+			STRTOOLS_TARGET_AVX2 static inline __m256i avxFoldCase(__m256i v, C8 first) {
+				__m256i shifted = _mm256_add_epi8(v, _mm256_set1_epi8((C8)(-128 - first)));
+				__m256i inRange = _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), shifted);
+				return _mm256_xor_si256(v, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+			}
+
+			STRTOOLS_TARGET_AVX2 static UTF16 avxFindChar(UTF16 str, U32 len, C8 c, bool caseSensitive) {
+				C8 other = caseSensitive ? c : (foldLower(c) != c ? foldLower(c) : foldUpper(c));
+				__m256i first = _mm256_set1_epi8(c), second = _mm256_set1_epi8(other);
+				U32 i = 0;
+				for (; i + 32 <= len; i += 32) {
+					__m256i block = _mm256_loadu_si256((const __m256i *)(str + i));
+					U32 mask = (U32)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(block, first), _mm256_cmpeq_epi8(block, second)));
+					if (mask != 0) {
+						return str + i + lowestSetBit(mask);
+					}
+				}
+				return sseFindChar(str + i, len - i, c, caseSensitive);
+			}
+
+			STRTOOLS_TARGET_AVX2 static UTF16 avxFindSubstring(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive) {
+				C8 firstChar = caseSensitive ? needle[0] : foldLower(needle[0]);
+				C8 lastChar = caseSensitive ? needle[needleLen - 1] : foldLower(needle[needleLen - 1]);
+				__m256i first = _mm256_set1_epi8(firstChar), last = _mm256_set1_epi8(lastChar);
+				U32 i = 0;
+				for (; i + needleLen - 1 + 32 <= len; i += 32) {
+					__m256i blockFirst = _mm256_loadu_si256((const __m256i *)(str + i));
+					__m256i blockLast = _mm256_loadu_si256((const __m256i *)(str + i + needleLen - 1));
+					if (!caseSensitive) {
+						blockFirst = avxFoldCase(blockFirst, 'A');
+						blockLast = avxFoldCase(blockLast, 'A');
+					}
+					U32 mask = (U32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last)));
+					while (mask != 0) {
+						U32 pos = i + lowestSetBit(mask);
+						if (needleLen <= 2 || rangeMatches(str + pos + 1, needle + 1, needleLen - 2, caseSensitive)) {
+							return str + pos;
+						}
+						mask &= mask - 1;
+					}
+				}
+				return sseFindSubstring(str + i, len - i, needle, needleLen, caseSensitive);
+			}
+
+			STRTOOLS_TARGET_AVX2 static void avxConvertCase(UTF8 str, U32 len, bool toUpper) {
+				C8 first = toUpper ? 'a' : 'A';
+				U32 i = 0;
+				for (; i + 32 <= len; i += 32) {
+					__m256i block = _mm256_loadu_si256((const __m256i *)(str + i));
+					_mm256_storeu_si256((__m256i *)(str + i), avxFoldCase(block, first));
+				}
+				sseConvertCase(str + i, len - i, toUpper);
+			}
+
+			//detectSimdLevel(): Query the CPU (and the OS, for the AVX register state) for the supported instruction sets
+			static U32 detectSimdLevel() {
+				U32 regs[4] = { 0 }, maxLeaf, xcr0 = 0;
+				#if defined(_MSC_VER)
+					__cpuid((int *)regs, 0);
+					maxLeaf = regs[0];
+					__cpuid((int *)regs, 1);
+				#else
+					maxLeaf = __get_cpuid_max(0, NULL);
+					__cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+				#endif
+				if (!(regs[3] & (1u << 26))) {
+					return 0;
+				}
+				//AVX needs both the CPU flag and the OS saving the YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+				bool hasAVX = (regs[2] & (1u << 27)) && (regs[2] & (1u << 28));
+				if (!hasAVX || maxLeaf < 7) {
+					return 1;
+				}
+				#if defined(_MSC_VER)
+					xcr0 = (U32)_xgetbv(0);
+					__cpuidex((int *)regs, 7, 0);
+				#else
+					U32 xcrHigh;
+					__asm__ __volatile__("xgetbv" : "=a"(xcr0), "=d"(xcrHigh) : "c"(0));
+					__cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+				#endif
+				if ((xcr0 & 6) != 6 || !(regs[1] & (1u << 5))) {
+					return 1;
+				}
+				return 2;
+			}
+
+		#endif
+
+		/* Kernel Dispatch */
+
+		struct StrToolsKernels {
+			UTF16 (*findChar)(UTF16 str, U32 len, C8 c, bool caseSensitive);
+			UTF16 (*findSubstring)(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive);
+			S32 (*compareNoCase)(UTF16 str1, UTF16 str2, U32 len);
+			UTF16 (*findInSet)(UTF16 str, U32 len, UTF16 set, bool wantInSet);
+			void (*convertCase)(UTF8 str, U32 len, bool toUpper);
+			U32 level;
+		};
+
+		static StrToolsKernels selectKernels() {
+			StrToolsKernels kernels = { scalarFindChar, scalarFindSubstring, scalarCompareNoCase, scalarFindInSet, scalarConvertCase, 0 };
+			#if GALACTIC_STRTOOLS_X86
+				kernels.level = detectSimdLevel();
+				if (kernels.level >= 1) {
+					kernels.findChar = sseFindChar;
+					kernels.findSubstring = sseFindSubstring;
+					kernels.compareNoCase = sseCompareNoCase;
+					kernels.findInSet = sseFindInSet;
+					kernels.convertCase = sseConvertCase;
+				}
+				if (kernels.level >= 2) {
+					kernels.findChar = avxFindChar;
+					kernels.findSubstring = avxFindSubstring;
+					kernels.convertCase = avxConvertCase;
+				}
+			#endif
+			return kernels;
+		}
+
+		//fetchKernels(): The table is selected once, the first time any of the bulk operations is used
+		static const StrToolsKernels &fetchKernels() {
+			static const StrToolsKernels kernels = selectKernels();
+			return kernels;
+		}
+
 		bool StrTools::fetchCmdLineToken(UTF16 &str, String &result, bool useEscapeChars) {
 			//Empty the result out (since this is a cummulative function), then skip over anything that is whitespace
 			result.clear();
@@ -83,6 +417,104 @@ namespace Galactic {
 			return result.length() > 0;
 		}
 
+
+		bool StrTools::fetchCmdLineToken(UTF16 &str, StringView &result) {
+			//The same rules as above without escape characters: a quoted token is the text between the quotes, anything else runs up to the
+			// first whitespace outside of a quote (keeping the quotes)
+			while (isWSpace(*str)) {
+				str++;
+			}
+			UTF16 start = str;
+			if (*str == '"') {
+				start = ++str;
+				while (*str && *str != '"') {
+					str++;
+				}
+				result = StringView(start, (U32)(str - start));
+				if (*str == '"') {
+					str++;
+				}
+			}
+			else {
+				bool isInQuote = false;
+				while (*str && (!isWSpace(*str) || isInQuote)) {
+					if (*str == '"') {
+						isInQuote = !isInQuote;
+					}
+					str++;
+				}
+				result = StringView(start, (U32)(str - start));
+			}
+			return !result.empty();
+		}
+
+		/*
+		 StrTools Class Definitions (Bulk Operations)
+		*/
+
+		UTF16 StrTools::whiteSpaceSet = " \t\n\v\f\r";
+
+		UTF16 StrTools::find(UTF16 str, UTF16 wantToFind) {
+			if (!str || !wantToFind) {
+				return NULL;
+			}
+			return findSubstring(str, (U32)strlen(str), wantToFind, (U32)strlen(wantToFind), false);
+		}
+
+		UTF16 StrTools::findChar(UTF16 str, U32 len, C8 c, bool caseSensitive) {
+			if (!str || len == 0) {
+				return NULL;
+			}
+			return fetchKernels().findChar(str, len, c, caseSensitive);
+		}
+
+		UTF16 StrTools::findSubstring(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive) {
+			if (!str || !needle || needleLen > len) {
+				return NULL;
+			}
+			if (needleLen == 0) {
+				return str;
+			}
+			if (needleLen == 1) {
+				return fetchKernels().findChar(str, len, needle[0], caseSensitive);
+			}
+			return fetchKernels().findSubstring(str, len, needle, needleLen, caseSensitive);
+		}
+
+		S32 StrTools::compareNoCase(UTF16 str1, UTF16 str2, U32 len) {
+			return fetchKernels().compareNoCase(str1, str2, len);
+		}
+
+		UTF16 StrTools::findFirstOf(UTF16 str, U32 len, UTF16 set) {
+			if (!str || !set || len == 0) {
+				return NULL;
+			}
+			return fetchKernels().findInSet(str, len, set, true);
+		}
+
+		UTF16 StrTools::findFirstNotOf(UTF16 str, U32 len, UTF16 set) {
+			if (!str || !set || len == 0) {
+				return NULL;
+			}
+			return fetchKernels().findInSet(str, len, set, false);
+		}
+
+		void StrTools::toLower(UTF8 str, U32 len) {
+			if (str && len) {
+				fetchKernels().convertCase(str, len, false);
+			}
+		}
+
+		void StrTools::toUpper(UTF8 str, U32 len) {
+			if (str && len) {
+				fetchKernels().convertCase(str, len, true);
+			}
+		}
+
+		U32 StrTools::fetchSimdLevel() {
+			return fetchKernels().level;
+		}
+
 	};
 
 };
\ No newline at end of file
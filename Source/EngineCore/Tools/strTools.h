@@ -45,27 +45,32 @@ namespace Galactic {
 			//fetchCmdLineToken(): Fetches a portion of a string based on a token deliminator for the command line
 			// Note: Command line params are formatted as such: -param:"args"
 			static bool fetchCmdLineToken(UTF16 &str, String &result, bool useEscapeChars);
+			//fetchCmdLineToken(): As above, but result views the token in place (no escape characters, so nothing has to be rewritten)
+			static bool fetchCmdLineToken(UTF16 &str, StringView &result);
 
-			//strnicmp is one of those MSVS depricated thingies, however, it's fully safe for use still, so ignore the annoying C4996 warn.
-			#pragma warning( push )
-			#pragma warning( disable : 4996 )
-			//find(): Find an instance of a string within another string
-			static UTF16 find(UTF16 str, UTF16 wantToFind) {
-				if (!str || !wantToFind) {
-					return NULL;
-				}
-				S32 findLength = (S32)strlen(wantToFind++) - 1;
-				C8 findChar = *wantToFind;
-				C8 currChar = *str++;
-				while (currChar) {
-					if (findChar == currChar && !strnicmp(str, wantToFind, findLength)) {
-						return str - 1;
-					}
-					currChar = *str++;
-				}
-				return NULL;
-			}
-			#pragma warning( pop )
+			//find(): Find an instance of a string within another string (not case sensitive)
+			static UTF16 find(UTF16 str, UTF16 wantToFind);
+
+			/* Bulk Operations: These work on a length rather than the terminator, and use SSE2 / AVX2 when the CPU supports it (see GALACTIC_STRTOOLS_SIMD) */
+			//findChar(): Find the first instance of a character, returns NULL if not found
+			static UTF16 findChar(UTF16 str, U32 len, C8 c, bool caseSensitive = true);
+			//findSubstring(): Find the first instance of needle in str, returns NULL if not found
+			static UTF16 findSubstring(UTF16 str, U32 len, UTF16 needle, U32 needleLen, bool caseSensitive = true);
+			//compareNoCase(): Compare two ranges of len characters without case sensitivity, returns the difference of the first mismatching (lower case) characters
+			static S32 compareNoCase(UTF16 str1, UTF16 str2, U32 len);
+			//findFirstOf(): Find the first character that is in the set, returns NULL if none is
+			static UTF16 findFirstOf(UTF16 str, U32 len, UTF16 set);
+			//findFirstNotOf(): Find the first character that is not in the set, returns NULL if all of them are
+			static UTF16 findFirstNotOf(UTF16 str, U32 len, UTF16 set);
+			//toLower(): Convert the characters to lower case, in place
+			static void toLower(UTF8 str, U32 len);
+			//toUpper(): Convert the characters to upper case, in place
+			static void toUpper(UTF8 str, U32 len);
+			//fetchSimdLevel(): Fetch the instruction set used by the bulk operations (0: None, 1: SSE2, 2: AVX2)
+			static U32 fetchSimdLevel();
+
+			//whiteSpaceSet: The characters treated as whitespace by isspace()
+			static UTF16 whiteSpaceSet;
 
 		};
 
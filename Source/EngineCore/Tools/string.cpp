@@ -28,147 +28,27 @@ namespace Galactic {
 
 	namespace Core {
 
-		Z32 String::maxStringSize = 2048;
-
 		Z32 String::NOTFOUND = U32(~0);
 
-		/**
-			StringFormat:
-			This class is used by the numerous ToStr() functions down below to convert the va_list parameters and relevant pointer information
-			into their proper string counterparts.
-		**/
-		class String::StringFormat {
-			typedef va_list* valptr;
-
-			public:
-				//Fixed Buffer (Only place in String where maxStringSize is currently enforced, someone with more C++ knowledge could possibly get around this limit)
-				C8 _strBuff[maxStringSize]; 
-				//Temporary Formatting Buffer
-				UTF8 _dynBuff;
-				//Size of _dynBuff
-				U32 _dynLen;
-				//size of _strBuff
-				U32 _strLen;
-
-				StringFormat() : _dynBuff(NULL), _dynLen(0), _strLen(0) {
-					_strBuff[0] = '\0';
-				}
-
-				StringFormat(UTF16 str, any args) : _dynBuff(NULL), _dynLen(0), _strLen(0) {
-					format(str, args);
-				}
-
-				~StringFormat() {
-					if(_dynBuff) {
-						SendToGatesOfHeaven(_dynBuff);
-					}
-				}
-
-				S32 format(UTF16 str, any args) {
-					_strLen = 0;
-					return formatAppend(str, args);
-				}
-				
-				S32 formatAppend(UTF16 str, any args) {
-					//This is a two step process, first we need to format the string into the fixed buffer, in the event
-					// of a failure at the second step, we'll at least have the fixed string to reference.
-					S32 firstLength = _strLen;
-					if(_dynBuff == NULL) {
-						_strLen += _vsnprintf(_strBuff + _strLen, sizeof(_strBuff) - _strLen, str, *(valptr)args);
-						if(_strLen >= 0 && _strLen < sizeof(_strBuff)) {
-							return _strLen;
-						}
-						//Now that we've got our fixed buffer, we can begin construction of the dynamic buffer, we'll start with a size two times
-						// larger than that of the fixed buffer to prevent anything from going wrong with out-of-bounds sizing later.
-						_strLen = firstLength;
-						_dynLen = sizeof(_strBuff) * 2;
-						_dynBuff = (UTF8)malloc(_dynLen);
-						memcpy(_dynBuff, _strBuff, _strLen+1);
-					}
-					//At this point, if the dynamic buffer wasn't empty, we can now safely use the same formatting step to format into the dynamic buffer.
-					// to ensure we're ok on size, we'll keep doubling the buffer until we have a working case.
-					_strLen += _vsnprintf(_dynBuff + _strLen, _dynLen - _strLen, str, *(valptr)args);
-					while(_strLen < 0 || _strLen >= _dynLen) {
-						_strLen = firstLength;
-						_dynBuff = (UTF8)realloc(_dynBuff, _dynLen *= 2); //Note the multiplicative operator here to catch the change as well.
-						_strLen += _vsnprintf(_dynBuff + _strLen, _dynLen - _strLen, str, *(valptr)args);
-					}
-					return _strLen;
-				}
-				
-				S32 append(UTF16 str, S32 len) {
-					//This function is here to append to the current formatting buffer. We take care of all of the 
-					// re-sizing and such throughout this function.
-					if(_dynBuff == NULL) {
-						if(_strLen + len >= 0 && _strLen + len < sizeof(_strBuff)) {
-							memcpy(_strBuff + _strLen, str, len);
-							_strLen += len;
-							_strBuff[_strLen] = '\0';
-							return _strLen;
-						}
-						_dynLen = sizeof(_strBuff) * 2;
-						_dynBuff = (UTF8)malloc(_dynLen);
-						memcpy(_dynBuff, _strBuff, _strLen + 1);
-					}
-					//Validation step...
-					U32 newSize = _dynLen;
-					while(newSize < _strLen + len) {
-						newSize *= 2;
-					}
-					if(newSize != _dynLen) {
-						_dynBuff = (UTF8)realloc(_dynBuff, newSize);
-					}
-					_dynLen = newSize;
-					memcpy(_dynBuff + _strLen, str, len);
-					_strLen += len;
-					_dynBuff[_strLen] = '\0';
-					return _strLen;
-				}
-				
-				S32 append(UTF16 str) {
-					return append(str, (U32)strlen(str));
-				}
-
-				String becomeString() {
-					return String(c_str(), _strLen);
-				}
-
-				UTF16 c_str() {
-					return _dynBuff ? _dynBuff : _strBuff;
-				}
-
-				void reset() {
-					_strBuff[0] = '\0';
-					_strLen = 0;
-				}
-
-				UTF8 copyBuffer(UTF8 dest) const {
-					memcpy(dest, _dynBuff ? _dynBuff : _strBuff, _strLen+1);
-					return dest;
-				}
-
-				U32 length() const { 
-					return _strLen; 
-				}
-		};
+		const String String::emptyStrRef;
 
 		/**
 			StringData:
 			This class is more or less a storage container, since there's actually quite a bit going on here, this cuts down on the actual amount
-			of redundant code in the actual class, not to mention it helpsto pin down any problems with the String class itself.
+			of redundant code in the actual class, not to mention it helpsto pin down any problems with the String class itself. Only strings
+			longer than String::InlineCapacity use a StringData.
 		**/
 		class String::StringData {
 			public:
-				StringData() {}
-
 				StringData(UTF16 data) {
 					refCount = 1;
 					numChars = U32(0xffffffff);
+					hashValue = 0;
 					if(data) {
 						//see operator new for initialization of length
-						memcpy(sData, data, sizeof(UTF8) * length);
-						sData[length] = '\0';
+						memcpy(sData, data, sizeof(C8) * length);
 					}
+					sData[length] = '\0';
 				}
 
 				~StringData() {
@@ -179,81 +59,82 @@ namespace Galactic {
 				}
 
 				void addRef() {
-					//Kind of redundant, but you know, someday, someone's going to do this just for a laugh.
-					if(refCount != U32(0xffffffff)) {
-						refCount++;
-					}
+					refCount++;
 				}
 
 				void killRef() {
-					if(refCount != U32(0xffffffff)) {
-						refCount--;
-						if(refCount == 0) {
-							delete this;
-						}
+					refCount--;
+					if(refCount == 0) {
+						delete this;
 					}
 				}
 
-				U32 getLength() {
+				U32 getLength() const {
 					return length;
 				}
 
-				U32 getSize() {
+				U32 getSize() const {
 					return getLength() + 1;
 				}
 
+				U32 getCapacity() const {
+					return capacity;
+				}
+
+				//Change the length of an unshared StringData (up to it's capacity), the terminator is placed by this function
+				void setLength(U32 len) {
+					length = len;
+					numChars = U32(0xffffffff);
+					hashValue = 0;
+					sData[len] = '\0';
+				}
+
 				U32 getNumChars() const {
 					if(numChars == U32(0xffffffff)) {
-						numChars = (U32)strlen((UTF16)sData);
+						numChars = Unicode::countCodePoints((UTF16)sData, length);
 					}
 					return numChars;
 				}
 
-				C8 operator[](U32 index) {
-					if(index >= length) {
-						return NULL;
-						//push an error here?
+				//Fetch the hash of the characters, computed on first use. A hash that happens to be 0 is simply never cached.
+				U64 getHash() const {
+					if(hashValue == 0) {
+						hashValue = Hash::hashBytes(sData, length);
 					}
-					return sData[index];
+					return hashValue;
 				}
 
-				UTF8 utf8() {
-					return sData;
+				//Has the hash been computed yet?
+				bool hasHash() const {
+					return hashValue != 0;
 				}
 
-				UTF16 utf16() {
+				UTF8 utf8() {
 					return sData;
 				}
 
-				static StringData *emptyStrRef() {
-					static StringData empty;
-					empty.refCount = U32(0xffffffff);
-					empty.length = 0;
-					empty.numChars = 0;
-					empty.sData[1] = 0;
-
-					return (StringData *)&empty;
+				UTF16 utf16() const {
+					return sData;
 				}
 				
-				//Allows length defining a la: new (length) StringData(x)
-				any operator new(size_t size, U32 len) {
-					if(len == 0) {
-						Galactic::Console::error("StringData::StringData(): Cannot create a String of length 0, use StringData::emptyStrRef()");
+				//Allows length defining a la: new (length) StringData(x), the capacity reserves room for the string to grow in place
+				any operator new(size_t size, U32 len, U32 cap = 0) {
+					if(len == 0 && cap == 0) {
+						Galactic::Console::error("StringData::StringData(): Cannot create a String of length 0, use an inline String");
 						return NULL;
 					}
-					StringData *data = reinterpret_cast<StringData *>(malloc(size + len * sizeof(UTF8)));
+					if(cap < len) {
+						cap = len;
+					}
+					StringData *data = reinterpret_cast<StringData *>(Memory::gmallocTagged(size + cap * sizeof(C8), MemoryTracker::Tag_Strings));
 					data->length = len;
+					data->capacity = cap;
 					return data;
 				}
 
 				//This definition of delete is used to match the above new operator, stops C4291
-				void operator delete(any ptr, U32 len) {
-					StringData* sub = static_cast<StringData *>(ptr);
-					if(sub->refCount != 0) {
-						Galactic::Console::error("StringData::delete() - Attempting to delete a String containing multiple references attached (%i).", sub->refCount);
-						return;
-					}
-					SendToGatesOfHeaven(ptr);
+				void operator delete(any ptr, U32 len, U32 cap) {
+					Memory::gfree(ptr);
 				}
 
 				void operator delete(any ptr) {
@@ -262,7 +143,7 @@ namespace Galactic {
 						Galactic::Console::error("StringData::delete() - Attempting to delete a String containing multiple references attached (%i).", sub->refCount);
 						return;
 					}
-					SendToGatesOfHeaven(ptr);
+					Memory::gfree(ptr);
 				}
 
 			protected:
@@ -270,74 +151,105 @@ namespace Galactic {
 				U32 refCount;
 				//length of the StringData, not including NULL
 				U32 length;
+				//amount of characters that fit in the StringData, not including NULL
+				U32 capacity;
 				//character count, mutable for usage through const functions
 				mutable U32 numChars;
+				//cached hash of the characters (0 when not computed), reset whenever the characters change
+				mutable U64 hashValue;
 				//This is the actual data of the string.
 				C8 sData[1];
 		};
 
 		String::String() {
-			_str = StringData::emptyStrRef();
+			_inlineLength = 0;
+			_inline[0] = '\0';
 		}
 
 		String::String(strRef str) {
-			_str = str._str;
-			_str->addRef();
+			//Copying an inline string is a plain copy of the buffer.
+			memcpy(this, &str, sizeof(String));
+			if(!isInline()) {
+				_str->addRef();
+			}
+		}
+
+		String::String(String &&str) {
+			memcpy(this, &str, sizeof(String));
+			str._inlineLength = 0;
+			str._inline[0] = '\0';
 		}
 
 		String::String(UTF16 str) {
+			_inlineLength = 0;
+			_inline[0] = '\0';
 			if(str && *str) {
 				U32 len = (U32)strlen(str);
-				_str = new (len) StringData(str);
-			}
-			else {
-				_str = StringData::emptyStrRef();
+				copy(str, allocate(len), len);
 			}
 		}
 
 		String::String(UTF16 str, U32 size) {
+			_inlineLength = 0;
+			_inline[0] = '\0';
 			if(str && *str && size != 0) {
-				if(size > strlen(str)) {
-					//push an error here for invalid size.
-					_str = NULL;
+				if(memchr(str, '\0', size) != NULL) {
+					Galactic::Console::error("String::String(%s, %i): The specified size is larger than the source string.", str, size);
 				}
 				else {
-				   _str = new (size) StringData(str);
+					copy(str, allocate(size), size);
 				}
 			}
-			else {
-				_str = StringData::emptyStrRef();
+		}
+
+		String::String(const StringView &view) {
+			_inlineLength = 0;
+			_inline[0] = '\0';
+			if(!view.empty()) {
+				copy(view.data(), allocate(view.length()), view.length());
 			}
 		}
 
 		String::~String() {
-			_str->killRef();
+			if(!isInline()) {
+				_str->killRef();
+			}
 		}
 
 		UTF16 String::c_str() const {
-			return _str->utf16();
+			return isInline() ? _inline : _str->utf16();
 		}
 
 		U32 String::length() const {
-			return _str->getLength();
+			return isInline() ? _inlineLength : _str->getLength();
 		}
 
 		U32 String::size() const {
-			return _str->getSize();
+			return length() + 1;
 		}
 
 		U32 String::numChrs() const {
-			return _str->getNumChars();
+			return isInline() ? Unicode::countCodePoints(_inline, _inlineLength) : _str->getNumChars();
+		}
+
+		bool String::isValidUTF8() const {
+			return Unicode::validateUTF8(c_str(), length());
+		}
+
+		StringView String::view() const {
+			return StringView(c_str(), length());
+		}
+
+		U64 String::hash() const {
+			return isInline() ? Hash::hashBytes(_inline, _inlineLength) : _str->getHash();
 		}
 
 		bool String::empty() const {
-			return (_str == StringData::emptyStrRef());
+			return length() == 0;
 		}
 
 		void String::clear() {
-			_str->killRef();
-			_str = NULL;
-			_str = StringData::emptyStrRef();
+			release();
 		}
 
 		S32 String::compare(UTF16 str, U32 len, U32 mode) const {
@@ -345,7 +257,7 @@ namespace Galactic {
 				Galactic::Console::error("String::compare(NULL, %i, %i): Cannot use compare on the target string. It contains a NULL Ptr.", len, mode);
 				return -1;
 			}
-			UTF16 s1 = _str->utf16();
+			UTF16 s1 = c_str();
 			UTF16 s2 = str;
 			//Compare the strings right away, if they match, we're done
 			if(s1 == s2) {
@@ -362,25 +274,17 @@ namespace Galactic {
 			}
 			//No Case Sensitivity
 			if(mode & String::NoCaseSens) {
-				if(len) {
-					//If we have a stored length, we can use a for loop to make this easy.
-					for( ; len--; s1++, s2++) {
-						if(tolower(*s1) != tolower(*s2) || !*s1) {
-							//mismatch, we're done here.
-							break;
-						}
-					}
+				//Compare the characters both strings have, then the first terminator (if we stopped before len), the same result as strncasecmp().
+				U32 l1 = length() - (U32)(s1 - c_str()), l2 = (U32)strlen(s2);
+				U32 count = l1 < l2 ? l1 : l2;
+				if(len && len < count) {
+					count = len;
 				}
-				else {
-					//If we don't have a stored length, we use a while loop to run through each char. This time however, we check to see if the strings
-					// match, and we run until we hit the end of s1.
-					while(tolower(*s1) == tolower(*s2) && *s1) {
-						s1++;
-						s2++;
-					}
+				S32 result = StrTools::compareNoCase(s1, s2, count);
+				if(result != 0 || (len && count == len)) {
+					return result;
 				}
-				//Return the integer result of the strcmp.
-				return tolower(*s1) - tolower(*s2);
+				return tolower((U8)s1[count]) - tolower((U8)s2[count]);
 			}
 			//If we were not in no-case mode, it's time to finish up the compare work.
 			if(len) {
@@ -398,14 +302,14 @@ namespace Galactic {
 		}
 
 		S32 String::compare(strRef str, U32 len, U32 mode) const {
-			if(_str == str._str) {
+			if(!isInline() && !str.isInline() && _str == str._str) {
 				return 0;
 			}
 			return compare(str.c_str(), len, mode);
 		}
 
 		U32 String::find(C8 needle, U32 startPos, U32 mode) const {
-			UTF16 ourStr = _str->utf16();
+			UTF16 ourStr = c_str();
 			if(mode & Right) {	
 				if(startPos) {
 					ourStr += startPos - 1;
@@ -417,131 +321,42 @@ namespace Galactic {
 				}
 				if(mode & NoCaseSens) {
 					needle = tolower(needle);
-					for(; ourStr >= _str->utf16(); ourStr--) {
+					for(; ourStr >= c_str(); ourStr--) {
 						if(tolower(*ourStr) == needle) {
 							//got a match
-							return U32(ourStr - _str->utf16());
+							return U32(ourStr - c_str());
 						}
 					}
 				}
 				else {
-					for(; ourStr >= _str->utf16(); ourStr--) {
+					for(; ourStr >= c_str(); ourStr--) {
 						if(*ourStr == needle) {
 							//got a match
-							return U32(ourStr - _str->utf16());
+							return U32(ourStr - c_str());
 						}
 					}					
 				}
 				return NOTFOUND;
 			}
 			else {
-				if(mode & NoCaseSens) {
-					needle = tolower(needle);
-					for(ourStr += startPos; *ourStr && tolower(*ourStr) != needle;) {
-						ourStr++;
-					}
+				if(startPos >= length()) {
+					return NOTFOUND;
 				}
-				else {
-					for(ourStr += startPos; *ourStr && *ourStr != needle;) {
-						ourStr++;
-					}
-				}
-
-				return *ourStr ? U32(ourStr - _str->utf16()) : NOTFOUND;
+				UTF16 result = StrTools::findChar(ourStr + startPos, length() - startPos, needle, !(mode & NoCaseSens));
+				return result ? U32(result - ourStr) : NOTFOUND;
 			}
 		}
 
 		U32 String::find(UTF16 needle, U32 startPos, U32 mode) const {
-			UTF16 ourStr = _str->utf16();
-			if(mode & Right) {
-				UTF16 copy = ourStr; //Copy of the original for manipulation purposes.
-				if(startPos) {
-					copy += startPos - 1;
-				}
-				else {
-					while(*copy) {
-						copy++;
-					}
-				}
-				if(mode & NoCaseSens) {
-					UTF16 lcs = _strlwr(_strdup(needle));
-					for(; copy >= ourStr; copy--) {
-						if(tolower(*copy) == *lcs) {
-							U32 index = 0;
-							while(lcs[index] && lcs[index] == tolower(copy[index])) {
-								index++;
-							}
-							if(!copy[index]) {
-								free((char *)lcs);
-								return U32(copy - _str->utf16());
-							}
-							if(!ourStr[index]) {
-								free((char *)lcs);
-								return NOTFOUND;
-							}
-						}
-					}
-				}
-				else {
-					for(; copy >= ourStr; copy--) {
-						if(*copy == *needle) {
-							U32 index = 0;
-							while(needle[index] && needle[index] == copy[index]) {
-								index++;
-							}
-							if(!needle[index]) {
-								return U32(copy - _str->utf16());
-							}
-							if(!ourStr[index]) {
-								return NOTFOUND;
-							}
-						}
-					}
-				}
-				return NOTFOUND;
-			}
-			else {
-				if(mode & NoCaseSens) {
-					UTF16 lcs = _strlwr(_strdup(needle));
-					for(ourStr += startPos; *ourStr; ourStr++) {
-						if(tolower(*ourStr) == *lcs) {
-							U32 index = 0;
-							while(lcs[index] && lcs[index] == tolower(ourStr[index])) {
-								index++;
-							}
-							if(!lcs[index]) {
-								free((char *)lcs);
-								return U32(ourStr - _str->utf16());
-							}
-							if(!ourStr[index]) {
-								free((char *)lcs);
-								return NOTFOUND;
-							}
-						}
-					}
-				}
-				else {
-					for(ourStr += startPos; *ourStr; ourStr++) {
-						if(*ourStr == *needle) {
-							U32 index = 0;
-							while(needle[index] && needle[index] == ourStr[index]) {
-								index++;
-							}
-							if(!needle[index]) {
-								return U32(ourStr - _str->utf16());
-							}
-							if(!ourStr[index]) {
-								return NOTFOUND;
-							}
-						}
-					}
-				}			
-			}
-			return NOTFOUND;
+			return view().find(StringView(needle), startPos, mode);
 		}
 
 		U32 String::find(strRef needle, U32 startPos, U32 mode) const {
-			return find(needle.c_str(), startPos, mode);
+			return view().find(StringView(needle), startPos, mode);
+		}
+
+		U32 String::find(const StringView &needle, U32 startPos, U32 mode) const {
+			return view().find(needle, startPos, mode);
 		}
 
 		String &String::insert(U32 position, UTF16 str) {
@@ -554,19 +369,17 @@ namespace Galactic {
 				Galactic::Console::error("String::insert(%i, %s): The specified position is outside of the String bounds", position, str);
 				return *this;
 			}
-			//Create the new string
-			StringData *newStr;
-			if(!len[2]) {
-				newStr = StringData::emptyStrRef();
-			}
-			else {
-				newStr = new (len[2]) StringData(NULL);
-				copy(_str->utf16(), newStr->utf8(), position);
-				copy(str, newStr->utf8() + position, len[0]);
-				copy(_str->utf16(), newStr->utf8() + position + len[0], len[1] - position - 1);
+			if(position == len[1]) {
+				append(str, len[0]);
+				return *this;
 			}
-			_str->killRef();
-			_str = newStr;
+			//Create the new string
+			String result;
+			UTF8 out = result.allocate(len[2]);
+			copy(c_str(), out, position);
+			copy(str, out + position, len[0]);
+			copy(c_str() + position, out + position + len[0], len[1] - position);
+			swap(result);
 			return *this;
 		}
 
@@ -585,26 +398,28 @@ namespace Galactic {
 			}
 			U32 cLen = length();
 			U32 nLen = cLen - len;
-			//Create the new String
-			StringData *newStr;
-			if(!nLen) {
-				newStr = StringData::emptyStrRef();
-			}
-			else {
-				newStr = new (nLen) StringData(NULL);
-				if(position > 0) {
-					copy(_str->utf16(), newStr->utf8(), position);
-				}
-				copy(_str->utf16() + position + len, newStr->utf8() + position, cLen - (position - len) + 1);
+			if(isInline() || !_str->hasMultipleReferences()) {
+				//We're the only owner of the characters, so the tail can be moved down in place.
+				UTF8 chrs = isInline() ? _inline : _str->utf8();
+				memmove(chrs + position, chrs + position + len, cLen - position - len);
+				setLength(nLen);
+				return *this;
 			}
-			_str->killRef();
-			_str = newStr;
+			//Create the new String
+			String result;
+			UTF8 out = result.allocate(nLen);
+			copy(c_str(), out, position);
+			copy(c_str() + position + len, out + position, cLen - position - len);
+			swap(result);
 			return *this;
 		}
 
 		String &String::replace(strRef search, strRef replace) {
 			//Get our numerical values ready...
 			Z32 &lenSrc = search.length(), &lenRep = replace.length();
+			if(lenSrc == 0) {
+				return *this;
+			}
 			U32 cPos = 0;
 			DynArray<U32> found_indicies;
 			//Grab a copy of our string, and begin looping through, finding all instances of &search
@@ -623,26 +438,24 @@ namespace Galactic {
 			}
 			//And start the replacing
 			U32 newSize = size() - (found_indicies.size() * lenSrc) + (found_indicies.size() * lenRep);
-			StringData *newStr;
-			if(newSize == 1) {
+			String result;
+			if(newSize > 1) {
 				//Unlike prior cases, this time a size value of 1 refers to empty (Null Terminator)
-				newStr = StringData::emptyStrRef();
-			}
-			else {
 				U32 nPos = 0, chrCt = 0;
 				cPos = 0;
-				newStr = new (newSize - 1) StringData(NULL);			
+				UTF8 out = result.allocate(newSize - 1);
+				UTF16 ourStr = c_str();
 				for(U32 i = 0; i < (U32)found_indicies.size(); i++) {
 					Z32 &index = found_indicies[i];
 					//IF we have any chars to copy over before our next string to replace, this will keep the count.
 					chrCt = index - cPos;
 					if(chrCt > 0) {
-						memcpy(newStr->utf8() + nPos, _str->utf8() + cPos, chrCt * sizeof(C8));
+						memcpy(out + nPos, ourStr + cPos, chrCt * sizeof(C8));
 						nPos += chrCt;
 					}
 					//Copy the replacement.
 					if(lenRep > 0) {
-						memcpy(newStr->utf8() + nPos, replace._str->utf8(), lenRep * sizeof(C8));
+						memcpy(out + nPos, replace.c_str(), lenRep * sizeof(C8));
 					}
 					nPos += lenRep;
 					cPos = index + lenSrc;
@@ -651,12 +464,10 @@ namespace Galactic {
 				// Note: We're safe to use .last without try-catch(DYNARRAYEMPTY) here because this is handled above already.
 				chrCt = length() - found_indicies.last() - lenSrc;
 				if(chrCt != 0) {
-					memcpy(newStr->utf8() + nPos, _str->utf8() + cPos, chrCt * sizeof(C8));
+					memcpy(out + nPos, ourStr + cPos, chrCt * sizeof(C8));
 				}
-				newStr->utf8()[newSize - 1] = NULL;
 			}
-			_str->killRef();
-			_str = newStr;
+			swap(result);
 			return *this;
 		}
 
@@ -671,59 +482,32 @@ namespace Galactic {
 			}
 
 			U32 lenV[3] = { length(), str.length(), (length() - len + str.length()) };
-			StringData *strDat;
-			if(!lenV[2]) {
-				strDat = StringData::emptyStrRef();
-			}
-			else {
-				strDat = new (lenV[2]) StringData(NULL);
+			String result;
+			if(lenV[2]) {
 				//Populate...
-				copy(_str->utf16(), strDat->utf8(), startPos);
-				copy(str.c_str(), strDat->utf8() + startPos, lenV[1]);
-				copy(_str->utf16() + startPos + len, strDat->utf8() + startPos + lenV[1], lenV[0] - startPos - len + 1);
+				UTF8 out = result.allocate(lenV[2]);
+				copy(c_str(), out, startPos);
+				copy(str.c_str(), out + startPos, lenV[1]);
+				copy(c_str() + startPos + len, out + startPos + lenV[1], lenV[0] - startPos - len);
 			}
-			_str->killRef();
-			_str = strDat;
+			swap(result);
 
 			return *this;
 		}
 
 		String String::trim() const {
-			if(empty()) {
-				return *this;
-			}
-			//Start trimming at the beginning
-			UTF16 begin = _str->utf16();
-			while(*begin && isspace(*begin)) {
-			   begin++;
-			}
-			//Next, trim from the end.
-			UTF16 end = _str->utf16() + length() - 1;
-			while(end > begin && isspace(*end)) {
-				end--;
-			}
-			//Add one position to the end.
-			end++;
-			//Length Test
-			SIZE_T len = end - begin;
-			if((U32)len == length()) {
+			StringView trimmed = view().trim();
+			if(trimmed.length() == length()) {
+				//Nothing to trim, share our characters
 				return *this;
 			}
-			//Build the new string
-			StringData *strDat;
-			if(!len) {
-				strDat = StringData::emptyStrRef();
-			}
-			else {
-				strDat = new ((U32)len) StringData(begin);
-			}
-			return strDat;
+			return String(trimmed);
 		}
 
 		String String::substr(U32 startPosition, U32 len) const {
 			if(startPosition > length()) {
 				Galactic::Console::error("String::substr(%i, %i): The requested starting position is outside of the String Length [%i]", startPosition, len, length());
-				return String("");
+				return String();
 			}
 			if(len == -1) {
 				//-1 argument: pull to end.
@@ -731,72 +515,29 @@ namespace Galactic {
 			}
 			if(len + startPosition > length()) {
 				Galactic::Console::error("String::substr(%i, %i): The requested position & length lie outside of the String Length [%i]", startPosition, len, length());
-				return String("");
+				return String();
 			}
-			StringData *subst;
-			if(!len) {
-				subst = StringData::emptyStrRef();
-			}
-			else {
-				subst = new (len) StringData(_str->utf16() + startPosition);
+			String result;
+			if(len) {
+				copy(c_str() + startPosition, result.allocate(len), len);
 			}
-			return subst;
+			return result;
 		}
 
 		void String::split(UTF16 token, DynArray<String> &ref) const {
-			UTF16 chrs = _str->utf16(), copy = chrs;
-			while(*chrs) {
-				if(*chrs != token[0]) {
-					chrs++;
-				}
-				else {
-					//Check for a matching case
-					UTF16 end = chrs, tokenCpy = token;
-					while(*tokenCpy && *tokenCpy == *chrs) {
-						chrs++;
-						tokenCpy++;
-					}
-					//This will trigger if we don't match a case completely.
-					if(*tokenCpy != '\0') {
-						continue;
-					}
-					//If we get here, then we've got a full match, so let's extract our string.
-					String newStr(copy, (U32)(end - copy));
-					ref.pushToBack(newStr);
-					copy = chrs;
-				}
-			}
-			//If we have anything left over, add it to the end.
-			if(copy != chrs) {
-				ref.pushToBack(copy);
+			StringSplitter pieces(view(), token, StringSplitter::Separator);
+			StringView piece;
+			while(pieces.next(piece)) {
+				ref.pushToBack(String(piece));
 			}
 		}
 
-		String String::VoidToStr(UTF16 format, any args) {
-			StringFormat strFormat(format, &args);
-			U32 formatLength = strFormat.length();
-			StringData *output;
-			if(formatLength == 0) {
-				output = StringData::emptyStrRef();
+		void String::split(UTF16 token, DynArray<StringView> &ref) const {
+			StringSplitter pieces(view(), token, StringSplitter::Separator);
+			StringView piece;
+			while(pieces.next(piece)) {
+				ref.pushToBack(piece);
 			}
-			else {
-				output = new (formatLength) StringData(NULL);
-				strFormat.copyBuffer(output->utf8());
-				output->utf8()[formatLength] = NULL;
-			}
-			return output;
-		}
-
-		String String::ToStr(UTF16 format, ...) {
-			if(!format) {
-				Galactic::Console::error("String::ToStr(NULL, ...): Cannot convert NULL type to a String.");
-				return StringData::emptyStrRef();
-			}
-			va_list args;
-			_crt_va_start(args, format);
-			String result = VoidToStr(format, args);
-			_crt_va_end(args);
-			return result;
 		}
 
 		String String::ToStr(bool v) {
@@ -807,106 +548,86 @@ namespace Galactic {
 		}
 
 		String String::ToStr(U32 v) {
-			return ToStr("%u", v);
+			C8 digits[CharConv::MaxChars];
+			return String(digits, CharConv::toChars(digits, v));
 		}
 
 		String String::ToStr(S32 v) {
-			return ToStr("%d", v);
+			C8 digits[CharConv::MaxChars];
+			return String(digits, CharConv::toChars(digits, v));
 		}
 
 		String String::ToStr(F32 v) {
-			return ToStr("%g", v);
+			C8 digits[CharConv::MaxChars];
+			return String(digits, CharConv::toChars(digits, v));
 		}
 
 		String String::ToStr(F64 v) {
-			return ToStr("%Lg", v);
+			C8 digits[CharConv::MaxChars];
+			return String(digits, CharConv::toChars(digits, v));
 		}
 
 		String String::ToLwr(strRef string) {
-			if(string.empty()) {
-				return StringData::emptyStrRef();
+			String result;
+			if(!string.empty()) {
+				UTF8 out = result.allocate(string.length());
+				copy(string.c_str(), out, string.length());
+				StrTools::toLower(out, string.length());
 			}
-			StringData *out = new (string.length()) StringData(string.c_str());
-			_strlwr(out->utf8());
-			return out;
+			return result;
 		}
 
 		String String::ToUpr(strRef string) {
-			if(string.empty()) {
-				return StringData::emptyStrRef();
+			String result;
+			if(!string.empty()) {
+				UTF8 out = result.allocate(string.length());
+				copy(string.c_str(), out, string.length());
+				StrTools::toUpper(out, string.length());
 			}
-			StringData *out = new (string.length()) StringData(string.c_str());
-			_strupr(out->utf8());
-			return out;
+			return result;
 		}
 
 		String& String::operator=(C8 c) {
-			_str->killRef();
-			_str = new (2) StringData(NULL);
-			_str->utf8()[0] = c;
-			_str->utf8()[1] = '\0';
-
+			allocate(1)[0] = c;
 			return *this;
 		}
 
 		String& String::operator+=(C8 c) {
-			U32 currentLength = _str->getLength();
-			StringData *newStr = new (currentLength + 1) StringData(NULL);
-			//Copy existing contents into the new string and construct the end.
-			copy(_str->utf16(), newStr->utf8(), currentLength);
-			newStr->utf8()[currentLength] = c;
-			newStr->utf8()[currentLength+1] = '\0';
-			_str->killRef();
-			_str = newStr;
-
+			append(&c, 1);
 			return *this;
 		}
 
 		String& String::operator=(UTF16 str) {
-			if(_str->utf16() == str) {
+			if(c_str() == str) {
 				//If the string we're assigning to is the one we already have, then stop the function here.
 				// This prevents the string data reference from being deleted when we actually still need it.
 				return *this;
 			}
-
-			_str->killRef();
-			if(str && *str) {
-				//Only proceed if there's actually something to put in the String
-				U32 length = (U32)strlen(str);
-				_str = new (length) StringData(str);
-			}
-			else {
-				_str = StringData::emptyStrRef();
-			}
+			//Build into a separate string, str may point into our own characters.
+			String result(str);
+			swap(result);
 			return *this;
 		}
 
 		String& String::operator+=(UTF16 str) {
-			if(str == NULL && !*str) {
+			if(str == NULL || !*str) {
 				//If there's nothing to add, just stop.
 				return *this;
 			}
-			//Three length values to calculate for.
-			U32 length[3] = { _str->getLength(), (U32)strlen(str), _str->getLength() + (U32)strlen(str) };
-			//Construct the new String
-			StringData *newStr;
-			if(length[2] == 0) {
-				newStr = StringData::emptyStrRef();
-			}
-			else {
-				newStr = new (length[2]) StringData(NULL);
-				copy(_str->utf16(), newStr->utf8(), length[0]);
-				copy(str, newStr->utf8() + length[0], length[1]+1);
-			}
-			_str->killRef();
-			_str = newStr;
+			append(str, (U32)strlen(str));
 			return *this;
 		}
 
 		String& String::operator=(strRef ref) {
-			ref._str->addRef();
-			_str->killRef();
-			_str = ref._str;
+			if(this != &ref) {
+				String result(ref);
+				swap(result);
+			}
+			return *this;
+		}
+
+		String& String::operator=(String &&ref) {
+			swap(ref);
 			return *this;
 		}
 
@@ -915,20 +636,16 @@ namespace Galactic {
 				//If the string we're adding from is empty, stop here.
 				return *this;
 			}
-			//Three length values to calculate for.
-			U32 len[3] = { _str->getLength(), ref._str->getLength(), _str->getLength() + ref._str->getLength() };
-			//Construct the new string.
-			StringData *newStr;
-			if(len[2] == 0) {
-				newStr = StringData::emptyStrRef();
-			}
-			else {
-				newStr = new (len[2]) StringData(NULL);
-				copy(_str->utf16(), newStr->utf8(), len[0]);
-				copy(ref._str->utf16(), newStr->utf8() + len[0], len[1]+1);
+			if(empty()) {
+				//Share the other string's data rather than copying it.
+				return operator=(ref);
 			}
-			_str->killRef();
-			_str = newStr;
+			append(ref.c_str(), ref.length());
+			return *this;
+		}
+
+		String& String::operator+=(const StringView &view) {
+			append(view.data(), view.length());
 			return *this;
 		}
 
@@ -941,38 +658,37 @@ namespace Galactic {
 			}
 			//Perform addition
 			U32 len[2] = { s1.length(), s2.length() };
-			//Declare new StringData
-			String::StringData *data = new (len[0] + len[1]) String::StringData( NULL );
+			String result;
+			UTF8 out = result.allocate(len[0] + len[1]);
 			//Populate it.
-			String::copy(s1._str->utf16(), data->utf8(), len[0]);
-			String::copy(s2._str->utf16(), data->utf8() + len[0], len[1] + 1);
+			String::copy(s1.c_str(), out, len[0]);
+			String::copy(s2.c_str(), out + len[0], len[1]);
 
-			return String(data);
+			return result;
 		}
 
 		String operator+(strRef s, C8 chr) {
 			U32 length = s.length();
-			//Declare new StringData
-			String::StringData *data = new (length + 1) String::StringData( NULL );
+			String result;
+			UTF8 out = result.allocate(length + 1);
 			//Populate.
-			String::copy(s._str->utf16(), data->utf8(), length);
+			String::copy(s.c_str(), out, length);
 			//Add the chr to the end
-			data->utf8()[length] = chr;
-			data->utf8()[length + 1] = NULL;
+			out[length] = chr;
 
-			return String(data);
+			return result;
 		}
 
 		String operator+(C8 chr, strRef s) {
 			U32 length = s.length();
-			//Declare new StringData
-			String::StringData *data = new (length + 1) String::StringData( NULL );
+			String result;
+			UTF8 out = result.allocate(length + 1);
 			//Populate.
-			String::copy(s._str->utf16(), data->utf8() + 1, length + 1);
+			String::copy(s.c_str(), out + 1, length);
 			//Add the chr to the beginning
-			data->utf8()[0] = chr;
+			out[0] = chr;
 
-			return String(data);			
+			return result;
 		}
 
 		String operator+(strRef s, UTF16 str) {
@@ -989,13 +705,13 @@ namespace Galactic {
 				//str is empty.
 				return s;
 			}
-			//Declare new StringData
-			String::StringData *data = new (len[0] + len[1]) String::StringData( NULL );
+			String result;
+			UTF8 out = result.allocate(len[0] + len[1]);
 			//Populate.
-			String::copy(s._str->utf16(), data->utf8(), len[0]);
-			String::copy(str, data->utf8() + len[0], len[1] + 1);
+			String::copy(s.c_str(), out, len[0]);
+			String::copy(str, out + len[0], len[1]);
 
-			return String(data);
+			return result;
 		}
 
 		String operator+(UTF16 str, strRef s) {
@@ -1012,34 +728,33 @@ namespace Galactic {
 				//str is empty.
 				return s;
 			}
-			//Declare new StringData
-			String::StringData *data = new (len[0] + len[1]) String::StringData( NULL );
+			String result;
+			UTF8 out = result.allocate(len[0] + len[1]);
 			//Populate.
-			String::copy(str, data->utf8(), len[0]);
-			String::copy(s._str->utf16(), data->utf8() + len[0], len[1] + 1);		
+			String::copy(str, out, len[0]);
+			String::copy(s.c_str(), out + len[0], len[1]);
 
-			return String(data);		
+			return result;
 		}
 
 		bool String::operator==(strRef ref) const {
-			if(_str == ref._str) {
+			if(!isInline() && !ref.isInline() && _str == ref._str) {
 				return true;
 			}
 			else if(length() != ref.length()) {
 				return false;
 			}
+			else if(!isInline() && !ref.isInline() && _str->hasHash() && ref._str->hasHash() && _str->getHash() != ref._str->getHash()) {
+				//Both hashes are already known, so a mismatch is settled without touching the characters.
+				return false;
+			}
 			else {
-				return memcmp(_str->utf8(), ref._str->utf8(), _str->getLength()) == 0;
+				return memcmp(c_str(), ref.c_str(), length()) == 0;
 			}
 		}
 
 		bool String::operator==(C8 c) const {
-			if(!_str || _str->getLength() != 1) {
-				return false;
-			}
-			else {
-				return (_str->utf8()[0] == c);
-			}
+			return length() == 1 && c_str()[0] == c;
 		}
 
 		C8 String::operator[](S32 index) const {
@@ -1050,6 +765,94 @@ namespace Galactic {
 			return c_str()[index];
 		}
 
+		UTF8 String::allocate(U32 len, U32 capacity) {
+			release();
+			if(len <= InlineCapacity && capacity <= InlineCapacity) {
+				_inlineLength = (U8)len;
+				_inline[len] = '\0';
+				return _inline;
+			}
+			_str = new (len, capacity) StringData(NULL);
+			_inlineLength = HeapMode;
+			return _str->utf8();
+		}
+
+		void String::append(UTF16 str, U32 len) {
+			if(len == 0) {
+				return;
+			}
+			U32 oldLength = length(), newLength = oldLength + len;
+			//Note: str may point into our own characters, it's never overwritten before being read in any of the cases below.
+			if(isInline() && newLength <= InlineCapacity) {
+				copy(str, _inline + oldLength, len);
+				_inlineLength = (U8)newLength;
+				_inline[newLength] = '\0';
+				return;
+			}
+			if(!isInline() && !_str->hasMultipleReferences() && newLength <= _str->getCapacity()) {
+				copy(str, _str->utf8() + oldLength, len);
+				_str->setLength(newLength);
+				return;
+			}
+			//Grow geometrically so a string built by repeated appends is only copied a logarithmic amount of times.
+			String result;
+			UTF8 out = result.allocate(newLength, oldLength * 2);
+			copy(c_str(), out, oldLength);
+			copy(str, out + oldLength, len);
+			swap(result);
+		}
+
+		void String::reserve(U32 capacity) {
+			U32 owned = isInline() ? (U32)InlineCapacity : (_str->hasMultipleReferences() ? 0 : _str->getCapacity());
+			if(capacity <= owned) {
+				return;
+			}
+			U32 len = length();
+			String result;
+			UTF8 out = result.allocate(len, capacity);
+			copy(c_str(), out, len);
+			swap(result);
+		}
+
+		UTF8 String::reserveAppend(U32 count) {
+			U32 len = length();
+			U32 owned = isInline() ? (U32)InlineCapacity : (_str->hasMultipleReferences() ? 0 : _str->getCapacity());
+			if(len + count > owned) {
+				reserve(len + count > len * 2 ? len + count : len * 2);
+			}
+			return (isInline() ? _inline : _str->utf8()) + len;
+		}
+
+		void String::commitAppend(U32 count) {
+			setLength(length() + count);
+		}
+
+		void String::setLength(U32 len) {
+			if(isInline()) {
+				_inlineLength = (U8)len;
+				_inline[len] = '\0';
+			}
+			else {
+				_str->setLength(len);
+			}
+		}
+
+		void String::release() {
+			if(!isInline()) {
+				_str->killRef();
+			}
+			_inlineLength = 0;
+			_inline[0] = '\0';
+		}
+
+		void String::swap(String &other) {
+			//Both representations can be moved around freely, so this is a plain exchange of the bytes.
+			U8 temp[sizeof(String)];
+			memcpy(temp, this, sizeof(String));
+			memcpy(this, &other, sizeof(String));
+			memcpy(&other, temp, sizeof(String));
+		}
+
 		void String::copy(UTF16 source, UTF8 destination, U32 size) {
 			memcpy(destination, source, size * sizeof(C8));
 		}
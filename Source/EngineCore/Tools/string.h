@@ -36,15 +36,21 @@ namespace Galactic {
 		Galactic Engine String Class. This is a widely used class throughout the engine as it provides a full String
 		module outside that of the C++ STL, the functioning of it is very similar to that of std::string, as well as some extended
 		functioning not included in the std::string class.
+
+		Strings of up to InlineCapacity bytes are stored inside of the String itself and never touch the heap, longer strings are held
+		in a reference counted StringData shared between copies. Appending to a String that is the only owner of it's StringData
+		happens in place, the StringData grows geometrically to keep repeated appends cheap.
 		*/
 		class String {
 			public:
-				//String formatting class used by all of the ToString operations
-				class StringFormat;
-
 				//StringData contains all of the String's information, and is used to actually "build" the string.
 				class StringData;
 
+				//The longest string stored inline (without a heap allocation), the String is 24 bytes in size.
+				enum {
+					InlineCapacity = 22,
+				};
+
 				//String Utility Enumeration, This is used in numerous places for find functions, and compare functions
 				enum StrMode {
 					CaseSens = 0,   /* String searching will be case sensitive */
@@ -67,6 +73,10 @@ namespace Galactic {
 				String(UTF16 str);
 				//Construct a string using a pre-defined size from a const char * instance
 				String(UTF16 str, U32 size);
+				//Construct a string by copying the characters of a StringView
+				explicit String(const StringView &view);
+				//Construct a string by taking over the contents of another string instance
+				String(String &&str);
 				//Destructor.
 				~String();
 
@@ -77,10 +87,18 @@ namespace Galactic {
 				U32 length() const;
 				//Returns the full size of the string, including the /0 terminator.
 				U32 size() const;
-				//Returns the character length of the string.
+				//Returns the character length of the string (the amount of UTF-8 code points).
 				U32 numChrs() const;
+				//Does the string hold well formed UTF-8? (Unicode::validateUTF8())
+				bool isValidUTF8() const;
 				//Is the string empty?
 				bool empty() const;
+				//Returns a StringView of the characters (valid until the string changes)
+				StringView view() const;
+				//Returns the hash of the string's characters (Hash::hashBytes()), long strings cache it in their StringData.
+				U64 hash() const;
+				//Is the string stored inline?
+				bool isInline() const { return _inlineLength != HeapMode; }
 
 				//Delete the entire string.
 				void clear();
@@ -96,6 +114,8 @@ namespace Galactic {
 				U32 find(UTF16 needle, U32 startPos = 0, U32 mode = CaseSens | Left) const; 
 				//Find an instance of a String in our string
 				U32 find(const String &needle, U32 startPos = 0, U32 mode = CaseSens | Left) const; 
+				//Find an instance of a StringView in our string
+				U32 find(const StringView &needle, U32 startPos = 0, U32 mode = CaseSens | Left) const;
 				//Insert a UTF16 into the current string at a specified position
 				String &insert(U32 position, UTF16 str);
 				//Insert a String into the current string at a specified position
@@ -112,11 +132,11 @@ namespace Galactic {
 				String trim() const;
 				//Split string into numerous delimitors based on input token
 				void split(UTF16 token, DynArray<String> &ref) const;
+				//Split string into views of it's characters based on input token, nothing is allocated for the pieces (see StringSplitter)
+				void split(UTF16 token, DynArray<StringView> &ref) const;
 
-				//Utility function used to convert pointer arguments into a String.
-				static String VoidToStr(UTF16 format, void* args);
-				//Converts a standard C++ string format w/ args into a String
-				static String ToStr(UTF16 format, ...);
+				//Formats a String (see Format for the placeholders), defined in format.h
+				template <typename... Args> static String ToStr(UTF16 format, const Args &... args);
 				//Converts a boolean into a String
 				static String ToStr(bool v);
 				//Convert a U32 into a String
@@ -144,8 +164,12 @@ namespace Galactic {
 				String& operator+=(UTF16 s);
 				//Set a string equal to another string.
 				String& operator=(const String &s);
+				//Set a string equal to another string, taking over it's contents.
+				String& operator=(String &&s);
 				//Add the contents of one string to another.
 				String& operator+=(const String &s);
+				//Add the characters of a StringView to the end of a string.
+				String& operator+=(const StringView &s);
 				/* Specials. These next five are defined specially such to allow addition syntax in other C++ files. */
 				//Add String to String
 				friend String operator+(const String &s1, const String &s2);
@@ -172,14 +196,51 @@ namespace Galactic {
 				C8 operator[](U32 index) const;
 		
 			private:
-				//Private String Constructor, Used to pre-define the internal StringData pointer
-				String(StringData *s) : _str(s) {}
+				//StringBuilder writes directly into the String it builds
+				friend class StringBuilder;
+
+				//Value of _inlineLength when the string is held in a StringData
+				enum {
+					HeapMode = 0xFF,
+				};
+
+				//Make the string an uninitialized (terminated) buffer of len characters able to hold capacity characters, and return it, the old
+				// contents are released so build into a separate String when they are needed.
+				UTF8 allocate(U32 len, U32 capacity = 0);
+				//Append characters to the end of the string, in place when possible
+				void append(UTF16 str, U32 len);
+				//Make sure the string owns room for capacity characters
+				void reserve(U32 capacity);
+				//Make room for count more characters (growing geometrically), returns where they are to be written, see commitAppend()
+				UTF8 reserveAppend(U32 count);
+				//Add count characters written to the pointer returned by reserveAppend() to the string
+				void commitAppend(U32 count);
+				//Change the length of a string that owns it's characters, the terminator is placed by this function
+				void setLength(U32 len);
+				//Release the StringData (if any) and become an empty inline string
+				void release();
+				//Exchange the contents of two strings
+				void swap(String &other);
 				//String copy function.
 				static void copy(UTF16 source, UTF8 destination, U32 size);
-				//Internal StringData pointer, holds all of the String information for usage by String
-				StringData *_str;
-				//Maximum string size
-				static Z32 maxStringSize;
+
+				union {
+					//Internal StringData pointer, holds the String information of long strings
+					StringData *_str;
+					struct {
+						//The characters of short strings (including the terminator)
+						C8 _inline[InlineCapacity + 1];
+						//The length of an inline string, or HeapMode (in the last byte, outside of the pointer)
+						U8 _inlineLength;
+					};
+				};
+		};
+
+		//Strings as hash keys
+		template <> struct Hasher<String> {
+			U64 operator()(const String &value) const {
+				return value.hash();
+			}
 		};
 
 		//Some useful typedefs
@@ -0,0 +1,117 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringBuilder.cpp
+* Defines the StringBuilder class, used to build String instances piece by piece
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		StringBuilder Class Definitions
+		*/
+		StringBuilder &StringBuilder::append(UTF16 str) {
+			if (str != NULL) {
+				append(str, (U32)strlen(str));
+			}
+			return *this;
+		}
+
+		StringBuilder &StringBuilder::append(UTF16 str, U32 len) {
+			if (len > 0) {
+				Memory::gmemcpy(buffer.reserveAppend(len), str, len);
+				buffer.commitAppend(len);
+			}
+			return *this;
+		}
+
+		StringBuilder &StringBuilder::append(C8 c) {
+			*buffer.reserveAppend(1) = c;
+			buffer.commitAppend(1);
+			return *this;
+		}
+
+		StringBuilder &StringBuilder::append(C8 c, U32 count) {
+			if (count > 0) {
+				Memory::gmemset(buffer.reserveAppend(count), c, count);
+				buffer.commitAppend(count);
+			}
+			return *this;
+		}
+
+		StringBuilder &StringBuilder::append(bool v) {
+			return v ? append("true", 4) : append("false", 5);
+		}
+
+		StringBuilder &StringBuilder::append(S64 v) {
+			if (v < 0) {
+				append('-');
+				//Negate as unsigned so the lowest S64 converts correctly.
+				return append((U64)0 - (U64)v);
+			}
+			return append((U64)v);
+		}
+
+		StringBuilder &StringBuilder::append(U64 v) {
+			//The digits are produced from the right, into a buffer large enough for the largest U64.
+			C8 digits[20];
+			UTF8 start = Format::writeDecimal(v, digits + 20);
+			return append(start, (U32)(digits + 20 - start));
+		}
+
+		StringBuilder &StringBuilder::append(F32 v) {
+			C8 digits[CharConv::MaxChars];
+			return append(digits, CharConv::toChars(digits, v));
+		}
+
+		StringBuilder &StringBuilder::append(F64 v) {
+			C8 digits[CharConv::MaxChars];
+			return append(digits, CharConv::toChars(digits, v));
+		}
+
+		StringBuilder &StringBuilder::appendHex(U64 v, U32 minDigits) {
+			static const C8 hexDigits[] = "0123456789abcdef";
+			C8 digits[16];
+			U32 pos = 16;
+			do {
+				digits[--pos] = hexDigits[v & 0xF];
+				v >>= 4;
+			} while (v != 0);
+			U32 count = 16 - pos;
+			if (minDigits > count) {
+				append('0', minDigits - count);
+			}
+			return append(digits + pos, count);
+		}
+
+		String StringBuilder::build() {
+			String result;
+			result.swap(buffer);
+			return result;
+		}
+
+	};
+
+};
\ No newline at end of file
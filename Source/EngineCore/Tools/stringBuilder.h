@@ -0,0 +1,106 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringBuilder.h
+* Defines the StringBuilder class, used to build String instances piece by piece
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_STRINGBUILDER
+#define GALACTIC_INTERNAL_STRINGBUILDER
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		StringBuilder: Builds a String out of many pieces. The characters are written straight into the storage of the String being built, which grows
+		 geometrically, so building a string of N characters costs O(N) no matter how many pieces it's made of. Numbers are converted without going
+		 through printf. build() hands the storage over to the resulting String without copying it.
+		*/
+		class StringBuilder {
+			public:
+				/* Constructors */
+				//Default Constructor
+				StringBuilder() { }
+				//Construct a builder with room for capacity characters
+				explicit StringBuilder(U32 capacity) { buffer.reserve(capacity); }
+
+				/* Public Class Methods */
+				//Make sure there is room for capacity characters in total
+				StringBuilder &reserve(U32 capacity) { buffer.reserve(capacity); return *this; }
+				//Append a UTF16
+				StringBuilder &append(UTF16 str);
+				//Append the first len characters of a UTF16
+				StringBuilder &append(UTF16 str, U32 len);
+				//Append a String
+				StringBuilder &append(strRef str) { return append(str.c_str(), str.length()); }
+				//Append a StringView
+				StringBuilder &append(const StringView &str) { return append(str.data(), str.length()); }
+				//Append a Name
+				StringBuilder &append(const Name &name) { return append(name.c_str(), name.length()); }
+				//Append a character
+				StringBuilder &append(C8 c);
+				//Append a character count times
+				StringBuilder &append(C8 c, U32 count);
+				//Append a boolean as "true" or "false"
+				StringBuilder &append(bool v);
+				//Append a S32
+				StringBuilder &append(S32 v) { return append((S64)v); }
+				//Append a U32
+				StringBuilder &append(U32 v) { return append((U64)v); }
+				//Append a S64
+				StringBuilder &append(S64 v);
+				//Append a U64
+				StringBuilder &append(U64 v);
+				//Append a F32
+				StringBuilder &append(F32 v);
+				//Append a F64
+				StringBuilder &append(F64 v);
+				//Append a value in (lower case) hexadecimal, padded with zeros to at least minDigits digits
+				StringBuilder &appendHex(U64 v, U32 minDigits = 1);
+				//Append a formatted string (see Format), defined in format.h
+				template <typename... Args> StringBuilder &appendFormat(UTF16 format, const Args &... args);
+				//Fetch the length of the string built so far
+				U32 length() const { return buffer.length(); }
+				//Fetch the string built so far, valid until the next append
+				UTF16 c_str() const { return buffer.c_str(); }
+				//Clear the builder, keeping the storage if it's not shared
+				void clear() { buffer.setLength(0); }
+				//Hand the built string over, the builder is empty afterwards
+				String build();
+
+			private:
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				StringBuilder(const StringBuilder &);
+				//Assignment Operator
+				StringBuilder &operator=(const StringBuilder &);
+
+				/* Private Class Members */
+				//The String being built
+				String buffer;
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_STRINGBUILDER
\ No newline at end of file
@@ -0,0 +1,273 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringTable.cpp
+* Defines the global string interning table and the Name type
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		StringTableEntry: An interned string, stored in the arena. The characters follow the entry and are terminated.
+		*/
+		struct StringTableEntry {
+			//The hash of the string
+			U32 hash;
+			//The length of the string
+			U32 length;
+			//The characters of the string
+			C8 chars[1];
+		};
+
+		/*
+		StringTableBuckets: The open addressing hash table, holding the IDs of the entries (0 marks an unused bucket, the empty string is never placed
+		 in the table). A full table is replaced by one twice the size, the old table is kept alive as readers may still be probing it.
+		*/
+		struct StringTableBuckets {
+			//The bucket count - 1
+			U32 mask;
+			//The previous (retired) table
+			StringTableBuckets *retired;
+			//The buckets
+			volatile U32 ids[1];
+		};
+
+		//The amount of IDs in each block of entry pointers, and the maximum amount of blocks
+		static const U32 stringTableBlockSize = 4096;
+		static const U32 stringTableMaxBlocks = 4096;
+		//The size of the arena chunks holding the entries
+		static const U32 stringTableChunkSize = 65536;
+		//The initial amount of buckets
+		static const U32 stringTableInitialBuckets = 1024;
+
+		//The blocks of entry pointers, indexed by ID
+		static StringTableEntry **volatile _stringBlocks[stringTableMaxBlocks];
+		//The current hash table
+		static StringTableBuckets *volatile _stringBuckets = NULL;
+		//The amount of IDs handed out
+		static volatile U32 _stringCount = 0;
+		//The arena chunk being filled
+		static UTX8 _stringChunk = NULL;
+		static U32 _stringChunkUsed = 0;
+		//The empty string (ID 0)
+		static StringTableEntry _emptyEntry = { 0, 0, { '\0' } };
+
+		//Fetch the lock guarding insertion
+		static PlatformCriticalSection &fetchStringTableLock() {
+			static PlatformCriticalSection cSec;
+			return cSec;
+		}
+
+		//Hash the characters of a string, the same hash as String::hash() folded to 32 bits
+		static U32 hashStringTableChars(UTF16 str, U32 len) {
+			return Hash::fold32(Hash::hashBytes(str, len));
+		}
+
+		//Fetch the entry of an ID, the ID must be valid
+		SFIN StringTableEntry *fetchStringTableEntry(U32 id) {
+			return _stringBlocks[id / stringTableBlockSize][id % stringTableBlockSize];
+		}
+
+		//Probe a table for a string, returns NotFound if it is not present
+		static U32 probeStringTable(StringTableBuckets *table, UTF16 str, U32 len, U32 hash) {
+			for (U32 i = hash & table->mask; ; i = (i + 1) & table->mask) {
+				U32 id = table->ids[i];
+				if (id == 0) {
+					return StringTable::NotFound;
+				}
+				StringTableEntry *entry = fetchStringTableEntry(id);
+				if (entry->hash == hash && entry->length == len && memcmp(entry->chars, str, len) == 0) {
+					return id;
+				}
+			}
+		}
+
+		//Place an ID in a table, the caller holds the lock
+		static void placeStringTableID(StringTableBuckets *table, U32 id, U32 hash) {
+			U32 i = hash & table->mask;
+			while (table->ids[i] != 0) {
+				i = (i + 1) & table->mask;
+			}
+			PlatformAtomics::exchange((volatile S32 *)&table->ids[i], (S32)id);
+		}
+
+		//Create a table, filled with every ID handed out so far, the caller holds the lock
+		static StringTableBuckets *createStringTable(U32 bucketCount) {
+			StringTableBuckets *table = (StringTableBuckets *)Memory::gmallocTagged(sizeof(StringTableBuckets) + (bucketCount - 1) * sizeof(U32),
+				MemoryTracker::Tag_Strings);
+			table->mask = bucketCount - 1;
+			table->retired = _stringBuckets;
+			Memory::gmemset((any)table->ids, 0, bucketCount * sizeof(U32));
+			for (U32 id = 1; id < _stringCount; id++) {
+				placeStringTableID(table, id, fetchStringTableEntry(id)->hash);
+			}
+			return table;
+		}
+
+		//Copy a string into the arena, the caller holds the lock
+		static StringTableEntry *createStringTableEntry(UTF16 str, U32 len, U32 hash) {
+			U32 entrySize = (U32)((offsetof(StringTableEntry, chars) + len + 1 + 7) & ~7);
+			StringTableEntry *entry;
+			if (entrySize > stringTableChunkSize / 4) {
+				//Large strings get an allocation of their own rather than wasting the rest of a chunk.
+				entry = (StringTableEntry *)Memory::gmallocTagged(entrySize, MemoryTracker::Tag_Strings);
+			}
+			else {
+				if (_stringChunk == NULL || _stringChunkUsed + entrySize > stringTableChunkSize) {
+					_stringChunk = (UTX8)Memory::gmallocTagged(stringTableChunkSize, MemoryTracker::Tag_Strings);
+					_stringChunkUsed = 0;
+				}
+				entry = (StringTableEntry *)(_stringChunk + _stringChunkUsed);
+				_stringChunkUsed += entrySize;
+			}
+			entry->hash = hash;
+			entry->length = len;
+			Memory::gmemcpy(entry->chars, str, len);
+			entry->chars[len] = '\0';
+			return entry;
+		}
+
+		/*
+		StringTable Class Definitions
+		*/
+		U32 StringTable::intern(UTF16 str) {
+			if (str == NULL || *str == '\0') {
+				return 0;
+			}
+			return intern(str, (U32)strlen(str));
+		}
+
+		U32 StringTable::intern(strRef str) {
+			return intern(str.c_str(), str.length());
+		}
+
+		U32 StringTable::intern(UTF16 str, U32 len) {
+			if (len == 0) {
+				return 0;
+			}
+			U32 hash = hashStringTableChars(str, len);
+			//Most strings are already interned, so check without the lock first.
+			StringTableBuckets *table = _stringBuckets;
+			if (table != NULL) {
+				U32 id = probeStringTable(table, str, len, hash);
+				if (id != NotFound) {
+					return id;
+				}
+			}
+			MutexLock lock(&fetchStringTableLock());
+			//Another thread may have interned the string (or replaced the table) while we were waiting.
+			table = _stringBuckets;
+			if (table == NULL) {
+				_stringBlocks[0] = (StringTableEntry **)Memory::gmallocTagged(stringTableBlockSize * sizeof(StringTableEntry *), MemoryTracker::Tag_Strings);
+				_stringBlocks[0][0] = &_emptyEntry;
+				_stringCount = 1;
+				table = createStringTable(stringTableInitialBuckets);
+				PlatformAtomics::exchange((any *)&_stringBuckets, (any)table);
+			}
+			else {
+				U32 id = probeStringTable(table, str, len, hash);
+				if (id != NotFound) {
+					return id;
+				}
+			}
+			U32 id = _stringCount;
+			if (id / stringTableBlockSize >= stringTableMaxBlocks) {
+				GC_Error("StringTable::intern(): The string table is full (%u strings), cannot intern '%.*s'.", id, len, str);
+				return 0;
+			}
+			//Keep the table at most 3/4 full so probes stay short.
+			if ((id + 1) * 4 > (table->mask + 1) * 3) {
+				table = createStringTable((table->mask + 1) * 2);
+				PlatformAtomics::exchange((any *)&_stringBuckets, (any)table);
+			}
+			if (id % stringTableBlockSize == 0) {
+				StringTableEntry **block = (StringTableEntry **)Memory::gmallocTagged(stringTableBlockSize * sizeof(StringTableEntry *),
+					MemoryTracker::Tag_Strings);
+				PlatformAtomics::exchange((any *)&_stringBlocks[id / stringTableBlockSize], (any)block);
+			}
+			//The entry is complete before the ID is published, a reader finding the ID always finds the full string.
+			_stringBlocks[id / stringTableBlockSize][id % stringTableBlockSize] = createStringTableEntry(str, len, hash);
+			PlatformAtomics::exchange((volatile S32 *)&_stringCount, (S32)(id + 1));
+			placeStringTableID(table, id, hash);
+			return id;
+		}
+
+		U32 StringTable::find(UTF16 str, U32 len) {
+			if (len == 0) {
+				return 0;
+			}
+			StringTableBuckets *table = _stringBuckets;
+			if (table == NULL) {
+				return NotFound;
+			}
+			U32 hash = hashStringTableChars(str, len);
+			U32 id = probeStringTable(table, str, len, hash);
+			if (id == NotFound && table != _stringBuckets) {
+				//The table was replaced during the probe, try the new table.
+				id = probeStringTable(_stringBuckets, str, len, hash);
+			}
+			return id;
+		}
+
+		UTF16 StringTable::fetchString(U32 id) {
+			if (!isValid(id)) {
+				GC_Error("StringTable::fetchString(): Invalid string ID %u.", id);
+				return _emptyEntry.chars;
+			}
+			return id == 0 ? _emptyEntry.chars : fetchStringTableEntry(id)->chars;
+		}
+
+		U32 StringTable::fetchLength(U32 id) {
+			return id != 0 && isValid(id) ? fetchStringTableEntry(id)->length : 0;
+		}
+
+		U32 StringTable::fetchHash(U32 id) {
+			return id != 0 && isValid(id) ? fetchStringTableEntry(id)->hash : 0;
+		}
+
+		bool StringTable::isValid(U32 id) {
+			return id == 0 || id < _stringCount;
+		}
+
+		U32 StringTable::fetchCount() {
+			return _stringCount == 0 ? 1 : _stringCount;
+		}
+
+		/*
+		Name Class Definitions
+		*/
+		Name Name::fromID(U32 id) {
+			Name result;
+			if (!StringTable::isValid(id)) {
+				GC_Error("Name::fromID(): Invalid string ID %u.", id);
+				return result;
+			}
+			result.id = id;
+			return result;
+		}
+
+	};
+
+};
\ No newline at end of file
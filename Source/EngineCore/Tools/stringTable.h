@@ -0,0 +1,127 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringTable.h
+* Defines the global string interning table and the Name type
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_STRINGTABLE
+#define GALACTIC_INTERNAL_STRINGTABLE
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		StringTable: The global string interning table. Every distinct string is stored once in an append only arena and is given a 32-bit ID, the
+		 characters of an ID never move or change for the life of the process. Looking up an existing string and fetching the string of an ID never
+		 lock, only the insertion of a new string does. ID 0 is always the empty string.
+
+		 Note: IDs are assigned in order of interning, so they only match between two processes that interned the same strings in the same order. When
+		 sending IDs over the network, send the string with it's ID the first time and map the IDs on the receiving end.
+		*/
+		class StringTable {
+			public:
+				/* Public Class Methods */
+				//Intern a string, returns it's ID
+				static U32 intern(UTF16 str);
+				//Intern the first len characters of a string, returns it's ID
+				static U32 intern(UTF16 str, U32 len);
+				//Intern a String instance, returns it's ID
+				static U32 intern(strRef str);
+				//Find the ID of a string without interning it, returns NotFound if the string was never interned
+				static U32 find(UTF16 str, U32 len);
+				//Fetch the characters of an ID
+				static UTF16 fetchString(U32 id);
+				//Fetch the length of an ID's string
+				static U32 fetchLength(U32 id);
+				//Fetch the hash of an ID's string
+				static U32 fetchHash(U32 id);
+				//Test if an ID (IE: One read from a stream) refers to an interned string
+				static bool isValid(U32 id);
+				//Fetch the amount of interned strings (including the empty string)
+				static U32 fetchCount();
+
+				/* Public Class Members */
+				enum {
+					//Returned by find() when the string is not in the table
+					NotFound = U32(~0),
+				};
+		};
+
+		/*
+		Name: A reference to an interned string, held as the StringTable ID. Names are the size of a U32, copy without any work, and compare and hash
+		 in constant time, which makes them the preferred type for identifiers (thread names, file extensions, command names, network identifiers).
+		*/
+		class Name {
+			public:
+				/* Constructors */
+				//Default Constructor, the empty name
+				Name() : id(0) { }
+				//Create a name from a UTF16, interning it
+				Name(UTF16 str) : id(StringTable::intern(str)) { }
+				//Create a name from a String, interning it
+				Name(strRef str) : id(StringTable::intern(str)) { }
+				//Create a name from a StringView, interning it (without building a String)
+				Name(const StringView &str) : id(StringTable::intern(str.data(), str.length())) { }
+
+				/* Public Class Methods */
+				//Create a name from an ID (IE: One read from a stream), returns the empty name if the ID is not valid
+				static Name fromID(U32 id);
+				//Fetch the StringTable ID of the name
+				U32 fetchID() const { return id; }
+				//Fetch the characters of the name
+				UTF16 c_str() const { return StringTable::fetchString(id); }
+				//Fetch the length of the name
+				U32 length() const { return StringTable::fetchLength(id); }
+				//Fetch the name as a String instance
+				String toString() const { return String(c_str()); }
+				//Test if this is the empty name
+				bool empty() const { return id == 0; }
+				//Fetch the hash value of the name (constant time, unique per name)
+				U32 hash() const { return id; }
+
+				/* Operators */
+				//Equality Operator
+				bool operator==(const Name &n) const { return id == n.id; }
+				//Inequality Operator
+				bool operator!=(const Name &n) const { return id != n.id; }
+				//Comparison Operator, orders by ID (not alphabetically), for use in sorted containers
+				bool operator<(const Name &n) const { return id < n.id; }
+
+			private:
+				/* Private Class Members */
+				//The StringTable ID
+				U32 id;
+		};
+
+		//Names as hash keys, the IDs are sequential so they're mixed before use
+		template <> struct Hasher<Name> {
+			U64 operator()(const Name &value) const {
+				return Hash::hashU32(value.fetchID());
+			}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_STRINGTABLE
\ No newline at end of file
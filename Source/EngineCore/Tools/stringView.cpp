@@ -0,0 +1,203 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringView.cpp
+* Defines StringView, a non-owning reference to a range of characters
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		 StringView Class Definitions
+		*/
+
+		StringView StringView::substr(U32 startPosition, U32 count) const {
+			if(startPosition > len) {
+				startPosition = len;
+			}
+			if(count > len - startPosition) {
+				count = len - startPosition;
+			}
+			return StringView(chars + startPosition, count);
+		}
+
+		StringView StringView::trim() const {
+			return trimLeft().trimRight();
+		}
+
+		StringView StringView::trimLeft() const {
+			UTF16 first = StrTools::findFirstNotOf(chars, len, StrTools::whiteSpaceSet);
+			return first ? StringView(first, len - (U32)(first - chars)) : StringView(chars + len, 0);
+		}
+
+		StringView StringView::trimRight() const {
+			U32 count = len;
+			while(count > 0 && isspace((U8)chars[count - 1])) {
+				count--;
+			}
+			return StringView(chars, count);
+		}
+
+		bool StringView::startsWith(const StringView &prefix, U32 mode) const {
+			if(prefix.len > len) {
+				return false;
+			}
+			return substr(0, prefix.len).compare(prefix, mode) == 0;
+		}
+
+		bool StringView::endsWith(const StringView &suffix, U32 mode) const {
+			if(suffix.len > len) {
+				return false;
+			}
+			return substr(len - suffix.len).compare(suffix, mode) == 0;
+		}
+
+		S32 StringView::compare(const StringView &str, U32 mode) const {
+			U32 count = len < str.len ? len : str.len;
+			S32 result = (mode & String::NoCaseSens) ? StrTools::compareNoCase(chars, str.chars, count) : memcmp(chars, str.chars, count);
+			if(result != 0) {
+				return result;
+			}
+			//The common part matches, the shorter view comes first
+			return len == str.len ? 0 : (len < str.len ? -1 : 1);
+		}
+
+		U32 StringView::find(C8 needle, U32 startPos, U32 mode) const {
+			bool caseSensitive = !(mode & String::NoCaseSens);
+			if(mode & String::Right) {
+				//Walk backwards from the end (or the position before startPos)
+				U32 position = startPos && startPos - 1 < len ? startPos : len;
+				C8 folded = (C8)tolower((U8)needle);
+				while(position-- > 0) {
+					if(caseSensitive ? chars[position] == needle : tolower((U8)chars[position]) == folded) {
+						return position;
+					}
+				}
+				return String::NOTFOUND;
+			}
+			if(startPos >= len) {
+				return String::NOTFOUND;
+			}
+			UTF16 result = StrTools::findChar(chars + startPos, len - startPos, needle, caseSensitive);
+			return result ? U32(result - chars) : String::NOTFOUND;
+		}
+
+		U32 StringView::find(const StringView &needle, U32 startPos, U32 mode) const {
+			if(needle.len == 0 || needle.len > len) {
+				return String::NOTFOUND;
+			}
+			bool caseSensitive = !(mode & String::NoCaseSens);
+			if(mode & String::Right) {
+				//Walk backwards from the last position the needle fits in (or the one before startPos)
+				U32 position = len - needle.len;
+				if(startPos && startPos - 1 < position) {
+					position = startPos - 1;
+				}
+				for(U32 i = position + 1; i-- > 0;) {
+					if((caseSensitive ? memcmp(chars + i, needle.chars, needle.len) : StrTools::compareNoCase(chars + i, needle.chars, needle.len)) == 0) {
+						return i;
+					}
+				}
+				return String::NOTFOUND;
+			}
+			if(startPos >= len) {
+				return String::NOTFOUND;
+			}
+			UTF16 result = StrTools::findSubstring(chars + startPos, len - startPos, needle.chars, needle.len, caseSensitive);
+			return result ? U32(result - chars) : String::NOTFOUND;
+		}
+
+		U32 StringView::findFirstOf(UTF16 set, U32 startPos) const {
+			if(startPos >= len) {
+				return String::NOTFOUND;
+			}
+			UTF16 result = StrTools::findFirstOf(chars + startPos, len - startPos, set);
+			return result ? U32(result - chars) : String::NOTFOUND;
+		}
+
+		U32 StringView::findFirstNotOf(UTF16 set, U32 startPos) const {
+			if(startPos >= len) {
+				return String::NOTFOUND;
+			}
+			UTF16 result = StrTools::findFirstNotOf(chars + startPos, len - startPos, set);
+			return result ? U32(result - chars) : String::NOTFOUND;
+		}
+
+		StringSplitter StringView::split(const StringView &separator) const {
+			return StringSplitter(*this, separator, StringSplitter::Separator);
+		}
+
+		StringSplitter StringView::tokenize(UTF16 delimiters) const {
+			return StringSplitter(*this, delimiters, StringSplitter::DelimiterSet);
+		}
+
+		/*
+		 StringSplitter Class Definitions
+		*/
+
+		StringSplitter::StringSplitter(const StringView &source, const StringView &delim, SplitMode splitMode) : delimiter(delim) {
+			position = source.begin();
+			last = source.end();
+			mode = splitMode;
+			done = (position == last);
+		}
+
+		bool StringSplitter::next(StringView &piece) {
+			if(done) {
+				return false;
+			}
+			U32 remaining = (U32)(last - position);
+			if(mode == DelimiterSet) {
+				//Skip the delimiters before the piece, then take everything up to the next one
+				UTF16 start = StrTools::findFirstNotOf(position, remaining, delimiter.data());
+				if(!start) {
+					done = true;
+					return false;
+				}
+				UTF16 stop = StrTools::findFirstOf(start, (U32)(last - start), delimiter.data());
+				if(!stop) {
+					stop = last;
+				}
+				piece = StringView(start, (U32)(stop - start));
+				position = stop;
+				done = (position == last);
+				return true;
+			}
+			UTF16 match = delimiter.empty() ? NULL : StrTools::findSubstring(position, remaining, delimiter.data(), delimiter.length());
+			if(!match) {
+				//The rest of the source is the last piece
+				piece = StringView(position, remaining);
+				done = true;
+				return true;
+			}
+			piece = StringView(position, (U32)(match - position));
+			position = match + delimiter.length();
+			done = (position == last);
+			return true;
+		}
+
+	};
+
+};
\ No newline at end of file
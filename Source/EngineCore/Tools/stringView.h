@@ -0,0 +1,201 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/stringView.h
+* Defines StringView, a non-owning reference to a range of characters
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_STRINGVIEW
+#define GALACTIC_INTERNAL_STRINGVIEW
+
+namespace Galactic {
+
+	namespace Core {
+
+		class StringSplitter;
+
+		/*
+		StringView: A pointer and a length referring to characters owned by someone else (a String, a literal, a file buffer). Views copy for free and
+		 taking a piece of one (substr, trim, split) never allocates, so parsers should pass views around and only build a String for what they keep.
+		 A view is NOT NULL terminated and does not keep the characters alive, it must not outlive what it refers to. The mode arguments use the
+		 String::StrMode values.
+		*/
+		class StringView {
+			public:
+				/* Constructors */
+				//Default Constructor, the empty view
+				StringView() : chars(""), len(0) { }
+				//View a NULL terminated string
+				StringView(UTF16 str) : chars(str ? str : ""), len(str ? (U32)strlen(str) : 0) { }
+				//View the first length characters of a string
+				StringView(UTF16 str, U32 length) : chars(str ? str : ""), len(str ? length : 0) { }
+				//View the characters of a String (valid until the String changes)
+				StringView(const String &str) : chars(str.c_str()), len(str.length()) { }
+
+				/* Public Class Methods */
+				//Fetch the first character (not terminated, see length())
+				UTF16 data() const { return chars; }
+				//Fetch the length of the view
+				U32 length() const { return len; }
+				//Is the view empty?
+				bool empty() const { return len == 0; }
+				//Fetch the start of the characters, for loops
+				UTF16 begin() const { return chars; }
+				//Fetch the end of the characters, for loops
+				UTF16 end() const { return chars + len; }
+
+				//Fetch a view of len characters from startPosition, both are clamped to the view (-1 takes the rest of it)
+				StringView substr(U32 startPosition, U32 count = -1) const;
+				//Fetch the view without leading and trailing whitespace
+				StringView trim() const;
+				//Fetch the view without leading whitespace
+				StringView trimLeft() const;
+				//Fetch the view without trailing whitespace
+				StringView trimRight() const;
+				//Fetch the view without it's first count characters
+				StringView dropFront(U32 count) const { return count < len ? StringView(chars + count, len - count) : StringView(chars + len, 0); }
+				//Fetch the view without it's last count characters
+				StringView dropBack(U32 count) const { return count < len ? StringView(chars, len - count) : StringView(chars, 0); }
+				//Does the view start with prefix?
+				bool startsWith(const StringView &prefix, U32 mode = String::CaseSens) const;
+				//Does the view end with suffix?
+				bool endsWith(const StringView &suffix, U32 mode = String::CaseSens) const;
+
+				//Compare to another view, returns < 0, 0, or > 0 like strcmp
+				S32 compare(const StringView &str, U32 mode = String::CaseSens) const;
+				//Find a character (String::find() rules), returns String::NOTFOUND if it isn't there
+				U32 find(C8 needle, U32 startPos = 0, U32 mode = String::CaseSens | String::Left) const;
+				//Find another view (String::find() rules), returns String::NOTFOUND if it isn't there
+				U32 find(const StringView &needle, U32 startPos = 0, U32 mode = String::CaseSens | String::Left) const;
+				//Find the first character that is in the set, returns String::NOTFOUND if there is none
+				U32 findFirstOf(UTF16 set, U32 startPos = 0) const;
+				//Find the first character that is not in the set, returns String::NOTFOUND if there is none
+				U32 findFirstNotOf(UTF16 set, U32 startPos = 0) const;
+
+				//Split into the pieces between each instance of separator (see StringSplitter)
+				StringSplitter split(const StringView &separator) const;
+				//Split into the runs of characters that aren't in the delimiters set, skipping empty pieces (see StringSplitter)
+				StringSplitter tokenize(UTF16 delimiters = StrTools::whiteSpaceSet) const;
+
+				//Hash the characters, the same value as String::hash() of the same characters
+				U64 hash() const { return Hash::hashBytes(chars, len); }
+				//Copy the characters into a String
+				String toString() const { return String(*this); }
+
+				/* Operators */
+				//Fetch a character
+				C8 operator[](U32 index) const { return chars[index]; }
+				//Equality Operator
+				bool operator==(const StringView &v) const { return len == v.len && (chars == v.chars || memcmp(chars, v.chars, len) == 0); }
+				//Inequality Operator
+				bool operator!=(const StringView &v) const { return !(*this == v); }
+				//Comparison Operator, for use in sorted containers
+				bool operator<(const StringView &v) const { return compare(v) < 0; }
+
+			private:
+				/* Private Class Members */
+				//The first character
+				UTF16 chars;
+				//The amount of characters
+				U32 len;
+		};
+
+		/*
+		StringSplitter: Walks the pieces of a StringView without allocating. In Separator mode the pieces between each instance of the separator are
+		 returned, including empty ones, but no empty piece is made after a trailing separator (the same pieces as String::split()). In DelimiterSet
+		 mode the runs of characters not in the set are returned, which is the usual tokenizer. Use it either as:
+		  StringView piece;
+		  while(splitter.next(piece)) { ... }
+		 or with a range based for loop.
+		*/
+		class StringSplitter {
+			public:
+				//How the delimiter is used
+				enum SplitMode {
+					Separator,
+					DelimiterSet,
+				};
+
+				/* Constructor */
+				//Split source, a DelimiterSet delimiter must be NULL terminated
+				StringSplitter(const StringView &source, const StringView &delimiter, SplitMode mode);
+
+				/* Public Class Methods */
+				//Fetch the next piece, returns false when there are none left
+				bool next(StringView &piece);
+
+				/*
+				Iterator: The range based for loop support, iterating consumes the splitter.
+				*/
+				class Iterator {
+					public:
+						Iterator(StringSplitter *owner) : splitter(owner) { advance(); }
+						const StringView &operator*() const { return current; }
+						const StringView *operator->() const { return &current; }
+						Iterator &operator++() { advance(); return *this; }
+						bool operator==(const Iterator &i) const { return splitter == i.splitter; }
+						bool operator!=(const Iterator &i) const { return splitter != i.splitter; }
+
+					private:
+						//Fetch the next piece, becoming the end iterator once there are none
+						void advance() {
+							if(splitter && !splitter->next(current)) {
+								splitter = NULL;
+							}
+						}
+
+						//The splitter being walked (NULL for the end)
+						StringSplitter *splitter;
+						//The current piece
+						StringView current;
+				};
+
+				//Fetch the iterator of the first piece
+				Iterator begin() { return Iterator(this); }
+				//Fetch the end iterator
+				Iterator end() { return Iterator(NULL); }
+
+			private:
+				/* Private Class Members */
+				//The rest of the source
+				UTF16 position;
+				//The end of the source
+				UTF16 last;
+				//The separator, or the set of delimiters
+				StringView delimiter;
+				//How the delimiter is used
+				SplitMode mode;
+				//Has the last piece been returned?
+				bool done;
+		};
+
+		//Views as hash keys, a view hashes like a String with the same characters
+		template <> struct Hasher<StringView> {
+			U64 operator()(const StringView &value) const {
+				return value.hash();
+			}
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_STRINGVIEW
\ No newline at end of file
@@ -0,0 +1,660 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/unicode.cpp
+* UTF-8 validation, code point counting and UTF-8 / UTF-16 / UTF-32 transcoding
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "../engineCore.h"
+
+#if GALACTIC_STRTOOLS_SIMD != 0 && (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+	#define GALACTIC_UNICODE_X86 1
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define UNICODE_TARGET_SSE2
+		#define UNICODE_TARGET_AVX2
+	#else
+		#include <immintrin.h>
+		//See strTools.cpp, the kernels are only called when StrTools::fetchSimdLevel() reports the instruction set
+		#define UNICODE_TARGET_SSE2 __attribute__((target("sse2")))
+		#define UNICODE_TARGET_AVX2 __attribute__((target("avx2")))
+	#endif
+#else
+	#define GALACTIC_UNICODE_X86 0
+#endif
+
+namespace Galactic {
+
+	namespace Core {
+
+		/* Scalar Kernels: Always available, and used for the non ASCII blocks of the vector loops */
+
+		//decodeUTF8(): Decode the sequence at str[pos], advancing pos past it. Returns false (leaving pos on the lead byte) if it is malformed.
+		static FINLINE bool decodeUTF8(const U8 *str, U32 len, U32 &pos, U32 &codePoint) {
+			U32 lead = str[pos], remaining = len - pos;
+			//The second byte has a narrower range after E0 / ED / F0 / F4, that is what rules out overlong forms, surrogates and values past U+10FFFF
+			U32 low = 0x80, high = 0xBF;
+			if (lead < 0x80) {
+				codePoint = lead;
+				pos++;
+				return true;
+			}
+			if (lead >= 0xC2 && lead <= 0xDF) {
+				if (remaining < 2 || (str[pos + 1] & 0xC0) != 0x80) {
+					return false;
+				}
+				codePoint = ((lead & 0x1F) << 6) | (str[pos + 1] & 0x3F);
+				pos += 2;
+				return true;
+			}
+			if (lead >= 0xE0 && lead <= 0xEF) {
+				if (lead == 0xE0) {
+					low = 0xA0;
+				}
+				else if (lead == 0xED) {
+					high = 0x9F;
+				}
+				if (remaining < 3 || str[pos + 1] < low || str[pos + 1] > high || (str[pos + 2] & 0xC0) != 0x80) {
+					return false;
+				}
+				codePoint = ((lead & 0x0F) << 12) | ((str[pos + 1] & 0x3F) << 6) | (str[pos + 2] & 0x3F);
+				pos += 3;
+				return true;
+			}
+			if (lead >= 0xF0 && lead <= 0xF4) {
+				if (lead == 0xF0) {
+					low = 0x90;
+				}
+				else if (lead == 0xF4) {
+					high = 0x8F;
+				}
+				if (remaining < 4 || str[pos + 1] < low || str[pos + 1] > high || (str[pos + 2] & 0xC0) != 0x80 || (str[pos + 3] & 0xC0) != 0x80) {
+					return false;
+				}
+				codePoint = ((lead & 0x07) << 18) | ((str[pos + 1] & 0x3F) << 12) | ((str[pos + 2] & 0x3F) << 6) | (str[pos + 3] & 0x3F);
+				pos += 4;
+				return true;
+			}
+			//Continuation bytes, C0 / C1 (always overlong) and F5+ can't start a sequence
+			return false;
+		}
+
+		//encodeUTF8(): Write a code point (already known to be valid) as UTF-8, returns the amount of bytes written
+		static FINLINE U32 encodeUTF8(U32 codePoint, UTF8 dest) {
+			if (codePoint < 0x80) {
+				dest[0] = (C8)codePoint;
+				return 1;
+			}
+			if (codePoint < 0x800) {
+				dest[0] = (C8)(0xC0 | (codePoint >> 6));
+				dest[1] = (C8)(0x80 | (codePoint & 0x3F));
+				return 2;
+			}
+			if (codePoint < 0x10000) {
+				dest[0] = (C8)(0xE0 | (codePoint >> 12));
+				dest[1] = (C8)(0x80 | ((codePoint >> 6) & 0x3F));
+				dest[2] = (C8)(0x80 | (codePoint & 0x3F));
+				return 3;
+			}
+			dest[0] = (C8)(0xF0 | (codePoint >> 18));
+			dest[1] = (C8)(0x80 | ((codePoint >> 12) & 0x3F));
+			dest[2] = (C8)(0x80 | ((codePoint >> 6) & 0x3F));
+			dest[3] = (C8)(0x80 | (codePoint & 0x3F));
+			return 4;
+		}
+
+		//writeUTF16(): Write a code point as one UTF-16 unit, or as a surrogate pair, returns the amount of units written
+		static FINLINE U32 writeUTF16(U32 codePoint, U16 *dest) {
+			if (codePoint < 0x10000) {
+				dest[0] = (U16)codePoint;
+				return 1;
+			}
+			codePoint -= 0x10000;
+			dest[0] = (U16)(0xD800 | (codePoint >> 10));
+			dest[1] = (U16)(0xDC00 | (codePoint & 0x3FF));
+			return 2;
+		}
+
+		//isASCIIWord(): Test eight bytes at once for the high bit
+		static FINLINE bool isASCIIWord(const U8 *str) {
+			U64 word;
+			memcpy(&word, str, sizeof(word));
+			return (word & U64DEF(0x8080808080808080)) == 0;
+		}
+
+		static U32 scalarFindInvalid(const U8 *str, U32 len) {
+			U32 pos = 0, codePoint;
+			while (pos < len) {
+				if (pos + 8 <= len && isASCIIWord(str + pos)) {
+					pos += 8;
+					continue;
+				}
+				if (!decodeUTF8(str, len, pos, codePoint)) {
+					return pos;
+				}
+			}
+			return len;
+		}
+
+		static bool scalarValidate(const U8 *str, U32 len) {
+			return scalarFindInvalid(str, len) == len;
+		}
+
+		//scalarCount(): Count the bytes that start a code point, and (if wanted) add the 4 byte leads that need a second UTF-16 unit
+		static U32 scalarCount(const U8 *str, U32 len, bool utf16Units) {
+			U32 count = 0;
+			for (U32 i = 0; i < len; i++) {
+				count += (str[i] & 0xC0) != 0x80;
+				if (utf16Units) {
+					count += str[i] >= 0xF0;
+				}
+			}
+			return count;
+		}
+
+		static bool scalarUTF8ToUTF16(const U8 *str, U32 len, U16 *dest, U32 &written) {
+			U32 pos = 0, out = 0, codePoint;
+			while (pos < len) {
+				if (!decodeUTF8(str, len, pos, codePoint)) {
+					return false;
+				}
+				out += writeUTF16(codePoint, dest + out);
+			}
+			written = out;
+			return true;
+		}
+
+		static bool scalarUTF8ToUTF32(const U8 *str, U32 len, U32 *dest, U32 &written) {
+			U32 pos = 0, out = 0;
+			while (pos < len) {
+				if (!decodeUTF8(str, len, pos, dest[out])) {
+					return false;
+				}
+				out++;
+			}
+			written = out;
+			return true;
+		}
+
+		//utf16ToUTF8Step(): Convert the unit (or surrogate pair) at str[pos], advancing pos past it. Returns false on an unpaired surrogate.
+		static FINLINE bool utf16ToUTF8Step(const U16 *str, U32 len, U32 &pos, UTF8 dest, U32 &out) {
+			U32 unit = str[pos];
+			if (unit < 0xD800 || unit > 0xDFFF) {
+				out += encodeUTF8(unit, dest + out);
+				pos++;
+				return true;
+			}
+			if (unit > 0xDBFF || pos + 1 >= len || str[pos + 1] < 0xDC00 || str[pos + 1] > 0xDFFF) {
+				return false;
+			}
+			out += encodeUTF8(0x10000 + ((unit - 0xD800) << 10) + (str[pos + 1] - 0xDC00), dest + out);
+			pos += 2;
+			return true;
+		}
+
+		static bool scalarUTF16ToUTF8(const U16 *str, U32 len, UTF8 dest, U32 &written) {
+			U32 pos = 0, out = 0;
+			while (pos < len) {
+				if (!utf16ToUTF8Step(str, len, pos, dest, out)) {
+					return false;
+				}
+			}
+			written = out;
+			return true;
+		}
+
+		static bool scalarUTF32ToUTF8(const U32 *str, U32 len, UTF8 dest, U32 &written) {
+			U32 out = 0;
+			for (U32 i = 0; i < len; i++) {
+				if (str[i] > 0x10FFFF || (str[i] >= 0xD800 && str[i] <= 0xDFFF)) {
+					return false;
+				}
+				out += encodeUTF8(str[i], dest + out);
+			}
+			written = out;
+			return true;
+		}
+
+		#if GALACTIC_UNICODE_X86
+
+			/* SSE2 Kernels: Blocks of ASCII (by far the most common text) are handled 16 bytes at a time, anything else goes through the scalar kernels */
+
+			UNICODE_TARGET_SSE2 static U32 sseFindInvalid(const U8 *str, U32 len) {
+				U32 pos = 0, codePoint;
+				while (pos < len) {
+					if (pos + 16 <= len && _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(str + pos))) == 0) {
+						pos += 16;
+						continue;
+					}
+					//Decode every sequence that starts in this block, then go back to the vector test (the last one may run past the block)
+					U32 stop = pos + 16 < len ? pos + 16 : len;
+					while (pos < stop) {
+						if (!decodeUTF8(str, len, pos, codePoint)) {
+							return pos;
+						}
+					}
+				}
+				return len;
+			}
+
+			UNICODE_TARGET_SSE2 static bool sseValidate(const U8 *str, U32 len) {
+				return sseFindInvalid(str, len) == len;
+			}
+
+			//sseCount(): Byte counters are summed with _mm_sad_epu8 before they can overflow (each block adds at most 2 to a counter)
+			UNICODE_TARGET_SSE2 static U32 sseCount(const U8 *str, U32 len, bool utf16Units) {
+				const __m128i zero = _mm_setzero_si128(), continuation = _mm_set1_epi8(-65), fourByte = _mm_set1_epi8((C8)0xF0);
+				U32 count = 0, pos = 0;
+				while (pos + 16 <= len) {
+					U32 blocks = (len - pos) / 16;
+					if (blocks > 127) {
+						blocks = 127;
+					}
+					__m128i counters = zero;
+					for (U32 i = 0; i < blocks; i++, pos += 16) {
+						__m128i block = _mm_loadu_si128((const __m128i *)(str + pos));
+						//Signed, continuation bytes (80 - BF) are the only ones below -64
+						counters = _mm_sub_epi8(counters, _mm_cmpgt_epi8(block, continuation));
+						if (utf16Units) {
+							counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_max_epu8(block, fourByte), block));
+						}
+					}
+					__m128i sums = _mm_sad_epu8(counters, zero);
+					count += (U32)_mm_cvtsi128_si32(sums) + (U32)_mm_cvtsi128_si32(_mm_srli_si128(sums, 8));
+				}
+				return count + scalarCount(str + pos, len - pos, utf16Units);
+			}
+
+			UNICODE_TARGET_SSE2 static bool sseUTF8ToUTF16(const U8 *str, U32 len, U16 *dest, U32 &written) {
+				const __m128i zero = _mm_setzero_si128();
+				U32 pos = 0, out = 0, codePoint;
+				while (pos < len) {
+					if (pos + 16 <= len) {
+						__m128i block = _mm_loadu_si128((const __m128i *)(str + pos));
+						if (_mm_movemask_epi8(block) == 0) {
+							_mm_storeu_si128((__m128i *)(dest + out), _mm_unpacklo_epi8(block, zero));
+							_mm_storeu_si128((__m128i *)(dest + out + 8), _mm_unpackhi_epi8(block, zero));
+							pos += 16;
+							out += 16;
+							continue;
+						}
+					}
+					U32 stop = pos + 16 < len ? pos + 16 : len;
+					while (pos < stop) {
+						if (!decodeUTF8(str, len, pos, codePoint)) {
+							return false;
+						}
+						out += writeUTF16(codePoint, dest + out);
+					}
+				}
+				written = out;
+				return true;
+			}
+
+			UNICODE_TARGET_SSE2 static bool sseUTF8ToUTF32(const U8 *str, U32 len, U32 *dest, U32 &written) {
+				const __m128i zero = _mm_setzero_si128();
+				U32 pos = 0, out = 0;
+				while (pos < len) {
+					if (pos + 16 <= len) {
+						__m128i block = _mm_loadu_si128((const __m128i *)(str + pos));
+						if (_mm_movemask_epi8(block) == 0) {
+							__m128i low = _mm_unpacklo_epi8(block, zero), high = _mm_unpackhi_epi8(block, zero);
+							_mm_storeu_si128((__m128i *)(dest + out), _mm_unpacklo_epi16(low, zero));
+							_mm_storeu_si128((__m128i *)(dest + out + 4), _mm_unpackhi_epi16(low, zero));
+							_mm_storeu_si128((__m128i *)(dest + out + 8), _mm_unpacklo_epi16(high, zero));
+							_mm_storeu_si128((__m128i *)(dest + out + 12), _mm_unpackhi_epi16(high, zero));
+							pos += 16;
+							out += 16;
+							continue;
+						}
+					}
+					U32 stop = pos + 16 < len ? pos + 16 : len;
+					while (pos < stop) {
+						if (!decodeUTF8(str, len, pos, dest[out])) {
+							return false;
+						}
+						out++;
+					}
+				}
+				written = out;
+				return true;
+			}
+
+			UNICODE_TARGET_SSE2 static bool sseUTF16ToUTF8(const U16 *str, U32 len, UTF8 dest, U32 &written) {
+				const __m128i highBits = _mm_set1_epi16((S16)0xFF80), zero = _mm_setzero_si128();
+				U32 pos = 0, out = 0;
+				while (pos < len) {
+					if (pos + 8 <= len) {
+						__m128i block = _mm_loadu_si128((const __m128i *)(str + pos));
+						if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(block, highBits), zero)) == 0xFFFF) {
+							_mm_storel_epi64((__m128i *)(dest + out), _mm_packus_epi16(block, block));
+							pos += 8;
+							out += 8;
+							continue;
+						}
+					}
+					U32 stop = pos + 8 < len ? pos + 8 : len;
+					while (pos < stop) {
+						if (!utf16ToUTF8Step(str, len, pos, dest, out)) {
+							return false;
+						}
+					}
+				}
+				written = out;
+				return true;
+			}
+
+			UNICODE_TARGET_SSE2 static bool sseUTF32ToUTF8(const U32 *str, U32 len, UTF8 dest, U32 &written) {
+				const __m128i highBits = _mm_set1_epi32((S32)0xFFFFFF80), zero = _mm_setzero_si128();
+				U32 pos = 0, out = 0;
+				for (; pos + 8 <= len; pos += 8) {
+					__m128i low = _mm_loadu_si128((const __m128i *)(str + pos)), high = _mm_loadu_si128((const __m128i *)(str + pos + 4));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(low, high), highBits), zero)) == 0xFFFF) {
+						__m128i units = _mm_packs_epi32(low, high);
+						_mm_storel_epi64((__m128i *)(dest + out), _mm_packus_epi16(units, units));
+						out += 8;
+						continue;
+					}
+					U32 blockWritten;
+					if (!scalarUTF32ToUTF8(str + pos, 8, dest + out, blockWritten)) {
+						return false;
+					}
+					out += blockWritten;
+				}
+				U32 tailWritten;
+				if (!scalarUTF32ToUTF8(str + pos, len - pos, dest + out, tailWritten)) {
+					return false;
+				}
+				written = out + tailWritten;
+				return true;
+			}
+
+			/* AVX2 Kernels */
+
+			/* avxValidate(): Validates 32 bytes at a time without branching on the contents, using the lookup algorithm by Keiser and Lemire
+			    ("Validating UTF-8 In Less Than One Instruction Per Byte"). Each byte and the one before it are classified by three nibble lookups, the
+			    intersection of those classes is an error unless the byte is a continuation that the lead 2 or 3 bytes back requires. */
+			enum {
+				UTF8TooShort = 1 << 0,    //11______ 0_______ / 11______ 11______
+				UTF8TooLong = 1 << 1,     //0_______ 10______
+				UTF8Overlong3 = 1 << 2,   //11100000 100_____
+				UTF8TooLarge = 1 << 3,    //11110100 1001____ / 11110100 101_____ / 11110101+ 10______
+				UTF8Surrogate = 1 << 4,   //11101101 101_____
+				UTF8Overlong2 = 1 << 5,   //1100000_ 10______
+				UTF8TooLarge1000 = 1 << 6,//11110101+ 1000____
+				UTF8Overlong4 = 1 << 6,   //11110000 1000____
+				UTF8TwoConts = 1 << 7,    //10______ 10______
+				UTF8Carry = UTF8TooShort | UTF8TooLong | UTF8TwoConts
+			};
+
+			//Classes by the high nibble of the previous byte
+			static const U8 utf8FirstHighTable[16] = {
+				UTF8TooLong, UTF8TooLong, UTF8TooLong, UTF8TooLong, UTF8TooLong, UTF8TooLong, UTF8TooLong, UTF8TooLong,
+				UTF8TwoConts, UTF8TwoConts, UTF8TwoConts, UTF8TwoConts,
+				UTF8TooShort | UTF8Overlong2,
+				UTF8TooShort,
+				UTF8TooShort | UTF8Overlong3 | UTF8Surrogate,
+				UTF8TooShort | UTF8TooLarge | UTF8TooLarge1000 | UTF8Overlong4
+			};
+
+			//Classes by the low nibble of the previous byte
+			static const U8 utf8FirstLowTable[16] = {
+				UTF8Carry | UTF8Overlong3 | UTF8Overlong2 | UTF8Overlong4,
+				UTF8Carry | UTF8Overlong2,
+				UTF8Carry,
+				UTF8Carry,
+				UTF8Carry | UTF8TooLarge,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000 | UTF8Surrogate,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000,
+				UTF8Carry | UTF8TooLarge | UTF8TooLarge1000
+			};
+
+			//Classes by the high nibble of the current byte
+			static const U8 utf8SecondHighTable[16] = {
+				UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort,
+				UTF8TooLong | UTF8Overlong2 | UTF8TwoConts | UTF8Overlong3 | UTF8TooLarge1000 | UTF8Overlong4,
+				UTF8TooLong | UTF8Overlong2 | UTF8TwoConts | UTF8Overlong3 | UTF8TooLarge,
+				UTF8TooLong | UTF8Overlong2 | UTF8TwoConts | UTF8Surrogate | UTF8TooLarge,
+				UTF8TooLong | UTF8Overlong2 | UTF8TwoConts | UTF8Surrogate | UTF8TooLarge,
+				UTF8TooShort, UTF8TooShort, UTF8TooShort, UTF8TooShort
+			};
+
+			//Bytes above these in the last three positions of a block start a sequence that continues into the next block
+			static const U8 utf8IncompleteTable[32] = {
+				0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+				0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xEF, 0xDF, 0xBF
+			};
+
+			UNICODE_TARGET_AVX2 static inline __m256i avxLookup(const U8 table[16], __m256i index) {
+				return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)table)), index);
+			}
+
+			UNICODE_TARGET_AVX2 static inline __m256i avxHighNibbles(__m256i block) {
+				return _mm256_and_si256(_mm256_srli_epi16(block, 4), _mm256_set1_epi8(0x0F));
+			}
+
+			//avxPrevious(): The block shifted by N bytes, with the end of the previous block shifted in
+			template <S32 N> UNICODE_TARGET_AVX2 static inline __m256i avxPrevious(__m256i block, __m256i previous) {
+				return _mm256_alignr_epi8(block, _mm256_permute2x128_si256(previous, block, 0x21), 16 - N);
+			}
+
+			struct AVXValidator {
+				__m256i error, previous, incomplete;
+
+				UNICODE_TARGET_AVX2 void check(__m256i block) {
+					if (_mm256_movemask_epi8(block) == 0) {
+						//Pure ASCII, only a sequence left open by the last block can be wrong
+						error = _mm256_or_si256(error, incomplete);
+					}
+					else {
+						__m256i previous1 = avxPrevious<1>(block, previous);
+						__m256i special = _mm256_and_si256(_mm256_and_si256(avxLookup(utf8FirstHighTable, avxHighNibbles(previous1)),
+							avxLookup(utf8FirstLowTable, _mm256_and_si256(previous1, _mm256_set1_epi8(0x0F)))),
+							avxLookup(utf8SecondHighTable, avxHighNibbles(block)));
+						//A continuation after a 3 / 4 byte lead two or three bytes back is expected, and is the one case the lookups flag TwoConts for
+						__m256i third = _mm256_subs_epu8(avxPrevious<2>(block, previous), _mm256_set1_epi8((C8)(0xE0 - 0x80)));
+						__m256i fourth = _mm256_subs_epu8(avxPrevious<3>(block, previous), _mm256_set1_epi8((C8)(0xF0 - 0x80)));
+						__m256i expected = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((C8)0x80));
+						error = _mm256_or_si256(error, _mm256_xor_si256(expected, special));
+						incomplete = _mm256_subs_epu8(block, _mm256_loadu_si256((const __m256i *)utf8IncompleteTable));
+					}
+					previous = block;
+				}
+			};
+
+			UNICODE_TARGET_AVX2 static bool avxValidate(const U8 *str, U32 len) {
+				AVXValidator validator;
+				validator.error = validator.previous = validator.incomplete = _mm256_setzero_si256();
+				U32 pos = 0;
+				for (; pos + 32 <= len; pos += 32) {
+					validator.check(_mm256_loadu_si256((const __m256i *)(str + pos)));
+				}
+				if (pos < len) {
+					//Pad the tail with ASCII, so a sequence cut short by the end of the range still shows up as incomplete
+					U8 tail[32] = { 0 };
+					memcpy(tail, str + pos, len - pos);
+					validator.check(_mm256_loadu_si256((const __m256i *)tail));
+				}
+				validator.error = _mm256_or_si256(validator.error, validator.incomplete);
+				return _mm256_testz_si256(validator.error, validator.error) != 0;
+			}
+
+			UNICODE_TARGET_AVX2 static U32 avxCount(const U8 *str, U32 len, bool utf16Units) {
+				const __m256i zero = _mm256_setzero_si256(), continuation = _mm256_set1_epi8(-65), fourByte = _mm256_set1_epi8((C8)0xF0);
+				U32 count = 0, pos = 0;
+				while (pos + 32 <= len) {
+					U32 blocks = (len - pos) / 32;
+					if (blocks > 127) {
+						blocks = 127;
+					}
+					__m256i counters = zero;
+					for (U32 i = 0; i < blocks; i++, pos += 32) {
+						__m256i block = _mm256_loadu_si256((const __m256i *)(str + pos));
+						counters = _mm256_sub_epi8(counters, _mm256_cmpgt_epi8(block, continuation));
+						if (utf16Units) {
+							counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(_mm256_max_epu8(block, fourByte), block));
+						}
+					}
+					__m256i sums = _mm256_sad_epu8(counters, zero);
+					__m128i lanes = _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+					count += (U32)_mm_cvtsi128_si32(lanes) + (U32)_mm_cvtsi128_si32(_mm_srli_si128(lanes, 8));
+				}
+				return count + scalarCount(str + pos, len - pos, utf16Units);
+			}
+
+		#endif
+
+		/* Kernel Dispatch */
+
+		struct UnicodeKernels {
+			bool (*validate)(const U8 *str, U32 len);
+			U32 (*findInvalid)(const U8 *str, U32 len);
+			U32 (*count)(const U8 *str, U32 len, bool utf16Units);
+			bool (*utf8ToUTF16)(const U8 *str, U32 len, U16 *dest, U32 &written);
+			bool (*utf8ToUTF32)(const U8 *str, U32 len, U32 *dest, U32 &written);
+			bool (*utf16ToUTF8)(const U16 *str, U32 len, UTF8 dest, U32 &written);
+			bool (*utf32ToUTF8)(const U32 *str, U32 len, UTF8 dest, U32 &written);
+		};
+
+		static UnicodeKernels selectUnicodeKernels() {
+			UnicodeKernels kernels = { scalarValidate, scalarFindInvalid, scalarCount, scalarUTF8ToUTF16, scalarUTF8ToUTF32, scalarUTF16ToUTF8, scalarUTF32ToUTF8 };
+			#if GALACTIC_UNICODE_X86
+				//Share the CPU detection (and the GALACTIC_STRTOOLS_SIMD switch) with StrTools
+				U32 level = StrTools::fetchSimdLevel();
+				if (level >= 1) {
+					kernels.validate = sseValidate;
+					kernels.findInvalid = sseFindInvalid;
+					kernels.count = sseCount;
+					kernels.utf8ToUTF16 = sseUTF8ToUTF16;
+					kernels.utf8ToUTF32 = sseUTF8ToUTF32;
+					kernels.utf16ToUTF8 = sseUTF16ToUTF8;
+					kernels.utf32ToUTF8 = sseUTF32ToUTF8;
+				}
+				if (level >= 2) {
+					kernels.validate = avxValidate;
+					kernels.count = avxCount;
+				}
+			#endif
+			return kernels;
+		}
+
+		static const UnicodeKernels &fetchUnicodeKernels() {
+			static const UnicodeKernels kernels = selectUnicodeKernels();
+			return kernels;
+		}
+
+		/*
+		 Unicode Class Definitions
+		*/
+
+		bool Unicode::validateUTF8(UTF16 str, U32 len) {
+			if (!str || len == 0) {
+				return true;
+			}
+			return fetchUnicodeKernels().validate((const U8 *)str, len);
+		}
+
+		U32 Unicode::findInvalidUTF8(UTF16 str, U32 len) {
+			if (!str || len == 0) {
+				return 0;
+			}
+			const UnicodeKernels &kernels = fetchUnicodeKernels();
+			//The vector validator is faster on valid text but can't say where the error is, only look for it once we know there is one
+			if (kernels.validate((const U8 *)str, len)) {
+				return len;
+			}
+			return kernels.findInvalid((const U8 *)str, len);
+		}
+
+		U32 Unicode::countCodePoints(UTF16 str, U32 len) {
+			if (!str || len == 0) {
+				return 0;
+			}
+			return fetchUnicodeKernels().count((const U8 *)str, len, false);
+		}
+
+		U32 Unicode::utf16Length(UTF16 str, U32 len) {
+			if (!str || len == 0) {
+				return 0;
+			}
+			return fetchUnicodeKernels().count((const U8 *)str, len, true);
+		}
+
+		U32 Unicode::utf8LengthFromUTF16(const U16 *str, U32 len) {
+			U32 count = 0;
+			for (U32 i = 0; i < len; i++) {
+				//Surrogates are 3 bytes each here, but a pair only needs 4 bytes, the low one corrects for it
+				count += 1 + (str[i] >= 0x80) + (str[i] >= 0x800) - ((str[i] & 0xFC00) == 0xDC00) * 2;
+			}
+			return count;
+		}
+
+		U32 Unicode::utf8LengthFromUTF32(const U32 *str, U32 len) {
+			U32 count = 0;
+			for (U32 i = 0; i < len; i++) {
+				count += 1 + (str[i] >= 0x80) + (str[i] >= 0x800) + (str[i] >= 0x10000);
+			}
+			return count;
+		}
+
+		bool Unicode::convertUTF8ToUTF16(UTF16 str, U32 len, U16 *dest, U32 &written) {
+			written = 0;
+			if (!str || len == 0) {
+				return true;
+			}
+			return fetchUnicodeKernels().utf8ToUTF16((const U8 *)str, len, dest, written);
+		}
+
+		bool Unicode::convertUTF8ToUTF32(UTF16 str, U32 len, U32 *dest, U32 &written) {
+			written = 0;
+			if (!str || len == 0) {
+				return true;
+			}
+			return fetchUnicodeKernels().utf8ToUTF32((const U8 *)str, len, dest, written);
+		}
+
+		bool Unicode::convertUTF16ToUTF8(const U16 *str, U32 len, UTF8 dest, U32 &written) {
+			written = 0;
+			if (!str || len == 0) {
+				return true;
+			}
+			return fetchUnicodeKernels().utf16ToUTF8(str, len, dest, written);
+		}
+
+		bool Unicode::convertUTF32ToUTF8(const U32 *str, U32 len, UTF8 dest, U32 &written) {
+			written = 0;
+			if (!str || len == 0) {
+				return true;
+			}
+			return fetchUnicodeKernels().utf32ToUTF8(str, len, dest, written);
+		}
+
+	};
+
+};
\ No newline at end of file
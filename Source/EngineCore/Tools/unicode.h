@@ -0,0 +1,72 @@
+/**
+* Galactic 2D
+* Source/EngineCore/Tools/unicode.h
+* UTF-8 validation, code point counting and UTF-8 / UTF-16 / UTF-32 transcoding
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#ifndef GALACTIC_INTERNAL_UNICODE
+#define GALACTIC_INTERNAL_UNICODE
+
+#include "../engineCore.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		Unicode: Tools to validate and transcode UTF-8 text (as used by String) to and from UTF-16 / UTF-32 code units. Validation follows rfc-3629, so
+		 overlong forms, UTF-16 surrogates and code points past U+10FFFF are rejected. Like the StrTools bulk operations these work on a length and use
+		 SSE2 / AVX2 when the CPU supports it (see GALACTIC_STRTOOLS_SIMD). UTF-16 / UTF-32 units are in the native byte order.
+		*/
+		struct Unicode {
+
+			//validateUTF8(): Returns true if the range holds well formed UTF-8. Use this on any text that comes from a client before storing or forwarding it.
+			static bool validateUTF8(UTF16 str, U32 len);
+			//findInvalidUTF8(): Returns the offset of the first byte of the first malformed sequence, or len if the whole range is valid
+			static U32 findInvalidUTF8(UTF16 str, U32 len);
+			//countCodePoints(): Count the characters (code points) in a range of valid UTF-8
+			static U32 countCodePoints(UTF16 str, U32 len);
+			//utf16Length(): The amount of UTF-16 units needed to hold a range of valid UTF-8 (never more than len)
+			static U32 utf16Length(UTF16 str, U32 len);
+			//utf8LengthFromUTF16(): The amount of UTF-8 bytes needed to hold a range of valid UTF-16 (never more than 3 * len)
+			static U32 utf8LengthFromUTF16(const U16 *str, U32 len);
+			//utf8LengthFromUTF32(): The amount of UTF-8 bytes needed to hold a range of valid UTF-32 (never more than 4 * len)
+			static U32 utf8LengthFromUTF32(const U32 *str, U32 len);
+
+			/* Transcoding: These validate the input as they go and return false if it is malformed, in which case the contents of dest are undefined.
+			    dest must be able to hold the length reported by the matching function above, and written receives the amount of units stored. */
+			//convertUTF8ToUTF16(): Convert UTF-8 to UTF-16 (code points past U+FFFF are written as surrogate pairs)
+			static bool convertUTF8ToUTF16(UTF16 str, U32 len, U16 *dest, U32 &written);
+			//convertUTF8ToUTF32(): Convert UTF-8 to UTF-32
+			static bool convertUTF8ToUTF32(UTF16 str, U32 len, U32 *dest, U32 &written);
+			//convertUTF16ToUTF8(): Convert UTF-16 to UTF-8, unpaired surrogates are rejected
+			static bool convertUTF16ToUTF8(const U16 *str, U32 len, UTF8 dest, U32 &written);
+			//convertUTF32ToUTF8(): Convert UTF-32 to UTF-8, surrogates and values past U+10FFFF are rejected
+			static bool convertUTF32ToUTF8(const U32 *str, U32 len, UTF8 dest, U32 &written);
+
+		};
+
+	};
+
+};
+
+#endif //GALACTIC_INTERNAL_UNICODE
\ No newline at end of file
@@ -55,8 +55,6 @@
 					/* Public Class Methods */
 					//initialize the module
 					static void init();
-					//obtain the instance of the Allocater class
-					static class Allocater *Allocater();
 					//Alloc method for windows
 					static any Alloc(SIZE_T amount);
 					//Free method for windows
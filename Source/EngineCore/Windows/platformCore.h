@@ -83,6 +83,8 @@
 	#endif
 	//U64DEF: Macro for properly declaring and formatting 64-bit numerics
 	#define U64DEF(x) x
+	//THREADLOCAL: Declare a variable with thread local storage (one instance of the variable per thread)
+	#define THREADLOCAL __declspec(thread)
 
 	#define GALACTIC_DLL_IMPORT __declspec(dllimport)
 	#define GALACTIC_DLL_EXPORT __declspec(dllexport)
@@ -28,6 +28,8 @@
 	#ifndef GALACTIC_PLATFORM_WINDOWS_THREADCLASSES
 	#define GALACTIC_PLATFORM_WINDOWS_THREADCLASSES
 
+	#include "../Thread/lockTools.h"
+
 	namespace Galactic {
 
 		namespace Core {
@@ -234,7 +236,10 @@
 					//Thread entry point function
 					static ::DWORD __stdcall __threadProc(LPVOID thisInst) {
 						if (thisInst != NULL) {
-							return ((PlatformContinualThread*)thisInst)->run();
+							U32 exitCode = ((PlatformContinualThread*)thisInst)->run();
+							//Hand back the thread's cached resources, the instance may be gone at this point
+							ContinualThread::onThreadExit();
+							return exitCode;
 						}
 						return NULL; 
 					}
@@ -325,17 +330,18 @@
 			};
 
 			/*
-			PlatformCriticalSection: Implements a mutex locking module for the Windows platform
+			PlatformCriticalSection: Implements a mutex locking module for the Windows platform. Windows critical sections are already a hybrid
+			 spin/park lock, so we simply apply the engine spin count to them (GALACTIC_CRITICALSECTION_SPINCOUNT).
 			WARNING: Please be mindful that any methods you add here MUST also have a Generic equivalent in
 			Platform/Generic/Thread/pThreadCriticalSection.h
 			*/
 			class PlatformCriticalSection {
 				public:
 					/* Constructor / Destructor */
-					//Default Constructor
-					FINLINE PlatformCriticalSection() {
+					//Default Constructor, orderLevel is used by the debug lock-order checker (0 = not checked)
+					FINLINE PlatformCriticalSection(U32 orderLevel = 0) : lockOrder(orderLevel), recursion(0) {
 						InitializeCriticalSection(&cSec);
-						SetCriticalSectionSpinCount(&cSec, 4500);
+						SetCriticalSectionSpinCount(&cSec, GALACTIC_CRITICALSECTION_SPINCOUNT);
 					}
 
 					//Destructor
@@ -348,18 +354,84 @@
 					FINLINE void lock() {
 						if (!TryEnterCriticalSection(&cSec)) {
 							EnterCriticalSection(&cSec);
+							#if GALACTIC_LOCK_CONTENTION_STATS == 1
+								stats.contended++;
+							#endif
+						}
+						onAcquired();
+					}
+
+					//Try to lock, waiting at most timeInMS miliseconds. Passing 0 will only attempt the lock once. Returns true if the lock was obtained.
+					FINLINE bool tryLock(U32 timeInMS = 0) {
+						if (!TryEnterCriticalSection(&cSec)) {
+							if (timeInMS == 0 || !tryLockSlow(timeInMS)) {
+								#if GALACTIC_LOCK_CONTENTION_STATS == 1
+									PlatformAtomics::increment(&stats.failedTries);
+								#endif
+								return false;
+							}
 						}
+						onAcquired();
+						return true;
 					}
 
 					//Unlock
 					FINLINE void unlock() {
+						if (--recursion == 0) {
+							LockOrderChecker::onRelease(this, lockOrder);
+						}
 						LeaveCriticalSection(&cSec);
 					}
 
+					//Fetch the contention statistics of this lock (all zero unless GALACTIC_LOCK_CONTENTION_STATS is enabled)
+					FINLINE const LockStatistics &fetchStatistics() const {
+						return stats;
+					}
+
+					//Reset the contention statistics of this lock
+					FINLINE void resetStatistics() {
+						stats.reset();
+					}
+
 				private:
+					/* Private Class Methods */
+					//Bookkeeping performed once the lock has been obtained
+					FINLINE void onAcquired() {
+						if (++recursion == 1) {
+							#if GALACTIC_LOCK_CONTENTION_STATS == 1
+								stats.acquisitions++;
+							#endif
+							LockOrderChecker::onAcquire(this, lockOrder);
+						}
+					}
+
+					//Contended tryLock path: spin with back-off, then sleep in small steps until the lock is ours or the time runs out.
+					bool tryLockSlow(U32 timeInMS) {
+						SpinBackoff backoff;
+						while (backoff.spin()) {
+							if (TryEnterCriticalSection(&cSec)) {
+								return true;
+							}
+						}
+						const ULONGLONG deadline = GetTickCount64() + timeInMS;
+						while (GetTickCount64() < deadline) {
+							Sleep(0);
+							if (TryEnterCriticalSection(&cSec)) {
+								return true;
+							}
+						}
+						return false;
+					}
+
 					/* Private Class Members */
 					//Critical Section Object
 					CRITICAL_SECTION cSec;
+					//The order level of this lock, used by LockOrderChecker
+					U32 lockOrder;
+					//The recursion depth of the owning thread
+					U32 recursion;
+					//Contention statistics for this lock
+					LockStatistics stats;
 			};
 
 		};
@@ -0,0 +1,1365 @@
+/**
+* Galactic 2D
+* Source/EngineCore/allocaterOverloads.cpp
+* Defines the engine's allocater systems (SlabHeap, StandardAllocater, ThreadSafeAllocater)
+* (C) 2014-2015 Phantom Games Development - All Rights Reserved
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+* THE SOFTWARE.
+**/
+
+#include "engineCore.h"
+#include "allocaterOverloads.h"
+
+namespace Galactic {
+
+	namespace Core {
+
+		/*
+		SlabSpan: The header stored at the start of every span (and page run) mapped by a SlabHeap.
+		*/
+		struct SlabSpan {
+			//Identifies a live span, cleared when the span is released
+			U32 magic;
+			//The size class of the span, or slabLargeClass for page runs
+			U32 sizeClass;
+			//The size of each block in the span (or the usable size of a page run)
+			SIZE_T blockSize;
+			//The total amount of bytes mapped for the span
+			SIZE_T runSize;
+			//The amount of blocks currently handed out
+			U32 liveCount;
+			//The total amount of blocks the span can hold
+			U32 capacity;
+			//Singly linked list of freed blocks
+			any freeList;
+			//The next block that has never been handed out
+			UTX8 bumpPtr;
+			//Links in the heap's partial span list (or the empty span cache)
+			SlabSpan *prev;
+			SlabSpan *next;
+			//The heap this span belongs to
+			SlabHeap *owner;
+			#if GALACTIC_MEMORY_TRACKING == 1
+				//The MemoryTracker tag of every block, stored between the header and the first block (page runs point this at runTag)
+				U8 *tags;
+				//The first block of the span
+				UTX8 firstBlock;
+				//Fixed point reciprocal of blockSize, turns a block's offset into it's index without a division
+				U64 blockReciprocal;
+				//The tag of a page run
+				U8 runTag;
+			#endif
+		};
+
+		//Magic value stored in live span headers
+		static const U32 slabSpanMagic = 0x534C4142;
+		//Size class used to mark page runs
+		static const U32 slabLargeClass = 0xffffffff;
+		//The size of a span header, kept at a multiple of 64 so blocks of the larger classes stay cache line aligned
+		static const SIZE_T slabHeaderSize = (sizeof(SlabSpan) + 63) & ~((SIZE_T)63);
+
+		//Size class lookup tables, built by the first SlabHeap
+		static SIZE_T slabClassSizes[SlabHeap::ClassCount];
+		//Class lookup for requests of up to 1K (16 byte steps)
+		static U8 slabSmallLookup[(1024 / 16) + 1];
+		//Class lookup for requests of up to 32K (128 byte steps)
+		static U8 slabMediumLookup[(SlabHeap::MaximumSmall / 128) + 1];
+		static bool slabTablesBuilt = false;
+
+		//Fetch the header of the span owning the pointer
+		SFIN SlabSpan *slabSpanOf(cAny ptr) {
+			return (SlabSpan *)((IntPointer)ptr & ~((IntPointer)GALACTIC_SLAB_SPAN_SIZE - 1));
+		}
+
+		/*
+		 The span registry holds one bit for every GALACTIC_SLAB_SPAN_SIZE bytes of the address space, set while a live span (or page run) header starts
+		  there. A pointer is only followed to it's header once the span is found in the registry, so pointers that never came from a SlabHeap are
+		  rejected rather than faulting. The bits are kept in leaves of 4K (covering 2^15 spans each) which are mapped on first use and never released.
+		*/
+		//The amount of spans covered by a registry leaf
+		static const U64 slabRegistryLeafSpans = 32768;
+		//The amount of leaves covering the address space (48 bits on 64 bit platforms)
+		static const U64 slabRegistryLeafCount = ((((U64)1 << (sizeof(any) == 8 ? 48 : 32)) / GALACTIC_SLAB_SPAN_SIZE) + slabRegistryLeafSpans - 1) / slabRegistryLeafSpans;
+		static volatile S32 *slabRegistry[slabRegistryLeafCount];
+
+		//Fetch the registry word holding the bit of a span, returns NULL if the span is outside of the registry (or it's leaf isn't mapped and create is false)
+		static volatile S32 *slabRegistryWord(cAny span, S32 &bit, bool create) {
+			U64 index = (U64)(IntPointer)span / GALACTIC_SLAB_SPAN_SIZE;
+			U64 leafIndex = index / slabRegistryLeafSpans;
+			if (leafIndex >= slabRegistryLeafCount) {
+				return NULL;
+			}
+			volatile S32 *leaf = slabRegistry[leafIndex];
+			if (leaf == NULL) {
+				if (!create) {
+					return NULL;
+				}
+				//Mapped pages start zeroed, if another thread maps the leaf first ours is released
+				any mapped = PlatformMemory::pageAlloc(slabRegistryLeafSpans / 8);
+				if (mapped == NULL) {
+					return NULL;
+				}
+				any current = PlatformAtomics::compareExchange((any *)&slabRegistry[leafIndex], mapped, NULL);
+				if (current != NULL) {
+					PlatformMemory::pageFree(mapped, slabRegistryLeafSpans / 8);
+					mapped = current;
+				}
+				leaf = (volatile S32 *)mapped;
+			}
+			U32 offset = (U32)(index % slabRegistryLeafSpans);
+			bit = (S32)(1u << (offset & 31));
+			return leaf + (offset >> 5);
+		}
+
+		//Add a span to the registry, returns false if the registry leaf could not be mapped
+		static bool slabRegisterSpan(cAny span) {
+			S32 bit;
+			volatile S32 *word = slabRegistryWord(span, bit, true);
+			if (word == NULL) {
+				return false;
+			}
+			S32 old;
+			do {
+				old = *word;
+			} while (PlatformAtomics::compareExchange(word, old | bit, old) != old);
+			return true;
+		}
+
+		//Remove a span from the registry, done before the span's header is cleared
+		static void slabUnregisterSpan(cAny span) {
+			S32 bit;
+			volatile S32 *word = slabRegistryWord(span, bit, false);
+			if (word == NULL) {
+				return;
+			}
+			S32 old;
+			do {
+				old = *word;
+			} while (PlatformAtomics::compareExchange(word, old & ~bit, old) != old);
+		}
+
+		//Fetch the live span owning a pointer, NULL if the pointer is not inside of one
+		static SlabSpan *slabLiveSpanOf(cAny ptr) {
+			if (ptr == NULL) {
+				return NULL;
+			}
+			SlabSpan *span = slabSpanOf(ptr);
+			S32 bit;
+			volatile S32 *word = slabRegistryWord(span, bit, false);
+			if (word == NULL || (*word & bit) == 0) {
+				return NULL;
+			}
+			return span->magic == slabSpanMagic ? span : NULL;
+		}
+
+		#if GALACTIC_MEMORY_TRACKING == 1
+			//Fetch the tag entry of a block (blocks are always at a multiple of blockSize from firstBlock, so the rounded up reciprocal is exact)
+			SFIN U8 *slabTagOf(SlabSpan *span, cAny ptr) {
+				return span->tags + (SIZE_T)(((U64)((UTX8)ptr - span->firstBlock) * span->blockReciprocal) >> 32);
+			}
+		#endif
+
+		/*
+		SlabHeap Class Definitions
+		*/
+		SlabHeap::SlabHeap(U32 maxCachedSpans) : cachedSpans(NULL), cachedSpanCount(0), maxCachedSpans(maxCachedSpans), mappedBytes(0), cacheLock(0) {
+			buildTables();
+			for (U32 i = 0; i < ClassCount; i++) {
+				partialSpans[i] = NULL;
+			}
+		}
+
+		SlabHeap::~SlabHeap() {
+			//Spans with live blocks are left alone, the blocks may still be referenced by static objects being destroyed after us.
+			while (cachedSpans != NULL) {
+				SlabSpan *next = cachedSpans->next;
+				PlatformMemory::pageFree(cachedSpans, GALACTIC_SLAB_SPAN_SIZE);
+				cachedSpans = next;
+			}
+			cachedSpanCount = 0;
+		}
+
+		void SlabHeap::buildTables() {
+			if (slabTablesBuilt) {
+				return;
+			}
+			//16 to 128 in steps of 16, then four classes for every power of 2 up to 32K (160, 192, 224, 256, 320, ...)
+			U32 index = 0;
+			for (U32 i = 1; i <= 8; i++) {
+				slabClassSizes[index++] = i * MinimumBlock;
+			}
+			for (SIZE_T base = 128; base < MaximumSmall; base <<= 1) {
+				for (U32 step = 1; step <= 4; step++) {
+					slabClassSizes[index++] = base + (step * (base >> 2));
+				}
+			}
+			U32 cls = 0;
+			for (U32 i = 0; i < sizeof(slabSmallLookup); i++) {
+				while (slabClassSizes[cls] < (SIZE_T)(i * 16)) {
+					cls++;
+				}
+				slabSmallLookup[i] = (U8)cls;
+			}
+			cls = 0;
+			for (U32 i = 0; i < sizeof(slabMediumLookup); i++) {
+				while (slabClassSizes[cls] < (SIZE_T)(i * 128)) {
+					cls++;
+				}
+				slabMediumLookup[i] = (U8)cls;
+			}
+			slabTablesBuilt = true;
+		}
+
+		U32 SlabHeap::sizeToClass(SIZE_T amount) {
+			if (amount <= 1024) {
+				return slabSmallLookup[(amount + 15) >> 4];
+			}
+			if (amount <= MaximumSmall) {
+				return slabMediumLookup[(amount + 127) >> 7];
+			}
+			return ClassCount;
+		}
+
+		SIZE_T SlabHeap::classToSize(U32 sizeClass) {
+			return sizeClass < ClassCount ? slabClassSizes[sizeClass] : 0;
+		}
+
+		any SlabHeap::alloc(SIZE_T amount, U32 memAlignment, U32 memTag) {
+			if (memAlignment < MinimumBlock) {
+				memAlignment = MinimumBlock;
+			}
+			if ((memAlignment & (memAlignment - 1)) != 0) {
+				GC_Error("SlabHeap::alloc(): Alignment must be a power of 2 (%u given).", memAlignment);
+				return NULL;
+			}
+			U32 cls = ClassCount;
+			if (memAlignment == MinimumBlock) {
+				cls = sizeToClass(amount);
+			}
+			else if (memAlignment <= MaximumClassAlignment) {
+				//Blocks of a class are aligned to the largest power of 2 dividing the class size (up to 64), find the first class that fits.
+				cls = sizeToClass((amount + memAlignment - 1) & ~((SIZE_T)memAlignment - 1));
+				while (cls < ClassCount && (slabClassSizes[cls] & (memAlignment - 1)) != 0) {
+					cls++;
+				}
+			}
+			if (cls >= ClassCount) {
+				return allocLarge(amount, memAlignment, memTag);
+			}
+			SlabSpan *span = partialSpans[cls];
+			if (span == NULL) {
+				span = createSpan(cls);
+				if (span == NULL) {
+					return NULL;
+				}
+			}
+			any block;
+			if (span->freeList != NULL) {
+				block = span->freeList;
+				span->freeList = *((any *)block);
+			}
+			else {
+				block = span->bumpPtr;
+				span->bumpPtr += span->blockSize;
+			}
+			#if GALACTIC_MEMORY_TRACKING == 1
+				*slabTagOf(span, block) = (U8)memTag;
+			#endif
+			span->liveCount++;
+			if (span->liveCount == span->capacity) {
+				//The span is full, take it off of the partial list (we always allocate from the head).
+				partialSpans[cls] = span->next;
+				if (span->next != NULL) {
+					span->next->prev = NULL;
+				}
+				span->next = NULL;
+			}
+			return block;
+		}
+
+		void SlabHeap::release(any ptr) {
+			if (ptr == NULL) {
+				return;
+			}
+			SlabSpan *span = slabLiveSpanOf(ptr);
+			if (span == NULL || span->owner != this) {
+				GC_Error("SlabHeap::release(): Attempted to free a pointer (%p) not owned by this heap.", ptr);
+				return;
+			}
+			if (span->sizeClass == slabLargeClass) {
+				slabUnregisterSpan(span);
+				span->magic = 0;
+				lockCache();
+				mappedBytes -= span->runSize;
+				unlockCache();
+				PlatformMemory::pageFree(span, span->runSize);
+				return;
+			}
+			U32 cls = span->sizeClass;
+			*((any *)ptr) = span->freeList;
+			span->freeList = ptr;
+			if (span->liveCount == span->capacity) {
+				//The span was full, it has space again so put it at the head of the partial list.
+				span->prev = NULL;
+				span->next = partialSpans[cls];
+				if (span->next != NULL) {
+					span->next->prev = span;
+				}
+				partialSpans[cls] = span;
+			}
+			span->liveCount--;
+			if (span->liveCount == 0 && (partialSpans[cls] != span || span->next != NULL)) {
+				//Empty and not the last span of the class, unlink it and release it. The last span is kept to avoid bouncing on the edge of a span.
+				if (span->prev != NULL) {
+					span->prev->next = span->next;
+				}
+				else {
+					partialSpans[cls] = span->next;
+				}
+				if (span->next != NULL) {
+					span->next->prev = span->prev;
+				}
+				releaseSpan(span);
+			}
+		}
+
+		SIZE_T SlabHeap::usableSize(cAny ptr) const {
+			SlabSpan *span = slabLiveSpanOf(ptr);
+			if (span == NULL) {
+				return 0;
+			}
+			if (span->sizeClass == slabLargeClass) {
+				return span->runSize - (SIZE_T)((IntPointer)ptr - (IntPointer)span);
+			}
+			return span->blockSize;
+		}
+
+		U32 SlabHeap::fetchTag(cAny ptr) {
+			#if GALACTIC_MEMORY_TRACKING == 1
+				SlabSpan *span = slabLiveSpanOf(ptr);
+				return span != NULL ? *slabTagOf(span, ptr) : 0;
+			#else
+				return 0;
+			#endif
+		}
+
+		bool SlabHeap::validate() const {
+			for (U32 i = 0; i < ClassCount; i++) {
+				SlabSpan *prev = NULL;
+				for (SlabSpan *span = partialSpans[i]; span != NULL; span = span->next) {
+					if (span->magic != slabSpanMagic || span->sizeClass != i || span->prev != prev || span->liveCount >= span->capacity) {
+						GC_Error("SlabHeap::validate(): Corrupted span header (%p) in size class %u.", span, i);
+						return false;
+					}
+					prev = span;
+				}
+			}
+			return true;
+		}
+
+		SIZE_T SlabHeap::fetchMappedBytes() const {
+			return mappedBytes;
+		}
+
+		void SlabHeap::trim() {
+			//Detach the cache under the lock, the spans are unmapped outside of it (unmapSpan() may take other locks).
+			lockCache();
+			SlabSpan *span = cachedSpans;
+			mappedBytes -= (SIZE_T)cachedSpanCount * GALACTIC_SLAB_SPAN_SIZE;
+			cachedSpans = NULL;
+			cachedSpanCount = 0;
+			unlockCache();
+			while (span != NULL) {
+				SlabSpan *next = span->next;
+				unmapSpan(span);
+				span = next;
+			}
+		}
+
+		void SlabHeap::lockCache() {
+			while (PlatformAtomics::compareExchange(&cacheLock, 1, 0) != 0) {
+				GALACTIC_SPIN_PAUSE();
+			}
+		}
+
+		void SlabHeap::unlockCache() {
+			PlatformAtomics::exchange(&cacheLock, 0);
+		}
+
+		SlabHeap *SlabHeap::ownerOf(cAny ptr) {
+			SlabSpan *span = slabLiveSpanOf(ptr);
+			return span != NULL ? span->owner : NULL;
+		}
+
+		any SlabHeap::mapSpan() {
+			return PlatformMemory::pageAlloc(GALACTIC_SLAB_SPAN_SIZE, GALACTIC_SLAB_SPAN_SIZE);
+		}
+
+		void SlabHeap::unmapSpan(any span) {
+			PlatformMemory::pageFree(span, GALACTIC_SLAB_SPAN_SIZE);
+		}
+
+		SlabSpan *SlabHeap::createSpan(U32 sizeClass) {
+			lockCache();
+			SlabSpan *span = cachedSpans;
+			if (span != NULL) {
+				cachedSpans = span->next;
+				cachedSpanCount--;
+			}
+			unlockCache();
+			if (span == NULL) {
+				span = (SlabSpan *)mapSpan();
+				if (span == NULL) {
+					return NULL;
+				}
+				lockCache();
+				mappedBytes += GALACTIC_SLAB_SPAN_SIZE;
+				unlockCache();
+			}
+			if (!slabRegisterSpan(span)) {
+				releaseSpan(span);
+				return NULL;
+			}
+			span->magic = slabSpanMagic;
+			span->sizeClass = sizeClass;
+			span->blockSize = slabClassSizes[sizeClass];
+			span->runSize = GALACTIC_SLAB_SPAN_SIZE;
+			span->liveCount = 0;
+			#if GALACTIC_MEMORY_TRACKING == 1
+				//The tag table takes one byte per block, the blocks start after it at the next cache line.
+				U32 tableEntries = (U32)((GALACTIC_SLAB_SPAN_SIZE - slabHeaderSize) / (span->blockSize + 1));
+				SIZE_T tableSize = ((SIZE_T)tableEntries + 63) & ~((SIZE_T)63);
+				U32 capacity = (U32)((GALACTIC_SLAB_SPAN_SIZE - slabHeaderSize - tableSize) / span->blockSize);
+				span->capacity = capacity < tableEntries ? capacity : tableEntries;
+				span->tags = (U8 *)span + slabHeaderSize;
+				span->firstBlock = (UTX8)span + slabHeaderSize + tableSize;
+				span->blockReciprocal = ((U64)1 << 32) / span->blockSize + 1;
+				span->bumpPtr = span->firstBlock;
+			#else
+				span->capacity = (U32)((GALACTIC_SLAB_SPAN_SIZE - slabHeaderSize) / span->blockSize);
+				span->bumpPtr = (UTX8)span + slabHeaderSize;
+			#endif
+			span->freeList = NULL;
+			span->owner = this;
+			span->prev = NULL;
+			span->next = partialSpans[sizeClass];
+			if (span->next != NULL) {
+				span->next->prev = span;
+			}
+			partialSpans[sizeClass] = span;
+			return span;
+		}
+
+		void SlabHeap::releaseSpan(SlabSpan *span) {
+			slabUnregisterSpan(span);
+			span->magic = 0;
+			lockCache();
+			if (cachedSpanCount < maxCachedSpans) {
+				span->next = cachedSpans;
+				cachedSpans = span;
+				cachedSpanCount++;
+				unlockCache();
+				return;
+			}
+			mappedBytes -= GALACTIC_SLAB_SPAN_SIZE;
+			unlockCache();
+			unmapSpan(span);
+		}
+
+		any SlabHeap::allocLarge(SIZE_T amount, U32 memAlignment, U32 memTag) {
+			//The block has to start inside the first span sized section of the run for slabSpanOf() to find the header.
+			if (memAlignment > (GALACTIC_SLAB_SPAN_SIZE >> 1)) {
+				GC_Error("SlabHeap::allocLarge(): Unsupported alignment (%u), the maximum is %u.", memAlignment, (U32)(GALACTIC_SLAB_SPAN_SIZE >> 1));
+				return NULL;
+			}
+			SIZE_T offset = slabHeaderSize > (SIZE_T)memAlignment ? slabHeaderSize : (SIZE_T)memAlignment;
+			SIZE_T pageSize = PlatformMemory::fetchPageSize();
+			SIZE_T runSize = (offset + amount + pageSize - 1) & ~(pageSize - 1);
+			SlabSpan *span = (SlabSpan *)PlatformMemory::pageAlloc(runSize, GALACTIC_SLAB_SPAN_SIZE);
+			if (span == NULL) {
+				return NULL;
+			}
+			if (!slabRegisterSpan(span)) {
+				PlatformMemory::pageFree(span, runSize);
+				return NULL;
+			}
+			lockCache();
+			mappedBytes += runSize;
+			unlockCache();
+			span->magic = slabSpanMagic;
+			span->sizeClass = slabLargeClass;
+			span->blockSize = runSize - offset;
+			span->runSize = runSize;
+			span->liveCount = 1;
+			span->capacity = 1;
+			span->freeList = NULL;
+			span->bumpPtr = NULL;
+			span->owner = this;
+			span->prev = span->next = NULL;
+			#if GALACTIC_MEMORY_TRACKING == 1
+				//The run holds a single block, so every offset resolves to index 0 of a one entry table
+				span->runTag = (U8)memTag;
+				span->tags = &span->runTag;
+				span->firstBlock = (UTX8)span + offset;
+				span->blockReciprocal = 0;
+			#endif
+			return (UTX8)span + offset;
+		}
+
+		/*
+		StandardAllocater Class Definitions
+		*/
+		any StandardAllocater::gmalloc(SIZE_T amount, U32 memAlignment) {
+			return gmallocTagged(amount, 0, memAlignment);
+		}
+
+		any StandardAllocater::gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment) {
+			MutexLock lock(&cSec);
+			any newPtr = heap.alloc(amount, memAlignment, memTag);
+			if (!newPtr) {
+				PlatformMemory::onOutOfMem(amount, memAlignment);
+			}
+			return newPtr;
+		}
+
+		any StandardAllocater::grealloc(any srcPtr, SIZE_T amount, U32 memAlignment) {
+			if (!srcPtr) {
+				return gmalloc(amount, memAlignment);
+			}
+			if (amount == 0) {
+				gfree(srcPtr);
+				return NULL;
+			}
+			MutexLock lock(&cSec);
+			SIZE_T oldSize = heap.usableSize(srcPtr);
+			U32 alignMask = memAlignment > SlabHeap::MinimumBlock ? memAlignment - 1 : 0;
+			//Keep the block if it still fits and isn't mostly wasted
+			if (amount <= oldSize && amount > (oldSize >> 1) && ((IntPointer)srcPtr & alignMask) == 0) {
+				return srcPtr;
+			}
+			any newPtr = heap.alloc(amount, memAlignment, SlabHeap::fetchTag(srcPtr));
+			if (!newPtr) {
+				PlatformMemory::onOutOfMem(amount, memAlignment);
+				return NULL;
+			}
+			Memory::gmemcpy(newPtr, srcPtr, amount < oldSize ? amount : oldSize);
+			heap.release(srcPtr);
+			return newPtr;
+		}
+
+		void StandardAllocater::gfree(any trgPtr) {
+			if (!trgPtr) {
+				return;
+			}
+			MutexLock lock(&cSec);
+			heap.release(trgPtr);
+		}
+
+		bool StandardAllocater::validateHeap() {
+			MutexLock lock(&cSec);
+			return heap.validate();
+		}
+
+		void StandardAllocater::releaseIdleMemory() {
+			MutexLock lock(&cSec);
+			heap.trim();
+		}
+
+		SIZE_T StandardAllocater::usableSize(cAny ptr) {
+			//The span header of a live block is read only, so this is called without the lock (Memory::gfree() calls it for every block when tracking).
+			return heap.usableSize(ptr);
+		}
+
+		U32 StandardAllocater::fetchTag(cAny ptr) {
+			return SlabHeap::fetchTag(ptr);
+		}
+
+		/*
+		ThreadMagazine Class Definitions
+		*/
+		//The calling thread's magazine, there is only ever one ThreadSafeAllocater installed so this is kept at file scope.
+		static THREADLOCAL ThreadMagazine *_threadMagazine = NULL;
+
+		//Called when a thread holding a magazine exits, sends back everything the magazine holds for other threads and leaves it for the next thread.
+		static void releaseThreadMagazine(any data) {
+			ThreadMagazine *magazine = (ThreadMagazine *)data;
+			if (magazine == NULL) {
+				return;
+			}
+			magazine->flushRemoteBatch();
+			magazine->service();
+			magazine->trim();
+			_threadMagazine = NULL;
+			PlatformAtomics::exchange(&magazine->abandoned, 1);
+		}
+
+		//The platform key used to be notified when a thread exits
+		#ifdef GALACTIC_WINDOWS
+			static DWORD magazineExitKey = FLS_OUT_OF_INDEXES;
+			static VOID WINAPI onMagazineThreadExit(PVOID data) {
+				releaseThreadMagazine(data);
+			}
+		#else
+			static pthread_key_t magazineExitKey;
+		#endif
+
+		ThreadMagazine::ThreadMagazine(ThreadSafeAllocater *parent) : SlabHeap(GALACTIC_MAGAZINE_CACHED_SPANS), parent(parent), remoteFrees(NULL),
+			seenEpoch(parent->fetchEpoch()), abandoned(0), nextMagazine(NULL), batchTarget(NULL), batchHead(NULL), batchTail(NULL), batchCount(0) { }
+
+		void ThreadMagazine::service() {
+			if (remoteFrees != NULL) {
+				any block = PlatformAtomics::exchange((any *)&remoteFrees, NULL);
+				while (block != NULL) {
+					any next = *((any *)block);
+					release(block);
+					block = next;
+				}
+			}
+			S32 epoch = parent->fetchEpoch();
+			if (seenEpoch != epoch) {
+				//A scavenge pass was started, hand back what we are not using.
+				seenEpoch = epoch;
+				flushRemoteBatch();
+				trim();
+			}
+		}
+
+		void ThreadMagazine::reclaim(S32 epoch) {
+			//Only the span cache can be touched from another thread, the blocks in the remote-free queue wait for the owner to come back.
+			if (epoch - seenEpoch >= GALACTIC_MAGAZINE_IDLE_PASSES) {
+				trim();
+			}
+		}
+
+		void ThreadMagazine::remoteFree(ThreadMagazine *target, any ptr) {
+			if (batchTarget != target) {
+				flushRemoteBatch();
+				batchTarget = target;
+			}
+			*((any *)ptr) = batchHead;
+			batchHead = ptr;
+			if (batchTail == NULL) {
+				batchTail = ptr;
+			}
+			batchCount++;
+			if (batchCount >= GALACTIC_ALLOCATER_REMOTE_BATCH) {
+				flushRemoteBatch();
+			}
+		}
+
+		void ThreadMagazine::flushRemoteBatch() {
+			if (batchHead != NULL) {
+				batchTarget->pushRemote(batchHead, batchTail);
+			}
+			batchHead = batchTail = NULL;
+			batchCount = 0;
+		}
+
+		void ThreadMagazine::pushRemote(any first, any last) {
+			//The owner only ever takes the entire queue, which keeps this push free of ABA issues.
+			any oldHead;
+			do {
+				oldHead = remoteFrees;
+				*((any *)last) = oldHead;
+			} while (PlatformAtomics::compareExchange((any *)&remoteFrees, first, oldHead) != oldHead);
+		}
+
+		any ThreadMagazine::mapSpan() {
+			return parent->fetchSpan();
+		}
+
+		void ThreadMagazine::unmapSpan(any span) {
+			parent->returnSpan(span);
+		}
+
+		/*
+		ThreadSafeAllocater Class Definitions
+		*/
+		ThreadSafeAllocater::ThreadSafeAllocater() : spanPool(NULL), spanPoolCount(0), magazines(NULL), scavengeEpoch(0) {
+			#ifdef GALACTIC_WINDOWS
+				magazineExitKey = FlsAlloc(onMagazineThreadExit);
+			#else
+				pthread_key_create(&magazineExitKey, releaseThreadMagazine);
+			#endif
+		}
+
+		ThreadMagazine *ThreadSafeAllocater::fetchMagazine() {
+			ThreadMagazine *magazine = _threadMagazine;
+			if (magazine != NULL && magazine->parent == this) {
+				return magazine;
+			}
+			//First allocation on this thread, try to adopt a magazine left behind by a thread that has exited.
+			magazine = NULL;
+			for (ThreadMagazine *iter = magazines; iter != NULL; iter = iter->nextMagazine) {
+				if (iter->abandoned && PlatformAtomics::compareExchange(&iter->abandoned, 0, 1) == 1) {
+					magazine = iter;
+					break;
+				}
+			}
+			if (magazine == NULL) {
+				any mem = Memory::sysmalloc(sizeof(ThreadMagazine));
+				if (mem == NULL) {
+					return NULL;
+				}
+				magazine = new (mem) ThreadMagazine(this);
+				ThreadMagazine *oldHead;
+				do {
+					oldHead = magazines;
+					magazine->nextMagazine = oldHead;
+				} while (PlatformAtomics::compareExchange((any *)&magazines, magazine, oldHead) != oldHead);
+			}
+			_threadMagazine = magazine;
+			#ifdef GALACTIC_WINDOWS
+				FlsSetValue(magazineExitKey, magazine);
+			#else
+				pthread_setspecific(magazineExitKey, magazine);
+			#endif
+			return magazine;
+		}
+
+		any ThreadSafeAllocater::gmalloc(SIZE_T amount, U32 memAlignment) {
+			return gmallocTagged(amount, 0, memAlignment);
+		}
+
+		any ThreadSafeAllocater::gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment) {
+			any newPtr = NULL;
+			ThreadMagazine *magazine = NULL;
+			if (amount <= SlabHeap::MaximumSmall && memAlignment <= SlabHeap::MaximumClassAlignment) {
+				magazine = fetchMagazine();
+			}
+			if (magazine != NULL) {
+				if (magazine->remoteFrees != NULL || magazine->seenEpoch != scavengeEpoch) {
+					magazine->service();
+				}
+				newPtr = magazine->alloc(amount, memAlignment, memTag);
+			}
+			else {
+				MutexLock lock(&cSec);
+				newPtr = central.alloc(amount, memAlignment, memTag);
+			}
+			if (!newPtr) {
+				PlatformMemory::onOutOfMem(amount, memAlignment);
+			}
+			return newPtr;
+		}
+
+		any ThreadSafeAllocater::grealloc(any srcPtr, SIZE_T amount, U32 memAlignment) {
+			if (!srcPtr) {
+				return gmalloc(amount, memAlignment);
+			}
+			if (amount == 0) {
+				gfree(srcPtr);
+				return NULL;
+			}
+			//The span header is read only, so the size can be fetched regardless of which thread owns the block.
+			SIZE_T oldSize = central.usableSize(srcPtr);
+			U32 alignMask = memAlignment > SlabHeap::MinimumBlock ? memAlignment - 1 : 0;
+			if (amount <= oldSize && amount > (oldSize >> 1) && ((IntPointer)srcPtr & alignMask) == 0) {
+				return srcPtr;
+			}
+			any newPtr = gmallocTagged(amount, SlabHeap::fetchTag(srcPtr), memAlignment);
+			if (!newPtr) {
+				return NULL;
+			}
+			Memory::gmemcpy(newPtr, srcPtr, amount < oldSize ? amount : oldSize);
+			gfree(srcPtr);
+			return newPtr;
+		}
+
+		void ThreadSafeAllocater::gfree(any trgPtr) {
+			if (!trgPtr) {
+				return;
+			}
+			SlabHeap *owner = SlabHeap::ownerOf(trgPtr);
+			if (owner == NULL) {
+				GC_Error("ThreadSafeAllocater::gfree(): Attempted to free a pointer (%p) not owned by this allocater.", trgPtr);
+				return;
+			}
+			if (owner == &central) {
+				MutexLock lock(&cSec);
+				central.release(trgPtr);
+				return;
+			}
+			ThreadMagazine *magazine = fetchMagazine();
+			if (owner == magazine) {
+				magazine->release(trgPtr);
+			}
+			else if (magazine != NULL) {
+				magazine->remoteFree((ThreadMagazine *)owner, trgPtr);
+			}
+			else {
+				((ThreadMagazine *)owner)->pushRemote(trgPtr, trgPtr);
+			}
+		}
+
+		bool ThreadSafeAllocater::validateHeap() {
+			ThreadMagazine *magazine = fetchMagazine();
+			if (magazine != NULL && !magazine->validate()) {
+				return false;
+			}
+			MutexLock lock(&cSec);
+			return central.validate();
+		}
+
+		void ThreadSafeAllocater::scavenge() {
+			//Every magazine trims itself the next time it's thread allocates, the central pool is trimmed right away.
+			S32 epoch = PlatformAtomics::increment(&scavengeEpoch);
+			ThreadMagazine *magazine = _threadMagazine;
+			if (magazine != NULL && magazine->parent == this) {
+				magazine->service();
+			}
+			//Threads that have gone idle never get to trim their magazine, take their cached spans back here. The spans are returned to the pool
+			// through returnSpan(), so this is done before taking the lock.
+			for (ThreadMagazine *iter = magazines; iter != NULL; iter = iter->nextMagazine) {
+				if (iter != magazine) {
+					iter->reclaim(epoch);
+				}
+			}
+			MutexLock lock(&cSec);
+			central.trim();
+			while (spanPoolCount > GALACTIC_SLAB_CACHED_SPANS) {
+				any next = *((any *)spanPool);
+				PlatformMemory::pageFree(spanPool, GALACTIC_SLAB_SPAN_SIZE);
+				spanPool = next;
+				spanPoolCount--;
+			}
+			//Keep the address space of the remaining spans, but give their memory back (the first page holds the pool link).
+			SIZE_T pageSize = PlatformMemory::fetchPageSize();
+			for (any span = spanPool; span != NULL; span = *((any *)span)) {
+				PlatformMemory::pageReset((UTX8)span + pageSize, GALACTIC_SLAB_SPAN_SIZE - pageSize);
+			}
+		}
+
+		void ThreadSafeAllocater::releaseIdleMemory() {
+			scavenge();
+		}
+
+		SIZE_T ThreadSafeAllocater::usableSize(cAny ptr) {
+			//The size of a live block never changes, so the owning heap can be read without it's lock.
+			SlabHeap *owner = SlabHeap::ownerOf(ptr);
+			return owner != NULL ? owner->usableSize(ptr) : 0;
+		}
+
+		U32 ThreadSafeAllocater::fetchTag(cAny ptr) {
+			return SlabHeap::fetchTag(ptr);
+		}
+
+		any ThreadSafeAllocater::fetchSpan() {
+			if (true) {
+				MutexLock lock(&cSec);
+				if (spanPool != NULL) {
+					any span = spanPool;
+					spanPool = *((any *)span);
+					spanPoolCount--;
+					return span;
+				}
+			}
+			return PlatformMemory::pageAlloc(GALACTIC_SLAB_SPAN_SIZE, GALACTIC_SLAB_SPAN_SIZE);
+		}
+
+		void ThreadSafeAllocater::returnSpan(any span) {
+			if (true) {
+				MutexLock lock(&cSec);
+				if (spanPoolCount < (GALACTIC_SLAB_CACHED_SPANS * 4)) {
+					*((any *)span) = spanPool;
+					spanPool = span;
+					spanPoolCount++;
+					return;
+				}
+			}
+			PlatformMemory::pageFree(span, GALACTIC_SLAB_SPAN_SIZE);
+		}
+
+		/*
+		GuardAllocater Class Definitions
+		*/
+		//The amount of call stack frames recorded for guarded blocks
+		static const U32 guardStackDepth = 12;
+		//The installed GuardAllocater, used by the fault handler
+		static GuardAllocater *_guardAllocater = NULL;
+		//The sampling state of the calling thread
+		static THREADLOCAL U32 _guardCountdown = 0;
+		static THREADLOCAL U32 _guardRandom = 0;
+
+		/*
+		GuardSlot: The bookkeeping of a single GuardAllocater slot.
+		*/
+		struct GuardSlot {
+			//The block handed out from the slot
+			UTX8 block;
+			//The requested size of the block
+			SIZE_T size;
+			//Set while the block is live
+			bool live;
+			//Set once the slot has been used
+			bool used;
+			//The MemoryTracker tag of the block
+			U32 tag;
+			//The call stack of the allocation
+			any allocStack[guardStackDepth];
+			U32 allocDepth;
+			//The call stack of the release
+			any freeStack[guardStackDepth];
+			U32 freeDepth;
+		};
+
+		//Fetch the canary byte for an address (varies with the address so a run of identical bytes never passes)
+		SFIN U8 guardCanaryAt(cAny ptr) {
+			return (U8)(0xAB ^ ((IntPointer)ptr & 0xFF));
+		}
+
+		//Record the call stack of the calling thread
+		static U32 captureGuardStack(any *frames, U32 maxFrames) {
+			#ifdef GALACTIC_WINDOWS
+				return (U32)CaptureStackBackTrace(2, maxFrames, frames, NULL);
+			#elif defined(GALACTIC_LINUX) || defined(GALACTIC_MAC)
+				//Skip this function and the GuardAllocater method calling it
+				any stack[guardStackDepth + 2];
+				S32 depth = backtrace(stack, (int)(maxFrames + 2)) - 2;
+				if (depth <= 0) {
+					return 0;
+				}
+				Memory::gmemcpy(frames, stack + 2, depth * sizeof(any));
+				return (U32)depth;
+			#else
+				return 0;
+			#endif
+		}
+
+		//Print a recorded call stack
+		static void printGuardStack(UTF16 title, any *frames, U32 depth) {
+			GC_CError("  %s:", title);
+			#if defined(GALACTIC_LINUX) || defined(GALACTIC_MAC)
+				char **symbols = backtrace_symbols(frames, (int)depth);
+				for (U32 i = 0; i < depth; i++) {
+					GC_CError("    #%u %s", i, symbols ? symbols[i] : "?");
+				}
+				free(symbols);
+			#else
+				for (U32 i = 0; i < depth; i++) {
+					GC_CError("    #%u %p", i, frames[i]);
+				}
+			#endif
+		}
+
+		#ifndef GALACTIC_WINDOWS
+			/* Fault Output: GC_CError() and backtrace_symbols() allocate memory and take locks, which may already be held by the thread that faulted,
+			    so the report made from inside of the signal handler is written straight to stderr with async-signal-safe calls only. */
+			//Write a string to stderr
+			static void writeFaultText(UTF16 text) {
+				SIZE_T length = 0;
+				while (text[length] != '\0') {
+					length++;
+				}
+				while (length > 0) {
+					ssize_t written = write(STDERR_FILENO, text, length);
+					if (written <= 0) {
+						return;
+					}
+					text += written;
+					length -= (SIZE_T)written;
+				}
+			}
+
+			//Write a number to stderr, in hexadecimal (with a 0x prefix) or decimal
+			static void writeFaultNumber(U64 value, bool hex) {
+				C8 buffer[24];
+				UTF8 p = buffer + sizeof(buffer) - 1;
+				*p = '\0';
+				do {
+					U32 digit = (U32)(hex ? (value & 0xF) : (value % 10));
+					*--p = (C8)(digit < 10 ? '0' + digit : 'a' + (digit - 10));
+					value = hex ? (value >> 4) : (value / 10);
+				} while (value != 0);
+				if (hex) {
+					*--p = 'x';
+					*--p = '0';
+				}
+				writeFaultText(p);
+			}
+
+			//Write a recorded call stack to stderr
+			static void writeFaultStack(UTF16 title, any *frames, U32 depth) {
+				writeFaultText("  ");
+				writeFaultText(title);
+				writeFaultText(":\n");
+				#if defined(GALACTIC_LINUX) || defined(GALACTIC_MAC)
+					backtrace_symbols_fd(frames, (int)depth, STDERR_FILENO);
+				#else
+					for (U32 i = 0; i < depth; i++) {
+						writeFaultText("    #");
+						writeFaultNumber(i, false);
+						writeFaultText(" ");
+						writeFaultNumber((U64)(IntPointer)frames[i], true);
+						writeFaultText("\n");
+					}
+				#endif
+			}
+		#endif
+
+		//Catch faults in the guarded slots, the report is printed and the fault is passed on to the previous handler
+		#ifdef GALACTIC_WINDOWS
+			static LONG WINAPI guardFaultHandler(PEXCEPTION_POINTERS info) {
+				if (_guardAllocater && info->ExceptionRecord->ExceptionCode == EXCEPTION_ACCESS_VIOLATION) {
+					_guardAllocater->reportFault((cAny)info->ExceptionRecord->ExceptionInformation[1]);
+				}
+				return EXCEPTION_CONTINUE_SEARCH;
+			}
+		#else
+			static struct sigaction _previousSegvAction;
+			static struct sigaction _previousBusAction;
+			static void guardFaultHandler(S32 signal, siginfo_t *info, any context) {
+				if (_guardAllocater) {
+					_guardAllocater->reportFault(info->si_addr);
+				}
+				//Restore the previous handlers, the faulting instruction runs again and is handled by them.
+				sigaction(SIGSEGV, &_previousSegvAction, NULL);
+				sigaction(SIGBUS, &_previousBusAction, NULL);
+			}
+		#endif
+
+		static void installGuardFaultHandler() {
+			#ifdef GALACTIC_WINDOWS
+				AddVectoredExceptionHandler(1, guardFaultHandler);
+			#else
+				struct sigaction action;
+				Memory::gmemset(&action, 0, sizeof(action));
+				action.sa_sigaction = guardFaultHandler;
+				action.sa_flags = SA_SIGINFO;
+				sigemptyset(&action.sa_mask);
+				sigaction(SIGSEGV, &action, &_previousSegvAction);
+				sigaction(SIGBUS, &action, &_previousBusAction);
+			#endif
+		}
+
+		GuardAllocater::GuardAllocater(Allocater *wrapped) : inner(wrapped), poolBase(NULL), poolEnd(NULL), slots(NULL), freeRing(NULL), freeHead(0),
+			freeCount(0) {
+			SIZE_T pageSize = PlatformMemory::fetchPageSize();
+			slotDataSize = (GALACTIC_GUARD_SLOT_SIZE + pageSize - 1) & ~(pageSize - 1);
+			slotStride = slotDataSize + pageSize;
+			//The range starts with a guard page, and every slot is followed by one.
+			SIZE_T poolSize = pageSize + slotStride * GALACTIC_GUARD_SLOT_COUNT;
+			poolBase = (UTX8)PlatformMemory::pageReserve(poolSize);
+			slots = (GuardSlot *)Memory::sysmalloc(sizeof(GuardSlot) * GALACTIC_GUARD_SLOT_COUNT);
+			freeRing = (U32 *)Memory::sysmalloc(sizeof(U32) * GALACTIC_GUARD_SLOT_COUNT);
+			if (poolBase == NULL || slots == NULL || freeRing == NULL) {
+				GC_Error("GuardAllocater(): Failed to reserve the guarded slots, allocations will not be guarded.");
+				PlatformMemory::pageRelease(poolBase, poolSize);
+				poolBase = NULL;
+				return;
+			}
+			Memory::gmemset(slots, 0, sizeof(GuardSlot) * GALACTIC_GUARD_SLOT_COUNT);
+			for (U32 i = 0; i < GALACTIC_GUARD_SLOT_COUNT; i++) {
+				freeRing[i] = i;
+			}
+			freeCount = GALACTIC_GUARD_SLOT_COUNT;
+			poolEnd = poolBase + poolSize;
+			_guardAllocater = this;
+			installGuardFaultHandler();
+		}
+
+		GuardAllocater::~GuardAllocater() {
+			if (_guardAllocater == this) {
+				_guardAllocater = NULL;
+			}
+			if (poolBase != NULL) {
+				PlatformMemory::pageRelease(poolBase, (SIZE_T)(poolEnd - poolBase));
+			}
+			Memory::sysfree(slots);
+			Memory::sysfree(freeRing);
+			SendToPitsOfHell(inner);
+		}
+
+		any GuardAllocater::gmalloc(SIZE_T amount, U32 memAlignment) {
+			return gmallocTagged(amount, 0, memAlignment);
+		}
+
+		any GuardAllocater::gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment) {
+			if (poolBase != NULL && shouldSample()) {
+				any block = allocGuarded(amount, memAlignment, memTag);
+				if (block != NULL) {
+					return block;
+				}
+			}
+			return inner->gmallocTagged(amount, memTag, memAlignment);
+		}
+
+		any GuardAllocater::grealloc(any srcPtr, SIZE_T amount, U32 memAlignment) {
+			if (!srcPtr) {
+				return gmalloc(amount, memAlignment);
+			}
+			if (amount == 0) {
+				gfree(srcPtr);
+				return NULL;
+			}
+			SIZE_T oldSize = 0;
+			U32 tag = 0;
+			if (isGuarded(srcPtr)) {
+				if (true) {
+					MutexLock lock(&cSec);
+					GuardSlot *slot = slotOf(srcPtr);
+					if (slot == NULL || !slot->live || slot->block != srcPtr) {
+						reportSlot(slot, "Invalid grealloc() of a guarded block", srcPtr);
+						return NULL;
+					}
+					oldSize = slot->size;
+					tag = slot->tag;
+				}
+				any newPtr = gmallocTagged(amount, tag, memAlignment);
+				if (newPtr) {
+					Memory::gmemcpy(newPtr, srcPtr, oldSize < amount ? oldSize : amount);
+					freeGuarded(srcPtr);
+				}
+				return newPtr;
+			}
+			if (poolBase != NULL && shouldSample() && (oldSize = inner->usableSize(srcPtr)) != 0) {
+				any newPtr = allocGuarded(amount, memAlignment, inner->fetchTag(srcPtr));
+				if (newPtr) {
+					Memory::gmemcpy(newPtr, srcPtr, oldSize < amount ? oldSize : amount);
+					gfree(srcPtr);
+					return newPtr;
+				}
+			}
+			return inner->grealloc(srcPtr, amount, memAlignment);
+		}
+
+		void GuardAllocater::gfree(any trgPtr) {
+			if (!trgPtr) {
+				return;
+			}
+			if (isGuarded(trgPtr)) {
+				freeGuarded(trgPtr);
+				return;
+			}
+			#if GALACTIC_GUARD_POISON_FREES == 1
+				SIZE_T size = inner->usableSize(trgPtr);
+				if (size > 0) {
+					Memory::gmemset(trgPtr, 0xDD, size);
+				}
+			#endif
+			inner->gfree(trgPtr);
+		}
+
+		bool GuardAllocater::validateHeap() {
+			bool result = true;
+			if (poolBase != NULL) {
+				MutexLock lock(&cSec);
+				for (U32 i = 0; i < GALACTIC_GUARD_SLOT_COUNT; i++) {
+					if (slots[i].live && !checkSlot(&slots[i])) {
+						result = false;
+					}
+				}
+			}
+			return inner->validateHeap() && result;
+		}
+
+		void GuardAllocater::releaseIdleMemory() {
+			inner->releaseIdleMemory();
+		}
+
+		SIZE_T GuardAllocater::usableSize(cAny ptr) {
+			if (isGuarded(ptr)) {
+				GuardSlot *slot = slotOf(ptr);
+				return slot != NULL && slot->live ? slot->size : 0;
+			}
+			return inner->usableSize(ptr);
+		}
+
+		U32 GuardAllocater::fetchTag(cAny ptr) {
+			if (isGuarded(ptr)) {
+				GuardSlot *slot = slotOf(ptr);
+				return slot != NULL && slot->live ? slot->tag : 0;
+			}
+			return inner->fetchTag(ptr);
+		}
+
+		bool GuardAllocater::reportFault(cAny address) {
+			if (!isGuarded(address)) {
+				return false;
+			}
+			//Note: This is called from the fault handler, the slots are read without locking.
+			UTX8 first = poolBase + PlatformMemory::fetchPageSize();
+			if ((UTX8)address < first) {
+				reportFaultSlot(slots[0].live ? &slots[0] : NULL, "Buffer underflow", address);
+				return true;
+			}
+			SIZE_T offset = (SIZE_T)((UTX8)address - first);
+			U32 index = (U32)(offset / slotStride);
+			if (offset % slotStride >= slotDataSize) {
+				//The guard page following slot index, blame whichever neighbour is live.
+				GuardSlot *before = &slots[index];
+				GuardSlot *after = index + 1 < GALACTIC_GUARD_SLOT_COUNT ? &slots[index + 1] : NULL;
+				if (before->live) {
+					reportFaultSlot(before, "Buffer overflow", address);
+				}
+				else if (after != NULL && after->live) {
+					reportFaultSlot(after, "Buffer underflow", address);
+				}
+				else {
+					reportFaultSlot(NULL, "Access to a guard page", address);
+				}
+				return true;
+			}
+			reportFaultSlot(&slots[index], slots[index].live ? "Invalid access" : "Use after free", address);
+			return true;
+		}
+
+		GuardSlot *GuardAllocater::slotOf(cAny ptr) const {
+			UTX8 first = poolBase + PlatformMemory::fetchPageSize();
+			if ((UTX8)ptr < first) {
+				return NULL;
+			}
+			SIZE_T offset = (SIZE_T)((UTX8)ptr - first);
+			if (offset % slotStride >= slotDataSize) {
+				return NULL;
+			}
+			return &slots[offset / slotStride];
+		}
+
+		UTX8 GuardAllocater::slotData(GuardSlot *slot) const {
+			return poolBase + PlatformMemory::fetchPageSize() + (SIZE_T)(slot - slots) * slotStride;
+		}
+
+		bool GuardAllocater::shouldSample() {
+			#if GALACTIC_GUARD_SAMPLE_RATE <= 1
+				return true;
+			#else
+				if (_guardCountdown == 0) {
+					//Pick a random interval averaging the sample rate, so allocation patterns cannot line up with the sampling.
+					if (_guardRandom == 0) {
+						_guardRandom = (U32)(IntPointer)&_guardCountdown | 1;
+					}
+					_guardRandom ^= _guardRandom << 13;
+					_guardRandom ^= _guardRandom >> 17;
+					_guardRandom ^= _guardRandom << 5;
+					_guardCountdown = 1 + (_guardRandom % (GALACTIC_GUARD_SAMPLE_RATE * 2));
+				}
+				return --_guardCountdown == 0;
+			#endif
+		}
+
+		any GuardAllocater::allocGuarded(SIZE_T amount, U32 memAlignment, U32 memTag) {
+			U32 alignment = memAlignment != Memory::Default ? memAlignment : (amount >= 16 ? 16 : (U32)Memory::Minimum);
+			if (amount == 0 || amount > slotDataSize || alignment > PlatformMemory::fetchPageSize()) {
+				return NULL;
+			}
+			MutexLock lock(&cSec);
+			if (freeCount == 0) {
+				return NULL;
+			}
+			//Take the slot that has been free the longest, giving use after free the best chance of being caught.
+			U32 index = freeRing[freeHead];
+			GuardSlot *slot = &slots[index];
+			UTX8 data = slotData(slot);
+			if (!PlatformMemory::pageCommit(data, slotDataSize)) {
+				return NULL;
+			}
+			freeHead = (freeHead + 1) % GALACTIC_GUARD_SLOT_COUNT;
+			freeCount--;
+			//Place the block as close to the guard page as the alignment allows, and fill the rest of the slot with canaries.
+			UTX8 block = (UTX8)((IntPointer)(data + slotDataSize - amount) & ~((IntPointer)alignment - 1));
+			for (UTX8 p = data; p < block; p++) {
+				*p = guardCanaryAt(p);
+			}
+			for (UTX8 p = block + amount; p < data + slotDataSize; p++) {
+				*p = guardCanaryAt(p);
+			}
+			slot->block = block;
+			slot->size = amount;
+			slot->tag = memTag;
+			slot->live = true;
+			slot->used = true;
+			slot->allocDepth = captureGuardStack(slot->allocStack, guardStackDepth);
+			slot->freeDepth = 0;
+			return block;
+		}
+
+		void GuardAllocater::freeGuarded(any ptr) {
+			MutexLock lock(&cSec);
+			GuardSlot *slot = slotOf(ptr);
+			if (slot == NULL || !slot->live || slot->block != ptr) {
+				reportSlot(slot, slot != NULL && !slot->live && slot->block == ptr ? "Double free" : "Invalid free", ptr);
+				return;
+			}
+			checkSlot(slot);
+			slot->live = false;
+			slot->freeDepth = captureGuardStack(slot->freeStack, guardStackDepth);
+			//The slot stays inaccessible until it is handed out again.
+			PlatformMemory::pageDecommit(slotData(slot), slotDataSize);
+			freeRing[(freeHead + freeCount) % GALACTIC_GUARD_SLOT_COUNT] = (U32)(slot - slots);
+			freeCount++;
+		}
+
+		bool GuardAllocater::checkSlot(GuardSlot *slot) {
+			UTX8 data = slotData(slot);
+			for (UTX8 p = data; p < slot->block; p++) {
+				if (*p != guardCanaryAt(p)) {
+					reportSlot(slot, "Buffer underflow (corrupted canary)", p);
+					return false;
+				}
+			}
+			for (UTX8 p = slot->block + slot->size; p < data + slotDataSize; p++) {
+				if (*p != guardCanaryAt(p)) {
+					reportSlot(slot, "Buffer overflow (corrupted canary)", p);
+					return false;
+				}
+			}
+			return true;
+		}
+
+		void GuardAllocater::reportSlot(GuardSlot *slot, UTF16 problem, cAny address) {
+			GC_CError("GuardAllocater: %s at %p.", problem, address);
+			if (slot == NULL || !slot->used) {
+				return;
+			}
+			GC_CError("  Block %p of %u bytes (%s).", slot->block, (U32)slot->size, slot->live ? "live" : "freed");
+			printGuardStack("Allocated at", slot->allocStack, slot->allocDepth);
+			if (!slot->live) {
+				printGuardStack("Freed at", slot->freeStack, slot->freeDepth);
+			}
+		}
+
+		void GuardAllocater::reportFaultSlot(GuardSlot *slot, UTF16 problem, cAny address) {
+			#ifdef GALACTIC_WINDOWS
+				//The vectored exception handler is not a signal handler, the regular report can be used.
+				reportSlot(slot, problem, address);
+			#else
+				writeFaultText("GuardAllocater: ");
+				writeFaultText(problem);
+				writeFaultText(" at ");
+				writeFaultNumber((U64)(IntPointer)address, true);
+				writeFaultText(".\n");
+				if (slot == NULL || !slot->used) {
+					return;
+				}
+				writeFaultText("  Block ");
+				writeFaultNumber((U64)(IntPointer)slot->block, true);
+				writeFaultText(" of ");
+				writeFaultNumber((U64)slot->size, false);
+				writeFaultText(slot->live ? " bytes (live).\n" : " bytes (freed).\n");
+				writeFaultStack("Allocated at", slot->allocStack, slot->allocDepth);
+				if (!slot->live) {
+					writeFaultStack("Freed at", slot->freeStack, slot->freeDepth);
+				}
+			#endif
+		}
+
+	};
+
+};
\ No newline at end of file
@@ -155,18 +155,333 @@ namespace Galactic {
 
 		};
 
+		//Header placed at the start of every span and page run, defined in allocaterOverloads.cpp
+		struct SlabSpan;
+
+		/*
+		SlabHeap: The size-class heap used by the StandardAllocater and ThreadSafeAllocater. Small requests (up to 32K) are rounded up to one of the fixed size classes and carved
+		 from spans of GALACTIC_SLAB_SPAN_SIZE bytes, larger requests are given their own run of pages. Every span and page run is aligned to the span size
+		 and starts with a header, so a pointer finds it's owner with a single mask (once a registry of the live spans confirms the header exists). All operations are O(1). This class is not thread safe by itself.
+		*/
+		class SlabHeap {
+			public:
+				/* Public Class Members */
+				//Constants used by the heap
+				enum SlabConstants {
+					//The minimum size (and alignment) of any block returned by the heap
+					MinimumBlock = 16,
+					//The largest request handled by the size classes, anything larger is given a page run
+					MaximumSmall = 32768,
+					//The amount of size classes in the heap
+					ClassCount = 40,
+					//The largest alignment (in bytes) handled directly by the size classes
+					MaximumClassAlignment = 64,
+				};
+
+				/* Constructor / Destructor */
+				//Default Constructor
+				SlabHeap(U32 maxCachedSpans = GALACTIC_SLAB_CACHED_SPANS);
+				//Destructor
+				virtual ~SlabHeap();
+
+				/* Public Class Methods */
+				//Allocate a block of the specified size and alignment, the MemoryTracker tag is kept with the block when GALACTIC_MEMORY_TRACKING is enabled
+				any alloc(SIZE_T amount, U32 memAlignment = MinimumBlock, U32 memTag = 0);
+				//Release a block allocated by this heap
+				void release(any ptr);
+				//Fetch the usable size of a block allocated by this heap
+				SIZE_T usableSize(cAny ptr) const;
+				//Walk the partially used spans and validate their headers
+				bool validate() const;
+				//Fetch the total amount of bytes mapped by this heap
+				SIZE_T fetchMappedBytes() const;
+				//Release all of the cached empty spans (the only method that may be called while another thread uses the heap)
+				void trim();
+				//Fetch the heap that owns a block, returns NULL if the pointer is not inside of a live span (pointers inside of one that weren't returned by alloc() are undefined)
+				static SlabHeap *ownerOf(cAny ptr);
+				//Fetch the MemoryTracker tag of a block allocated by any heap, 0 (Tag_General) if tracking is disabled
+				static U32 fetchTag(cAny ptr);
+				//Fetch the size class used for a request, ClassCount is returned for requests handled by page runs
+				static U32 sizeToClass(SIZE_T amount);
+				//Fetch the block size of a size class
+				static SIZE_T classToSize(U32 sizeClass);
+
+			protected:
+				/* Protected Class Methods */
+				//Map a span (GALACTIC_SLAB_SPAN_SIZE bytes, aligned to it's size) for the heap, the default maps it from the system
+				virtual any mapSpan();
+				//Unmap a span that is no longer used by the heap
+				virtual void unmapSpan(any span);
+
+			private:
+				/* Private Class Methods */
+				//Fetch a new (or cached) span for the size class
+				SlabSpan *createSpan(U32 sizeClass);
+				//Release an empty span to the cache, or the system if the cache is full
+				void releaseSpan(SlabSpan *span);
+				//Allocate a page run for large (or highly aligned) requests
+				any allocLarge(SIZE_T amount, U32 memAlignment, U32 memTag);
+				//Build the size class tables (only done once)
+				static void buildTables();
+				//Lock the span cache, which trim() may take from another thread
+				void lockCache();
+				//Unlock the span cache
+				void unlockCache();
+
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				SlabHeap(const SlabHeap &);
+				//Assignment Operator
+				SlabHeap &operator=(const SlabHeap &);
+
+				/* Private Class Members */
+				//The spans with free blocks for each size class
+				SlabSpan *partialSpans[ClassCount];
+				//Empty spans held for re-use
+				SlabSpan *cachedSpans;
+				//The amount of spans held in cachedSpans
+				U32 cachedSpanCount;
+				//The maximum amount of spans to hold in cachedSpans
+				U32 maxCachedSpans;
+				//The total amount of bytes currently mapped from the system
+				SIZE_T mappedBytes;
+				//Spin lock protecting cachedSpans, cachedSpanCount and mappedBytes, only taken when a span is created or released
+				volatile S32 cacheLock;
+		};
+
 		/*
-		StandardAllocater: Standardized Allocater system for usage on pretty much any platform
+		StandardAllocater: Standardized Allocater system for usage on pretty much any platform. This is a thin wrapper around a single SlabHeap which is
+		 protected by a critical section, see ThreadSafeAllocater for an allocater that avoids the shared lock.
 		*/
 		class StandardAllocater : public Allocater {
+			public:
+				/* Public Class Methods */
+				//Malloc override
+				virtual any gmalloc(SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Malloc override, recording the MemoryTracker tag of the block
+				virtual any gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment = Memory::Default);
+				//Realloc override
+				virtual any grealloc(any srcPtr, SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Free override
+				virtual void gfree(any trgPtr);
+				//The heap is always accessed under the lock
+				virtual bool isThreadSafe() const { return true; }
+				//Validate the allocation heap
+				virtual bool validateHeap();
+				//Release the heap's cached spans
+				virtual void releaseIdleMemory();
+				//Fetch the usable size of a block
+				virtual SIZE_T usableSize(cAny ptr);
+				//Fetch the MemoryTracker tag of a block
+				virtual U32 fetchTag(cAny ptr);
+
+			private:
+				/* Private Class Members */
+				//The critical section object protecting the heap
+				PlatformCriticalSection cSec;
+				//The heap itself
+				SlabHeap heap;
+		};
+
+		/*
+		ThreadMagazine: The per-thread cache used by the ThreadSafeAllocater. Each thread owns a private SlabHeap (it's magazine of spans), which is used
+		 without any locking. Blocks freed by other threads are sent back in batches through a lock-free remote-free queue that the owner drains on it's
+		 next allocation. Magazines are never destroyed, when a thread exits it's magazine is abandoned and adopted by the next new thread.
+		*/
+		class ThreadMagazine : public SlabHeap {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				ThreadMagazine(class ThreadSafeAllocater *parent);
+
+				/* Public Class Methods */
+				//Service the magazine, drains remote frees and handles scavenge requests
+				void service();
+				//Called by a scavenge pass from another thread, releases the cached spans of the magazine if it's owner hasn't used it in a while
+				void reclaim(S32 epoch);
+				//Add a block owned by another magazine to the pending remote batch
+				void remoteFree(ThreadMagazine *target, any ptr);
+				//Send the pending remote batch to it's owner
+				void flushRemoteBatch();
+				//Push a chain of blocks onto this magazine's remote-free queue (called from other threads)
+				void pushRemote(any first, any last);
+
+				/* Public Class Members */
+				//The allocater this magazine belongs to
+				class ThreadSafeAllocater *parent;
+				//The lock-free queue of blocks freed by other threads
+				any volatile remoteFrees;
+				//The last scavenge pass seen by this magazine
+				volatile S32 seenEpoch;
+				//Set while the magazine has no owning thread
+				volatile S32 abandoned;
+				//The next magazine in the allocater's list
+				ThreadMagazine *nextMagazine;
+
+			protected:
+				/* Protected Class Methods */
+				//Spans are fetched from the parent's central span pool
+				virtual any mapSpan();
+				//Spans are returned to the parent's central span pool
+				virtual void unmapSpan(any span);
 
+			private:
+				/* Private Class Members */
+				//The magazine the pending remote batch is going to
+				ThreadMagazine *batchTarget;
+				//The pending remote batch
+				any batchHead;
+				any batchTail;
+				U32 batchCount;
 		};
 
 		/*
-		ThreadSafeAllocater: Allocater system with a guarenteed thread-safe function proxy
+		ThreadSafeAllocater: Allocater system with a guarenteed thread-safe function proxy. Small requests are served from a per-thread ThreadMagazine
+		 without any locking, the central heap (under a lock) only serves large requests and spans to the magazines. Call scavenge() periodically (the main
+		 loop does through Memory::releaseIdleMemory()) to have magazines hand their cached spans and pending frees back. Magazines of threads that have
+		 been idle for GALACTIC_MAGAZINE_IDLE_PASSES passes have their cached spans taken back by the pass itself.
 		*/
 		class ThreadSafeAllocater : public Allocater {
+			public:
+				/* Constructor / Destructor */
+				//Default Constructor
+				ThreadSafeAllocater();
+
+				/* Public Class Methods */
+				//Malloc override
+				virtual any gmalloc(SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Malloc override, recording the MemoryTracker tag of the block
+				virtual any gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment = Memory::Default);
+				//Realloc override
+				virtual any grealloc(any srcPtr, SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Free override
+				virtual void gfree(any trgPtr);
+				//This allocater is always thread safe
+				virtual bool isThreadSafe() const { return true; }
+				//Validate the central heap and the calling thread's magazine
+				virtual bool validateHeap();
+				//Start a scavenge pass (see scavenge())
+				virtual void releaseIdleMemory();
+				//Fetch the usable size of a block
+				virtual SIZE_T usableSize(cAny ptr);
+				//Fetch the MemoryTracker tag of a block
+				virtual U32 fetchTag(cAny ptr);
+				//Start a scavenge pass, trims the central span pool (the pages of the spans it keeps are reset), asks every magazine to release it's idle memory
+				// and reclaims the cached spans of idle magazines
+				void scavenge();
+				//Fetch a span from the central span pool
+				any fetchSpan();
+				//Return a span to the central span pool
+				void returnSpan(any span);
+				//Fetch the current scavenge pass
+				S32 fetchEpoch() const { return scavengeEpoch; }
+
+			private:
+				/* Private Class Methods */
+				//Fetch (or create / adopt) the calling thread's magazine
+				ThreadMagazine *fetchMagazine();
+
+				/* Private Class Members */
+				//The critical section object protecting the central heap and span pool
+				PlatformCriticalSection cSec;
+				//The central heap, used for large requests
+				SlabHeap central;
+				//Empty spans shared between the magazines
+				any spanPool;
+				//The amount of spans in the span pool
+				U32 spanPoolCount;
+				//List of every magazine created by this allocater
+				ThreadMagazine * volatile magazines;
+				//The current scavenge pass
+				volatile S32 scavengeEpoch;
+		};
+
+		//Bookkeeping of a GuardAllocater slot, defined in allocaterOverloads.cpp
+		struct GuardSlot;
+
+		/*
+		GuardAllocater: Debugging allocater that wraps another allocater. A sampled fraction of allocations (see GALACTIC_GUARD_SAMPLE_RATE) is placed in a
+		 slot of it's own, right against an inaccessible guard page, with the rest of the slot filled with canary bytes. Freed slots are made inaccessible
+		 and quarantined for as long as possible before being reused. Overflows into the guard page and use after free fault immediately, smaller overflows
+		 and underflows are caught by the canaries when the block is freed (or by validateHeap()). Every report includes the call stack of the allocation.
+		 All other allocations are passed to the wrapped allocater, and are poisoned with 0xDD when freed if GALACTIC_GUARD_POISON_FREES is set.
+		*/
+		class GuardAllocater : public Allocater {
+			public:
+				/* Constructor / Destructor */
+				//Creation Constructor, the GuardAllocater takes ownership of the wrapped allocater
+				GuardAllocater(Allocater *wrapped);
+				//Destructor
+				virtual ~GuardAllocater();
+
+				/* Public Class Methods */
+				//Malloc override
+				virtual any gmalloc(SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Malloc override, recording the MemoryTracker tag of the block
+				virtual any gmallocTagged(SIZE_T amount, U32 memTag, U32 memAlignment = Memory::Default);
+				//Realloc override
+				virtual any grealloc(any srcPtr, SIZE_T amount, U32 memAlignment = Memory::Default);
+				//Free override
+				virtual void gfree(any trgPtr);
+				//Thread safety is inherited from the wrapped allocater
+				virtual bool isThreadSafe() const { return inner->isThreadSafe(); }
+				//Check the canaries of every guarded block, and validate the wrapped allocater
+				virtual bool validateHeap();
+				//Release the wrapped allocater's idle memory
+				virtual void releaseIdleMemory();
+				//Fetch the usable size of a block
+				virtual SIZE_T usableSize(cAny ptr);
+				//Fetch the MemoryTracker tag of a block
+				virtual U32 fetchTag(cAny ptr);
+				//Report a memory fault if the address belongs to a guarded slot, returns false otherwise (called by the platform fault handler)
+				bool reportFault(cAny address);
+
+			private:
+				/* Private Class Methods */
+				//Test if a pointer is inside of the guarded slot range
+				bool isGuarded(cAny ptr) const {
+					return (UTX8)ptr >= poolBase && (UTX8)ptr < poolEnd;
+				}
+				//Fetch the slot a pointer in the guarded range belongs to
+				GuardSlot *slotOf(cAny ptr) const;
+				//Decide if the calling thread's next allocation is sampled
+				bool shouldSample();
+				//Allocate a block in a guarded slot, returns NULL if no slot is available
+				any allocGuarded(SIZE_T amount, U32 memAlignment, U32 memTag);
+				//Release a block in a guarded slot
+				void freeGuarded(any ptr);
+				//Fetch the first byte of a slot's data pages
+				UTX8 slotData(GuardSlot *slot) const;
+				//Verify the canaries of a live slot, reports and returns false on corruption
+				bool checkSlot(GuardSlot *slot);
+				//Print a report about a slot
+				void reportSlot(GuardSlot *slot, UTF16 problem, cAny address);
+				//Print a report about a slot from the fault handler, using async-signal-safe output only
+				void reportFaultSlot(GuardSlot *slot, UTF16 problem, cAny address);
+
+				/* Private (Blocked) Constructors / Operators */
+				//Copy Constructor
+				GuardAllocater(const GuardAllocater &);
+				//Assignment Operator
+				GuardAllocater &operator=(const GuardAllocater &);
 
+				/* Private Class Members */
+				//The wrapped allocater
+				Allocater *inner;
+				//The critical section object protecting the slots
+				PlatformCriticalSection cSec;
+				//The reserved range holding the slots (each slot is followed by a guard page)
+				UTX8 poolBase;
+				UTX8 poolEnd;
+				//The size of a slot's data pages, and the distance between two slots
+				SIZE_T slotDataSize;
+				SIZE_T slotStride;
+				//The slot bookkeeping
+				GuardSlot *slots;
+				//Ring of the slots not in use, oldest freed first
+				U32 *freeRing;
+				U32 freeHead;
+				U32 freeCount;
 		};
 
 	};
@@ -39,7 +39,9 @@ namespace Galactic {
 	namespace Core {
 		/* Forward Decs. (ToDo: Find a better order of execution) */
 		class String;
-		template <typename T> class DynArray;
+		class StringView;
+		class GlobalAllocaterPolicy;
+		template <typename T, class A = GlobalAllocaterPolicy> class DynArray;
 	}
 }
 
@@ -50,8 +52,17 @@ namespace Galactic {
 #include "Tools/advTools.h"
 #include "Tools/strTools.h"
 #include "Tools/charTools.h"
+#include "Tools/unicode.h"
+#include "Tools/hash.h"
+#include "Tools/frameArena.h"
+#include "Containers/allocaterPolicy.h"
 #include "Containers/dynArray.h"
 #include "Tools/string.h"
+#include "Tools/stringView.h"
+#include "Tools/stringTable.h"
+#include "Tools/stringBuilder.h"
+#include "Tools/format.h"
+#include "Tools/charConv.h"
 #include "Containers/mSingleton.h"
 #include "Containers/map.h"
 #include "Tools/filePath.h"
@@ -59,10 +70,12 @@ namespace Galactic {
 //Load everything else we need.
 #include "Tools/commandLineParams.h"
 #include "Tools/reference.h"
+#include "Containers/objectPool.h"
 #include "Delegates/engineDelegates.h"
 #include "Thread/threadBase.h"
 #include "Thread/singleThreadBase.h" 
 #include "Thread/threadTasks.h"
+#include "Thread/threadSync.h"
 #include "Math/math.h"
 #include "Containers/frameTicker.h"
 #include "GenericPlatform/window.h"
@@ -84,4 +97,4 @@ extern U64  gFrameCount;
 extern bool gInInitialLoad;
 extern bool gSuspendRender;
 
-#endif
+#endif
\ No newline at end of file
@@ -109,6 +109,213 @@
 */
 #define GALACTIC_AFFINITY_MANAGER_THREADCOUNT 32
 
+//GALACTIC_CRITICALSECTION_SPINCOUNT
+/*
+	This define controls how long a contended PlatformCriticalSection will spin on the lock before parking the calling thread in the
+	kernel. The value is the total amount of processor pause instructions spent in the spin phase, the spin itself backs off exponentially
+	so the first few retries are very quick. Short critical sections (registries, allocators) should never reach the kernel with the default
+	value of 4500, which also matches the spin count used by Windows critical sections in the engine.
+*/
+#define GALACTIC_CRITICALSECTION_SPINCOUNT 4500
+
+//GALACTIC_LOCK_CONTENTION_STATS
+/*
+	This define enables per-lock contention statistics on PlatformCriticalSection (acquisitions, contended acquisitions, parks, and spin counts).
+	The counters are only written by the owner of the lock, so the overhead is small, but you should leave this as 0 for shipping builds.
+*/
+#define GALACTIC_LOCK_CONTENTION_STATS 0
+
+//GALACTIC_DEBUG_LOCK_ORDER
+/*
+	This define enables the debug lock-order checker. Critical sections that are constructed with an order level must always be taken in
+	increasing level order by a thread, any violation of this rule (a potential deadlock) is reported to the console. Locks with an order
+	level of 0 are ignored by the checker. This should only be enabled in debug builds.
+*/
+#define GALACTIC_DEBUG_LOCK_ORDER 0
+
+//GALACTIC_EVENTPOOL_PREWARM_COUNT
+/*
+	This define controls how many Event objects the EventPool creates when it is first accessed. Once the pool has been warmed, fetching an event
+	for a SingleEvent never needs to allocate or create a new platform event. If your project fires a large amount of parallel jobs each frame, raise
+	this value to match the peak amount of events in flight. The default value for this is 32.
+*/
+#define GALACTIC_EVENTPOOL_PREWARM_COUNT 32
+
+//GALACTIC_EVENTPOOL_THREAD_CACHE_SIZE
+/*
+	This define controls the maximum amount of Event objects each thread holds in it's local EventPool cache before half of the cache is handed back
+	to the shared pool. Fetching and returning events through the local cache requires no atomic operations at all. The default value for this is 16.
+*/
+#define GALACTIC_EVENTPOOL_THREAD_CACHE_SIZE 16
+
+//GALACTIC_SLAB_SPAN_SIZE
+/*
+	This define controls the size of the spans the StandardAllocater carves it's small object size classes from. Spans are aligned to their own size
+	which allows a freed pointer to find it's span in a single operation, so this value must be a power of 2. Larger spans waste less space on the
+	larger size classes (up to 32K) at the cost of more reserved address space per size class. The default value for this is 256K, or 2^18.
+*/
+#define GALACTIC_SLAB_SPAN_SIZE 262144
+
+//GALACTIC_SLAB_CACHED_SPANS
+/*
+	This define controls how many completely empty spans the StandardAllocater holds on to before returning them to the operating system. Keeping a few
+	spans around avoids repeatedly mapping and unmapping memory when an allocation pattern bounces around the edge of a span. The default value is 8.
+*/
+#define GALACTIC_SLAB_CACHED_SPANS 8
+
+//GALACTIC_HUGE_PAGES
+/*
+	This define controls the usage of huge pages for large page runs (PlatformMemory::pageAlloc() requests of at least GALACTIC_HUGE_PAGE_SIZE), which cuts
+	down on TLB misses for large working sets. Set to 0 to disable, 1 to align large runs and request transparent huge pages (Default), or 2 to request
+	explicit huge pages (MAP_HUGETLB) first, falling back to transparent huge pages when the system has none reserved. This is ignored on Windows.
+*/
+#define GALACTIC_HUGE_PAGES 1
+
+//GALACTIC_HUGE_PAGE_SIZE
+/*
+	This define is the size of a huge page on the target system, this must be a power of 2. The default value is 2MB (x86-64).
+*/
+#define GALACTIC_HUGE_PAGE_SIZE 2097152
+
+//GALACTIC_GUARD_ALLOCATER
+/*
+	This define enables the GuardAllocater, a debugging layer wrapped around the engine allocater which catches buffer overflows, underflows and use after
+	free on a sampled fraction of allocations, reporting them with the call stack of the allocation. Sampling keeps the overhead low enough to leave this
+	enabled on test and canary servers. Set to 1 to enable, 0 to disable (Default).
+*/
+#define GALACTIC_GUARD_ALLOCATER 0
+
+//GALACTIC_GUARD_SAMPLE_RATE
+/*
+	This define controls how often the GuardAllocater places an allocation in a guarded slot, on average one out of every GALACTIC_GUARD_SAMPLE_RATE
+	allocations is guarded. Set to 1 to guard every allocation that fits in a slot. The default value is 1000.
+*/
+#define GALACTIC_GUARD_SAMPLE_RATE 1000
+
+//GALACTIC_GUARD_SLOT_COUNT
+/*
+	This define controls the amount of guarded slots reserved by the GuardAllocater. Freed slots are quarantined until every other free slot has been
+	used, so more slots catch use after free for longer. The default value is 256.
+*/
+#define GALACTIC_GUARD_SLOT_COUNT 256
+
+//GALACTIC_GUARD_SLOT_SIZE
+/*
+	This define controls the size of each guarded slot (rounded up to the page size), larger allocations are never guarded. The default value is 16K.
+*/
+#define GALACTIC_GUARD_SLOT_SIZE 16384
+
+//GALACTIC_GUARD_POISON_FREES
+/*
+	This define controls if the GuardAllocater fills the allocations it does not guard with 0xDD when they are freed, which makes use after free of any
+	block easy to spot in a debugger. Set to 1 to enable (Default), 0 to disable.
+*/
+#define GALACTIC_GUARD_POISON_FREES 1
+
+//GALACTIC_ALLOCATER_REMOTE_BATCH
+/*
+	This define controls how many blocks a thread collects before it sends memory freed on behalf of another thread back to the owning thread's
+	magazine in the ThreadSafeAllocater. Larger batches mean fewer atomic operations, but more memory held in flight. The default value is 32.
+*/
+#define GALACTIC_ALLOCATER_REMOTE_BATCH 32
+
+//GALACTIC_MAGAZINE_CACHED_SPANS
+/*
+	This define controls how many empty spans each thread's magazine holds on to before returning them to the ThreadSafeAllocater's shared span pool.
+	The default value is 2.
+*/
+#define GALACTIC_MAGAZINE_CACHED_SPANS 2
+
+//GALACTIC_MAGAZINE_IDLE_PASSES
+/*
+	This define controls how many scavenge passes a thread's magazine can go without it's thread allocating before the scavenge pass takes the magazine's
+	cached spans back itself, so threads that have gone idle don't hold on to them. Blocks other threads freed to an idle magazine wait for it's thread
+	to return. The default value is 4.
+*/
+#define GALACTIC_MAGAZINE_IDLE_PASSES 4
+
+//GALACTIC_ALLOCATER_SCAVENGE_FRAMES
+/*
+	This define controls how often (in frames) the main loop calls Memory::releaseIdleMemory() to start a scavenge pass of the allocater. Set to 0 to
+	disable the periodic scavenge. The default value is 600, or about every 10 seconds at 60 frames per second.
+*/
+#define GALACTIC_ALLOCATER_SCAVENGE_FRAMES 600
+
+//GALACTIC_FRAMEARENA_BLOCK_SIZE
+/*
+	This define controls the step each thread's FrameArena sub-arena commits it's reserved memory in, this must be a power of 2 and a multiple of the
+	page size. Committed memory is kept from frame to frame (memory that goes unused for a while is decommitted), so this should be large enough to hold
+	the temporary allocations of an average frame on a single thread. The default value is 1MB.
+*/
+#define GALACTIC_FRAMEARENA_BLOCK_SIZE 1048576
+
+//GALACTIC_FRAMEARENA_RESERVE_SIZE
+/*
+	This define controls the amount of address space reserved by each thread's FrameArena sub-arena, only the part that is used is committed. Requests
+	that do not fit in the reserved range are given their own block. The default value is 64MB.
+*/
+#define GALACTIC_FRAMEARENA_RESERVE_SIZE 67108864
+
+//GALACTIC_DEBUG_FRAMEARENA
+/*
+	This define enables the debug checks on the FrameArena. Memory released at the end of a frame is filled with 0xDD, and any use of a FramePtr or
+	frame container past the end of the frame it was created in is reported to the console. This should only be enabled in debug builds.
+*/
+#define GALACTIC_DEBUG_FRAMEARENA 0
+
+//GALACTIC_OBJECTPOOL_CHUNK_SIZE
+/*
+	This define controls the default amount of objects allocated at once by an ObjectPool<T> when it runs out of free objects. The default value is 64.
+*/
+#define GALACTIC_OBJECTPOOL_CHUNK_SIZE 64
+
+//GALACTIC_OBJECTPOOL_FRONT_SIZE
+/*
+	This define controls the maximum amount of free objects held in each thread's local front of an ObjectPool<T> created with the ThreadFront flag.
+	Allocating and releasing objects through the front requires no locking, the front is refilled from (or returned to) the pool in batches of half
+	this amount. The default value is 32.
+*/
+#define GALACTIC_OBJECTPOOL_FRONT_SIZE 32
+
+//GALACTIC_STRTOOLS_SIMD
+/*
+	This define controls if the bulk string operations in StrTools (search, case insensitive compare, case conversion, character sets) and the UTF-8
+	validation / transcoding in Unicode use SSE2 and AVX2 on x86 CPUs. The instruction set is selected when first used, and a scalar fallback is always available. Set to 1 to enable (Default), 0 to disable.
+*/
+#define GALACTIC_STRTOOLS_SIMD 1
+
+//GALACTIC_FORMAT_CHECK_LENGTH
+/*
+	This define controls the longest literal format string (in bytes) that the GC_Print/Warn/Error/CError macros check against their arguments at
+	compile time (see FormatCheck). The check is evaluated one character at a time, longer formats are left unchecked so they don't run into the
+	compiler's constant evaluation depth. Set to 0 to disable the check. The default value is 256.
+*/
+#define GALACTIC_FORMAT_CHECK_LENGTH 256
+
+//GALACTIC_SNAPSHOT_HISTORY
+/*
+	This define controls the amount of past snapshots kept by a SnapshotHistory (see Stream/snapshot.h). A client's acknowledged snapshot can only be
+	used as a delta baseline while it is in the history, when the acknowledgements fall further behind than this the full state is sent instead. The
+	server keeps one history that is shared by all clients. The default value is 32.
+*/
+#define GALACTIC_SNAPSHOT_HISTORY 32
+
+//GALACTIC_MEMORY_TRACKING
+/*
+	This define controls the tagged memory accounting performed by Memory::gmalloc(). When enabled the live bytes of every MemoryTracker tag are
+	tracked with per-thread counters (see MemoryTracker), so per-subsystem growth can be watched in long running builds such as dedicated servers.
+	The engine's allocaters keep the tag of a block in a one byte per block table at the start of it's slab span (no per-allocation header) and
+	the counters record the usable size of each block. Allocaters that don't report block sizes only count allocations. Set to 1 to enable (Default), 0 to disable.
+*/
+#define GALACTIC_MEMORY_TRACKING 1
+
+//GALACTIC_BUILD_TESTS
+/*
+	This define compiles the engine's self tests (see Tests/engineTests.h) into the build. They are run at startup when the -runTests command line
+	parameter is given, the results are printed to the console and the engine exits once they are done. Set to 1 to enable, 0 to disable (Default).
+*/
+#define GALACTIC_BUILD_TESTS 0
+
 //GALACTIC_USE_NETWORKING
 /**
 	This define can (and should) be used by software developers seeking to use Galactic 2D to develop non-game software that